@@ -376,6 +376,60 @@ void CL_ShutdownCGame( void ) {
 	cgvm = NULL;
 }
 
+/*
+====================
+CL_AddSceneCommands
+
+Validates a packed buffer of cgame scene commands and hands
+every refEntity and poly batch in it to the renderer
+====================
+*/
+static void CL_AddSceneCommands(const byte *data,int size){
+	const byte *end;
+	if(size <= 0){return;}
+	if(size > MAX_SCENE_COMMAND_BYTES || !data){
+		Com_Error(ERR_DROP,"CL_AddSceneCommands: bad buffer size %i",size);
+	}
+	end = data + size;
+	while(data < end){
+		int commandId;
+		if(end - data < (int)sizeof(int)){
+			Com_Error(ERR_DROP,"CL_AddSceneCommands: truncated command");
+		}
+		commandId = *(const int*)data;
+		switch(commandId){
+		case SCENECMD_REFENTITY:{
+			const sceneEntityCommand_t *cmd = (const sceneEntityCommand_t*)data;
+			if(end - data < (int)sizeof(*cmd)){
+				Com_Error(ERR_DROP,"CL_AddSceneCommands: truncated refEntity");
+			}
+			re.AddRefEntityToScene(&cmd->entity);
+			data += PAD(sizeof(*cmd),sizeof(int));
+			break;
+		}
+		case SCENECMD_POLYS:{
+			const scenePolysCommand_t *cmd = (const scenePolysCommand_t*)data;
+			int vertBytes;
+			if(end - data < (int)sizeof(*cmd)){
+				Com_Error(ERR_DROP,"CL_AddSceneCommands: truncated poly batch");
+			}
+			if(cmd->numVerts <= 0 || cmd->numPolys <= 0 || cmd->numVerts > size / (int)sizeof(polyVert_t) / cmd->numPolys){
+				Com_Error(ERR_DROP,"CL_AddSceneCommands: bad poly batch %i x %i",cmd->numVerts,cmd->numPolys);
+			}
+			vertBytes = cmd->numVerts * cmd->numPolys * sizeof(polyVert_t);
+			if(end - data < (int)sizeof(*cmd) + vertBytes){
+				Com_Error(ERR_DROP,"CL_AddSceneCommands: truncated poly batch");
+			}
+			re.AddPolyToScene(cmd->hShader,cmd->numVerts,(const polyVert_t*)(cmd + 1),cmd->numPolys);
+			data += PAD(sizeof(*cmd) + vertBytes,sizeof(int));
+			break;
+		}
+		default:
+			Com_Error(ERR_DROP,"CL_AddSceneCommands: bad command %i",commandId);
+		}
+	}
+}
+
 static int	FloatAsInt( float f ) {
 	floatint_t fi;
 	fi.f = f;
@@ -452,6 +506,7 @@ intptr_t CL_CgameSystemCalls(intptr_t *args){
 	case CG_R_ADDREFENTITYTOSCENE: 			re.AddRefEntityToScene(VMA(1)); return 0;
 	case CG_R_ADDPOLYTOSCENE: 				re.AddPolyToScene(args[1],args[2],VMA(3),1); return 0;
 	case CG_R_ADDPOLYSTOSCENE: 				re.AddPolyToScene(args[1],args[2],VMA(3),args[4]); return 0;
+	case CG_R_ADDSCENECOMMANDS: 			CL_AddSceneCommands(VMA(1),args[2]); return 0;
 	case CG_R_LIGHTFORPOINT: 				return re.LightForPoint(VMA(1),VMA(2),VMA(3),VMA(4));
 	case CG_R_ADDFOGTOSCENE: 				re.AddFogToScene(VMF(1),VMF(2),VMF(3),VMF(4),VMF(5),VMF(6),VMF(7),VMF(8)); return 0;
 	case CG_R_ADDLIGHTTOSCENE: 				re.AddLightToScene(VMA(1),VMF(2),VMF(3),VMF(4),VMF(5)); return 0;
@@ -461,6 +516,9 @@ intptr_t CL_CgameSystemCalls(intptr_t *args){
 	case CG_R_DRAWSTRETCHPIC:				re.DrawStretchPic(VMF(1),VMF(2),VMF(3),VMF(4),VMF(5),VMF(6),VMF(7),VMF(8),args[9]); return 0;
 	case CG_R_MODELBOUNDS:					re.ModelBounds(args[1],VMA(2),VMA(3)); return 0;
 	case CG_R_LERPTAG:						return re.LerpTag(VMA(1),args[2],args[3],args[4],VMF(5),VMA(6));
+	case CG_R_TAGINDEX:						return re.TagIndex(args[1],VMA(2));
+	case CG_R_LERPTAGS:						return re.LerpTags(VMA(1),args[2],args[3],args[4],VMF(5),VMA(6),args[7]);
+	case CG_R_DRAWSTRING:					re.DrawString(VMF(1),VMF(2),VMF(3),VMF(4),VMF(5),VMA(6),args[7],args[8],args[9]); return 0;
 	case CG_GETGLCONFIG:					CL_GetGlconfig(VMA(1)); return 0;
 	case CG_GETGAMESTATE:					CL_GetGameState(VMA(1)); return 0;
 	case CG_GETCURRENTSNAPSHOTNUMBER:		CL_GetCurrentSnapshotNumber(VMA(1),VMA(2)); return 0;
@@ -471,7 +471,7 @@ void CL_ConsolePrint( char *txt ) {
 
 		// count word length
 		for (l=0 ; l< con.linewidth ; l++) {
-			if ( txt[l] <= ' ') {
+			if ( ((unsigned char *)txt)[l] <= ' ') {
 				break;
 			}
 
@@ -617,6 +617,62 @@ void Con_DrawNotify (void)
 
 }
 
+/*
+================
+Con_DrawLine
+
+Turns a line of console cells back into a string with color escapes and
+draws it in one go.  Multibyte UTF-8 sequences were stored a byte to a
+cell and come back together here as one glyph in the first cell; the run
+ends after the sequence so the text after it stays in its own cells, where
+the cursor and selection expect it.  A caret that would read as the start
+of a color escape ends the run too, so it is drawn as it is.
+================
+*/
+static void Con_DrawLine( int x, int y, const short *text ) {
+	char	line[MAX_STRING_CHARS];
+	int		i, c, len, start;
+	int		color;
+	qboolean	visible;
+
+	len = 0;
+	start = 0;
+	color = -1;
+	visible = qfalse;
+	for ( i = 0 ; i < con.linewidth ; i++ ) {
+		c = text[i] & 0xff;
+		if ( !len ) {
+			start = i;
+		}
+		if ( c != ' ' ) {
+			if ( ColorIndexForNumber( text[i]>>8 ) != color ) {
+				color = ColorIndexForNumber( text[i]>>8 );
+				line[len++] = Q_COLOR_ESCAPE;
+				line[len++] = '0' + color;
+			}
+			visible = qtrue;
+		}
+		line[len++] = c;
+
+		if ( ( c == Q_COLOR_ESCAPE && i + 1 < con.linewidth && isalnum( text[i+1] & 0xff ) )
+			|| ( c >= 0x80 && ( i + 1 >= con.linewidth || ( text[i+1] & 0xc0 ) != 0x80 ) )
+			|| len + 3 >= (int)sizeof( line ) ) {
+			line[len] = 0;
+			if ( visible ) {
+				SCR_DrawSmallString( x + start * SMALLCHAR_WIDTH, y, line, 0 );
+			}
+			len = 0;
+			color = -1;
+			visible = qfalse;
+		}
+	}
+
+	if ( visible ) {
+		line[len] = 0;
+		SCR_DrawSmallString( x + start * SMALLCHAR_WIDTH, y, line, 0 );
+	}
+}
+
 /*
 ================
 Con_DrawSolidConsole
@@ -631,8 +687,8 @@ void Con_DrawSolidConsole( float frac ) {
 	int				row;
 	int				lines;
 //	qhandle_t		conShader;
-	int				currentColor;
 	vec4_t			color;
+	char			line[MAX_STRING_CHARS];
 
 	lines = cls.glconfig.vidHeight * frac;
 	if (lines <= 0)
@@ -667,10 +723,8 @@ void Con_DrawSolidConsole( float frac ) {
 
 	i = strlen( ENGINE_VERSION );
 
-	for (x=0 ; x<i ; x++) {
-		SCR_DrawSmallChar( cls.glconfig.vidWidth - ( i - x + 1 ) * SMALLCHAR_WIDTH,
-			lines - SMALLCHAR_HEIGHT, ENGINE_VERSION[x] );
-	}
+	SCR_DrawSmallString( cls.glconfig.vidWidth - ( i + 1 ) * SMALLCHAR_WIDTH,
+		lines - SMALLCHAR_HEIGHT, ENGINE_VERSION, DS_FORCECOLOR | DS_NOCOLORESCAPE );
 
 
 	// draw the text
@@ -684,8 +738,10 @@ void Con_DrawSolidConsole( float frac ) {
 	{
 	// draw arrows to show the buffer is backscrolled
 		re.SetColor( g_color_table[ColorIndex(COLOR_GREEN)] );
-		for (x=0 ; x<con.linewidth ; x+=4)
-			SCR_DrawSmallChar( con.xadjust + (x+1)*SMALLCHAR_WIDTH, y, '^' );
+		for (x=0 ; x<con.linewidth && x<MAX_STRING_CHARS-1 ; x++)
+			line[x] = ( x & 3 ) ? ' ' : '^';
+		line[x] = 0;
+		SCR_DrawSmallString( con.xadjust + SMALLCHAR_WIDTH, y, line, DS_FORCECOLOR | DS_NOCOLORESCAPE );
 		y -= SMALLCHAR_HEIGHT;
 		rows--;
 	}
@@ -696,8 +752,7 @@ void Con_DrawSolidConsole( float frac ) {
 		row--;
 	}
 
-	currentColor = 7;
-	re.SetColor( g_color_table[currentColor] );
+	re.SetColor( g_color_table[7] );
 
 	for (i=0 ; i<rows ; i++, y -= SMALLCHAR_HEIGHT, row--)
 	{
@@ -710,17 +765,7 @@ void Con_DrawSolidConsole( float frac ) {
 
 		text = con.text + (row % con.totallines)*con.linewidth;
 
-		for (x=0 ; x<con.linewidth ; x++) {
-			if ( ( text[x] & 0xff ) == ' ' ) {
-				continue;
-			}
-
-			if ( ColorIndexForNumber( text[x]>>8 ) != currentColor ) {
-				currentColor = ColorIndexForNumber( text[x]>>8 );
-				re.SetColor( g_color_table[currentColor] );
-			}
-			SCR_DrawSmallChar(  con.xadjust + (x+1)*SMALLCHAR_WIDTH, y, text[x] & 0xff );
-		}
+		Con_DrawLine( con.xadjust + SMALLCHAR_WIDTH, y, text );
 	}
 
 	// draw the input prompt, user text, and cursor if desired
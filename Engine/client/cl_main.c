@@ -3086,6 +3086,7 @@ void CL_InitRef( void ) {
 	ri.FS_ListFiles = FS_ListFiles;
 	ri.FS_FileIsInPAK = FS_FileIsInPAK;
 	ri.FS_FileExists = FS_FileExists;
+	ri.FS_FileStamp = FS_FileStamp;
 	ri.Cvar_Get = Cvar_Get;
 	ri.Cvar_Set = Cvar_Set;
 	ri.Cvar_SetValue = Cvar_SetValue;
@@ -3112,6 +3113,18 @@ void CL_InitRef( void ) {
 	ri.Sys_GLimpInit = Sys_GLimpInit;
 	ri.Sys_LowPhysicalMemory = Sys_LowPhysicalMemory;
 
+	ri.Sys_CreateThread = Sys_CreateThread;
+	ri.Sys_WaitThread = Sys_WaitThread;
+	ri.Sys_CreateMutex = Sys_CreateMutex;
+	ri.Sys_DestroyMutex = Sys_DestroyMutex;
+	ri.Sys_LockMutex = Sys_LockMutex;
+	ri.Sys_UnlockMutex = Sys_UnlockMutex;
+	ri.Sys_CreateSemaphore = Sys_CreateSemaphore;
+	ri.Sys_DestroySemaphore = Sys_DestroySemaphore;
+	ri.Sys_PostSemaphore = Sys_PostSemaphore;
+	ri.Sys_WaitSemaphore = Sys_WaitSemaphore;
+	ri.Sys_ProcessorCount = Sys_ProcessorCount;
+
 	ret = GetRefAPI( REF_API_VERSION, &ri );
 
 #if defined __USEA3D && defined __A3D_GEOM
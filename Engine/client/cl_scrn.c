@@ -116,20 +116,13 @@ void SCR_DrawPic( float x, float y, float width, float height, qhandle_t hShader
 
 
 /*
-** SCR_DrawChar
-** chars are drawn at 640*480 virtual screen size
+** SCR_DrawCharString
+** chars are drawn at 640*480 virtual screen size, spacing apart,
+** all of them in one render command
 */
-static void SCR_DrawChar( int x, int y, float size, int ch ) {
-	int row, col;
-	float frow, fcol;
+static void SCR_DrawCharString( int x, int y, float size, float spacing, const char *string, int flags ) {
 	float	ax, ay, aw, ah;
 
-	ch &= 255;
-
-	if ( ch == ' ' ) {
-		return;
-	}
-
 	if ( y < -size ) {
 		return;
 	}
@@ -140,17 +133,7 @@ static void SCR_DrawChar( int x, int y, float size, int ch ) {
 	ah = size;
 	SCR_AdjustFrom640( &ax, &ay, &aw, &ah );
 
-	row = ch>>4;
-	col = ch&15;
-
-	frow = row*0.0625;
-	fcol = col*0.0625;
-	size = 0.0625;
-
-	re.DrawStretchPic( ax, ay, aw, ah,
-					   fcol, frow, 
-					   fcol + size, frow + size, 
-					   cls.charSetShader );
+	re.DrawString( ax, ay, aw, ah, aw * spacing / size, string, 0, flags, cls.charSetShader );
 }
 
 /*
@@ -198,87 +181,33 @@ Coordinates are at 640 by 480 virtual resolution
 */
 
 void SCR_DrawCustomString(int spacing,int x, int y, const char *string) {
-	vec4_t		color,shadow;
-	const char	*s;
-	int			xx;
+	vec4_t		shadow;
 	int size = 10;
 	shadow[0] = shadow[1] = shadow[2] = 0;
 	shadow[3] = 0.7;
-	color[0] = color[1] = color[2] = color[3] = 1.0;
 	re.SetColor(shadow);
-	s = string;
-	xx = x;
-	while ( *s ) {
-		if (Q_IsColorString( s ) ) {
-			s += 2;
-			continue;
-		}
-		SCR_DrawChar( xx+1, y+1, size, *s );
-		xx += spacing;
-		s++;
-	}
+	SCR_DrawCharString( x+1, y+1, size, spacing, string, DS_FORCECOLOR );
 	// draw the colored text
-	s = string;
-	xx = x;
-	re.SetColor(color );
-	while ( *s ) {
-		if (Q_IsColorString( s ) ) {
-			Com_Memcpy(shadow, g_color_table[ColorIndex(*(s+1))], sizeof( shadow ) );
-			shadow[3] = 0.7;
-			re.SetColor(shadow);
-			s += 2;
-			continue;
-		}
-		SCR_DrawChar( xx, y, size, *s );
-		xx += spacing;
-		s++;
-	}
 	re.SetColor(NULL);
+	SCR_DrawCharString( x, y, size, spacing, string, 0 );
 }
 
 void SCR_DrawStringExt( int x, int y, float size, const char *string, float *setColor, qboolean forceColor,
 		qboolean noColorEscape ) {
 	vec4_t		color;
-	const char	*s;
-	int			xx;
+	int			flags;
+
+	flags = noColorEscape ? DS_NOCOLORESCAPE : 0;
 
 	// draw the drop shadow
 	color[0] = color[1] = color[2] = 0;
 	color[3] = setColor[3];
 	re.SetColor( color );
-	s = string;
-	xx = x;
-	while ( *s ) {
-		if ( !noColorEscape && Q_IsColorString( s ) ) {
-			s += 2;
-			continue;
-		}
-		SCR_DrawChar( xx+2, y+2, size, *s );
-		xx += size;
-		s++;
-	}
-
+	SCR_DrawCharString( x+2, y+2, size, size, string, flags | DS_FORCECOLOR );
 
 	// draw the colored text
-	s = string;
-	xx = x;
 	re.SetColor( setColor );
-	while ( *s ) {
-		if ( Q_IsColorString( s ) ) {
-			if ( !forceColor ) {
-				Com_Memcpy( color, g_color_table[ColorIndex(*(s+1))], sizeof( color ) );
-				color[3] = setColor[3];
-				re.SetColor( color );
-			}
-			if ( !noColorEscape ) {
-				s += 2;
-				continue;
-			}
-		}
-		SCR_DrawChar( xx, y, size, *s );
-		xx += size;
-		s++;
-	}
+	SCR_DrawCharString( x, y, size, size, string, forceColor ? flags | DS_FORCECOLOR : flags );
 	re.SetColor( NULL );
 }
 
@@ -306,33 +235,33 @@ to a fixed color.
 */
 void SCR_DrawSmallStringExt( int x, int y, const char *string, float *setColor, qboolean forceColor,
 		qboolean noColorEscape ) {
-	vec4_t		color;
-	const char	*s;
-	int			xx;
+	int		flags;
+
+	flags = noColorEscape ? DS_NOCOLORESCAPE : 0;
+	if ( forceColor ) {
+		flags |= DS_FORCECOLOR;
+	}
 
 	// draw the colored text
-	s = string;
-	xx = x;
 	re.SetColor( setColor );
-	while ( *s ) {
-		if ( Q_IsColorString( s ) ) {
-			if ( !forceColor ) {
-				Com_Memcpy( color, g_color_table[ColorIndex(*(s+1))], sizeof( color ) );
-				color[3] = setColor[3];
-				re.SetColor( color );
-			}
-			if ( !noColorEscape ) {
-				s += 2;
-				continue;
-			}
-		}
-		SCR_DrawSmallChar( xx, y, *s );
-		xx += SMALLCHAR_WIDTH;
-		s++;
-	}
+	SCR_DrawSmallString( x, y, string, flags );
 	re.SetColor( NULL );
 }
 
+/*
+** SCR_DrawSmallString
+** small chars are drawn at native screen resolution, in the current
+** color and all in one render command; flags are DS_*
+*/
+void SCR_DrawSmallString( int x, int y, const char *string, int flags ) {
+	if ( y < -SMALLCHAR_HEIGHT ) {
+		return;
+	}
+
+	re.DrawString( x, y, SMALLCHAR_WIDTH, SMALLCHAR_HEIGHT, SMALLCHAR_WIDTH,
+				   string, 0, flags, cls.charSetShader );
+}
+
 
 
 /*
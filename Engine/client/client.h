@@ -572,6 +572,7 @@ void	SCR_DrawBigStringColor( int x, int y, const char *s, vec4_t color, qboolean
 void	SCR_DrawSmallStringExt( int x, int y, const char *string, float *setColor, qboolean forceColor, qboolean noColorEscape );
 void	SCR_DrawCustomString( int spacing, int x, int y, const char *string);
 void	SCR_DrawSmallChar( int x, int y, int ch );
+void	SCR_DrawSmallString( int x, int y, const char *string, int flags );	// one render command, DS_* flags
 
 
 //
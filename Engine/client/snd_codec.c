@@ -190,6 +190,8 @@ int S_CodecReadStream(snd_stream_t *stream, int bytes, void *buffer)
 //=======================================================================
 // Util functions (used by codecs)
 
+#define STREAM_BUFFER_BYTES (256*1024)	// window of a buffered stream, power of two
+
 /*
 =================
 S_CodecUtilOpen
@@ -231,7 +233,181 @@ S_CodecUtilClose
 */
 void S_CodecUtilClose(snd_stream_t **stream)
 {
-	FS_FCloseFile((*stream)->file);
+	// a filesystem restart has already closed the handle of a buffered stream
+	if((*stream)->file && !((*stream)->buffer && (*stream)->restartCount != FS_RestartCount()))
+		FS_FCloseFile((*stream)->file);
+	if((*stream)->buffer)
+		Z_Free((*stream)->buffer);
 	Z_Free(*stream);
 	*stream = NULL;
 }
+
+/*
+=================
+S_CodecUtilBufferStream
+
+Sets up a bounded window ahead of the read position of an opened stream,
+so the stream can be decoded away from the main thread.  The main thread
+keeps the window filled with S_CodecUtilFillStream, the only place the
+file is read from; after that the codec reads from the window and can
+only seek within what is there.
+=================
+*/
+qboolean S_CodecUtilBufferStream(snd_stream_t *stream)
+{
+	if(stream->buffer)
+		return qtrue;
+	if(!stream->file)
+		return qfalse;
+
+	stream->buffer = Z_Malloc(STREAM_BUFFER_BYTES);
+	stream->bufferPos = stream->bufferEnd = FS_FTell(stream->file);
+	stream->restartCount = FS_RestartCount();
+
+	S_CodecUtilFillStream(stream);
+	return qtrue;
+}
+
+/*
+=================
+S_CodecUtilFillStream
+
+Tops up the window of a buffered stream.  Main thread only, the decoder
+may be reading the window at the same time.
+=================
+*/
+void S_CodecUtilFillStream(snd_stream_t *stream)
+{
+	int end, space, ofs, len, r;
+
+	if(!stream->buffer || !stream->file)
+		return;
+
+	if(stream->restartCount != FS_RestartCount())
+	{
+		// the handle went with the filesystem, play out what is in the window
+		stream->file = 0;
+		stream->length = stream->bufferEnd;
+		return;
+	}
+
+	end = stream->bufferEnd;
+	space = STREAM_BUFFER_BYTES - (end - Sys_AtomicGet(&stream->bufferPos));
+	if(space > stream->length - end)
+		space = stream->length - end;
+
+	while(space > 0)
+	{
+		ofs = end & (STREAM_BUFFER_BYTES - 1);
+		len = MIN(space, STREAM_BUFFER_BYTES - ofs);
+		r = FS_Read(stream->buffer + ofs, len, stream->file);
+		if(r > 0)
+		{
+			end += r;
+			space -= r;
+		}
+		if(r != len)
+		{
+			// short file, end the stream where the data does
+			stream->length = end;
+			break;
+		}
+	}
+
+	Sys_AtomicSet(&stream->bufferEnd, end);
+}
+
+/*
+=================
+S_CodecUtilStreamReady
+
+True when a read of up to bytes won't run dry before the end of the file,
+which a codec would take for the end of the stream
+=================
+*/
+qboolean S_CodecUtilStreamReady(snd_stream_t *stream, int bytes)
+{
+	int end;
+
+	if(!stream->buffer)
+		return qtrue;
+
+	end = Sys_AtomicGet(&stream->bufferEnd);
+	return end - stream->bufferPos >= bytes || end >= stream->length;
+}
+
+/*
+=================
+S_CodecUtilRead
+=================
+*/
+int S_CodecUtilRead(snd_stream_t *stream, void *buffer, int len)
+{
+	int pos, avail, ofs, first;
+
+	if(!stream->buffer)
+		return FS_Read(buffer, len, stream->file);
+
+	pos = stream->bufferPos;
+	avail = Sys_AtomicGet(&stream->bufferEnd) - pos;
+	if(len > avail)
+		len = avail;
+	if(len <= 0)
+		return 0;
+
+	ofs = pos & (STREAM_BUFFER_BYTES - 1);
+	first = MIN(len, STREAM_BUFFER_BYTES - ofs);
+	Com_Memcpy(buffer, stream->buffer + ofs, first);
+	Com_Memcpy((byte *)buffer + first, stream->buffer, len - first);
+
+	Sys_AtomicSet(&stream->bufferPos, pos + len);
+	return len;
+}
+
+/*
+=================
+S_CodecUtilSeek
+=================
+*/
+int S_CodecUtilSeek(snd_stream_t *stream, long offset, int origin)
+{
+	long pos;
+
+	if(!stream->buffer)
+		return FS_Seek(stream->file, offset, origin);
+
+	switch(origin)
+	{
+		case FS_SEEK_SET:
+			pos = offset;
+			break;
+		case FS_SEEK_CUR:
+			pos = stream->bufferPos + offset;
+			break;
+		case FS_SEEK_END:
+			pos = stream->length + offset;
+			break;
+		default:
+			return -1;
+	}
+
+	// what is behind the read position may already be refilled
+	if(pos < stream->bufferPos || pos > Sys_AtomicGet(&stream->bufferEnd))
+		return -1;
+
+	Sys_AtomicSet(&stream->bufferPos, (int)pos);
+	return 0;
+}
+
+/*
+=================
+S_CodecUtilTell
+=================
+*/
+int S_CodecUtilTell(snd_stream_t *stream)
+{
+	if(!stream->buffer)
+		return FS_FTell(stream->file);
+
+	return stream->bufferPos;
+}
@@ -47,6 +47,10 @@ typedef struct snd_stream_s
 	int length;
 	int pos;
 	void *ptr;
+	byte *buffer;		// window of the file ahead of the decoder, see S_CodecUtilBufferStream
+	volatile int bufferPos;	// file offset the decoder reads next
+	volatile int bufferEnd;	// file offset the window is filled up to
+	int restartCount;	// FS_RestartCount when the window was set up
 } snd_stream_t;
 
 // Codec functions
@@ -78,6 +82,12 @@ int S_CodecReadStream(snd_stream_t *stream, int bytes, void *buffer);
 // Util functions (used by codecs)
 snd_stream_t *S_CodecUtilOpen(const char *filename, snd_codec_t *codec);
 void S_CodecUtilClose(snd_stream_t **stream);
+qboolean S_CodecUtilBufferStream(snd_stream_t *stream);
+void S_CodecUtilFillStream(snd_stream_t *stream);
+qboolean S_CodecUtilStreamReady(snd_stream_t *stream, int bytes);
+int S_CodecUtilRead(snd_stream_t *stream, void *buffer, int len);
+int S_CodecUtilSeek(snd_stream_t *stream, long offset, int origin);
+int S_CodecUtilTell(snd_stream_t *stream);
 
 // WAV Codec
 extern snd_codec_t wav_codec;
@@ -84,8 +84,8 @@ int S_OggOpus_Callback_read(void *datasource, unsigned char *ptr, int size )
 	// we use a snd_stream_t in the generic pointer to pass around
 	stream = (snd_stream_t *) datasource;
 
-	// read it with the Q3 function FS_Read()
-	bytesRead = FS_Read(ptr, size, stream->file);
+	// read it from the file or its in-memory copy
+	bytesRead = S_CodecUtilRead(stream, ptr, size);
 
 	// update the file position
 	stream->pos += bytesRead;
@@ -115,7 +115,7 @@ int S_OggOpus_Callback_seek(void *datasource, opus_int64 offset, int whence)
 		case SEEK_SET :
 		{
 			// set the file position in the actual file with the Q3 function
-			retVal = FS_Seek(stream->file, (long) offset, FS_SEEK_SET);
+			retVal = S_CodecUtilSeek(stream, (long) offset, FS_SEEK_SET);
 
 			// something has gone wrong, so we return here
 			if(retVal < 0)
@@ -131,7 +131,7 @@ int S_OggOpus_Callback_seek(void *datasource, opus_int64 offset, int whence)
 		case SEEK_CUR :
 		{
 			// set the file position in the actual file with the Q3 function
-			retVal = FS_Seek(stream->file, (long) offset, FS_SEEK_CUR);
+			retVal = S_CodecUtilSeek(stream, (long) offset, FS_SEEK_CUR);
 
 			// something has gone wrong, so we return here
 			if(retVal < 0)
@@ -147,7 +147,7 @@ int S_OggOpus_Callback_seek(void *datasource, opus_int64 offset, int whence)
 		case SEEK_END :
 		{
 			// set the file position in the actual file with the Q3 function
-			retVal = FS_Seek(stream->file, (long) offset, FS_SEEK_END);
+			retVal = S_CodecUtilSeek(stream, (long) offset, FS_SEEK_END);
 
 			// something has gone wrong, so we return here
 			if(retVal < 0)
@@ -197,7 +197,7 @@ opus_int64 S_OggOpus_Callback_tell(void *datasource)
 	// snd_stream_t in the generic pointer
 	stream = (snd_stream_t *) datasource;
 
-	return (opus_int64) FS_FTell(stream->file);
+	return (opus_int64) S_CodecUtilTell(stream);
 }
 
 // the callback structure
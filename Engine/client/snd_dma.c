@@ -33,12 +33,45 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 void S_Update_( void );
 void S_Base_StopAllSounds(void);
+void S_Base_ClearSoundBuffer( void );
 void S_Base_StopBackgroundTrack( void );
+static qboolean S_MusicActive( void );
+static void S_MusicDrain( void );
+static void S_MusicStartThread( void );
+static void S_MusicStopThread( void );
 
-snd_stream_t	*s_backgroundStream = NULL;
 static char		s_backgroundLoop[MAX_QPATH];
 //static char		s_backgroundMusic[MAX_QPATH]; //TTimo: unused
 
+#define	MUSIC_RING_FRAMES	65536		// about 3 seconds at 22kHz, power of two
+#define	MUSIC_DECODE_BYTES	16384
+#define	MUSIC_MIN_FRAMES	256
+#define	MUSIC_STALL_MSEC	100			// main thread silence before the music thread mixes
+
+typedef struct {
+	sysThread_t		*thread;
+	sysMutex_t		*lock;			// guards the stream slots, only held briefly
+	sysMutex_t		*decodeLock;	// held by the decoder for a whole block, keeps current open
+	sysSemaphore_t	*wake;
+	volatile int	quit;
+
+	snd_stream_t	*current;		// being decoded
+	snd_stream_t	*next;			// loop stream opened ahead by the main thread
+	snd_stream_t	*finished;		// exhausted, closed by the main thread
+	int				resampleFrac;	// 16.16 position into the next decoded block
+
+	volatile int	readFrame;		// only advanced by the mixer
+	volatile int	writeFrame;		// only advanced by the decoder
+	volatile int	lastMixTime;	// Sys_Milliseconds of the last main thread mix
+	short			ring[MUSIC_RING_FRAMES * 2];
+} musicStream_t;
+
+static musicStream_t	s_music;
+static sysMutex_t		*s_mixLock;		// serializes painting between the main and music threads
+static qboolean			s_musicPainting;	// the music thread holds s_mixLock and is painting
+
+mixState_t				s_mixState;
+
 
 // =======================================================================
 // Internal sound data & structures
@@ -102,7 +135,7 @@ void S_Base_SoundInfo(void) {
 		Com_Printf("%5d submission_chunk\n", dma.submission_chunk);
 		Com_Printf("%5d speed\n", dma.speed);
 		Com_Printf("%p dma buffer\n", dma.buffer);
-		if ( s_backgroundStream ) {
+		if ( S_MusicActive() ) {
 			Com_Printf("Background file: %s\n", s_backgroundLoop );
 		} else {
 			Com_Printf("No background file.\n" );
@@ -338,7 +371,8 @@ are no longer valid.
 ===================
 */
 void S_Base_DisableSounds( void ) {
-	S_Base_StopAllSounds();
+	// the background track is left playing through the reload
+	S_Base_ClearSoundBuffer();
 	s_soundMuted = qtrue;
 }
 
@@ -686,10 +720,13 @@ so sound doesn't stutter.
 */
 void S_Base_ClearSoundBuffer( void ) {
 	int		clear;
+	int		musicEnd;
 		
 	if (!s_soundStarted)
 		return;
 
+	Sys_LockMutex( s_mixLock );
+
 	// stop looping sounds
 	Com_Memset(loopSounds, 0, MAX_GENTITIES*sizeof(loopSound_t));
 	Com_Memset(loop_channels, 0, MAX_CHANNELS*sizeof(channel_t));
@@ -697,7 +734,11 @@ void S_Base_ClearSoundBuffer( void ) {
 
 	S_ChannelSetup();
 
+	// the music keeps streaming through loads and filesystem restarts
+	musicEnd = s_rawend[0];
 	Com_Memset(s_rawend, '\0', sizeof (s_rawend));
+	if ( S_MusicActive() )
+		s_rawend[0] = musicEnd;
 
 	if (dma.samplebits == 8)
 		clear = 0x80;
@@ -708,6 +749,8 @@ void S_Base_ClearSoundBuffer( void ) {
 	if (dma.buffer)
 		Com_Memset(dma.buffer, clear, dma.samples * dma.samplebits/8);
 	SNDDMA_Submit ();
+
+	Sys_UnlockMutex( s_mixLock );
 }
 
 /*
@@ -1011,6 +1054,9 @@ void S_Base_RawSamples( int stream, int samples, int rate, int width, int s_chan
 		intVolumeRight = rightvol * volume * s_volume->value;
 	}
 
+	// the music thread may be painting the raw streams
+	Sys_LockMutex( s_mixLock );
+
 	if ( s_rawend[stream] < s_soundtime ) {
 		Com_DPrintf( "S_Base_RawSamples: resetting minimum: %i < %i\n", s_rawend[stream], s_soundtime );
 		s_rawend[stream] = s_soundtime;
@@ -1094,6 +1140,8 @@ void S_Base_RawSamples( int stream, int samples, int rate, int width, int s_chan
 	if ( s_rawend[stream] > s_soundtime + MAX_RAW_SAMPLES ) {
 		Com_DPrintf( "S_Base_RawSamples: overflowed %i > %i\n", s_rawend[stream], s_soundtime );
 	}
+
+	Sys_UnlockMutex( s_mixLock );
 }
 
 //=============================================================================
@@ -1198,6 +1246,21 @@ qboolean S_ScanChannelStarts( void ) {
 	return newSamples;
 }
 
+/*
+============
+S_UpdateMixState
+
+Main thread only.  Called with s_mixLock held when the music thread runs.
+============
+*/
+static void S_UpdateMixState( void ) {
+	s_mixState.volume = s_muted->integer ? 0 : s_volume->value;
+	s_mixState.musicVolume = s_musicVolume->value;
+	s_mixState.mixahead = s_mixahead->value;
+	s_mixState.testsound = s_testsound->integer != 0;
+	s_mixState.videoRecording = CL_VideoRecording();
+}
+
 /*
 ============
 S_Update
@@ -1210,7 +1273,18 @@ void S_Base_Update( void ) {
 	int			total;
 	channel_t	*ch;
 
-	if ( !s_soundStarted || s_soundMuted ) {
+	if ( !s_soundStarted ) {
+		return;
+	}
+
+	Sys_LockMutex( s_mixLock );
+	S_UpdateMixState();
+	Sys_UnlockMutex( s_mixLock );
+
+	// queue the music streams, even when muted
+	S_UpdateBackgroundTrack();
+
+	if ( s_soundMuted ) {
 //		Com_DPrintf ("not started or muted\n");
 		return;
 	}
@@ -1231,11 +1305,16 @@ void S_Base_Update( void ) {
 		Com_Printf ("----(%i)---- painted: %i\n", total, s_paintedtime);
 	}
 
+	Sys_LockMutex( s_mixLock );
+
 	// add raw data from streamed samples
-	S_UpdateBackgroundTrack();
+	S_MusicDrain();
 
 	// mix some sound
 	S_Update_();
+
+	Sys_UnlockMutex( s_mixLock );
+	Sys_AtomicSet( &s_music.lastMixTime, Sys_Milliseconds() );
 }
 
 void S_GetSoundtime(void)
@@ -1247,7 +1326,7 @@ void S_GetSoundtime(void)
 	
 	fullsamples = dma.samples / dma.channels;
 
-	if( CL_VideoRecording( ) )
+	if( s_mixState.videoRecording )
 	{
 		float fps = MIN(cl_aviFrameRate->value, 1000.0f);
 		float frameDuration = MAX(dma.speed / fps, 1.0f) + clc.aviSoundFrameRemainder;
@@ -1266,8 +1345,9 @@ void S_GetSoundtime(void)
 	{
 		buffers++;					// buffer wrapped
 		
-		if (s_paintedtime > 0x40000000)
-		{	// time to chop things off to avoid 32 bit limits
+		if (s_paintedtime > 0x40000000 && !s_musicPainting)
+		{	// time to chop things off to avoid 32 bit limits,
+			// left for the main thread to do at a later wrap
 			buffers = 0;
 			s_paintedtime = fullsamples;
 			S_Base_StopAllSounds ();
@@ -1362,20 +1442,323 @@ void S_Update_(void) {
 
 background music functions
 
+The track is decoded on its own thread into a ring of 16-bit stereo frames
+at the mixer rate.  Every frame the main thread moves as much as the raw
+stream can hold into s_rawsamples[0].  If the main thread stops mixing for
+a while, e.g. during a map load or a filesystem restart, the music thread
+paints the raw streams itself so the track keeps playing.  Streams are
+pulled into memory when they are opened, so the decoder never touches the
+filesystem or the zone.
+
 ===============================================================================
 */
 
+/*
+======================
+S_MusicActive
+======================
+*/
+static qboolean S_MusicActive( void ) {
+	return s_backgroundLoop[0] || s_music.current || s_music.next
+		|| s_music.readFrame != s_music.writeFrame;
+}
+
+/*
+======================
+S_MusicDecode
+
+Decodes one block of the current stream into the ring.  Called with
+s_music.decodeLock held, from the music thread or from the main thread
+when the thread couldn't be started.  s_music.lock is only taken to look
+at the stream slots and to publish what was decoded, so the main thread
+never waits on the codec.  Returns qfalse when there was nothing to do.
+======================
+*/
+static qboolean S_MusicDecode( void ) {
+	byte			raw[MUSIC_DECODE_BYTES];
+	snd_stream_t	*stream;
+	short			*dst;
+	int				writeFrame, space;
+	int				frameBytes, frames, r;
+	int				step, pos, src, out;
+
+	Sys_LockMutex( s_music.lock );
+	stream = s_music.current;
+	if ( !stream ) {
+		if ( !s_music.next ) {
+			Sys_UnlockMutex( s_music.lock );
+			return qfalse;
+		}
+		stream = s_music.current = s_music.next;
+		s_music.next = NULL;
+		s_music.resampleFrac = 0;
+	}
+	pos = s_music.resampleFrac;
+	Sys_UnlockMutex( s_music.lock );
+
+	writeFrame = s_music.writeFrame;
+	space = MUSIC_RING_FRAMES - ( writeFrame - Sys_AtomicGet( &s_music.readFrame ) );
+	if ( space < MUSIC_MIN_FRAMES ) {
+		return qfalse;
+	}
+
+	// read no more source frames than will fit in the ring once resampled
+	frameBytes = stream->info.width * stream->info.channels;
+	step = (int)( ( (int64_t)stream->info.rate << 16 ) / dma.speed );
+	frames = (int)( ( (int64_t)( space - 1 ) * step + pos ) >> 16 );
+	if ( frames > MUSIC_DECODE_BYTES / frameBytes ) {
+		frames = MUSIC_DECODE_BYTES / frameBytes;
+	}
+	if ( frames <= 0 ) {
+		return qfalse;
+	}
+
+	// an empty window would read as the end of the stream
+	if ( !S_CodecUtilStreamReady( stream, MUSIC_DECODE_BYTES ) ) {
+		return qfalse;
+	}
+
+	r = S_CodecReadStream( stream, frames * frameBytes, raw );
+	if ( r < frameBytes ) {
+		// end of the stream, hand it back for closing
+		Sys_LockMutex( s_music.lock );
+		if ( s_music.finished ) {
+			Sys_UnlockMutex( s_music.lock );
+			return qfalse;
+		}
+		s_music.finished = stream;
+		s_music.current = NULL;
+		Sys_UnlockMutex( s_music.lock );
+		return qtrue;
+	}
+	frames = r / frameBytes;
+
+	// nothing past writeFrame is read until it is published
+	for ( out = 0 ; ( src = pos >> 16 ) < frames ; pos += step, out++ ) {
+		dst = &s_music.ring[( ( writeFrame + out ) & ( MUSIC_RING_FRAMES - 1 ) ) * 2];
+
+		if ( stream->info.width == 2 ) {
+			const short *samples = (const short *)raw + src * stream->info.channels;
+
+			dst[0] = samples[0];
+			dst[1] = samples[stream->info.channels - 1];
+		} else {
+			const byte *samples = raw + src * stream->info.channels;
+
+			dst[0] = ( samples[0] - 128 ) << 8;
+			dst[1] = ( samples[stream->info.channels - 1] - 128 ) << 8;
+		}
+	}
+
+	Sys_LockMutex( s_music.lock );
+	s_music.resampleFrac = pos - ( frames << 16 );
+	Sys_AtomicSet( &s_music.writeFrame, writeFrame + out );
+	Sys_UnlockMutex( s_music.lock );
+	return qtrue;
+}
+
+/*
+======================
+S_MusicDrain
+
+Moves decoded frames into the music raw stream.  Called with s_mixLock held.
+======================
+*/
+static void S_MusicDrain( void ) {
+	int			readFrame, count, avail;
+	int			i, dst, intVolume;
+	const short	*src;
+
+	// don't bother playing anything if musicvolume is 0
+	if ( s_mixState.musicVolume <= 0 ) {
+		return;
+	}
+
+	if ( s_rawend[0] < s_soundtime ) {
+		s_rawend[0] = s_soundtime;
+	}
+
+	readFrame = s_music.readFrame;
+	avail = Sys_AtomicGet( &s_music.writeFrame ) - readFrame;
+	count = s_soundtime + MAX_RAW_SAMPLES - s_rawend[0];
+	if ( count > avail ) {
+		count = avail;
+	}
+	if ( count <= 0 ) {
+		return;
+	}
+
+	intVolume = 256 * s_mixState.musicVolume * s_mixState.volume;
+
+	for ( i = 0 ; i < count ; i++ ) {
+		src = &s_music.ring[( ( readFrame + i ) & ( MUSIC_RING_FRAMES - 1 ) ) * 2];
+		dst = s_rawend[0] & ( MAX_RAW_SAMPLES - 1 );
+		s_rawend[0]++;
+		s_rawsamples[0][dst].left = src[0] * intVolume;
+		s_rawsamples[0][dst].right = src[1] * intVolume;
+	}
+
+	Sys_AtomicSet( &s_music.readFrame, readFrame + count );
+	Sys_PostSemaphore( s_music.wake );
+}
+
+/*
+======================
+S_MusicKeepAlive
+
+The main thread hasn't mixed in a while, so paint the raw streams from
+here.  Sound effects are left alone as they may be reloading.
+======================
+*/
+static void S_MusicKeepAlive( void ) {
+	int		endtime, samps;
+
+	if ( Sys_Milliseconds() - Sys_AtomicGet( &s_music.lastMixTime ) < MUSIC_STALL_MSEC ) {
+		return;
+	}
+
+	Sys_LockMutex( s_mixLock );
+	if ( s_soundStarted && !s_mixState.videoRecording ) {
+		s_musicPainting = qtrue;
+		S_GetSoundtime();
+		s_musicPainting = qfalse;
+		S_MusicDrain();
+
+		endtime = s_soundtime + s_mixState.mixahead * dma.speed;
+		samps = dma.samples >> ( dma.channels - 1 );
+		if ( endtime - s_soundtime > samps ) {
+			endtime = s_soundtime + samps;
+		}
+
+		SNDDMA_BeginPainting();
+		S_PaintRawStreams( endtime );
+		SNDDMA_Submit();
+	}
+	Sys_UnlockMutex( s_mixLock );
+}
+
+/*
+======================
+S_MusicThread
+======================
+*/
+static int S_MusicThread( void *data ) {
+	qboolean	decoded;
+
+	(void)data;
+
+	while ( !Sys_AtomicGet( &s_music.quit ) ) {
+		Sys_LockMutex( s_music.decodeLock );
+		decoded = S_MusicDecode();
+		Sys_UnlockMutex( s_music.decodeLock );
+
+		S_MusicKeepAlive();
+
+		if ( !decoded ) {
+			Sys_WaitSemaphore( s_music.wake, 10 );
+		}
+	}
+
+	return 0;
+}
+
+/*
+======================
+S_MusicSetStream
+
+Replaces every queued stream with the given one and drops whatever was
+decoded but not yet mixed.
+======================
+*/
+static void S_MusicSetStream( snd_stream_t *stream ) {
+	snd_stream_t	*old[3];
+	int				i;
+
+	// waits out a block being decoded from the current stream
+	Sys_LockMutex( s_music.decodeLock );
+	Sys_LockMutex( s_mixLock );
+	Sys_LockMutex( s_music.lock );
+	old[0] = s_music.current;
+	old[1] = s_music.next;
+	old[2] = s_music.finished;
+	s_music.current = stream;
+	s_music.next = NULL;
+	s_music.finished = NULL;
+	s_music.resampleFrac = 0;
+	Sys_AtomicSet( &s_music.readFrame, s_music.writeFrame );
+	Sys_UnlockMutex( s_music.lock );
+	Sys_UnlockMutex( s_mixLock );
+	Sys_UnlockMutex( s_music.decodeLock );
+
+	for ( i = 0 ; i < 3 ; i++ ) {
+		if ( old[i] ) {
+			S_CodecCloseStream( old[i] );
+		}
+	}
+
+	Sys_PostSemaphore( s_music.wake );
+}
+
+/*
+======================
+S_MusicStartThread
+======================
+*/
+static void S_MusicStartThread( void ) {
+	s_mixLock = Sys_CreateMutex();
+	s_music.lock = Sys_CreateMutex();
+	s_music.decodeLock = Sys_CreateMutex();
+	s_music.wake = Sys_CreateSemaphore( 0 );
+	s_music.quit = 0;
+	s_music.lastMixTime = Sys_Milliseconds();
+	S_UpdateMixState();
+
+	if ( s_mixLock && s_music.lock && s_music.decodeLock && s_music.wake ) {
+		s_music.thread = Sys_CreateThread( "music", S_MusicThread, NULL );
+	}
+
+	if ( !s_music.thread ) {
+		Com_Printf( S_COLOR_YELLOW "WARNING: music will be decoded on the main thread\n" );
+	}
+}
+
+/*
+======================
+S_MusicStopThread
+======================
+*/
+static void S_MusicStopThread( void ) {
+	if ( s_music.thread ) {
+		Sys_AtomicSet( &s_music.quit, 1 );
+		Sys_PostSemaphore( s_music.wake );
+		Sys_WaitThread( s_music.thread );
+		s_music.thread = NULL;
+	}
+
+	Sys_DestroySemaphore( s_music.wake );
+	Sys_DestroyMutex( s_music.decodeLock );
+	Sys_DestroyMutex( s_music.lock );
+	Sys_DestroyMutex( s_mixLock );
+	s_music.wake = NULL;
+	s_music.decodeLock = NULL;
+	s_music.lock = NULL;
+	s_mixLock = NULL;
+}
+
 /*
 ======================
 S_StopBackgroundTrack
 ======================
 */
 void S_Base_StopBackgroundTrack( void ) {
-	if(!s_backgroundStream)
+	if ( !S_MusicActive() )
 		return;
-	S_CodecCloseStream(s_backgroundStream);
-	s_backgroundStream = NULL;
+	s_backgroundLoop[0] = '\0';
+	S_MusicSetStream( NULL );
+
+	Sys_LockMutex( s_mixLock );
 	s_rawend[0] = 0;
+	Sys_UnlockMutex( s_mixLock );
 }
 
 /*
@@ -1383,25 +1766,28 @@ void S_Base_StopBackgroundTrack( void ) {
 S_OpenBackgroundStream
 ======================
 */
-static void S_OpenBackgroundStream( const char *filename ) {
-	// close the background track, but DON'T reset s_rawend
-	// if restarting the same back ground track
-	if(s_backgroundStream)
-	{
-		S_CodecCloseStream(s_backgroundStream);
-		s_backgroundStream = NULL;
-	}
+static snd_stream_t *S_OpenBackgroundStream( const char *filename ) {
+	snd_stream_t	*stream;
 
 	// Open stream
-	s_backgroundStream = S_CodecOpenStream(filename);
-	if(!s_backgroundStream) {
+	stream = S_CodecOpenStream(filename);
+	if(!stream) {
 		Com_Printf( S_COLOR_YELLOW "WARNING: couldn't open music file %s\n", filename );
-		return;
+		return NULL;
 	}
 
-	if(s_backgroundStream->info.channels != 2 || s_backgroundStream->info.rate != 22050) {
+	if(stream->info.channels != 2 || stream->info.rate != 22050) {
 		Com_Printf(S_COLOR_YELLOW "WARNING: music file %s is not 22k stereo\n", filename );
 	}
+
+	// the decoder runs off the main thread, which keeps the window filled
+	if(!S_CodecUtilBufferStream(stream)) {
+		Com_Printf( S_COLOR_YELLOW "WARNING: couldn't buffer music file %s\n", filename );
+		S_CodecCloseStream(stream);
+		return NULL;
+	}
+
+	return stream;
 }
 
 /*
@@ -1426,80 +1812,71 @@ void S_Base_StartBackgroundTrack( const char *intro, const char *loop ){
 
 	Q_strncpyz( s_backgroundLoop, loop, sizeof( s_backgroundLoop ) );
 
-	S_OpenBackgroundStream( intro );
+	// s_rawend is kept, so whatever of the old track was already
+	// queued still plays out
+	S_MusicSetStream( S_OpenBackgroundStream( intro ) );
 }
 
 /*
 ======================
 S_UpdateBackgroundTrack
+
+Closes exhausted streams, keeps the file windows of the open ones filled
+and opens the next loop ahead of time, on the main thread where the
+filesystem can be used.  Runs even while sounds
+are disabled so the music keeps looping through loads.
 ======================
 */
 void S_UpdateBackgroundTrack( void ) {
-	int		bufferSamples;
-	int		fileSamples;
-	byte	raw[30000];		// just enough to fit in a mac stack frame
-	int		fileBytes;
-	int		r;
+	snd_stream_t	*finished, *current, *next;
+	qboolean		needNext;
 
-	if(!s_backgroundStream) {
-		return;
-	}
+	Sys_LockMutex( s_music.lock );
+	finished = s_music.finished;
+	s_music.finished = NULL;
+	current = s_music.current;
+	next = s_music.next;
+	needNext = s_backgroundLoop[0] && !s_music.next;
+	Sys_UnlockMutex( s_music.lock );
 
-	// don't bother playing anything if musicvolume is 0
-	if ( s_musicVolume->value <= 0 ) {
-		return;
+	if ( finished ) {
+		S_CodecCloseStream( finished );
 	}
 
-	// see how many samples should be copied into the raw buffer
-	if ( s_rawend[0] < s_soundtime ) {
-		s_rawend[0] = s_soundtime;
+	// only the main thread closes streams, so these stay open even if the
+	// decoder moves on from them meanwhile
+	if ( current ) {
+		S_CodecUtilFillStream( current );
+	}
+	if ( next ) {
+		S_CodecUtilFillStream( next );
 	}
 
-	while ( s_rawend[0] < s_soundtime + MAX_RAW_SAMPLES ) {
-		bufferSamples = MAX_RAW_SAMPLES - (s_rawend[0] - s_soundtime);
-
-		// decide how much data needs to be read from the file
-		fileSamples = bufferSamples * s_backgroundStream->info.rate / dma.speed;
-
-		if (!fileSamples)
-			return;
-
-		// our max buffer size
-		fileBytes = fileSamples * (s_backgroundStream->info.width * s_backgroundStream->info.channels);
-		if ( fileBytes > sizeof(raw) ) {
-			fileBytes = sizeof(raw);
-			fileSamples = fileBytes / (s_backgroundStream->info.width * s_backgroundStream->info.channels);
-		}
-
-		// Read
-		r = S_CodecReadStream(s_backgroundStream, fileBytes, raw);
-		if(r < fileBytes)
-		{
-			fileSamples = r / (s_backgroundStream->info.width * s_backgroundStream->info.channels);
-		}
-
-		if(r > 0)
-		{
-			// add to raw buffer
-			S_Base_RawSamples(0, fileSamples, s_backgroundStream->info.rate,
-				s_backgroundStream->info.width, s_backgroundStream->info.channels, raw, s_musicVolume->value, -1);
-		}
-		else
-		{
-			// loop
-			if(s_backgroundLoop[0])
-			{
-				S_OpenBackgroundStream( s_backgroundLoop );
-				if(!s_backgroundStream)
-					return;
+	if ( needNext ) {
+		next = S_OpenBackgroundStream( s_backgroundLoop );
+		if ( !next ) {
+			// don't retry every frame, let the current stream play out
+			s_backgroundLoop[0] = '\0';
+		} else {
+			Sys_LockMutex( s_music.lock );
+			if ( !s_music.next ) {
+				s_music.next = next;
+				next = NULL;
 			}
-			else
-			{
-				S_Base_StopBackgroundTrack();
-				return;
+			Sys_UnlockMutex( s_music.lock );
+
+			if ( next ) {
+				S_CodecCloseStream( next );
 			}
+			Sys_PostSemaphore( s_music.wake );
 		}
+	}
 
+	if ( !s_music.thread ) {
+		Sys_LockMutex( s_music.decodeLock );
+		while ( S_MusicDecode() )
+			;
+		Sys_UnlockMutex( s_music.decodeLock );
 	}
 }
 
@@ -1549,6 +1926,9 @@ void S_Base_Shutdown( void ) {
 		return;
 	}
 
+	S_Base_StopBackgroundTrack();
+	S_MusicStopThread();
+
 	SNDDMA_Shutdown();
 	SND_shutdown();
 
@@ -1587,6 +1967,7 @@ qboolean S_Base_Init( soundInterface_t *si ) {
 		s_soundtime = 0;
 		s_paintedtime = 0;
 
+		S_MusicStartThread( );
 		S_Base_StopAllSounds( );
 	} else {
 		return qfalse;
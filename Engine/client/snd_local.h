@@ -202,6 +202,18 @@ extern cvar_t *s_doppler;
 
 extern cvar_t *s_testsound;
 
+// what the mixer reads of the cvars and the client, copied by the main
+// thread each update so the music thread never looks at them
+typedef struct {
+	float		volume;			// 0 when muted
+	float		musicVolume;
+	float		mixahead;
+	qboolean	testsound;
+	qboolean	videoRecording;
+} mixState_t;
+
+extern mixState_t	s_mixState;
+
 qboolean S_LoadSound( sfx_t *sfx );
 
 void		SND_free(sndBuffer *v);
@@ -210,6 +222,8 @@ void		SND_setup( void );
 void		SND_shutdown(void);
 
 void S_PaintChannels(int endtime);
+void S_PaintRawStreams(int endtime);
+void S_MixBenchmark_f(void);
 
 void S_memoryLoad(sfx_t *sfx);
 
@@ -484,6 +484,9 @@ void S_Init( void )
 	s_muteWhenMinimized = Cvar_Get( "s_muteWhenMinimized", "0", CVAR_ARCHIVE );
 	s_muteWhenUnfocused = Cvar_Get( "s_muteWhenUnfocused", "0", CVAR_ARCHIVE );
 
+	// the benchmark brings its own output buffer, so it works without a device
+	Cmd_AddCommand( "s_mixBench", S_MixBenchmark_f );
+
 	cv = Cvar_Get( "s_initsound", "1", 0 );
 	if( !cv->integer ) {
 		Com_Printf( "^3Warning: Audio disabled. Toggle cvar 's_initSound' to enable.^7\n" );
@@ -544,6 +547,7 @@ void S_Shutdown( void )
 	Cmd_RemoveCommand( "s_list" );
 	Cmd_RemoveCommand( "s_stop" );
 	Cmd_RemoveCommand( "s_info" );
+	Cmd_RemoveCommand( "s_mixBench" );
 
 	S_CodecShutdown( );
 }
@@ -115,10 +115,10 @@ resample / decimate to the current source rate
 */
 static int ResampleSfx( sfx_t *sfx, int channels, int inrate, int inwidth, int samples, byte *data, qboolean compressed ) {
 	int		outcount;
-	int		srcsample;
+	int		srcframe, srcsample, nextsample;
 	float	stepscale;
 	int		i, j;
-	int		sample, samplefrac, fracstep;
+	int		sample, next, samplefrac, fracstep;
 	int			part;
 	sndBuffer	*chunk;
 	
@@ -126,23 +126,26 @@ static int ResampleSfx( sfx_t *sfx, int channels, int inrate, int inwidth, int s
 
 	outcount = samples / stepscale;
 
-	srcsample = 0;
+	// step through source frames with a 16 bit fraction, interpolating linearly between them
+	srcframe = 0;
 	samplefrac = 0;
-	fracstep = stepscale * 256 * channels;
+	fracstep = stepscale * 65536;
 	chunk = sfx->soundData;
 
 	for (i=0 ; i<outcount ; i++)
 	{
-		srcsample += samplefrac >> 8;
-		samplefrac &= 255;
-		samplefrac += fracstep;
+		srcsample = srcframe * channels;
+		nextsample = srcframe + 1 < samples ? srcsample + channels : srcsample;
 		for (j=0 ; j<channels ; j++)
 		{
 			if( inwidth == 2 ) {
 				sample = ( ((short *)data)[srcsample+j] );
+				next = ( ((short *)data)[nextsample+j] );
 			} else {
 				sample = (int)( (unsigned char)(data[srcsample+j]) - 128) << 8;
+				next = (int)( (unsigned char)(data[nextsample+j]) - 128) << 8;
 			}
+			sample += ( ( next - sample ) * ( samplefrac >> 8 ) ) >> 8;
 			part = (i*channels+j)&(SND_CHUNK_SIZE-1);
 			if (part == 0) {
 				sndBuffer	*newchunk;
@@ -157,6 +160,9 @@ static int ResampleSfx( sfx_t *sfx, int channels, int inrate, int inwidth, int s
 
 			chunk->sndChunk[part] = sample;
 		}
+		samplefrac += fracstep;
+		srcframe += samplefrac >> 16;
+		samplefrac &= 0xffff;
 	}
 
 	return outcount;
@@ -171,33 +177,39 @@ resample / decimate to the current source rate
 */
 static int ResampleSfxRaw( short *sfx, int channels, int inrate, int inwidth, int samples, byte *data ) {
 	int			outcount;
-	int			srcsample;
+	int			srcframe, srcsample, nextsample;
 	float		stepscale;
 	int			i, j;
-	int			sample, samplefrac, fracstep;
+	int			sample, next, samplefrac, fracstep;
 	
 	stepscale = (float)inrate / dma.speed;	// this is usually 0.5, 1, or 2
 
 	outcount = samples / stepscale;
 
-	srcsample = 0;
+	// step through source frames with a 16 bit fraction, interpolating linearly between them
+	srcframe = 0;
 	samplefrac = 0;
-	fracstep = stepscale * 256 * channels;
+	fracstep = stepscale * 65536;
 
 	for (i=0 ; i<outcount ; i++)
 	{
-		srcsample += samplefrac >> 8;
-		samplefrac &= 255;
-		samplefrac += fracstep;
+		srcsample = srcframe * channels;
+		nextsample = srcframe + 1 < samples ? srcsample + channels : srcsample;
 		for (j=0 ; j<channels ; j++)
 		{
 			if( inwidth == 2 ) {
 				sample = LittleShort ( ((short *)data)[srcsample+j] );
+				next = LittleShort ( ((short *)data)[nextsample+j] );
 			} else {
 				sample = (int)( (unsigned char)(data[srcsample+j]) - 128) << 8;
+				next = (int)( (unsigned char)(data[nextsample+j]) - 128) << 8;
 			}
+			sample += ( ( next - sample ) * ( samplefrac >> 8 ) ) >> 8;
 			sfx[i*channels+j] = sample;
 		}
+		samplefrac += fracstep;
+		srcframe += samplefrac >> 16;
+		samplefrac &= 0xffff;
 	}
 	return outcount;
 }
@@ -27,6 +27,20 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #include <altivec.h>
 #endif
 
+#if defined(__SSE2__) || idx64
+#define idsse2 1
+#include <emmintrin.h>
+#else
+#define idsse2 0
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define idneon 1
+#include <arm_neon.h>
+#else
+#define idneon 0
+#endif
+
 static portable_samplepair_t paintbuffer[PAINTBUFFER_SIZE];
 static int snd_vol;
 
@@ -138,7 +152,7 @@ void S_TransferStereo16 (unsigned long *pbuf, int endtime)
 		snd_p += snd_linear_count;
 		ls_paintedtime += (snd_linear_count>>1);
 
-		if( CL_VideoRecording( ) )
+		if( s_mixState.videoRecording )
 			CL_WriteAVIAudioFrame( (byte *)snd_out, snd_linear_count << 1 );
 	}
 }
@@ -162,7 +176,7 @@ void S_TransferPaintBuffer(int endtime)
 	pbuf = (unsigned long *)dma.buffer;
 
 
-	if ( s_testsound->integer ) {
+	if ( s_mixState.testsound ) {
 		int		i;
 
 		// write a fixed sine wave
@@ -512,6 +526,160 @@ static void S_PaintChannelFrom16_scalar( channel_t *ch, const sfx_t *sc, int cou
 	}
 }
 
+#if idsse2 || idneon
+// set by s_mixBench to time the scalar path against the vector kernels
+static qboolean s_mixScalar;
+
+/*
+===================
+S_MixRun16
+
+Adds a run of 16 bit samples that doesn't cross a chunk boundary into
+the paint buffer, producing exactly what the scalar loop would
+===================
+*/
+#if idsse2
+static ID_INLINE void S_MixPairs_sse2( __m128i data, __m128i volHigh, __m128i volLow, int *out ) {
+	__m128i lo, hi, mix0, mix1;
+
+	// (data * vol) >> 8 == data * (vol >> 8) + ((data * (vol & 255)) >> 8)
+	// keeps every product inside 16 bit multiplies with 32 bit results
+	lo = _mm_mullo_epi16( data, volHigh );
+	hi = _mm_mulhi_epi16( data, volHigh );
+	mix0 = _mm_unpacklo_epi16( lo, hi );
+	mix1 = _mm_unpackhi_epi16( lo, hi );
+
+	lo = _mm_mullo_epi16( data, volLow );
+	hi = _mm_mulhi_epi16( data, volLow );
+	mix0 = _mm_add_epi32( mix0, _mm_srai_epi32( _mm_unpacklo_epi16( lo, hi ), 8 ) );
+	mix1 = _mm_add_epi32( mix1, _mm_srai_epi32( _mm_unpackhi_epi16( lo, hi ), 8 ) );
+
+	_mm_storeu_si128( (__m128i *)out, _mm_add_epi32( _mm_loadu_si128( (__m128i *)out ), mix0 ) );
+	_mm_storeu_si128( (__m128i *)( out + 4 ), _mm_add_epi32( _mm_loadu_si128( (__m128i *)( out + 4 ) ), mix1 ) );
+}
+#endif
+
+#if idneon
+static ID_INLINE void S_MixPairs_neon( int16x8_t data, int32x4_t vol, int *out ) {
+	int32x4_t mix0, mix1;
+
+	mix0 = vshrq_n_s32( vmulq_s32( vmovl_s16( vget_low_s16( data ) ), vol ), 8 );
+	mix1 = vshrq_n_s32( vmulq_s32( vmovl_s16( vget_high_s16( data ) ), vol ), 8 );
+	vst1q_s32( out, vaddq_s32( vld1q_s32( out ), mix0 ) );
+	vst1q_s32( out + 4, vaddq_s32( vld1q_s32( out + 4 ), mix1 ) );
+}
+#endif
+
+static void S_MixRun16( portable_samplepair_t *samp, const short *samples, int count, int channels, int leftvol, int rightvol ) {
+	int		i, data;
+	int		*out = (int *)samp;
+#if idsse2
+	const __m128i volHigh = _mm_set_epi16( rightvol >> 8, leftvol >> 8, rightvol >> 8, leftvol >> 8,
+		rightvol >> 8, leftvol >> 8, rightvol >> 8, leftvol >> 8 );
+	const __m128i volLow = _mm_set_epi16( rightvol & 255, leftvol & 255, rightvol & 255, leftvol & 255,
+		rightvol & 255, leftvol & 255, rightvol & 255, leftvol & 255 );
+	__m128i s;
+
+	i = 0;
+	if ( channels == 2 ) {
+		// already interleaved left / right like the paint buffer
+		for ( ; i + 4 <= count ; i += 4 ) {
+			S_MixPairs_sse2( _mm_loadu_si128( (const __m128i *)( samples + i * 2 ) ), volHigh, volLow, out + i * 2 );
+		}
+	} else {
+		for ( ; i + 8 <= count ; i += 8 ) {
+			s = _mm_loadu_si128( (const __m128i *)( samples + i ) );
+			S_MixPairs_sse2( _mm_unpacklo_epi16( s, s ), volHigh, volLow, out + i * 2 );
+			S_MixPairs_sse2( _mm_unpackhi_epi16( s, s ), volHigh, volLow, out + i * 2 + 8 );
+		}
+	}
+#elif idneon
+	const int32_t volPair[4] = { leftvol, rightvol, leftvol, rightvol };
+	const int32x4_t vol = vld1q_s32( volPair );
+	int16x8x2_t s;
+
+	i = 0;
+	if ( channels == 2 ) {
+		for ( ; i + 4 <= count ; i += 4 ) {
+			S_MixPairs_neon( vld1q_s16( samples + i * 2 ), vol, out + i * 2 );
+		}
+	} else {
+		for ( ; i + 8 <= count ; i += 8 ) {
+			s = vzipq_s16( vld1q_s16( samples + i ), vld1q_s16( samples + i ) );
+			S_MixPairs_neon( s.val[0], vol, out + i * 2 );
+			S_MixPairs_neon( s.val[1], vol, out + i * 2 + 8 );
+		}
+	}
+#endif
+
+	// whatever doesn't fill a whole vector
+	for ( ; i < count ; i++ ) {
+		data = samples[i * channels];
+		samp[i].left += (data * leftvol)>>8;
+		if ( channels == 2 ) {
+			data = samples[i * 2 + 1];
+		}
+		samp[i].right += (data * rightvol)>>8;
+	}
+}
+
+static void S_PaintChannelFrom16_vector( channel_t *ch, const sfx_t *sc, int count, int sampleOffset, int bufferOffset ) {
+	int						leftvol, rightvol;
+	int						i, run;
+	portable_samplepair_t	*samp;
+	sndBuffer				*chunk;
+
+	if (sc->soundChannels <= 0) {
+		return;
+	}
+
+	// doppler resampling stays on the scalar path
+	if (ch->doppler && ch->dopplerScale!=1.0f) {
+		S_PaintChannelFrom16_scalar( ch, sc, count, sampleOffset, bufferOffset );
+		return;
+	}
+
+	samp = &paintbuffer[ bufferOffset ];
+
+	if (ch->doppler) {
+		sampleOffset = sampleOffset*ch->oldDopplerScale;
+	}
+
+	if ( sc->soundChannels == 2 ) {
+		sampleOffset *= sc->soundChannels;
+
+		if ( sampleOffset & 1 ) {
+			sampleOffset &= ~1;
+		}
+	}
+
+	chunk = sc->soundData;
+	while (sampleOffset>=SND_CHUNK_SIZE) {
+		chunk = chunk->next;
+		sampleOffset -= SND_CHUNK_SIZE;
+		if (!chunk) {
+			chunk = sc->soundData;
+		}
+	}
+
+	leftvol = ch->leftvol*snd_vol;
+	rightvol = ch->rightvol*snd_vol;
+	for ( i=0 ; i<count ; i+=run ) {
+		run = ( SND_CHUNK_SIZE - sampleOffset ) / sc->soundChannels;
+		if ( run > count - i ) {
+			run = count - i;
+		}
+		S_MixRun16( samp + i, chunk->sndChunk + sampleOffset, run, sc->soundChannels, leftvol, rightvol );
+		sampleOffset += run * sc->soundChannels;
+
+		if (sampleOffset == SND_CHUNK_SIZE && i + run < count) {
+			chunk = chunk->next;
+			sampleOffset = 0;
+		}
+	}
+}
+#endif
+
 static void S_PaintChannelFrom16( channel_t *ch, const sfx_t *sc, int count, int sampleOffset, int bufferOffset ) {
 #if idppc_altivec
 	if (com_altivec->integer) {
@@ -519,6 +687,12 @@ static void S_PaintChannelFrom16( channel_t *ch, const sfx_t *sc, int count, int
 		S_PaintChannelFrom16_altivec( ch, sc, count, sampleOffset, bufferOffset );
 		return;
 	}
+#endif
+#if idsse2 || idneon
+	if (!s_mixScalar) {
+		S_PaintChannelFrom16_vector( ch, sc, count, sampleOffset, bufferOffset );
+		return;
+	}
 #endif
 	S_PaintChannelFrom16_scalar( ch, sc, count, sampleOffset, bufferOffset );
 }
@@ -668,10 +842,13 @@ void S_PaintChannelFromMuLaw( channel_t *ch, sfx_t *sc, int count, int sampleOff
 
 /*
 ===================
-S_PaintChannels
+S_Paint
+
+Mixes the raw streams and, unless rawOnly is set, the sound effect
+channels up to endtime.
 ===================
 */
-void S_PaintChannels( int endtime ) {
+static void S_Paint( int endtime, qboolean rawOnly ) {
 	int 	i;
 	int 	end;
 	int 	stream;
@@ -679,11 +856,12 @@ void S_PaintChannels( int endtime ) {
 	sfx_t	*sc;
 	int		ltime, count;
 	int		sampleOffset;
+	int		numChannels, numLoops;
 
-	if(s_muted->integer)
-		snd_vol = 0;
-	else
-		snd_vol = s_volume->value*255;
+	numChannels = rawOnly ? 0 : MAX_CHANNELS;
+	numLoops = rawOnly ? 0 : numLoopChannels;
+
+	snd_vol = s_mixState.volume*255;
 
 //Com_Printf ("%i to %i\n", s_paintedtime, endtime);
 	while ( s_paintedtime < endtime ) {
@@ -711,7 +889,7 @@ void S_PaintChannels( int endtime ) {
 
 		// paint in the channels.
 		ch = s_channels;
-		for ( i = 0; i < MAX_CHANNELS ; i++, ch++ ) {		
+		for ( i = 0; i < numChannels ; i++, ch++ ) {		
 			if ( !ch->thesfx || (ch->leftvol<0.25 && ch->rightvol<0.25 )) {
 				continue;
 			}
@@ -744,7 +922,7 @@ void S_PaintChannels( int endtime ) {
 
 		// paint in the looped channels.
 		ch = loop_channels;
-		for ( i = 0; i < numLoopChannels ; i++, ch++ ) {		
+		for ( i = 0; i < numLoops ; i++, ch++ ) {		
 			if ( !ch->thesfx || (!ch->leftvol && !ch->rightvol )) {
 				continue;
 			}
@@ -786,3 +964,256 @@ void S_PaintChannels( int endtime ) {
 		s_paintedtime = end;
 	}
 }
+
+/*
+===================
+S_PaintChannels
+===================
+*/
+void S_PaintChannels( int endtime ) {
+	S_Paint( endtime, qfalse );
+}
+
+/*
+===================
+S_PaintRawStreams
+
+Only the raw streams are mixed; used to keep the music going while the
+sound effects may be reloading.
+===================
+*/
+void S_PaintRawStreams( int endtime ) {
+	S_Paint( endtime, qtrue );
+}
+
+/*
+===============================================================================
+
+MIXER BENCHMARK
+
+===============================================================================
+*/
+
+#define	MIXBENCH_SPEED		22050
+#define	MIXBENCH_BLOCK		1024
+#define	MIXBENCH_SOUNDS		4
+
+static unsigned int mixBenchSeed;
+
+static int S_MixBenchRandom( void ) {
+	mixBenchSeed = mixBenchSeed * 1103515245 + 12345;
+	return ( mixBenchSeed >> 16 ) & 0x7fff;
+}
+
+/*
+===================
+S_MixBenchSound
+
+Builds a synthetic uncompressed sound in zone memory
+===================
+*/
+static void S_MixBenchSound( sfx_t *sfx, const char *name, int channels, float seconds, float pitch ) {
+	sndBuffer	*chunk = NULL, **link;
+	int			i, total;
+
+	Com_Memset( sfx, 0, sizeof( *sfx ) );
+	Q_strncpyz( sfx->soundName, name, sizeof( sfx->soundName ) );
+	sfx->soundChannels = channels;
+	sfx->soundLength = seconds * MIXBENCH_SPEED;
+	sfx->inMemory = qtrue;
+
+	total = sfx->soundLength * channels;
+	link = &sfx->soundData;
+	for ( i = 0 ; i < total ; i++ ) {
+		if ( !( i & ( SND_CHUNK_SIZE - 1 ) ) ) {
+			chunk = Z_Malloc( sizeof( *chunk ) );
+			*link = chunk;
+			link = &chunk->next;
+		}
+		chunk->sndChunk[i & ( SND_CHUNK_SIZE - 1 )] = sin( i * pitch ) * 12000 + ( S_MixBenchRandom() - 0x4000 ) / 4;
+	}
+}
+
+static void S_MixBenchFreeSound( sfx_t *sfx ) {
+	sndBuffer	*chunk, *next;
+
+	for ( chunk = sfx->soundData ; chunk ; chunk = next ) {
+		next = chunk->next;
+		Z_Free( chunk );
+	}
+}
+
+/*
+===================
+S_MixBenchRender
+
+Mixes the scripted workload into out and returns the msec spent painting
+===================
+*/
+static int S_MixBenchRender( sfx_t *sounds, short *out, int frames, int numChannels ) {
+	channel_t	*ch;
+	int			i, time, start, msec;
+
+	mixBenchSeed = 1;
+	Com_Memset( s_channels, 0, sizeof( s_channels ) );
+	Com_Memset( loop_channels, 0, sizeof( loop_channels ) );
+
+	// a third of the channels are aura and charge loops, the rest are blasts
+	numLoopChannels = numChannels / 3;
+	for ( i = 0, ch = loop_channels ; i < numLoopChannels ; i++, ch++ ) {
+		ch->thesfx = &sounds[i & 1];
+		ch->leftvol = 32 + S_MixBenchRandom() % 224;
+		ch->rightvol = 32 + S_MixBenchRandom() % 224;
+		ch->doppler = ( i % 8 ) == 7;
+		ch->dopplerScale = ch->oldDopplerScale = ch->doppler ? 1.1f : 1.0f;
+	}
+
+	msec = 0;
+	for ( time = 0 ; time < frames ; time += MIXBENCH_BLOCK ) {
+		// restart finished one shots with new volumes
+		for ( i = 0, ch = s_channels ; i < numChannels - numLoopChannels && i < MAX_CHANNELS ; i++, ch++ ) {
+			if ( ch->thesfx && time - ch->startSample < ch->thesfx->soundLength ) {
+				continue;
+			}
+			ch->thesfx = &sounds[2 + ( i & 1 )];
+			ch->startSample = time;
+			ch->leftvol = S_MixBenchRandom() % 256;
+			ch->rightvol = S_MixBenchRandom() % 256;
+		}
+
+		start = Sys_Milliseconds();
+		S_PaintChannels( time + MIXBENCH_BLOCK );
+		msec += Sys_Milliseconds() - start;
+
+		Com_Memcpy( out + time * 2, dma.buffer + ( time & ( ( dma.samples >> 1 ) - 1 ) ) * 4,
+			( frames - time < MIXBENCH_BLOCK ? frames - time : MIXBENCH_BLOCK ) * 4 );
+	}
+
+	return msec;
+}
+
+/*
+===================
+S_MixBenchmark_f
+
+Renders a scripted channel workload without an audio device, times the
+scalar and vector mixers against each other and writes the result as a wav
+===================
+*/
+void S_MixBenchmark_f( void ) {
+	dma_t		oldDma;
+	channel_t	*oldChannels, *oldLoopChannels;
+	int			oldNumLoops, oldPaintedTime;
+	int			oldRawEnd[MAX_RAW_STREAMS];
+	sfx_t		sounds[MIXBENCH_SOUNDS];
+	byte		*wav;
+	short		*scalarOut, *vectorOut;
+	int			frames, numChannels, i;
+	int			scalarMsec, vectorMsec;
+	float		seconds;
+
+	if ( Cmd_Argc() < 2 ) {
+		Com_Printf( "usage: s_mixBench <file.wav> [seconds] [channels]\n" );
+		return;
+	}
+	if ( !Q_stricmp( Cvar_VariableString( "s_backend" ), "base" ) ) {
+		Com_Printf( "s_mixBench can't run while the base sound backend owns the mixer\n" );
+		return;
+	}
+	seconds = Cmd_Argc() > 2 ? atof( Cmd_Argv( 2 ) ) : 10;
+	numChannels = Cmd_Argc() > 3 ? atoi( Cmd_Argv( 3 ) ) : MAX_CHANNELS;
+	seconds = Com_Clamp( 1, 120, seconds );
+	numChannels = Com_Clamp( 1, MAX_CHANNELS * 2, numChannels );
+	frames = PAD( (int)( seconds * MIXBENCH_SPEED ), MIXBENCH_BLOCK );
+
+	if ( !s_testsound ) {
+		s_testsound = Cvar_Get( "s_testsound", "0", CVAR_CHEAT );
+	}
+	s_mixState.volume = s_muted->integer ? 0 : s_volume->value;
+	s_mixState.testsound = s_testsound->integer != 0;
+	s_mixState.videoRecording = qfalse;
+
+	// keep whatever the real mixer had
+	oldDma = dma;
+	oldChannels = Z_Malloc( sizeof( s_channels ) );
+	oldLoopChannels = Z_Malloc( sizeof( loop_channels ) );
+	Com_Memcpy( oldChannels, s_channels, sizeof( s_channels ) );
+	Com_Memcpy( oldLoopChannels, loop_channels, sizeof( loop_channels ) );
+	Com_Memcpy( oldRawEnd, s_rawend, sizeof( s_rawend ) );
+	oldNumLoops = numLoopChannels;
+	oldPaintedTime = s_paintedtime;
+
+	Com_Memset( &dma, 0, sizeof( dma ) );
+	dma.channels = 2;
+	dma.samplebits = 16;
+	dma.speed = MIXBENCH_SPEED;
+	dma.samples = MIXBENCH_BLOCK * 8;
+	dma.submission_chunk = 1;
+	dma.buffer = Z_Malloc( dma.samples * 2 );
+	for ( i = 0 ; i < MAX_RAW_STREAMS ; i++ ) {
+		s_rawend[i] = -1;
+	}
+
+	mixBenchSeed = 1;
+	S_MixBenchSound( &sounds[0], "*aura_loop", 1, 2.0f, 0.031f );
+	S_MixBenchSound( &sounds[1], "*charge_loop", 2, 1.5f, 0.047f );
+	S_MixBenchSound( &sounds[2], "*blast", 1, 0.7f, 0.11f );
+	S_MixBenchSound( &sounds[3], "*explosion", 2, 1.2f, 0.013f );
+
+	wav = Z_Malloc( 44 + frames * 4 * 2 );
+	scalarOut = (short *)( wav + 44 + frames * 4 );
+	vectorOut = (short *)( wav + 44 );
+
+#if idsse2 || idneon
+	s_mixScalar = qtrue;
+	s_paintedtime = 0;
+	scalarMsec = S_MixBenchRender( sounds, scalarOut, frames, numChannels );
+	s_mixScalar = qfalse;
+#else
+	scalarMsec = 0;
+#endif
+	s_paintedtime = 0;
+	vectorMsec = S_MixBenchRender( sounds, vectorOut, frames, numChannels );
+
+	Com_Printf( "%i channels, %.1f seconds at %i Hz\n", numChannels, frames / (float)MIXBENCH_SPEED, MIXBENCH_SPEED );
+#if idsse2 || idneon
+	Com_Printf( "scalar mixer: %i msec\n", scalarMsec );
+	Com_Printf( "vector mixer: %i msec\n", vectorMsec );
+	if ( memcmp( scalarOut, vectorOut, frames * 4 ) ) {
+		Com_Printf( S_COLOR_RED "scalar and vector mixers produced different output\n" );
+	}
+#else
+	Com_Printf( "scalar mixer: %i msec\n", vectorMsec );
+#endif
+
+	// canonical 16 bit stereo pcm header
+	Com_Memcpy( wav, "RIFF", 4 );
+	*(int *)( wav + 4 ) = LittleLong( 36 + frames * 4 );
+	Com_Memcpy( wav + 8, "WAVEfmt ", 8 );
+	*(int *)( wav + 16 ) = LittleLong( 16 );
+	*(short *)( wav + 20 ) = LittleShort( WAV_FORMAT_PCM );
+	*(short *)( wav + 22 ) = LittleShort( 2 );
+	*(int *)( wav + 24 ) = LittleLong( MIXBENCH_SPEED );
+	*(int *)( wav + 28 ) = LittleLong( MIXBENCH_SPEED * 4 );
+	*(short *)( wav + 32 ) = LittleShort( 4 );
+	*(short *)( wav + 34 ) = LittleShort( 16 );
+	Com_Memcpy( wav + 36, "data", 4 );
+	*(int *)( wav + 40 ) = LittleLong( frames * 4 );
+	FS_WriteFile( Cmd_Argv( 1 ), wav, 44 + frames * 4 );
+	Com_Printf( "Wrote %s\n", Cmd_Argv( 1 ) );
+
+	for ( i = 0 ; i < MIXBENCH_SOUNDS ; i++ ) {
+		S_MixBenchFreeSound( &sounds[i] );
+	}
+	Z_Free( wav );
+	Z_Free( dma.buffer );
+
+	dma = oldDma;
+	Com_Memcpy( s_channels, oldChannels, sizeof( s_channels ) );
+	Com_Memcpy( loop_channels, oldLoopChannels, sizeof( loop_channels ) );
+	Com_Memcpy( s_rawend, oldRawEnd, sizeof( s_rawend ) );
+	numLoopChannels = oldNumLoops;
+	s_paintedtime = oldPaintedTime;
+	Z_Free( oldChannels );
+	Z_Free( oldLoopChannels );
+}
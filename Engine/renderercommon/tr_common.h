@@ -132,6 +132,8 @@ qhandle_t RE_RegisterShaderFromImage(const char *name, int lightmapIndex, image_
 void R_InitFreeType( void );
 void R_DoneFreeType( void );
 void RE_RegisterFont(const char *fontName, int pointSize, fontInfo_t *font);
+int R_CharsetGlyph( int c );
+int R_NextStringGlyph( const char **s, int flags, const byte *baseColor, byte *color );
 
 /*
 =============================================================
@@ -147,6 +149,47 @@ void R_LoadPCX( const char *name, byte **pic, int *width, int *height );
 void R_LoadPNG( const char *name, byte **pic, int *width, int *height );
 void R_LoadTGA( const char *name, byte **pic, int *width, int *height );
 
+// The decoders work on a file already in memory and never call back
+// into the engine, so they can run on the image worker threads.  What
+// the loaders used to drop the level for is left in decode->error.
+typedef struct imageDecode_s {
+	const char	*name;
+	void		*(*Malloc)( int bytes );
+	void		(*Free)( void *buf );
+	char		warning[MAX_STRING_CHARS];
+	char		error[MAX_STRING_CHARS];
+} imageDecode_t;
+
+typedef void (*imageDecoder_t)( imageDecode_t *decode, const byte *buffer, int length, byte **pic, int *width, int *height );
+
+void R_DecodeJPG( imageDecode_t *decode, const byte *buffer, int length, byte **pic, int *width, int *height );
+void R_DecodePNG( imageDecode_t *decode, const byte *buffer, int length, byte **pic, int *width, int *height );
+void R_DecodeTGA( imageDecode_t *decode, const byte *buffer, int length, byte **pic, int *width, int *height );
+
+void R_DecodeWarning( imageDecode_t *decode, const char *fmt, ... ) __attribute__ ((format (printf, 2, 3)));
+void R_DecodeError( imageDecode_t *decode, const char *fmt, ... ) __attribute__ ((format (printf, 2, 3)));
+void R_LoadImageWithDecoder( const char *name, imageDecoder_t decoder, byte **pic, int *width, int *height );
+
+/*
+=============================================================
+
+IMAGE WORKERS
+
+=============================================================
+*/
+
+void R_InitImageJobs( void );
+void R_ShutdownImageJobs( void );
+void R_PrefetchImage( const char *name );
+qboolean R_TakePrefetchedImage( const char *name, byte **pic, int *width, int *height );
+void R_FlushImageJobs( void );
+qboolean R_ImageJobsActive( void );
+
+// implemented by each renderer
+const char *R_ImageLoaderExtension( int i );
+qboolean R_ImageLoaded( const char *name );
+void R_PrefetchShaderImages( const char *shaderName );
+
 /*
 ====================================================================
 
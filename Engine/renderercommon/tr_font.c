@@ -56,8 +56,9 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 //    point size. the original TrueType fonts must exist in fonts at this point.
 // 3. run the game, you should see things normally.
 // 4. Exit the game and there will be three dat files and at least three tga files. The 
-//    tga's are in 256x256 pages so if it takes three images to render a 24 point font you 
-//    will end up with fontImage_0_24.tga through fontImage_2_24.tga
+//    tga's are in FONT_PAGE_SIZE square pages, big enough that all but the largest point
+//    sizes fit the whole charset on one page and draw without a shader change. If it
+//    takes more, a font ends up with fontImage_0_24.tga through fontImage_N_24.tga
 // 5. In future runs of the game, the system looks for these images and data files when a s
 //    specific point sized font is rendered and loads them for use. 
 // 6. Because of the original beta nature of the FreeType code you will probably want to hand
@@ -83,6 +84,9 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #define _CEIL(x)   (((x)+63) & -64)
 #define _TRUNC(x)  ((x) >> 6)
 
+// glyph pages are square images this wide
+#define FONT_PAGE_SIZE	512
+
 FT_Library ftLibrary = NULL;  
 #endif
 
@@ -229,12 +233,12 @@ static glyphInfo_t *RE_ConstructGlyphInfo(unsigned char *imageOut, int *xOut, in
 		scaled_height = glyph.height;
 
 		// we need to make sure we fit
-		if (*xOut + scaled_width + 1 >= 255) {
+		if (*xOut + scaled_width + 1 >= FONT_PAGE_SIZE - 1) {
 			*xOut = 0;
 			*yOut += *maxHeight + 1;
 		}
 
-		if (*yOut + *maxHeight + 1 >= 255) {
+		if (*yOut + *maxHeight + 1 >= FONT_PAGE_SIZE - 1) {
 			*yOut = -1;
 			*xOut = -1;
 			ri.Free(bitmap->buffer);
@@ -244,7 +248,7 @@ static glyphInfo_t *RE_ConstructGlyphInfo(unsigned char *imageOut, int *xOut, in
 
 
 		src = bitmap->buffer;
-		dst = imageOut + (*yOut * 256) + *xOut;
+		dst = imageOut + (*yOut * FONT_PAGE_SIZE) + *xOut;
 
 		if (bitmap->pixel_mode == ft_pixel_mode_mono) {
 			for (i = 0; i < glyph.height; i++) {
@@ -269,13 +273,13 @@ static glyphInfo_t *RE_ConstructGlyphInfo(unsigned char *imageOut, int *xOut, in
 				}
 
 				src += glyph.pitch;
-				dst += 256;
+				dst += FONT_PAGE_SIZE;
 			}
 		} else {
 			for (i = 0; i < glyph.height; i++) {
 				Com_Memcpy(dst, src, glyph.pitch);
 				src += glyph.pitch;
-				dst += 256;
+				dst += FONT_PAGE_SIZE;
 			}
 		}
 
@@ -284,10 +288,10 @@ static glyphInfo_t *RE_ConstructGlyphInfo(unsigned char *imageOut, int *xOut, in
 
 		glyph.imageHeight = scaled_height;
 		glyph.imageWidth = scaled_width;
-		glyph.s = (float)*xOut / 256;
-		glyph.t = (float)*yOut / 256;
-		glyph.s2 = glyph.s + (float)scaled_width / 256;
-		glyph.t2 = glyph.t + (float)scaled_height / 256;
+		glyph.s = (float)*xOut / FONT_PAGE_SIZE;
+		glyph.t = (float)*yOut / FONT_PAGE_SIZE;
+		glyph.s2 = glyph.s + (float)scaled_width / FONT_PAGE_SIZE;
+		glyph.t2 = glyph.t + (float)scaled_height / FONT_PAGE_SIZE;
 
 		*xOut += scaled_width + 1;
 
@@ -433,15 +437,15 @@ void RE_RegisterFont(const char *fontName, int pointSize, fontInfo_t *font) {
 
 	//*font = &registeredFonts[registeredFontCount++];
 
-	// make a 256x256 image buffer, once it is full, register it, clean it and keep going 
+	// make a page sized image buffer, once it is full, register it, clean it and keep going 
 	// until all glyphs are rendered
 
-	out = ri.Malloc(256*256);
+	out = ri.Malloc(FONT_PAGE_SIZE*FONT_PAGE_SIZE);
 	if (out == NULL) {
 		ri.Printf(PRINT_WARNING, "RE_RegisterFont: ri.Malloc failure during output image creation.\n");
 		return;
 	}
-	Com_Memset(out, 0, 256*256);
+	Com_Memset(out, 0, FONT_PAGE_SIZE*FONT_PAGE_SIZE);
 
 	maxHeight = 0;
 
@@ -469,7 +473,7 @@ void RE_RegisterFont(const char *fontName, int pointSize, fontInfo_t *font) {
 			// we need to create an image from the bitmap, set all the handles in the glyphs to this point
 			// 
 
-			scaledSize = 256*256;
+			scaledSize = FONT_PAGE_SIZE*FONT_PAGE_SIZE;
 			newSize = scaledSize * 4;
 			imageBuff = ri.Malloc(newSize);
 			left = 0;
@@ -494,18 +498,18 @@ void RE_RegisterFont(const char *fontName, int pointSize, fontInfo_t *font) {
 
 			Com_sprintf (name, sizeof(name), "fonts/fontImage_%i_%i.tga", imageNumber++, pointSize);
 			if (r_saveFontData->integer) { 
-				WriteTGA(name, imageBuff, 256, 256);
+				WriteTGA(name, imageBuff, FONT_PAGE_SIZE, FONT_PAGE_SIZE);
 			}
 
 			//Com_sprintf (name, sizeof(name), "fonts/fontImage_%i_%i", imageNumber++, pointSize);
-			image = R_CreateImage(name, imageBuff, 256, 256, IMGTYPE_COLORALPHA, IMGFLAG_CLAMPTOEDGE, 0 );
+			image = R_CreateImage(name, imageBuff, FONT_PAGE_SIZE, FONT_PAGE_SIZE, IMGTYPE_COLORALPHA, IMGFLAG_CLAMPTOEDGE, 0 );
 			h = RE_RegisterShaderFromImage(name, LIGHTMAP_2D, image, qfalse);
 			for (j = lastStart; j < i; j++) {
 				font->glyphs[j].glyph = h;
 				Q_strncpyz(font->glyphs[j].shaderName, name, sizeof(font->glyphs[j].shaderName));
 			}
 			lastStart = i;
-			Com_Memset(out, 0, 256*256);
+			Com_Memset(out, 0, FONT_PAGE_SIZE*FONT_PAGE_SIZE);
 			xOut = 0;
 			yOut = 0;
 			ri.Free(imageBuff);
@@ -559,3 +563,86 @@ void R_DoneFreeType(void) {
 	registeredFontCount = 0;
 }
 
+
+/*
+===============
+R_CharsetGlyph
+
+Picks the cell of a 16 by 16 charset sheet a code point is drawn with.
+The sheet only holds the first 256 code points, so the punctuation that
+turns up most in pasted text is folded to its plain look and anything
+else is drawn as a question mark.
+===============
+*/
+int R_CharsetGlyph( int c ) {
+	if ( c < 256 ) {
+		return c;
+	}
+
+	switch ( c ) {
+	case 0x2018:	// quotation marks
+	case 0x2019:
+	case 0x201a:
+	case 0x2032:
+		return '\'';
+	case 0x201c:
+	case 0x201d:
+	case 0x201e:
+	case 0x2033:
+		return '"';
+	case 0x2010:	// hyphens and dashes
+	case 0x2011:
+	case 0x2012:
+	case 0x2013:
+	case 0x2014:
+	case 0x2015:
+	case 0x2212:
+		return '-';
+	case 0x2022:	// bullet
+		return '*';
+	case 0x2026:	// ellipsis
+		return '.';
+	case 0x2002:	// spaces
+	case 0x2003:
+	case 0x2009:
+	case 0x200a:
+	case 0x202f:
+	case 0x3000:
+		return ' ';
+	default:
+		return '?';
+	}
+}
+
+/*
+===============
+R_NextStringGlyph
+
+Steps through a DrawString string, following the color escapes on the
+way.  The caller starts color off as baseColor; it is left holding the
+color of the glyph returned.  Returns the charset cell of the next glyph, or -1
+at the end of the string.
+===============
+*/
+int R_NextStringGlyph( const char **s, int flags, const byte *baseColor, byte *color ) {
+	const float	*c;
+
+	while ( Q_IsColorString( *s ) ) {
+		if ( !( flags & DS_FORCECOLOR ) ) {
+			c = g_color_table[ColorIndex( (*s)[1] )];
+			color[0] = c[0] * 255;
+			color[1] = c[1] * 255;
+			color[2] = c[2] * 255;
+			color[3] = baseColor[3];
+		}
+		if ( flags & DS_NOCOLORESCAPE ) {
+			break;
+		}
+		*s += 2;
+	}
+
+	if ( !**s ) {
+		return -1;
+	}
+	return R_CharsetGlyph( Q_DecodeUTF8( s ) );
+}
@@ -0,0 +1,928 @@
+/*
+===========================================================================
+Copyright (C) 1999-2005 Id Software, Inc.
+
+This file is part of Quake III Arena source code.
+
+Quake III Arena source code is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of the License,
+or (at your option) any later version.
+
+Quake III Arena source code is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Quake III Arena source code; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+===========================================================================
+*/
+// tr_image_jobs.c -- decodes level textures on worker threads ahead of registration
+
+#include "tr_common.h"
+
+/*
+=============================================================
+
+IMAGE DECODING
+
+=============================================================
+*/
+
+/*
+=================
+R_DecodeWarning
+
+Messages are collected rather than printed, since the decoder may be
+running on a thread that can't call back into the engine.
+=================
+*/
+void R_DecodeWarning( imageDecode_t *decode, const char *fmt, ... ) {
+	va_list		argptr;
+	int			len;
+
+	len = strlen( decode->warning );
+	if ( len >= (int)sizeof( decode->warning ) - 1 ) {
+		return;
+	}
+
+	va_start( argptr, fmt );
+	Q_vsnprintf( decode->warning + len, sizeof( decode->warning ) - len, fmt, argptr );
+	va_end( argptr );
+}
+
+/*
+=================
+R_DecodeError
+
+Only the first error is kept; the caller drops the level with it.
+=================
+*/
+void R_DecodeError( imageDecode_t *decode, const char *fmt, ... ) {
+	va_list		argptr;
+
+	if ( decode->error[0] ) {
+		return;
+	}
+
+	va_start( argptr, fmt );
+	Q_vsnprintf( decode->error, sizeof( decode->error ), fmt, argptr );
+	va_end( argptr );
+}
+
+static void R_InitDecode( imageDecode_t *decode, const char *name, void *(*allocFunc)( int bytes ), void (*freeFunc)( void *buf ) ) {
+	decode->name = name;
+	decode->Malloc = allocFunc;
+	decode->Free = freeFunc;
+	decode->warning[0] = '\0';
+	decode->error[0] = '\0';
+}
+
+/*
+=================
+R_LoadImageWithDecoder
+
+The synchronous path used by the R_Load* functions.
+=================
+*/
+void R_LoadImageWithDecoder( const char *name, imageDecoder_t decoder, byte **pic, int *width, int *height ) {
+	imageDecode_t	decode;
+	union {
+		byte *b;
+		void *v;
+	} buffer;
+	int				length;
+
+	*pic = NULL;
+	if ( width ) {
+		*width = 0;
+	}
+	if ( height ) {
+		*height = 0;
+	}
+
+	length = ri.FS_ReadFile( ( char * ) name, &buffer.v );
+	if ( !buffer.b || length < 0 ) {
+		return;
+	}
+
+	R_InitDecode( &decode, name, ri.Malloc, ri.Free );
+	decoder( &decode, buffer.b, length, pic, width, height );
+	ri.FS_FreeFile( buffer.v );
+
+	if ( decode.warning[0] ) {
+		ri.Printf( PRINT_WARNING, "%s", decode.warning );
+	}
+	if ( decode.error[0] ) {
+		ri.Error( ERR_DROP, "%s", decode.error );
+	}
+}
+
+/*
+=============================================================
+
+IMAGE WORKERS
+
+R_PrefetchImage resolves a texture name to a file the same way
+R_LoadImage does, reads it on the main thread and queues it for the
+workers.  When registration reaches the image, R_LoadImage takes the
+decoded pixels instead of decoding them itself.  Anything that can't
+be prefetched simply loads synchronously as before.
+
+=============================================================
+*/
+
+#define	MAX_IMAGE_THREADS	8
+#define	MAX_IMAGE_JOBS		64		// files read and in flight at once
+#define	MAX_PENDING_IMAGES	1024	// names waiting for a job slot
+
+typedef enum {
+	IJ_FREE,
+	IJ_QUEUED,
+	IJ_DECODING,
+	IJ_DONE
+} imageJobState_t;
+
+typedef struct {
+	imageJobState_t	state;
+	int				sequence;
+
+	char			name[MAX_QPATH];		// as requested
+	char			fileName[MAX_QPATH];	// as found
+	qboolean		substituted;			// R_LoadImage warns about these
+
+	imageDecoder_t	decoder;
+	byte			*buffer;
+	int				length;
+
+	imageDecode_t	decode;
+	byte			*pic;
+	int				width, height;
+} imageJob_t;
+
+typedef struct {
+	int				numThreads;
+	struct sysThread_s		*threads[MAX_IMAGE_THREADS];
+	struct sysMutex_s		*lock;
+	struct sysSemaphore_s	*work;		// posted once per queued job
+	struct sysSemaphore_s	*done;		// posted once per finished job
+	qboolean		quit;
+
+	imageJob_t		jobs[MAX_IMAGE_JOBS];
+	int				nextSequence;
+	int				takenSequence;
+
+	char			pending[MAX_PENDING_IMAGES][MAX_QPATH];
+	int				firstPending;
+	int				numPending;
+
+	// statistics for the current registration
+	int				numPrefetched;
+	int				numTaken;
+	int				waitMsec;
+} imageJobs_t;
+
+static imageJobs_t	r_imageJobs;
+static cvar_t		*r_imageThreads;
+
+static void *R_ThreadMalloc( int bytes ) {
+	return malloc( bytes );
+}
+
+static void R_ThreadFree( void *buf ) {
+	free( buf );
+}
+
+static imageDecoder_t R_DecoderForExtension( const char *ext ) {
+	if ( !Q_stricmp( ext, "png" ) ) {
+		return R_DecodePNG;
+	}
+	if ( !Q_stricmp( ext, "tga" ) ) {
+		return R_DecodeTGA;
+	}
+	if ( !Q_stricmp( ext, "jpg" ) || !Q_stricmp( ext, "jpeg" ) ) {
+		return R_DecodeJPG;
+	}
+	return NULL;
+}
+
+static void R_RunImageJob( imageJob_t *job ) {
+	R_InitDecode( &job->decode, job->fileName, R_ThreadMalloc, R_ThreadFree );
+	job->decoder( &job->decode, job->buffer, job->length, &job->pic, &job->width, &job->height );
+
+	free( job->buffer );
+	job->buffer = NULL;
+}
+
+/*
+=================
+R_ImageWorker
+=================
+*/
+static int R_ImageWorker( void *data ) {
+	imageJob_t	*job;
+	int			i;
+
+	(void)data;
+
+	while ( 1 ) {
+		ri.Sys_WaitSemaphore( r_imageJobs.work, -1 );
+
+		ri.Sys_LockMutex( r_imageJobs.lock );
+		if ( r_imageJobs.quit ) {
+			ri.Sys_UnlockMutex( r_imageJobs.lock );
+			break;
+		}
+
+		// oldest first, since that is the order registration wants them in
+		job = NULL;
+		for ( i = 0; i < MAX_IMAGE_JOBS; i++ ) {
+			if ( r_imageJobs.jobs[i].state != IJ_QUEUED ) {
+				continue;
+			}
+			if ( !job || r_imageJobs.jobs[i].sequence < job->sequence ) {
+				job = &r_imageJobs.jobs[i];
+			}
+		}
+		if ( job ) {
+			job->state = IJ_DECODING;
+		}
+		ri.Sys_UnlockMutex( r_imageJobs.lock );
+
+		// the main thread got to it first
+		if ( !job ) {
+			continue;
+		}
+
+		R_RunImageJob( job );
+
+		ri.Sys_LockMutex( r_imageJobs.lock );
+		job->state = IJ_DONE;
+		ri.Sys_UnlockMutex( r_imageJobs.lock );
+		ri.Sys_PostSemaphore( r_imageJobs.done );
+	}
+
+	return 0;
+}
+
+/*
+=================
+R_WaitImageJob
+
+Returns with the job decoded, running it here if no worker has
+started on it yet.
+=================
+*/
+static void R_WaitImageJob( imageJob_t *job ) {
+	qboolean	runHere = qfalse;
+	int			start;
+
+	ri.Sys_LockMutex( r_imageJobs.lock );
+	if ( job->state == IJ_QUEUED ) {
+		job->state = IJ_DECODING;
+		runHere = qtrue;
+	}
+	ri.Sys_UnlockMutex( r_imageJobs.lock );
+
+	if ( runHere ) {
+		R_RunImageJob( job );
+
+		ri.Sys_LockMutex( r_imageJobs.lock );
+		job->state = IJ_DONE;
+		ri.Sys_UnlockMutex( r_imageJobs.lock );
+		return;
+	}
+
+	start = ri.Milliseconds();
+	while ( 1 ) {
+		imageJobState_t	state;
+
+		ri.Sys_LockMutex( r_imageJobs.lock );
+		state = job->state;
+		ri.Sys_UnlockMutex( r_imageJobs.lock );
+
+		if ( state == IJ_DONE ) {
+			break;
+		}
+
+		// done is posted for every job, so don't trust a wakeup to be ours
+		ri.Sys_WaitSemaphore( r_imageJobs.done, 10 );
+	}
+	r_imageJobs.waitMsec += ri.Milliseconds() - start;
+}
+
+/*
+=================
+R_ReleaseImageJob
+
+The job must not be running.
+=================
+*/
+static void R_ReleaseImageJob( imageJob_t *job ) {
+	if ( job->buffer ) {
+		free( job->buffer );
+	}
+	if ( job->pic ) {
+		free( job->pic );
+	}
+	Com_Memset( job, 0, sizeof( *job ) );
+}
+
+/*
+=================
+R_ReadImageFile
+
+Resolves the name through the renderer's loader preference exactly as
+R_LoadImage does and reads the winning file.  Returns NULL if there is
+nothing to do in the background: no file, a format the workers don't
+decode, or a DDS that R_LoadImage will take first.
+=================
+*/
+static imageDecoder_t R_ReadImageFile( imageJob_t *job ) {
+	char		localName[MAX_QPATH];
+	char		*altName;
+	const char	*ext;
+	const char	*loaderExt;
+	int			orgLoader = -1;
+	int			i;
+	union {
+		byte *b;
+		void *v;
+	} buffer;
+	int			length;
+
+	if ( r_ext_compressed_textures->integer ) {
+		char ddsName[MAX_QPATH];
+
+		COM_StripExtension( job->name, ddsName, MAX_QPATH );
+		Q_strcat( ddsName, MAX_QPATH, ".dds" );
+		if ( ri.FS_FileExists( ddsName ) ) {
+			return NULL;
+		}
+	}
+
+	Q_strncpyz( localName, job->name, MAX_QPATH );
+	altName = NULL;
+	loaderExt = NULL;
+
+	ext = COM_GetExtension( localName );
+	if ( *ext ) {
+		for ( i = 0; ( loaderExt = R_ImageLoaderExtension( i ) ) != NULL; i++ ) {
+			if ( !Q_stricmp( ext, loaderExt ) ) {
+				break;
+			}
+		}
+
+		if ( loaderExt ) {
+			if ( ri.FS_ReadFile( localName, NULL ) > 0 ) {
+				altName = localName;
+			} else {
+				orgLoader = i;
+				COM_StripExtension( job->name, localName, MAX_QPATH );
+			}
+		}
+	}
+
+	if ( !altName ) {
+		for ( i = 0; ( loaderExt = R_ImageLoaderExtension( i ) ) != NULL; i++ ) {
+			if ( i == orgLoader ) {
+				continue;
+			}
+
+			altName = va( "%s.%s", localName, loaderExt );
+			if ( ri.FS_ReadFile( altName, NULL ) > 0 ) {
+				job->substituted = ( orgLoader != -1 );
+				break;
+			}
+		}
+		if ( !loaderExt ) {
+			return NULL;
+		}
+	}
+
+	job->decoder = R_DecoderForExtension( loaderExt );
+	if ( !job->decoder ) {
+		return NULL;
+	}
+
+	Q_strncpyz( job->fileName, altName, sizeof( job->fileName ) );
+
+	length = ri.FS_ReadFile( job->fileName, &buffer.v );
+	if ( !buffer.b || length <= 0 ) {
+		return NULL;
+	}
+
+	// the file system hands out temp hunk memory, which has to go back
+	// in order, so the workers get their own copy
+	job->buffer = malloc( length );
+	if ( !job->buffer ) {
+		ri.FS_FreeFile( buffer.v );
+		return NULL;
+	}
+	Com_Memcpy( job->buffer, buffer.b, length );
+	job->length = length;
+	ri.FS_FreeFile( buffer.v );
+
+	return job->decoder;
+}
+
+/*
+=================
+R_FreeImageJob
+
+Finds a slot for a new job, giving up a decoded image that registration
+has already gone past if there is nothing free.
+=================
+*/
+static imageJob_t *R_FreeImageJob( void ) {
+	imageJob_t	*job, *oldest;
+	int			i;
+
+	oldest = NULL;
+
+	ri.Sys_LockMutex( r_imageJobs.lock );
+	for ( i = 0; i < MAX_IMAGE_JOBS; i++ ) {
+		job = &r_imageJobs.jobs[i];
+		if ( job->state == IJ_FREE ) {
+			ri.Sys_UnlockMutex( r_imageJobs.lock );
+			return job;
+		}
+		if ( job->state != IJ_DONE || job->sequence >= r_imageJobs.takenSequence ) {
+			continue;
+		}
+		if ( !oldest || job->sequence < oldest->sequence ) {
+			oldest = job;
+		}
+	}
+	ri.Sys_UnlockMutex( r_imageJobs.lock );
+
+	if ( oldest ) {
+		R_ReleaseImageJob( oldest );
+	}
+	return oldest;
+}
+
+/*
+=================
+R_PumpImageJobs
+
+Moves pending names into job slots.
+=================
+*/
+static void R_PumpImageJobs( void ) {
+	imageJob_t	*job;
+	const char	*name;
+
+	while ( r_imageJobs.numPending ) {
+		job = R_FreeImageJob();
+		if ( !job ) {
+			return;
+		}
+
+		name = r_imageJobs.pending[r_imageJobs.firstPending];
+		r_imageJobs.firstPending = ( r_imageJobs.firstPending + 1 ) % MAX_PENDING_IMAGES;
+		r_imageJobs.numPending--;
+
+		// registration may have loaded it since it was asked for
+		if ( R_ImageLoaded( name ) ) {
+			continue;
+		}
+
+		Q_strncpyz( job->name, name, sizeof( job->name ) );
+		if ( !R_ReadImageFile( job ) ) {
+			R_ReleaseImageJob( job );
+			continue;
+		}
+
+		ri.Sys_LockMutex( r_imageJobs.lock );
+		job->sequence = r_imageJobs.nextSequence++;
+		job->state = IJ_QUEUED;
+		ri.Sys_UnlockMutex( r_imageJobs.lock );
+		ri.Sys_PostSemaphore( r_imageJobs.work );
+
+		r_imageJobs.numPrefetched++;
+	}
+}
+
+static imageJob_t *R_FindImageJob( const char *name ) {
+	imageJob_t	*job = NULL;
+	int			i;
+
+	ri.Sys_LockMutex( r_imageJobs.lock );
+	for ( i = 0; i < MAX_IMAGE_JOBS; i++ ) {
+		if ( r_imageJobs.jobs[i].state != IJ_FREE && !strcmp( r_imageJobs.jobs[i].name, name ) ) {
+			job = &r_imageJobs.jobs[i];
+			break;
+		}
+	}
+	ri.Sys_UnlockMutex( r_imageJobs.lock );
+
+	return job;
+}
+
+/*
+=================
+R_PrefetchImage
+
+Called with image names as soon as a level or skin mentions them.
+=================
+*/
+void R_PrefetchImage( const char *name ) {
+	int		i;
+
+	if ( !r_imageJobs.numThreads || !name || !name[0] ) {
+		return;
+	}
+	if ( strlen( name ) >= MAX_QPATH || r_imageJobs.numPending == MAX_PENDING_IMAGES ) {
+		return;
+	}
+
+	if ( R_ImageLoaded( name ) || R_FindImageJob( name ) ) {
+		return;
+	}
+	for ( i = 0; i < r_imageJobs.numPending; i++ ) {
+		if ( !strcmp( r_imageJobs.pending[( r_imageJobs.firstPending + i ) % MAX_PENDING_IMAGES], name ) ) {
+			return;
+		}
+	}
+
+	Q_strncpyz( r_imageJobs.pending[( r_imageJobs.firstPending + r_imageJobs.numPending ) % MAX_PENDING_IMAGES],
+		name, MAX_QPATH );
+	r_imageJobs.numPending++;
+
+	R_PumpImageJobs();
+}
+
+/*
+=================
+R_TakePrefetchedImage
+
+Called by R_LoadImage.  Returns qfalse if the image wasn't prefetched,
+or couldn't be decoded, and should be loaded the usual way.
+=================
+*/
+qboolean R_TakePrefetchedImage( const char *name, byte **pic, int *width, int *height ) {
+	imageJob_t	*job;
+	char		error[MAX_STRING_CHARS];
+	qboolean	taken = qfalse;
+
+	if ( !r_imageJobs.numThreads ) {
+		return qfalse;
+	}
+
+	job = R_FindImageJob( name );
+	if ( !job ) {
+		return qfalse;
+	}
+
+	R_WaitImageJob( job );
+
+	// a soft failure is left for R_LoadImage to repeat, messages and all
+	if ( job->decode.warning[0] && ( job->pic || job->decode.error[0] ) ) {
+		ri.Printf( PRINT_WARNING, "%s", job->decode.warning );
+	}
+	if ( job->decode.error[0] ) {
+		Q_strncpyz( error, job->decode.error, sizeof( error ) );
+		R_ReleaseImageJob( job );
+		ri.Error( ERR_DROP, "%s", error );
+	}
+
+	if ( job->pic ) {
+		int		size = job->width * job->height * 4;
+
+		if ( job->substituted ) {
+			ri.Printf( PRINT_DEVELOPER, "WARNING: %s not present, using %s instead\n",
+					name, job->fileName );
+		}
+
+		*pic = ri.Malloc( size );
+		Com_Memcpy( *pic, job->pic, size );
+		*width = job->width;
+		*height = job->height;
+
+		r_imageJobs.takenSequence = job->sequence;
+		r_imageJobs.numTaken++;
+		taken = qtrue;
+	}
+
+	R_ReleaseImageJob( job );
+	R_PumpImageJobs();
+
+	return taken;
+}
+
+/*
+=================
+R_FlushImageJobs
+
+Called at the end of registration to throw away whatever was
+prefetched but never asked for.
+=================
+*/
+void R_FlushImageJobs( void ) {
+	int		i;
+
+	if ( !r_imageJobs.numThreads ) {
+		return;
+	}
+
+	r_imageJobs.numPending = 0;
+	r_imageJobs.firstPending = 0;
+
+	for ( i = 0; i < MAX_IMAGE_JOBS; i++ ) {
+		imageJob_t	*job = &r_imageJobs.jobs[i];
+		qboolean	running;
+
+		ri.Sys_LockMutex( r_imageJobs.lock );
+		if ( job->state == IJ_QUEUED ) {
+			job->state = IJ_FREE;
+		}
+		running = ( job->state == IJ_DECODING );
+		ri.Sys_UnlockMutex( r_imageJobs.lock );
+
+		if ( running ) {
+			R_WaitImageJob( job );
+		}
+		R_ReleaseImageJob( job );
+	}
+
+	if ( r_imageJobs.numPrefetched ) {
+		ri.Printf( PRINT_DEVELOPER, "%i images prefetched, %i used, %i msec waiting for workers\n",
+			r_imageJobs.numPrefetched, r_imageJobs.numTaken, r_imageJobs.waitMsec );
+	}
+	r_imageJobs.numPrefetched = 0;
+	r_imageJobs.numTaken = 0;
+	r_imageJobs.waitMsec = 0;
+	r_imageJobs.nextSequence = 0;
+	r_imageJobs.takenSequence = 0;
+}
+
+/*
+=================
+R_ImageJobsActive
+=================
+*/
+qboolean R_ImageJobsActive( void ) {
+	return r_imageJobs.numThreads > 0;
+}
+
+/*
+=============================================================
+
+BENCHMARK
+
+=============================================================
+*/
+
+typedef struct {
+	char	name[MAX_QPATH];
+	byte	*buffer;
+	int		length;
+	int		pixels;
+} benchImage_t;
+
+static struct {
+	benchImage_t	*images;
+	int				numImages;
+	int				next;
+	struct sysMutex_s	*lock;
+} r_imageBench;
+
+static void R_BenchDecode( benchImage_t *image ) {
+	imageDecode_t	decode;
+	byte			*pic;
+	int				width, height;
+
+	R_InitDecode( &decode, image->name, R_ThreadMalloc, R_ThreadFree );
+	R_DecoderForExtension( COM_GetExtension( image->name ) )( &decode, image->buffer, image->length, &pic, &width, &height );
+	if ( pic ) {
+		image->pixels = width * height;
+		free( pic );
+	}
+}
+
+static int R_BenchWorker( void *data ) {
+	int		i;
+
+	(void)data;
+
+	while ( 1 ) {
+		ri.Sys_LockMutex( r_imageBench.lock );
+		i = r_imageBench.next++;
+		ri.Sys_UnlockMutex( r_imageBench.lock );
+
+		if ( i >= r_imageBench.numImages ) {
+			break;
+		}
+		R_BenchDecode( &r_imageBench.images[i] );
+	}
+	return 0;
+}
+
+/*
+=================
+R_ImageBench_f
+
+imageBench [directory] [threads]
+
+Decodes every png, tga and jpg in a directory once on the main thread
+and once spread over worker threads.  The files are read up front, so
+only decoding is timed; nothing is uploaded.
+=================
+*/
+static void R_ImageBench_f( void ) {
+	static const char	*exts[] = { "png", "tga", "jpg" };
+	struct sysThread_s	*threads[MAX_IMAGE_THREADS];
+	const char	*dir;
+	char		**list;
+	int			numFiles;
+	int			numThreads;
+	int			i, j;
+	int			start, serialMsec, threadedMsec;
+	int			totalBytes, totalPixels;
+
+	dir = ri.Cmd_Argc() > 1 ? ri.Cmd_Argv( 1 ) : "textures";
+	numThreads = ri.Cmd_Argc() > 2 ? atoi( ri.Cmd_Argv( 2 ) ) : ri.Sys_ProcessorCount();
+	numThreads = Com_Clamp( 1, MAX_IMAGE_THREADS, numThreads );
+
+	// count, then read
+	r_imageBench.numImages = 0;
+	for ( i = 0; i < (int)ARRAY_LEN( exts ); i++ ) {
+		list = ri.FS_ListFiles( dir, exts[i], &numFiles );
+		r_imageBench.numImages += numFiles;
+		ri.FS_FreeFileList( list );
+	}
+	if ( !r_imageBench.numImages ) {
+		ri.Printf( PRINT_ALL, "imageBench: no png, tga or jpg files in %s\n", dir );
+		return;
+	}
+
+	r_imageBench.images = calloc( r_imageBench.numImages, sizeof( benchImage_t ) );
+	r_imageBench.numImages = 0;
+	totalBytes = 0;
+	for ( i = 0; i < (int)ARRAY_LEN( exts ); i++ ) {
+		list = ri.FS_ListFiles( dir, exts[i], &numFiles );
+		for ( j = 0; j < numFiles; j++ ) {
+			benchImage_t	*image = &r_imageBench.images[r_imageBench.numImages];
+			void			*buffer;
+
+			Com_sprintf( image->name, sizeof( image->name ), "%s/%s", dir, list[j] );
+			image->length = ri.FS_ReadFile( image->name, &buffer );
+			if ( !buffer || image->length <= 0 ) {
+				continue;
+			}
+			image->buffer = malloc( image->length );
+			Com_Memcpy( image->buffer, buffer, image->length );
+			ri.FS_FreeFile( buffer );
+
+			totalBytes += image->length;
+			r_imageBench.numImages++;
+		}
+		ri.FS_FreeFileList( list );
+	}
+
+	start = ri.Milliseconds();
+	for ( i = 0; i < r_imageBench.numImages; i++ ) {
+		R_BenchDecode( &r_imageBench.images[i] );
+	}
+	serialMsec = ri.Milliseconds() - start;
+
+	totalPixels = 0;
+	for ( i = 0; i < r_imageBench.numImages; i++ ) {
+		totalPixels += r_imageBench.images[i].pixels;
+	}
+
+	r_imageBench.lock = ri.Sys_CreateMutex();
+	r_imageBench.next = 0;
+
+	start = ri.Milliseconds();
+	for ( i = 0; i < numThreads; i++ ) {
+		threads[i] = ri.Sys_CreateThread( "imageBench", R_BenchWorker, NULL );
+	}
+	for ( i = 0; i < numThreads; i++ ) {
+		ri.Sys_WaitThread( threads[i] );
+	}
+	threadedMsec = ri.Milliseconds() - start;
+
+	ri.Sys_DestroyMutex( r_imageBench.lock );
+	r_imageBench.lock = NULL;
+
+	ri.Printf( PRINT_ALL, "%i images, %i KB compressed, %i Mpixels\n",
+		r_imageBench.numImages, totalBytes / 1024, totalPixels / 1000000 );
+	ri.Printf( PRINT_ALL, "1 thread: %i msec\n", serialMsec );
+	ri.Printf( PRINT_ALL, "%i threads: %i msec (%.2fx)\n", numThreads, threadedMsec,
+		threadedMsec ? (float)serialMsec / threadedMsec : 0.0f );
+
+	for ( i = 0; i < r_imageBench.numImages; i++ ) {
+		free( r_imageBench.images[i].buffer );
+	}
+	free( r_imageBench.images );
+	r_imageBench.images = NULL;
+	r_imageBench.numImages = 0;
+}
+
+/*
+=============================================================
+
+INIT / SHUTDOWN
+
+=============================================================
+*/
+
+/*
+=================
+R_StopImageWorkers
+=================
+*/
+static void R_StopImageWorkers( void ) {
+	int		i;
+
+	if ( r_imageJobs.numThreads ) {
+		R_FlushImageJobs();
+
+		ri.Sys_LockMutex( r_imageJobs.lock );
+		r_imageJobs.quit = qtrue;
+		ri.Sys_UnlockMutex( r_imageJobs.lock );
+
+		for ( i = 0; i < r_imageJobs.numThreads; i++ ) {
+			ri.Sys_PostSemaphore( r_imageJobs.work );
+		}
+		for ( i = 0; i < r_imageJobs.numThreads; i++ ) {
+			ri.Sys_WaitThread( r_imageJobs.threads[i] );
+		}
+	}
+
+	ri.Sys_DestroySemaphore( r_imageJobs.done );
+	ri.Sys_DestroySemaphore( r_imageJobs.work );
+	ri.Sys_DestroyMutex( r_imageJobs.lock );
+
+	Com_Memset( &r_imageJobs, 0, sizeof( r_imageJobs ) );
+}
+
+/*
+=================
+R_InitImageJobs
+=================
+*/
+void R_InitImageJobs( void ) {
+	int		numThreads;
+	int		i;
+
+	r_imageThreads = ri.Cvar_Get( "r_imageThreads", "-1", CVAR_ARCHIVE | CVAR_LATCH );
+	ri.Cmd_AddCommand( "imageBench", R_ImageBench_f );
+
+	Com_Memset( &r_imageJobs, 0, sizeof( r_imageJobs ) );
+
+	// -1 leaves one core for the main thread
+	numThreads = r_imageThreads->integer;
+	if ( numThreads < 0 ) {
+		numThreads = ri.Sys_ProcessorCount() - 1;
+		if ( numThreads < 1 ) {
+			numThreads = 1;
+		}
+	}
+	if ( numThreads > MAX_IMAGE_THREADS ) {
+		numThreads = MAX_IMAGE_THREADS;
+	}
+	if ( numThreads <= 0 ) {
+		return;
+	}
+
+	r_imageJobs.lock = ri.Sys_CreateMutex();
+	r_imageJobs.work = ri.Sys_CreateSemaphore( 0 );
+	r_imageJobs.done = ri.Sys_CreateSemaphore( 0 );
+	if ( !r_imageJobs.lock || !r_imageJobs.work || !r_imageJobs.done ) {
+		ri.Printf( PRINT_WARNING, "WARNING: couldn't create image worker sync objects\n" );
+		R_StopImageWorkers();
+		return;
+	}
+
+	for ( i = 0; i < numThreads; i++ ) {
+		r_imageJobs.threads[i] = ri.Sys_CreateThread( "imageWorker", R_ImageWorker, NULL );
+		if ( !r_imageJobs.threads[i] ) {
+			break;
+		}
+	}
+	r_imageJobs.numThreads = i;
+
+	if ( !r_imageJobs.numThreads ) {
+		ri.Printf( PRINT_WARNING, "WARNING: couldn't start image worker threads\n" );
+		R_StopImageWorkers();
+		return;
+	}
+
+	ri.Printf( PRINT_ALL, "Decoding images on %i worker thread%s\n", r_imageJobs.numThreads,
+		r_imageJobs.numThreads == 1 ? "" : "s" );
+}
+
+/*
+=================
+R_ShutdownImageJobs
+=================
+*/
+void R_ShutdownImageJobs( void ) {
+	ri.Cmd_RemoveCommand( "imageBench" );
+	R_StopImageWorkers();
+}
@@ -50,6 +50,8 @@ typedef struct q_jpeg_error_mgr_s
   struct jpeg_error_mgr pub;  /* "public" fields */
 
   jmp_buf setjmp_buffer;  /* for return to caller */
+
+  imageDecode_t *decode;  /* when decoding, messages go through it */
 } q_jpeg_error_mgr_t;
 
 static void R_JPGErrorExit(j_common_ptr cinfo)
@@ -61,7 +63,13 @@ static void R_JPGErrorExit(j_common_ptr cinfo)
   
   (*cinfo->err->format_message) (cinfo, buffer);
 
-  ri.Printf(PRINT_ALL, "Error: %s", buffer);
+  if (jerr->decode)
+  {
+    /* Append the filename to the error for easier debugging */
+    R_DecodeWarning(jerr->decode, "Error: %s, loading file %s\n", buffer, jerr->decode->name);
+  }
+  else
+    ri.Printf(PRINT_ALL, "Error: %s", buffer);
 
   /* Return control to the setjmp point */
   longjmp(jerr->setjmp_buffer, 1);
@@ -70,15 +78,19 @@ static void R_JPGErrorExit(j_common_ptr cinfo)
 static void R_JPGOutputMessage(j_common_ptr cinfo)
 {
   char buffer[JMSG_LENGTH_MAX];
+  q_jpeg_error_mgr_t *jerr = (q_jpeg_error_mgr_t *)cinfo->err;
   
   /* Create the message */
   (*cinfo->err->format_message) (cinfo, buffer);
   
   /* Send it to stderr, adding a newline */
-  ri.Printf(PRINT_ALL, "%s\n", buffer);
+  if (jerr->decode)
+    R_DecodeWarning(jerr->decode, "%s\n", buffer);
+  else
+    ri.Printf(PRINT_ALL, "%s\n", buffer);
 }
 
-void R_LoadJPG(const char *filename, unsigned char **pic, int *width, int *height)
+void R_DecodeJPG(imageDecode_t *decode, const byte *fbuffer, int len, unsigned char **pic, int *width, int *height)
 {
   /* This struct contains the JPEG decompression parameters and pointers to
    * working space (which is allocated as needed by the JPEG library).
@@ -102,24 +114,10 @@ void R_LoadJPG(const char *filename, unsigned char **pic, int *width, int *heigh
   unsigned int row_stride;	/* physical row width in output buffer */
   unsigned int pixelcount, memcount;
   unsigned int sindex, dindex;
-  byte *out;
-  int len;
-	union {
-		byte *b;
-		void *v;
-	} fbuffer;
+  byte * volatile out = NULL;	/* still valid after a longjmp */
   byte  *buf;
 
-  /* In this example we want to open the input file before doing anything else,
-   * so that the setjmp() error recovery below can assume the file is open.
-   * VERY IMPORTANT: use "b" option to fopen() if you are on a machine that
-   * requires it in order to read binary files.
-   */
-
-  len = ri.FS_ReadFile ( ( char * ) filename, &fbuffer.v);
-  if (!fbuffer.b || len < 0) {
-	return;
-  }
+  *pic = NULL;
 
   /* Step 1: allocate and initialize JPEG decompression object */
 
@@ -131,18 +129,18 @@ void R_LoadJPG(const char *filename, unsigned char **pic, int *width, int *heigh
   cinfo.err = jpeg_std_error(&jerr.pub);
   cinfo.err->error_exit = R_JPGErrorExit;
   cinfo.err->output_message = R_JPGOutputMessage;
+  jerr.decode = decode;
 
   /* Establish the setjmp return context for R_JPGErrorExit to use. */
   if (setjmp(jerr.setjmp_buffer))
   {
     /* If we get here, the JPEG code has signaled an error.
-     * We need to clean up the JPEG object, close the input file, and return.
+     * We need to clean up the JPEG object and return.
      */
     jpeg_destroy_decompress(&cinfo);
-    ri.FS_FreeFile(fbuffer.v);
 
-    /* Append the filename to the error for easier debugging */
-    ri.Printf(PRINT_ALL, ", loading file %s\n", filename);
+    if (out)
+      decode->Free(out);
     return;
   }
 
@@ -151,7 +149,7 @@ void R_LoadJPG(const char *filename, unsigned char **pic, int *width, int *heigh
 
   /* Step 2: specify data source (eg, a file) */
 
-  jpeg_mem_src(&cinfo, fbuffer.b, len);
+  jpeg_mem_src(&cinfo, (unsigned char *)fbuffer, len);
 
   /* Step 3: read file parameters with jpeg_read_header() */
 
@@ -192,18 +190,18 @@ void R_LoadJPG(const char *filename, unsigned char **pic, int *width, int *heigh
       || pixelcount > 0x1FFFFFFF || cinfo.output_components != 3
     )
   {
+    R_DecodeError(decode, "LoadJPG: %s has an invalid image format: %dx%d*4=%d, components: %d", decode->name,
+		    cinfo.output_width, cinfo.output_height, pixelcount * 4, cinfo.output_components);
+
     // Free the memory to make sure we don't leak memory
-    ri.FS_FreeFile (fbuffer.v);
     jpeg_destroy_decompress(&cinfo);
-  
-    ri.Error(ERR_DROP, "LoadJPG: %s has an invalid image format: %dx%d*4=%d, components: %d", filename,
-		    cinfo.output_width, cinfo.output_height, pixelcount * 4, cinfo.output_components);
+    return;
   }
 
   memcount = pixelcount * 4;
   row_stride = cinfo.output_width * cinfo.output_components;
 
-  out = ri.Malloc(memcount);
+  out = decode->Malloc(memcount);
 
   *width = cinfo.output_width;
   *height = cinfo.output_height;
@@ -252,13 +250,6 @@ void R_LoadJPG(const char *filename, unsigned char **pic, int *width, int *heigh
   /* This is an important step since it will release a good deal of memory. */
   jpeg_destroy_decompress(&cinfo);
 
-  /* After finish_decompress, we can close the input file.
-   * Here we postpone it until after no more JPEG errors are possible,
-   * so as to simplify the setjmp error logic above.  (Actually, I don't
-   * think that jpeg_destroy can do an error exit, but why assume anything...)
-   */
-  ri.FS_FreeFile (fbuffer.v);
-
   /* At this point you may want to check to see whether any corrupt-data
    * warnings occurred (test whether jerr.pub.num_warnings is nonzero).
    */
@@ -266,6 +257,11 @@ void R_LoadJPG(const char *filename, unsigned char **pic, int *width, int *heigh
   /* And we're done! */
 }
 
+void R_LoadJPG(const char *filename, unsigned char **pic, int *width, int *height)
+{
+  R_LoadImageWithDecoder(filename, R_DecodeJPG, pic, width, height);
+}
+
 
 /* Expanded data destination object for stdio output */
 
@@ -398,6 +394,7 @@ size_t RE_SaveJPGToBuffer(byte *buffer, size_t bufSize, int quality,
   cinfo.err = jpeg_std_error(&jerr.pub);
   cinfo.err->error_exit = R_JPGErrorExit;
   cinfo.err->output_message = R_JPGOutputMessage;
+  jerr.decode = NULL;
 
   /* Establish the setjmp return context for R_JPGErrorExit to use. */
   if (setjmp(jerr.setjmp_buffer))
@@ -202,6 +202,7 @@ struct PNG_ZlibHeader
 
 struct BufferedFile
 {
+	imageDecode_t *Decode;
 	byte *Buffer;
 	int   Length;
 	byte *Ptr;
@@ -209,22 +210,18 @@ struct BufferedFile
 };
 
 /*
- *  Read a file into a buffer.
+ *  Wrap an in-memory file. The buffer stays owned by the caller.
  */
 
-static struct BufferedFile *ReadBufferedFile(const char *name)
+static struct BufferedFile *OpenBufferedFile(imageDecode_t *decode, const byte *buffer, int length)
 {
 	struct BufferedFile *BF;
-	union {
-		byte *b;
-		void *v;
-	} buffer;
 
 	/*
 	 *  input verification
 	 */
 
-	if(!name)
+	if(!(buffer && (length > 0)))
 	{
 		return(NULL);
 	}
@@ -233,43 +230,19 @@ static struct BufferedFile *ReadBufferedFile(const char *name)
 	 *  Allocate control struct.
 	 */
 
-	BF = ri.Malloc(sizeof(struct BufferedFile));
+	BF = decode->Malloc(sizeof(struct BufferedFile));
 	if(!BF)
 	{
 		return(NULL);
 	}
 
-	/*
-	 *  Initialize the structs components.
-	 */
-
-	BF->Length    = 0;
-	BF->Buffer    = NULL;
-	BF->Ptr       = NULL;
-	BF->BytesLeft = 0;
-
-	/*
-	 *  Read the file.
-	 */
-
-	BF->Length = ri.FS_ReadFile((char *) name, &buffer.v);
-	BF->Buffer = buffer.b;
-
-	/*
-	 *  Did we get it? Is it big enough?
-	 */
-
-	if(!(BF->Buffer && (BF->Length > 0)))
-	{
-		ri.Free(BF);
-
-		return(NULL);
-	}
-
 	/*
 	 *  Set the pointers and counters.
 	 */
 
+	BF->Decode    = decode;
+	BF->Buffer    = (byte *) buffer;
+	BF->Length    = length;
 	BF->Ptr       = BF->Buffer;
 	BF->BytesLeft = BF->Length;
 
@@ -284,12 +257,7 @@ static void CloseBufferedFile(struct BufferedFile *BF)
 {
 	if(BF)
 	{
-		if(BF->Buffer)
-		{
-			ri.FS_FreeFile(BF->Buffer);
-		}
-
-		ri.Free(BF);
+		BF->Decode->Free(BF);
 	}
 }
 
@@ -623,7 +591,7 @@ static uint32_t DecompressIDATs(struct BufferedFile *BF, uint8_t **Buffer)
 
 	BufferedFileRewind(BF, BytesToRewind);
 
-	CompressedData = ri.Malloc(CompressedDataLength);
+	CompressedData = BF->Decode->Malloc(CompressedDataLength);
 	if(!CompressedData)
 	{
 		return(-1);
@@ -644,7 +612,7 @@ static uint32_t DecompressIDATs(struct BufferedFile *BF, uint8_t **Buffer)
 		CH = BufferedFileRead(BF, PNG_ChunkHeader_Size);
 		if(!CH)
 		{
-			ri.Free(CompressedData); 
+			BF->Decode->Free(CompressedData); 
 
 			return(-1);
 		}
@@ -678,14 +646,14 @@ static uint32_t DecompressIDATs(struct BufferedFile *BF, uint8_t **Buffer)
 			OrigCompressedData = BufferedFileRead(BF, Length);
 			if(!OrigCompressedData)
 			{
-				ri.Free(CompressedData); 
+				BF->Decode->Free(CompressedData); 
 
 				return(-1);
 			}
 
 			if(!BufferedFileSkip(BF, PNG_ChunkCRC_Size))
 			{
-				ri.Free(CompressedData); 
+				BF->Decode->Free(CompressedData); 
 
 				return(-1);
 			}
@@ -716,7 +684,7 @@ static uint32_t DecompressIDATs(struct BufferedFile *BF, uint8_t **Buffer)
 	puffResult = puff(puffDest, &puffDestLen, puffSrc, &puffSrcLen);
 	if(!((puffResult == 0) && (puffDestLen > 0)))
 	{
-		ri.Free(CompressedData);
+		BF->Decode->Free(CompressedData);
 
 		return(-1);
 	}
@@ -725,10 +693,10 @@ static uint32_t DecompressIDATs(struct BufferedFile *BF, uint8_t **Buffer)
 	 *  Allocate the buffer for the uncompressed data.
 	 */
 
-	DecompressedData = ri.Malloc(puffDestLen);
+	DecompressedData = BF->Decode->Malloc(puffDestLen);
 	if(!DecompressedData)
 	{
-		ri.Free(CompressedData);
+		BF->Decode->Free(CompressedData);
 
 		return(-1);
 	}
@@ -751,7 +719,7 @@ static uint32_t DecompressIDATs(struct BufferedFile *BF, uint8_t **Buffer)
 	 *  The compressed data is not needed anymore.
 	 */
 
-	ri.Free(CompressedData);
+	BF->Decode->Free(CompressedData);
 
 	/*
 	 *  Check if the last puff() was successfull.
@@ -759,7 +727,7 @@ static uint32_t DecompressIDATs(struct BufferedFile *BF, uint8_t **Buffer)
 
 	if(!((puffResult == 0) && (puffDestLen > 0)))
 	{
-		ri.Free(DecompressedData);
+		BF->Decode->Free(DecompressedData);
 
 		return(-1);
 	}
@@ -1900,7 +1868,7 @@ static qboolean DecodeImageInterlaced(struct PNG_Chunk_IHDR *IHDR,
  *  The PNG loader
  */
 
-void R_LoadPNG(const char *name, byte **pic, int *width, int *height)
+void R_DecodePNG(imageDecode_t *decode, const byte *buffer, int length, byte **pic, int *width, int *height)
 {
 	struct BufferedFile *ThePNG;
 	byte *OutBuffer;
@@ -1934,7 +1902,7 @@ void R_LoadPNG(const char *name, byte **pic, int *width, int *height)
 	 *  input verification
 	 */
 
-	if(!(name && pic))
+	if(!pic)
 	{
 		return;
 	}
@@ -1956,10 +1924,10 @@ void R_LoadPNG(const char *name, byte **pic, int *width, int *height)
 	}
 
 	/*
-	 *  Read the file.
+	 *  Wrap the file.
 	 */
 
-	ThePNG = ReadBufferedFile(name);
+	ThePNG = OpenBufferedFile(decode, buffer, length);
 	if(!ThePNG)
 	{
 		return;
@@ -2062,7 +2030,7 @@ void R_LoadPNG(const char *name, byte **pic, int *width, int *height)
 	{
 		CloseBufferedFile(ThePNG);
 
-		ri.Printf( PRINT_WARNING, "%s: invalid image size\n", name );
+		R_DecodeWarning( decode, "%s: invalid image size\n", decode->name );
 
 		return; 
 	}
@@ -2398,10 +2366,10 @@ void R_LoadPNG(const char *name, byte **pic, int *width, int *height)
 	 *  Allocate output buffer.
 	 */
 
-	OutBuffer = ri.Malloc(IHDR_Width * IHDR_Height * Q3IMAGE_BYTESPERPIXEL); 
+	OutBuffer = decode->Malloc(IHDR_Width * IHDR_Height * Q3IMAGE_BYTESPERPIXEL); 
 	if(!OutBuffer)
 	{
-		ri.Free(DecompressedData); 
+		decode->Free(DecompressedData); 
 		CloseBufferedFile(ThePNG);
 
 		return;  
@@ -2417,8 +2385,8 @@ void R_LoadPNG(const char *name, byte **pic, int *width, int *height)
 		{
 			if(!DecodeImageNonInterlaced(IHDR, OutBuffer, DecompressedData, DecompressedDataLength, HasTransparentColour, TransparentColour, OutPal))
 			{
-				ri.Free(OutBuffer); 
-				ri.Free(DecompressedData); 
+				decode->Free(OutBuffer); 
+				decode->Free(DecompressedData); 
 				CloseBufferedFile(ThePNG);
 
 				return;
@@ -2431,8 +2399,8 @@ void R_LoadPNG(const char *name, byte **pic, int *width, int *height)
 		{
 			if(!DecodeImageInterlaced(IHDR, OutBuffer, DecompressedData, DecompressedDataLength, HasTransparentColour, TransparentColour, OutPal))
 			{
-				ri.Free(OutBuffer); 
-				ri.Free(DecompressedData); 
+				decode->Free(OutBuffer); 
+				decode->Free(DecompressedData); 
 				CloseBufferedFile(ThePNG);
 
 				return;
@@ -2443,8 +2411,8 @@ void R_LoadPNG(const char *name, byte **pic, int *width, int *height)
 
 		default :
 		{
-			ri.Free(OutBuffer); 
-			ri.Free(DecompressedData); 
+			decode->Free(OutBuffer); 
+			decode->Free(DecompressedData); 
 			CloseBufferedFile(ThePNG);
 
 			return;
@@ -2475,7 +2443,7 @@ void R_LoadPNG(const char *name, byte **pic, int *width, int *height)
 	 *  DecompressedData is not needed anymore.
 	 */
 
-	ri.Free(DecompressedData); 
+	decode->Free(DecompressedData); 
 
 	/*
 	 *  We have all data, so close the file.
@@ -2483,3 +2451,8 @@ void R_LoadPNG(const char *name, byte **pic, int *width, int *height)
 
 	CloseBufferedFile(ThePNG);
 }
+
+void R_LoadPNG(const char *name, byte **pic, int *width, int *height)
+{
+	R_LoadImageWithDecoder(name, R_DecodePNG, pic, width, height);
+}
@@ -38,20 +38,16 @@ typedef struct _TargaHeader {
 	unsigned char	pixel_size, attributes;
 } TargaHeader;
 
-void R_LoadTGA ( const char *name, byte **pic, int *width, int *height)
+void R_DecodeTGA( imageDecode_t *decode, const byte *buffer, int length, byte **pic, int *width, int *height )
 {
 	unsigned	columns, rows, numPixels;
 	byte	*pixbuf;
 	int		row, column;
-	byte	*buf_p;
-	byte	*end;
-	union {
-		byte *b;
-		void *v;
-	} buffer;
+	const byte	*buf_p;
+	const byte	*end;
 	TargaHeader	targa_header;
-	byte		*targa_rgba;
-	int length;
+	byte		*targa_rgba = NULL;
+	const char	*name = decode->name;
 
 	*pic = NULL;
 
@@ -60,21 +56,14 @@ void R_LoadTGA ( const char *name, byte **pic, int *width, int *height)
 	if(height)
 		*height = 0;
 
-	//
-	// load the file
-	//
-	length = ri.FS_ReadFile ( ( char * ) name, &buffer.v);
-	if (!buffer.b || length < 0) {
-		return;
-	}
-
 	if(length < 18)
 	{
-		ri.Error( ERR_DROP, "LoadTGA: header too short (%s)", name );
+		R_DecodeError( decode, "LoadTGA: header too short (%s)", name );
+		return;
 	}
 
-	buf_p = buffer.b;
-	end = buffer.b + length;
+	buf_p = buffer;
+	end = buffer + length;
 
 	targa_header.id_length = buf_p[0];
 	targa_header.colormap_type = buf_p[1];
@@ -103,17 +92,20 @@ void R_LoadTGA ( const char *name, byte **pic, int *width, int *height)
 		&& targa_header.image_type!=10
 		&& targa_header.image_type != 3 ) 
 	{
-		ri.Error (ERR_DROP, "LoadTGA: Only type 2 (RGB), 3 (gray), and 10 (RGB) TGA images supported");
+		R_DecodeError( decode, "LoadTGA: Only type 2 (RGB), 3 (gray), and 10 (RGB) TGA images supported" );
+		return;
 	}
 
 	if ( targa_header.colormap_type != 0 )
 	{
-		ri.Error( ERR_DROP, "LoadTGA: colormaps not supported" );
+		R_DecodeError( decode, "LoadTGA: colormaps not supported" );
+		return;
 	}
 
 	if ( ( targa_header.pixel_size != 32 && targa_header.pixel_size != 24 ) && targa_header.image_type != 3 )
 	{
-		ri.Error (ERR_DROP, "LoadTGA: Only 32 or 24 bit images supported (no colormaps)");
+		R_DecodeError( decode, "LoadTGA: Only 32 or 24 bit images supported (no colormaps)" );
+		return;
 	}
 
 	columns = targa_header.width;
@@ -122,16 +114,20 @@ void R_LoadTGA ( const char *name, byte **pic, int *width, int *height)
 
 	if(!columns || !rows || numPixels > 0x7FFFFFFF || numPixels / columns / 4 != rows)
 	{
-		ri.Error (ERR_DROP, "LoadTGA: %s has an invalid image size", name);
+		R_DecodeError( decode, "LoadTGA: %s has an invalid image size", name );
+		return;
 	}
 
 
-	targa_rgba = ri.Malloc (numPixels);
+	targa_rgba = decode->Malloc (numPixels);
 
 	if (targa_header.id_length != 0)
 	{
 		if (buf_p + targa_header.id_length > end)
-			ri.Error( ERR_DROP, "LoadTGA: header too short (%s)", name );
+		{
+			R_DecodeError( decode, "LoadTGA: header too short (%s)", name );
+			goto failed;
+		}
 
 		buf_p += targa_header.id_length;  // skip TARGA image comment
 	}
@@ -140,7 +136,8 @@ void R_LoadTGA ( const char *name, byte **pic, int *width, int *height)
 	{ 
 		if(buf_p + columns*rows*targa_header.pixel_size/8 > end)
 		{
-			ri.Error (ERR_DROP, "LoadTGA: file truncated (%s)", name);
+			R_DecodeError( decode, "LoadTGA: file truncated (%s)", name );
+			goto failed;
 		}
 
 		// Uncompressed RGB or gray scale image
@@ -183,7 +180,7 @@ void R_LoadTGA ( const char *name, byte **pic, int *width, int *height)
 					*pixbuf++ = alphabyte;
 					break;
 				default:
-					ri.Error( ERR_DROP, "LoadTGA: illegal pixel_size '%d' in file '%s'", targa_header.pixel_size, name );
+					goto badPixelSize;
 					break;
 				}
 			}
@@ -196,12 +193,12 @@ void R_LoadTGA ( const char *name, byte **pic, int *width, int *height)
 			pixbuf = targa_rgba + row*columns*4;
 			for(column=0; column<columns; ) {
 				if(buf_p + 1 > end)
-					ri.Error (ERR_DROP, "LoadTGA: file truncated (%s)", name);
+					goto truncated;
 				packetHeader= *buf_p++;
 				packetSize = 1 + (packetHeader & 0x7f);
 				if (packetHeader & 0x80) {        // run-length packet
 					if(buf_p + targa_header.pixel_size/8 > end)
-						ri.Error (ERR_DROP, "LoadTGA: file truncated (%s)", name);
+						goto truncated;
 					switch (targa_header.pixel_size) {
 						case 24:
 								blue = *buf_p++;
@@ -216,7 +213,7 @@ void R_LoadTGA ( const char *name, byte **pic, int *width, int *height)
 								alphabyte = *buf_p++;
 								break;
 						default:
-							ri.Error( ERR_DROP, "LoadTGA: illegal pixel_size '%d' in file '%s'", targa_header.pixel_size, name );
+							goto badPixelSize;
 							break;
 					}
 	
@@ -239,7 +236,7 @@ void R_LoadTGA ( const char *name, byte **pic, int *width, int *height)
 				else {                            // non run-length packet
 
 					if(buf_p + targa_header.pixel_size/8*packetSize > end)
-						ri.Error (ERR_DROP, "LoadTGA: file truncated (%s)", name);
+						goto truncated;
 					for(j=0;j<packetSize;j++) {
 						switch (targa_header.pixel_size) {
 							case 24:
@@ -262,7 +259,7 @@ void R_LoadTGA ( const char *name, byte **pic, int *width, int *height)
 									*pixbuf++ = alphabyte;
 									break;
 							default:
-								ri.Error( ERR_DROP, "LoadTGA: illegal pixel_size '%d' in file '%s'", targa_header.pixel_size, name );
+								goto badPixelSize;
 								break;
 						}
 						column++;
@@ -301,7 +298,7 @@ void R_LoadTGA ( const char *name, byte **pic, int *width, int *height)
 #endif
   // instead we just print a warning
   if (targa_header.attributes & 0x20) {
-    ri.Printf( PRINT_WARNING, "WARNING: '%s' TGA file header declares top-down image, ignoring\n", name);
+    R_DecodeWarning( decode, "WARNING: '%s' TGA file header declares top-down image, ignoring\n", name);
   }
 
   if (width)
@@ -310,6 +307,21 @@ void R_LoadTGA ( const char *name, byte **pic, int *width, int *height)
 	  *height = rows;
 
   *pic = targa_rgba;
+  return;
+
+truncated:
+	R_DecodeError( decode, "LoadTGA: file truncated (%s)", name );
+	goto failed;
+
+badPixelSize:
+	R_DecodeError( decode, "LoadTGA: illegal pixel_size '%d' in file '%s'", targa_header.pixel_size, name );
 
-  ri.FS_FreeFile (buffer.v);
+failed:
+	if ( targa_rgba )
+		decode->Free( targa_rgba );
+}
+
+void R_LoadTGA ( const char *name, byte **pic, int *width, int *height)
+{
+	R_LoadImageWithDecoder( name, R_DecodeTGA, pic, width, height );
 }
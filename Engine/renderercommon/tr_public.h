@@ -24,7 +24,7 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include "tr_types.h"
 
-#define	REF_API_VERSION		8
+#define	REF_API_VERSION		10
 
 //
 // these are the functions exported by the refresh module
@@ -73,6 +73,10 @@ typedef struct {
 	void	(*SetColor)( const float *rgba );	// NULL = 1,1,1,1
 	void	(*DrawStretchPic) ( float x, float y, float w, float h, 
 		float s1, float t1, float s2, float t2, qhandle_t hShader );	// 0 = white
+	// a whole UTF-8 string of glyphs off a 16 by 16 charset sheet in one command,
+	// w by h each and advance apart; maxChars 0 = all of them
+	void	(*DrawString)( float x, float y, float w, float h, float advance,
+		const char *string, int maxChars, int flags, qhandle_t hShader );
 
 	// Draw images for cinematic rendering, pass as 32 bit rgba
 	void	(*DrawStretchRaw) (int x, int y, int w, int h, int cols, int rows, const byte *data, int client, qboolean dirty);
@@ -89,6 +93,10 @@ typedef struct {
 
 	int		(*LerpTag)( orientation_t *tag,  qhandle_t model, int startFrame, int endFrame, 
 					 float frac, const char *tagName );
+	// tag numbers for LerpTags stay good for as long as the model handle does
+	int		(*TagIndex)( qhandle_t model, const char *tagName );
+	int		(*LerpTags)( orientation_t *tags, qhandle_t model, int startFrame, int endFrame, 
+					 float frac, const int *tagIndexes, int numTags );
 	void	(*ModelBounds)( qhandle_t model, vec3_t mins, vec3_t maxs );
 
 #ifdef __USEA3D
@@ -160,6 +168,7 @@ typedef struct {
 	void	(*FS_FreeFileList)( char **filelist );
 	void	(*FS_WriteFile)( const char *qpath, const void *buffer, int size );
 	qboolean (*FS_FileExists)( const char *file );
+	qboolean (*FS_FileStamp)( const char *name, int *stamp, int *size );
 
 	// cinematic stuff
 	void	(*CIN_UploadCinematic)(int handle);
@@ -181,6 +190,19 @@ typedef struct {
 	void	(*Sys_GLimpSafeInit)( void );
 	void	(*Sys_GLimpInit)( void );
 	qboolean (*Sys_LowPhysicalMemory)( void );
+
+	// threads, for work the renderer can do away from the main thread
+	struct sysThread_s *(*Sys_CreateThread)( const char *name, int (*function)( void *data ), void *data );
+	int		(*Sys_WaitThread)( struct sysThread_s *thread );
+	struct sysMutex_s *(*Sys_CreateMutex)( void );
+	void	(*Sys_DestroyMutex)( struct sysMutex_s *mutex );
+	void	(*Sys_LockMutex)( struct sysMutex_s *mutex );
+	void	(*Sys_UnlockMutex)( struct sysMutex_s *mutex );
+	struct sysSemaphore_s *(*Sys_CreateSemaphore)( int value );
+	void	(*Sys_DestroySemaphore)( struct sysSemaphore_s *sem );
+	void	(*Sys_PostSemaphore)( struct sysSemaphore_s *sem );
+	qboolean (*Sys_WaitSemaphore)( struct sysSemaphore_s *sem, int msec );
+	int		(*Sys_ProcessorCount)( void );
 } refimport_t;
 
 
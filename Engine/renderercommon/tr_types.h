@@ -60,6 +60,10 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #define RDF_HYPERSPACE		0x0004		// teleportation effect
 #define RDF_MOTIONBLUR		0x0008		// motion blur (only has an effect when RDF_NOWORLDMODEL is not set)
 
+// DrawString flags
+#define	DS_FORCECOLOR		0x0001		// color escapes leave the color alone
+#define	DS_NOCOLORESCAPE	0x0002		// color escapes are drawn like any other text
+
 
 typedef struct {
 	vec3_t		xyz;
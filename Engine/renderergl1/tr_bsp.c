@@ -1457,6 +1457,9 @@ static	void R_LoadShaders( lump_t *l ) {
 	for ( i=0 ; i<count ; i++ ) {
 		out[i].surfaceFlags = LittleLong( out[i].surfaceFlags );
 		out[i].contentFlags = LittleLong( out[i].contentFlags );
+
+		// start decoding the textures while the rest of the map loads
+		R_PrefetchShaderImages( out[i].shader );
 	}
 }
 
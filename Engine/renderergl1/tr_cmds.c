@@ -233,6 +233,44 @@ void RE_StretchPic ( float x, float y, float w, float h,
 	cmd->t2 = t2;
 }
 
+/*
+=============
+RE_DrawString
+
+The string rides along in the command buffer, so a whole line of text
+costs one command instead of one per glyph.
+=============
+*/
+void RE_DrawString( float x, float y, float w, float h, float advance,
+					const char *string, int maxChars, int flags, qhandle_t hShader ) {
+	drawStringCommand_t	*cmd;
+	int		length;
+
+	if ( !tr.registered || !string || !string[0] ) {
+		return;
+	}
+	length = strlen( string ) + 1;
+	if ( length > MAX_STRING_CHARS ) {
+		length = MAX_STRING_CHARS;
+	}
+	cmd = R_GetCommandBuffer( sizeof( *cmd ) + length );
+	if ( !cmd ) {
+		return;
+	}
+	cmd->commandId = RC_DRAW_STRING;
+	cmd->shader = R_GetShaderByHandle( hShader );
+	cmd->x = x;
+	cmd->y = y;
+	cmd->w = w;
+	cmd->h = h;
+	cmd->advance = advance;
+	cmd->maxChars = maxChars > 0 ? maxChars : length;
+	cmd->flags = flags;
+	// the buffer pads every command, so step over the padding too
+	cmd->length = PAD( sizeof( *cmd ) + length, sizeof( void * ) ) - sizeof( *cmd );
+	Q_strncpyz( (char *)( cmd + 1 ), string, length );
+}
+
 #define MODE_RED_CYAN	1
 #define MODE_RED_BLUE	2
 #define MODE_RED_GREEN	3
@@ -962,6 +962,10 @@ void R_LoadImage( const char *name, byte **pic, int *width, int *height )
 
 	ext = COM_GetExtension( localName );
 
+	// The image workers may already have decoded it
+	if( R_TakePrefetchedImage( name, pic, width, height ) )
+		return;
+
 	if( *ext )
 	{
 		// Look for the correct loader and use it
@@ -1019,6 +1023,39 @@ void R_LoadImage( const char *name, byte **pic, int *width, int *height )
 	}
 }
 
+/*
+=================
+R_ImageLoaderExtension
+
+Lets the image workers resolve names in the same order as R_LoadImage.
+=================
+*/
+const char *R_ImageLoaderExtension( int i )
+{
+	if( i < 0 || i >= numImageLoaders )
+		return NULL;
+
+	return imageLoaders[ i ].ext;
+}
+
+/*
+=================
+R_ImageLoaded
+=================
+*/
+qboolean R_ImageLoaded( const char *name )
+{
+	image_t	*image;
+
+	for( image = hashTable[ generateHashValue( name ) ]; image; image = image->next )
+	{
+		if( !strcmp( name, image->imgName ) )
+			return qtrue;
+	}
+
+	return qfalse;
+}
+
 
 /*
 ===============
@@ -1549,6 +1586,7 @@ RE_RegisterSkin
 */
 qhandle_t RE_RegisterSkin( const char *name ) {
 	skinSurface_t parseSurfaces[MAX_SKIN_SURFACES];
+	char		shaderNames[MAX_SKIN_SURFACES][MAX_QPATH];
 	qhandle_t	hSkin;
 	skin_t		*skin;
 	skinSurface_t	*surf;
@@ -1560,6 +1598,7 @@ qhandle_t RE_RegisterSkin( const char *name ) {
 	char		*token;
 	char		surfName[MAX_QPATH];
 	int			totalSurfaces;
+	int			i;
 
 	if ( !name || !name[0] ) {
 		ri.Printf( PRINT_DEVELOPER, "Empty name passed to RE_RegisterSkin\n" );
@@ -1637,7 +1676,7 @@ qhandle_t RE_RegisterSkin( const char *name ) {
 		if ( skin->numSurfaces < MAX_SKIN_SURFACES ) {
 			surf = &parseSurfaces[skin->numSurfaces];
 			Q_strncpyz( surf->name, surfName, sizeof( surf->name ) );
-			surf->shader = R_FindShader( token, LIGHTMAP_NONE, qtrue );
+			Q_strncpyz( shaderNames[skin->numSurfaces], token, MAX_QPATH );
 			skin->numSurfaces++;
 		}
 
@@ -1646,6 +1685,14 @@ qhandle_t RE_RegisterSkin( const char *name ) {
 
 	ri.FS_FreeFile( text.v );
 
+	// let the image workers start on every surface before any of them is needed
+	for ( i = 0; i < skin->numSurfaces; i++ ) {
+		R_PrefetchShaderImages( shaderNames[i] );
+	}
+	for ( i = 0; i < skin->numSurfaces; i++ ) {
+		parseSurfaces[i].shader = R_FindShader( shaderNames[i], LIGHTMAP_NONE, qtrue );
+	}
+
 	if ( totalSurfaces > MAX_SKIN_SURFACES ) {
 		ri.Printf( PRINT_WARNING, "WARNING: Ignoring excess surfaces (found %d, max is %d) in skin '%s'!\n",
 					totalSurfaces, MAX_SKIN_SURFACES, name );
@@ -1269,6 +1269,8 @@ void R_Init( void ) {
 
 	R_InitImages();
 
+	R_InitImageJobs();
+
 	R_InitShaders();
 
 	R_InitSkins();
@@ -1312,6 +1314,8 @@ void RE_Shutdown( qboolean destroyWindow ) {
 		R_DeleteTextures();
 	}
 
+	R_ShutdownImageJobs();
+
 	R_DoneFreeType();
 
 	// shut down platform specific OpenGL stuff
@@ -1334,6 +1338,7 @@ Touch all images to make sure they are resident
 =============
 */
 void RE_EndRegistration( void ) {
+	R_FlushImageJobs();
 	R_IssuePendingRenderCommands();
 	if (!ri.Sys_LowPhysicalMemory()) {
 		RB_ShowImages();
@@ -1383,6 +1388,8 @@ refexport_t *GetRefAPI ( int apiVersion, refimport_t *rimp ) {
 
 	re.MarkFragments = R_MarkFragments;
 	re.LerpTag = R_LerpTag;
+	re.TagIndex = R_TagIndex;
+	re.LerpTags = R_LerpTags;
 	re.ModelBounds = R_ModelBounds;
 
 	re.ClearScene = RE_ClearScene;
@@ -1395,6 +1402,7 @@ refexport_t *GetRefAPI ( int apiVersion, refimport_t *rimp ) {
 
 	re.SetColor = RE_SetColor;
 	re.DrawStretchPic = RE_StretchPic;
+	re.DrawString = RE_DrawString;
 	re.DrawStretchRaw = RE_StretchRaw;
 	re.UploadCinematic = RE_UploadCinematic;
 
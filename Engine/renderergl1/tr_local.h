@@ -846,6 +846,9 @@ void		R_ModelInit (void);
 model_t		*R_GetModelByHandle( qhandle_t hModel );
 int			R_LerpTag( orientation_t *tag, qhandle_t handle, int startFrame, int endFrame, 
 					 float frac, const char *tagName );
+int			R_TagIndex( qhandle_t handle, const char *tagName );
+int			R_LerpTags( orientation_t *tags, qhandle_t handle, int startFrame, int endFrame, 
+					 float frac, const int *tagIndexes, int numTags );
 void		R_ModelBounds( qhandle_t handle, vec3_t mins, vec3_t maxs );
 
 void		R_Modellist_f (void);
@@ -1815,6 +1818,10 @@ void RB_IQMSurfaceAnim( surfaceType_t *surface );
 int R_IQMLerpTag( orientation_t *tag, iqmData_t *data,
                   int startFrame, int endFrame,
                   float frac, const char *tagName );
+int R_IQMTagIndex( iqmData_t *data, const char *tagName );
+int R_IQMLerpTags( orientation_t *tags, iqmData_t *data,
+                   int startFrame, int endFrame,
+                   float frac, const int *tagIndexes, int numTags );
 
 /*
 =============================================================
@@ -1918,6 +1925,17 @@ typedef struct {
 	float	s2, t2;
 } stretchPicCommand_t;
 
+typedef struct {
+	int		commandId;
+	shader_t	*shader;
+	float	x, y;
+	float	w, h;
+	float	advance;
+	int		maxChars;
+	int		flags;
+	int		length;		// bytes to the next command, the string and its padding
+} drawStringCommand_t;
+
 typedef struct {
 	int		commandId;
 	trRefdef_t	refdef;
@@ -1967,7 +1985,8 @@ typedef enum {
 	RC_SCREENSHOT,
 	RC_VIDEOFRAME,
 	RC_COLORMASK,
-	RC_CLEARDEPTH
+	RC_CLEARDEPTH,
+	RC_DRAW_STRING
 } renderCommand_t;
 
 
@@ -2012,6 +2031,8 @@ void R_AddDrawSurfCmd( drawSurf_t *drawSurfs, int numDrawSurfs );
 void RE_SetColor( const float *rgba );
 void RE_StretchPic ( float x, float y, float w, float h, 
 					  float s1, float t1, float s2, float t2, qhandle_t hShader );
+void RE_DrawString( float x, float y, float w, float h, float advance,
+					const char *string, int maxChars, int flags, qhandle_t hShader );
 void RE_BeginFrame( stereoFrame_t stereoFrame );
 void RE_EndFrame( int *frontEndMsec, int *backEndMsec );
 void RE_SaveJPG(char * filename, int quality, int image_width, int image_height,
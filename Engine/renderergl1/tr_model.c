@@ -944,68 +944,180 @@ void R_Modellist_f( void ) {
 
 /*
 ================
-R_GetTag
+R_GetTagIndex
 ================
 */
-static md3Tag_t *R_GetTag( md3Header_t *mod, int frame, const char *tagName ) {
+static int R_GetTagIndex( md3Header_t *mod, const char *tagName ) {
 	md3Tag_t		*tag;
 	int				i;
 
+	tag = (md3Tag_t *)((byte *)mod + mod->ofsTags);
+	for ( i = 0 ; i < mod->numTags ; i++, tag++ ) {
+		if ( !strcmp( tag->name, tagName ) ) {
+			return i;	// found it
+		}
+	}
+
+	return -1;
+}
+
+static md3Tag_t *R_GetTagByIndex( md3Header_t *mod, int frame, int index ) {
+	if ( index < 0 || index >= mod->numTags ) {
+		return NULL;
+	}
+
 	if ( frame >= mod->numFrames ) {
 		// it is possible to have a bad frame while changing models, so don't error
 		frame = mod->numFrames - 1;
 	}
 
-	tag = (md3Tag_t *)((byte *)mod + mod->ofsTags) + frame * mod->numTags;
-	for ( i = 0 ; i < mod->numTags ; i++, tag++ ) {
-		if ( !strcmp( tag->name, tagName ) ) {
-			return tag;	// found it
+	return (md3Tag_t *)((byte *)mod + mod->ofsTags) + frame * mod->numTags + index;
+}
+
+static int R_GetAnimTagIndex( mdrHeader_t *mod, const char *tagName )
+{
+	int				i;
+	mdrTag_t		*tag;
+
+	tag = (mdrTag_t *)((byte *)mod + mod->ofsTags);
+	for ( i = 0 ; i < mod->numTags ; i++, tag++ )
+	{
+		if ( !strcmp( tag->name, tagName ) )
+		{
+			return i;
 		}
 	}
 
-	return NULL;
+	return -1;
 }
 
-md3Tag_t *R_GetAnimTag( mdrHeader_t *mod, int framenum, const char *tagName, md3Tag_t * dest) 
+static md3Tag_t *R_GetAnimTagByIndex( mdrHeader_t *mod, int framenum, int index, md3Tag_t * dest) 
 {
-	int				i, j, k;
+	int				j, k;
 	int				frameSize;
 	mdrFrame_t		*frame;
 	mdrTag_t		*tag;
 
+	if ( index < 0 || index >= mod->numTags ) {
+		return NULL;
+	}
+
 	if ( framenum >= mod->numFrames ) 
 	{
 		// it is possible to have a bad frame while changing models, so don't error
 		framenum = mod->numFrames - 1;
 	}
 
-	tag = (mdrTag_t *)((byte *)mod + mod->ofsTags);
-	for ( i = 0 ; i < mod->numTags ; i++, tag++ )
+	tag = (mdrTag_t *)((byte *)mod + mod->ofsTags) + index;
+	Q_strncpyz(dest->name, tag->name, sizeof(dest->name));
+
+	// uncompressed model...
+	//
+	frameSize = (intptr_t)( &((mdrFrame_t *)0)->bones[ mod->numBones ] );
+	frame = (mdrFrame_t *)((byte *)mod + mod->ofsFrames + framenum * frameSize );
+
+	for (j = 0; j < 3; j++)
 	{
-		if ( !strcmp( tag->name, tagName ) )
-		{
-			Q_strncpyz(dest->name, tag->name, sizeof(dest->name));
+		for (k = 0; k < 3; k++)
+			dest->axis[j][k]=frame->bones[tag->boneIndex].matrix[k][j];
+	}
 
-			// uncompressed model...
-			//
-			frameSize = (intptr_t)( &((mdrFrame_t *)0)->bones[ mod->numBones ] );
-			frame = (mdrFrame_t *)((byte *)mod + mod->ofsFrames + framenum * frameSize );
+	dest->origin[0]=frame->bones[tag->boneIndex].matrix[0][3];
+	dest->origin[1]=frame->bones[tag->boneIndex].matrix[1][3];
+	dest->origin[2]=frame->bones[tag->boneIndex].matrix[2][3];				
 
-			for (j = 0; j < 3; j++)
-			{
-				for (k = 0; k < 3; k++)
-					dest->axis[j][k]=frame->bones[tag->boneIndex].matrix[k][j];
-			}
+	return dest;
+}
+
+static void R_LerpTagOrientation( orientation_t *tag, const md3Tag_t *start, const md3Tag_t *end, float frac ) {
+	int		i;
+	float		frontLerp, backLerp;
+
+	frontLerp = frac;
+	backLerp = 1.0f - frac;
+
+	for ( i = 0 ; i < 3 ; i++ ) {
+		tag->origin[i] = start->origin[i] * backLerp +  end->origin[i] * frontLerp;
+		tag->axis[0][i] = start->axis[0][i] * backLerp +  end->axis[0][i] * frontLerp;
+		tag->axis[1][i] = start->axis[1][i] * backLerp +  end->axis[1][i] * frontLerp;
+		tag->axis[2][i] = start->axis[2][i] * backLerp +  end->axis[2][i] * frontLerp;
+	}
+	VectorNormalize( tag->axis[0] );
+	VectorNormalize( tag->axis[1] );
+	VectorNormalize( tag->axis[2] );
+}
+
+/*
+================
+R_TagIndex
+
+Returns the number the model knows the named tag by, for R_LerpTags,
+or -1 if it has no such tag.  The number stays good for as long as
+the model handle does.
+================
+*/
+int R_TagIndex( qhandle_t handle, const char *tagName ) {
+	model_t		*model;
+
+	model = R_GetModelByHandle( handle );
+	if ( model->md3[0] ) {
+		return R_GetTagIndex( model->md3[0], tagName );
+	}
+	if ( model->type == MOD_MDR ) {
+		return R_GetAnimTagIndex( (mdrHeader_t *)model->modelData, tagName );
+	}
+	if ( model->type == MOD_IQM ) {
+		return R_IQMTagIndex( model->modelData, tagName );
+	}
+	return -1;
+}
+
+/*
+================
+R_LerpTags
+
+Lerps any number of tags, given by R_TagIndex numbers, between the same
+two frames.  Tags the model doesn't have are cleared.  Returns the number
+of tags found.
+================
+*/
+int R_LerpTags( orientation_t *tags, qhandle_t handle, int startFrame, int endFrame, 
+					 float frac, const int *tagIndexes, int numTags ) {
+	md3Tag_t	*start, *end;
+	md3Tag_t	start_space, end_space;
+	model_t		*model;
+	int		i, found;
 
-			dest->origin[0]=frame->bones[tag->boneIndex].matrix[0][3];
-			dest->origin[1]=frame->bones[tag->boneIndex].matrix[1][3];
-			dest->origin[2]=frame->bones[tag->boneIndex].matrix[2][3];				
+	model = R_GetModelByHandle( handle );
+	if ( !model->md3[0] && model->type == MOD_IQM ) {
+		return R_IQMLerpTags( tags, model->modelData,
+				startFrame, endFrame,
+				frac, tagIndexes, numTags );
+	}
 
-			return dest;
+	found = 0;
+	for ( i = 0 ; i < numTags ; i++ ) {
+		if ( model->md3[0] ) {
+			start = R_GetTagByIndex( model->md3[0], startFrame, tagIndexes[i] );
+			end = R_GetTagByIndex( model->md3[0], endFrame, tagIndexes[i] );
+		} else if ( model->type == MOD_MDR ) {
+			start = R_GetAnimTagByIndex( (mdrHeader_t *)model->modelData, startFrame, tagIndexes[i], &start_space );
+			end = R_GetAnimTagByIndex( (mdrHeader_t *)model->modelData, endFrame, tagIndexes[i], &end_space );
+		} else {
+			start = end = NULL;
 		}
+
+		if ( !start || !end ) {
+			AxisClear( tags[i].axis );
+			VectorClear( tags[i].origin );
+			continue;
+		}
+
+		R_LerpTagOrientation( &tags[i], start, end, frac );
+		found++;
 	}
 
-	return NULL;
+	return found;
 }
 
 /*
@@ -1017,8 +1129,6 @@ int R_LerpTag( orientation_t *tag, qhandle_t handle, int startFrame, int endFram
 					 float frac, const char *tagName ) {
 	md3Tag_t	*start, *end;
 	md3Tag_t	start_space, end_space;
-	int		i;
-	float		frontLerp, backLerp;
 	model_t		*model;
 
 	model = R_GetModelByHandle( handle );
@@ -1026,8 +1136,10 @@ int R_LerpTag( orientation_t *tag, qhandle_t handle, int startFrame, int endFram
 	{
 		if(model->type == MOD_MDR)
 		{
-			start = R_GetAnimTag((mdrHeader_t *) model->modelData, startFrame, tagName, &start_space);
-			end = R_GetAnimTag((mdrHeader_t *) model->modelData, endFrame, tagName, &end_space);
+			mdrHeader_t *mdr = (mdrHeader_t *) model->modelData;
+
+			start = R_GetAnimTagByIndex(mdr, startFrame, R_GetAnimTagIndex(mdr, tagName), &start_space);
+			end = R_GetAnimTagByIndex(mdr, endFrame, R_GetAnimTagIndex(mdr, tagName), &end_space);
 		}
 		else if( model->type == MOD_IQM ) {
 			return R_IQMLerpTag( tag, model->modelData,
@@ -1039,8 +1151,10 @@ int R_LerpTag( orientation_t *tag, qhandle_t handle, int startFrame, int endFram
 	}
 	else
 	{
-		start = R_GetTag( model->md3[0], startFrame, tagName );
-		end = R_GetTag( model->md3[0], endFrame, tagName );
+		int index = R_GetTagIndex( model->md3[0], tagName );
+
+		start = R_GetTagByIndex( model->md3[0], startFrame, index );
+		end = R_GetTagByIndex( model->md3[0], endFrame, index );
 	}
 
 	if ( !start || !end ) {
@@ -1049,18 +1163,7 @@ int R_LerpTag( orientation_t *tag, qhandle_t handle, int startFrame, int endFram
 		return qfalse;
 	}
 
-	frontLerp = frac;
-	backLerp = 1.0f - frac;
-
-	for ( i = 0 ; i < 3 ; i++ ) {
-		tag->origin[i] = start->origin[i] * backLerp +  end->origin[i] * frontLerp;
-		tag->axis[0][i] = start->axis[0][i] * backLerp +  end->axis[0][i] * frontLerp;
-		tag->axis[1][i] = start->axis[1][i] * backLerp +  end->axis[1][i] * frontLerp;
-		tag->axis[2][i] = start->axis[2][i] * backLerp +  end->axis[2][i] * frontLerp;
-	}
-	VectorNormalize( tag->axis[0] );
-	VectorNormalize( tag->axis[1] );
-	VectorNormalize( tag->axis[2] );
+	R_LerpTagOrientation( tag, start, end, frac );
 	return qtrue;
 }
 
@@ -1147,39 +1147,78 @@ void RB_IQMSurfaceAnim( surfaceType_t *surface ) {
 	tess.numVertexes += surf->num_vertexes;
 }
 
-int R_IQMLerpTag( orientation_t *tag, iqmData_t *data,
-		  int startFrame, int endFrame, 
-		  float frac, const char *tagName ) {
-	float	jointMats[IQM_MAX_JOINTS * 12];
+/*
+=================
+R_IQMTagIndex
+
+Joint number of the named tag, or -1.
+=================
+*/
+int R_IQMTagIndex( iqmData_t *data, const char *tagName ) {
 	int	joint;
 	char	*names = data->names;
 
 	// get joint number by reading the joint names
 	for( joint = 0; joint < data->num_joints; joint++ ) {
 		if( !strcmp( tagName, names ) )
-			break;
+			return joint;
 		names += strlen( names ) + 1;
 	}
-	if( joint >= data->num_joints ) {
-		AxisClear( tag->axis );
-		VectorClear( tag->origin );
-		return qfalse;
-	}
+	return -1;
+}
+
+int R_IQMLerpTag( orientation_t *tag, iqmData_t *data,
+		  int startFrame, int endFrame, 
+		  float frac, const char *tagName ) {
+	int	joint;
 
-	ComputeJointMats( data, startFrame, endFrame, frac, jointMats );
-
-	tag->axis[0][0] = jointMats[12 * joint + 0];
-	tag->axis[1][0] = jointMats[12 * joint + 1];
-	tag->axis[2][0] = jointMats[12 * joint + 2];
-	tag->origin[0] = jointMats[12 * joint + 3];
-	tag->axis[0][1] = jointMats[12 * joint + 4];
-	tag->axis[1][1] = jointMats[12 * joint + 5];
-	tag->axis[2][1] = jointMats[12 * joint + 6];
-	tag->origin[1] = jointMats[12 * joint + 7];
-	tag->axis[0][2] = jointMats[12 * joint + 8];
-	tag->axis[1][2] = jointMats[12 * joint + 9];
-	tag->axis[2][2] = jointMats[12 * joint + 10];
-	tag->origin[2] = jointMats[12 * joint + 11];
+	joint = R_IQMTagIndex( data, tagName );
+	return R_IQMLerpTags( tag, data, startFrame, endFrame, frac, &joint, 1 );
+}
 
-	return qtrue;
+/*
+=================
+R_IQMLerpTags
+
+All the tags come off the one set of joint matrices, which is
+computed once.
+=================
+*/
+int R_IQMLerpTags( orientation_t *tags, iqmData_t *data,
+		  int startFrame, int endFrame, 
+		  float frac, const int *tagIndexes, int numTags ) {
+	float	jointMats[IQM_MAX_JOINTS * 12];
+	qboolean	computed;
+	int	i, joint, found;
+
+	computed = qfalse;
+	found = 0;
+	for ( i = 0; i < numTags; i++ ) {
+		joint = tagIndexes[i];
+		if ( joint < 0 || joint >= data->num_joints ) {
+			AxisClear( tags[i].axis );
+			VectorClear( tags[i].origin );
+			continue;
+		}
+		if ( !computed ) {
+			ComputeJointMats( data, startFrame, endFrame, frac, jointMats );
+			computed = qtrue;
+		}
+
+		tags[i].axis[0][0] = jointMats[12 * joint + 0];
+		tags[i].axis[1][0] = jointMats[12 * joint + 1];
+		tags[i].axis[2][0] = jointMats[12 * joint + 2];
+		tags[i].origin[0] = jointMats[12 * joint + 3];
+		tags[i].axis[0][1] = jointMats[12 * joint + 4];
+		tags[i].axis[1][1] = jointMats[12 * joint + 5];
+		tags[i].axis[2][1] = jointMats[12 * joint + 6];
+		tags[i].origin[1] = jointMats[12 * joint + 7];
+		tags[i].axis[0][2] = jointMats[12 * joint + 8];
+		tags[i].axis[1][2] = jointMats[12 * joint + 9];
+		tags[i].axis[2][2] = jointMats[12 * joint + 10];
+		tags[i].origin[2] = jointMats[12 * joint + 11];
+		found++;
+	}
+
+	return found;
 }
@@ -3286,6 +3286,12 @@ static void FixRenderCommandList( int newShader ) {
 				curCmd = (const void *)(sp_cmd + 1);
 				break;
 				}
+			case RC_DRAW_STRING:
+				{
+				const drawStringCommand_t *st_cmd = (const drawStringCommand_t *)curCmd;
+				curCmd = (const void *)((const char *)(st_cmd + 1) + st_cmd->length);
+				break;
+				}
 			case RC_DRAW_SURFS:
 				{
 				int i;
@@ -3817,6 +3823,77 @@ shader_t *R_FindShaderByName( const char *name ) {
 	return tr.defaultShader;
 }
 
+/*
+====================
+R_PrefetchShaderImages
+
+Hands the images a shader is going to load to the image workers, so
+they decode while registration gets on with everything else.
+====================
+*/
+static qboolean PrefetchKeyword( const char *token, const char *keyword ) {
+	int		len = strlen( keyword );
+
+	if ( Q_stricmpn( token, keyword, len ) ) {
+		return qfalse;
+	}
+
+	// map2, animMap3 and so on
+	return !token[len] || ( token[len] >= '0' && token[len] <= '9' && !token[len+1] );
+}
+
+void R_PrefetchShaderImages( const char *shaderName ) {
+	char		strippedName[MAX_QPATH];
+	char		*p, *token;
+	int			depth;
+
+	if ( !R_ImageJobsActive() || !shaderName || !shaderName[0] ) {
+		return;
+	}
+
+	COM_StripExtension( shaderName, strippedName, sizeof( strippedName ) );
+	if ( R_FindShaderByName( strippedName ) != tr.defaultShader ) {
+		return;
+	}
+
+	p = FindShaderInShaderText( strippedName );
+	if ( !p ) {
+		// no shader text, so R_FindShader will look for an image
+		R_PrefetchImage( shaderName );
+		return;
+	}
+
+	depth = 0;
+	while ( 1 ) {
+		token = COM_ParseExt( &p, qtrue );
+		if ( !token[0] ) {
+			break;
+		}
+
+		if ( token[0] == '{' ) {
+			depth++;
+		} else if ( token[0] == '}' ) {
+			if ( --depth <= 0 ) {
+				break;
+			}
+		} else if ( PrefetchKeyword( token, "map" ) || PrefetchKeyword( token, "clampmap" ) ) {
+			token = COM_ParseExt( &p, qfalse );
+			if ( token[0] && token[0] != '$' && token[0] != '*' ) {
+				R_PrefetchImage( token );
+			}
+		} else if ( PrefetchKeyword( token, "animMap" ) || PrefetchKeyword( token, "clampAnimMap" ) ) {
+			COM_ParseExt( &p, qfalse );		// frequency
+			while ( 1 ) {
+				token = COM_ParseExt( &p, qfalse );
+				if ( !token[0] ) {
+					break;
+				}
+				R_PrefetchImage( token );
+			}
+		}
+	}
+}
+
 
 /*
 ===============
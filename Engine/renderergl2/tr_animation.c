@@ -190,6 +190,8 @@ void R_MDRAddAnimSurfaces( trRefEntity_t *ent ) {
 	int				cull;
 	int             cubemapIndex;
 	qboolean	personalModel;
+	mdrFrame_t	*oldFrame, *newFrame;
+	int			frameSize;
 
 	header = (mdrHeader_t *) tr.currentModel->modelData;
 	
@@ -228,6 +230,13 @@ void R_MDRAddAnimSurfaces( trRefEntity_t *ent ) {
 		return;
 	}	
 
+	frameSize = (size_t)( &((mdrFrame_t *)0)->bones[ header->numBones ] );
+	newFrame = ( mdrFrame_t * ) ( ( byte * ) header + header->ofsFrames + frameSize * ent->e.frame );
+	oldFrame = ( mdrFrame_t * ) ( ( byte * ) header + header->ofsFrames + frameSize * ent->e.oldframe );
+	if ( R_OccludedModel( ent, oldFrame->bounds, newFrame->bounds ) ) {
+		return;
+	}
+
 	// figure out the current LOD of the model we're rendering, and set the lod pointer respectively.
 	lodnum = R_ComputeLOD(ent);
 	// check whether this model has as that many LODs at all. If not, try the closest thing we got.
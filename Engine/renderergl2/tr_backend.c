@@ -872,6 +872,108 @@ const void *RB_StretchPic ( const void *data ) {
 	return (const void *)(cmd + 1);
 }
 
+/*
+=============
+RB_DrawString
+
+Every glyph of the string goes into the current 2D batch as one quad,
+tinted by its own vertex colors, so color escapes don't end the batch.
+=============
+*/
+const void *RB_DrawString( const void *data ) {
+	const drawStringCommand_t	*cmd;
+	const char	*s;
+	shader_t	*shader;
+	byte		color[4];
+	uint16_t	color16[4];
+	float		x, s1, t1;
+	int			glyph, count;
+	int			numVerts, numIndexes;
+
+	cmd = (const drawStringCommand_t *)data;
+
+	// FIXME: HUGE hack
+	if (glRefConfig.framebufferObject)
+		FBO_Bind(backEnd.framePostProcessed ? NULL : tr.renderFbo);
+
+	RB_SetGL2D();
+
+	shader = cmd->shader;
+	if ( shader != tess.shader ) {
+		if ( tess.numIndexes ) {
+			RB_EndSurface();
+		}
+		backEnd.currentEntity = &backEnd.entity2D;
+		RB_BeginSurface( shader, 0, 0 );
+	}
+
+	s = (const char *)( cmd + 1 );
+	x = cmd->x;
+	VectorCopy4( backEnd.color2D, color );
+	for ( count = 0 ; count < cmd->maxChars ; count++, x += cmd->advance ) {
+		glyph = R_NextStringGlyph( &s, cmd->flags, backEnd.color2D, color );
+		if ( glyph < 0 ) {
+			break;
+		}
+		if ( glyph == ' ' ) {
+			continue;
+		}
+
+		RB_CHECKOVERFLOW( 4, 6 );
+		numVerts = tess.numVertexes;
+		numIndexes = tess.numIndexes;
+
+		tess.numVertexes += 4;
+		tess.numIndexes += 6;
+
+		tess.indexes[ numIndexes ] = numVerts + 3;
+		tess.indexes[ numIndexes + 1 ] = numVerts + 0;
+		tess.indexes[ numIndexes + 2 ] = numVerts + 2;
+		tess.indexes[ numIndexes + 3 ] = numVerts + 2;
+		tess.indexes[ numIndexes + 4 ] = numVerts + 0;
+		tess.indexes[ numIndexes + 5 ] = numVerts + 1;
+
+		VectorScale4( color, 257, color16 );
+		VectorCopy4( color16, tess.color[ numVerts ] );
+		VectorCopy4( color16, tess.color[ numVerts + 1 ] );
+		VectorCopy4( color16, tess.color[ numVerts + 2 ] );
+		VectorCopy4( color16, tess.color[ numVerts + 3 ] );
+
+		s1 = ( glyph & 15 ) * 0.0625f;
+		t1 = ( glyph >> 4 ) * 0.0625f;
+
+		tess.xyz[ numVerts ][0] = x;
+		tess.xyz[ numVerts ][1] = cmd->y;
+		tess.xyz[ numVerts ][2] = 0;
+
+		tess.texCoords[ numVerts ][0] = s1;
+		tess.texCoords[ numVerts ][1] = t1;
+
+		tess.xyz[ numVerts + 1 ][0] = x + cmd->w;
+		tess.xyz[ numVerts + 1 ][1] = cmd->y;
+		tess.xyz[ numVerts + 1 ][2] = 0;
+
+		tess.texCoords[ numVerts + 1 ][0] = s1 + 0.0625f;
+		tess.texCoords[ numVerts + 1 ][1] = t1;
+
+		tess.xyz[ numVerts + 2 ][0] = x + cmd->w;
+		tess.xyz[ numVerts + 2 ][1] = cmd->y + cmd->h;
+		tess.xyz[ numVerts + 2 ][2] = 0;
+
+		tess.texCoords[ numVerts + 2 ][0] = s1 + 0.0625f;
+		tess.texCoords[ numVerts + 2 ][1] = t1 + 0.0625f;
+
+		tess.xyz[ numVerts + 3 ][0] = x;
+		tess.xyz[ numVerts + 3 ][1] = cmd->y + cmd->h;
+		tess.xyz[ numVerts + 3 ][2] = 0;
+
+		tess.texCoords[ numVerts + 3 ][0] = s1;
+		tess.texCoords[ numVerts + 3 ][1] = t1 + 0.0625f;
+	}
+
+	return (const void *)( (const char *)( cmd + 1 ) + cmd->length );
+}
+
 
 /*
 =============
@@ -1755,6 +1857,9 @@ void RB_ExecuteRenderCommands( const void *data ) {
 		case RC_STRETCH_PIC:
 			data = RB_StretchPic( data );
 			break;
+		case RC_DRAW_STRING:
+			data = RB_DrawString( data );
+			break;
 		case RC_DRAW_SURFS:
 			data = RB_DrawSurfs( data );
 			break;
@@ -1680,6 +1680,413 @@ void R_MovePatchSurfacesToHunk(void) {
 }
 
 
+/*
+===============================================================================
+
+Surface cache
+
+Everything R_LoadSurfaces builds from the map -- the converted vertexes,
+triangles with the degenerate ones dropped, tangent spaces, tessellated
+and stitched patches, and cull information -- is saved once it has been
+built and loaded back the next time the map is loaded.  It is keyed by a
+checksum of the lumps it is built from and of the settings that change it
+(overbright bits, hdr vertex colors, lightmap packing, patch subdivisions,
+and the sizes of the structures saved).
+
+Shaders and fog volumes are not cached, they are looked up from the map
+as before.
+
+===============================================================================
+*/
+
+#define	SURFCACHE_IDENT			(('C'<<24)+('F'<<16)+('R'<<8)+'S')
+#define	SURFCACHE_VERSION		1
+
+#define	SURFCACHE_DEFAULTSHADER	1		// face had too many points
+
+typedef struct {
+	int			ident;
+	int			version;
+	unsigned	checksum;		// of the surface, vertex, index and shader lumps
+	unsigned	settings;		// of everything else the surfaces depend on
+	int			numSurfaces;
+	// followed by a surfCacheRecord_t for every surface, each followed by
+	// its vertexes, indexes, and for grids the lod errors
+} surfCacheHeader_t;
+
+typedef struct {
+	int				flags;
+	cullinfo_t		cullinfo;
+	srfBspSurface_t	surface;	// pointers are not saved
+} surfCacheRecord_t;
+
+/*
+===============
+R_SurfaceCacheName
+===============
+*/
+static void R_SurfaceCacheName( char filename[MAX_QPATH] ) {
+	char	name[MAX_QPATH];
+
+	COM_StripExtension( s_worldData.name, name, sizeof( name ) );
+	Com_sprintf( filename, MAX_QPATH, "cache/%s.dat", name );
+}
+
+/*
+===============
+R_SurfaceCacheSettings
+===============
+*/
+static unsigned R_SurfaceCacheSettings( const float *hdrVertColors, int hdrVertColorsSize ) {
+	int			settings[11];
+	unsigned	checksum;
+
+	settings[0] = r_mapOverBrightBits->integer;
+	settings[1] = tr.overbrightBits;
+	settings[2] = r_hdr->integer;
+	settings[3] = tr.worldDeluxeMapping;
+	settings[4] = tr.fatLightmapCols;
+	settings[5] = tr.fatLightmapRows;
+	settings[6] = (int)( r_subdivisions->value * 1000.0f );
+	settings[7] = sizeof( srfVert_t );
+	settings[8] = sizeof( glIndex_t );
+	settings[9] = sizeof( surfCacheRecord_t );
+#ifdef PATCH_STITCHING
+	settings[10] = 1;
+#else
+	settings[10] = 0;
+#endif
+
+	checksum = R_BlockChecksum( 2166136261u, settings, sizeof( settings ) );
+	if ( hdrVertColors ) {
+		checksum = R_BlockChecksum( checksum, hdrVertColors, hdrVertColorsSize );
+	}
+	return checksum;
+}
+
+/*
+===============
+R_SurfaceCacheChecksum
+===============
+*/
+static unsigned R_SurfaceCacheChecksum( lump_t *surfs, lump_t *verts, lump_t *indexLump ) {
+	unsigned	checksum;
+
+	checksum = R_BlockChecksum( 2166136261u, fileBase + surfs->fileofs, surfs->filelen );
+	checksum = R_BlockChecksum( checksum, fileBase + verts->fileofs, verts->filelen );
+	checksum = R_BlockChecksum( checksum, fileBase + indexLump->fileofs, indexLump->filelen );
+	// patches with nodraw shaders are skipped
+	checksum = R_BlockChecksum( checksum, s_worldData.shaders, s_worldData.numShaders * sizeof( dshader_t ) );
+	return checksum;
+}
+
+/*
+===============
+R_SurfaceCacheDataSize
+
+Size of what follows a record
+===============
+*/
+static int R_SurfaceCacheDataSize( const srfBspSurface_t *surface ) {
+	int		size;
+
+	switch ( surface->surfaceType ) {
+	case SF_GRID:
+		size = ( surface->width + surface->height ) * sizeof( float );
+		break;
+	case SF_FACE:
+	case SF_TRIANGLES:
+		size = 0;
+		break;
+	default:
+		return 0;
+	}
+	return size + surface->numVerts * sizeof( srfVert_t ) + surface->numIndexes * sizeof( glIndex_t );
+}
+
+/*
+===============
+R_CheckCachedSurface
+
+The checks ParseFace, ParseTriSurf and R_CreateSurfaceGridMesh would have
+made on the data following a record, which may not have been written by us.
+===============
+*/
+static qboolean R_CheckCachedSurface( const srfBspSurface_t *surface, const byte *data ) {
+	glIndex_t	index;
+	int			i;
+
+	switch ( surface->surfaceType ) {
+	case SF_GRID:
+		if ( surface->width * surface->height != surface->numVerts ) {
+			return qfalse;
+		}
+		break;
+	case SF_FACE:
+	case SF_TRIANGLES:
+		break;
+	default:
+		return qtrue;
+	}
+
+	if ( surface->numIndexes % 3 ) {
+		return qfalse;
+	}
+
+	data += surface->numVerts * sizeof( srfVert_t );
+	for ( i = 0 ; i < surface->numIndexes ; i++, data += sizeof( index ) ) {
+		Com_Memcpy( &index, data, sizeof( index ) );
+		if ( index >= (glIndex_t)surface->numVerts ) {
+			return qfalse;
+		}
+	}
+
+	return qtrue;
+}
+
+/*
+===============
+R_LoadSurfaceCache
+
+Returns the cache if it was built from the same map and settings, with
+every record checked against the map's surfaces and every index against
+its vertexes.  Anything that doesn't add up throws the cache away, so the
+surfaces are built from the BSP again.
+===============
+*/
+static void *R_LoadSurfaceCache( unsigned checksum, unsigned settings, dsurface_t *in, int count ) {
+	char				filename[MAX_QPATH];
+	surfCacheHeader_t	header;
+	surfCacheRecord_t	record;
+	void				*buffer;
+	byte				*p;
+	int					length, remaining, size;
+	int					i;
+	surfaceType_t		expected;
+
+	R_SurfaceCacheName( filename );
+	length = ri.FS_ReadFile( filename, &buffer );
+	if ( !buffer ) {
+		return NULL;
+	}
+
+	if ( length < (int)sizeof( header ) ) {
+		ri.FS_FreeFile( buffer );
+		return NULL;
+	}
+	Com_Memcpy( &header, buffer, sizeof( header ) );
+	if ( header.ident != SURFCACHE_IDENT
+		|| header.version != SURFCACHE_VERSION
+		|| header.checksum != checksum
+		|| header.settings != settings
+		|| header.numSurfaces != count ) {
+		ri.FS_FreeFile( buffer );
+		return NULL;
+	}
+
+	p = (byte *)buffer + sizeof( header );
+	remaining = length - sizeof( header );
+	for ( i = 0 ; i < count ; i++, in++ ) {
+		if ( remaining < (int)sizeof( record ) ) {
+			break;
+		}
+		Com_Memcpy( &record, p, sizeof( record ) );
+		p += sizeof( record );
+		remaining -= sizeof( record );
+
+		switch ( LittleLong( in->surfaceType ) ) {
+		case MST_PATCH:
+			expected = record.surface.surfaceType == SF_SKIP ? SF_SKIP : SF_GRID;
+			break;
+		case MST_TRIANGLE_SOUP:
+			expected = SF_TRIANGLES;
+			break;
+		case MST_PLANAR:
+			expected = SF_FACE;
+			break;
+		default:
+			expected = SF_FLARE;
+			break;
+		}
+		if ( record.surface.surfaceType != expected
+			|| record.surface.numVerts < 0 || record.surface.numIndexes < 0
+			|| record.surface.width < 0 || record.surface.width > MAX_GRID_SIZE
+			|| record.surface.height < 0 || record.surface.height > MAX_GRID_SIZE
+			|| record.surface.numVerts > remaining / (int)sizeof( srfVert_t )
+			|| record.surface.numIndexes > remaining / (int)sizeof( glIndex_t )
+			|| record.surface.width + record.surface.height > remaining / (int)sizeof( float ) ) {
+			break;
+		}
+
+		size = R_SurfaceCacheDataSize( &record.surface );
+		if ( size > remaining || !R_CheckCachedSurface( &record.surface, p ) ) {
+			break;
+		}
+		p += size;
+		remaining -= size;
+	}
+
+	if ( i != count || remaining ) {
+		ri.Printf( PRINT_WARNING, "WARNING: %s is damaged, rebuilding it\n", filename );
+		ri.FS_FreeFile( buffer );
+		return NULL;
+	}
+
+	return buffer;
+}
+
+/*
+===============
+ParseCachedSurface
+
+Takes the place of ParseFace, ParseMesh and ParseTriSurf when the cache is
+used, trusting only what R_LoadSurfaceCache has checked.  Returns the cache
+data following the surface.
+===============
+*/
+static byte *ParseCachedSurface( dsurface_t *ds, msurface_t *surf, byte *p ) {
+	surfCacheRecord_t	record;
+	srfBspSurface_t		*cv;
+	static surfaceType_t	skipData = SF_SKIP;
+	int					lightmapNum;
+	int					size;
+
+	Com_Memcpy( &record, p, sizeof( record ) );
+	p += sizeof( record );
+
+	if ( LittleLong( ds->surfaceType ) == MST_TRIANGLE_SOUP ) {
+		lightmapNum = LIGHTMAP_BY_VERTEX;
+	} else {
+		lightmapNum = FatLightmap( LittleLong( ds->lightmapNum ) );
+	}
+
+	// get fog volume
+	surf->fogIndex = LittleLong( ds->fogNum ) + 1;
+
+	// get shader value
+	surf->shader = ShaderForShaderNum( ds->shaderNum, lightmapNum );
+	if ( r_singleShader->integer && !surf->shader->isSky ) {
+		surf->shader = tr.defaultShader;
+	}
+	if ( record.flags & SURFCACHE_DEFAULTSHADER ) {
+		surf->shader = tr.defaultShader;
+	}
+
+	if ( record.surface.surfaceType == SF_SKIP ) {
+		surf->data = &skipData;
+		return p;
+	}
+
+	surf->cullinfo = record.cullinfo;
+
+	cv = (srfBspSurface_t *)surf->data;
+	*cv = record.surface;
+
+	size = cv->numVerts * sizeof( srfVert_t );
+	cv->verts = ri.Hunk_Alloc( size, h_low );
+	Com_Memcpy( cv->verts, p, size );
+	p += size;
+
+	size = cv->numIndexes * sizeof( glIndex_t );
+	cv->indexes = ri.Hunk_Alloc( size, h_low );
+	Com_Memcpy( cv->indexes, p, size );
+	p += size;
+
+	if ( cv->surfaceType == SF_GRID ) {
+		size = cv->width * sizeof( float );
+		cv->widthLodError = ri.Hunk_Alloc( size, h_low );
+		Com_Memcpy( cv->widthLodError, p, size );
+		p += size;
+
+		size = cv->height * sizeof( float );
+		cv->heightLodError = ri.Hunk_Alloc( size, h_low );
+		Com_Memcpy( cv->heightLodError, p, size );
+		p += size;
+	} else {
+		cv->widthLodError = NULL;
+		cv->heightLodError = NULL;
+	}
+
+	return p;
+}
+
+/*
+===============
+R_SaveSurfaceCache
+===============
+*/
+static void R_SaveSurfaceCache( unsigned checksum, unsigned settings, dsurface_t *in ) {
+	char				filename[MAX_QPATH];
+	surfCacheHeader_t	header;
+	surfCacheRecord_t	record;
+	srfBspSurface_t		*cv;
+	byte				*buffer, *p;
+	int					size, i;
+
+	size = sizeof( header );
+	for ( i = 0 ; i < s_worldData.numsurfaces ; i++ ) {
+		size += sizeof( record ) + R_SurfaceCacheDataSize( (srfBspSurface_t *)s_worldData.surfaces[i].data );
+	}
+
+	buffer = ri.Hunk_AllocateTempMemory( size );
+
+	Com_Memset( &header, 0, sizeof( header ) );
+	header.ident = SURFCACHE_IDENT;
+	header.version = SURFCACHE_VERSION;
+	header.checksum = checksum;
+	header.settings = settings;
+	header.numSurfaces = s_worldData.numsurfaces;
+	Com_Memcpy( buffer, &header, sizeof( header ) );
+	p = buffer + sizeof( header );
+
+	for ( i = 0 ; i < s_worldData.numsurfaces ; i++, in++ ) {
+		cv = (srfBspSurface_t *)s_worldData.surfaces[i].data;
+
+		Com_Memset( &record, 0, sizeof( record ) );
+		if ( LittleLong( in->surfaceType ) == MST_PLANAR && LittleLong( in->numVerts ) > MAX_FACE_POINTS ) {
+			record.flags |= SURFCACHE_DEFAULTSHADER;
+		}
+		record.cullinfo = s_worldData.surfaces[i].cullinfo;
+		switch ( cv->surfaceType ) {
+		case SF_FACE:
+		case SF_TRIANGLES:
+		case SF_GRID:
+			record.surface = *cv;
+			record.surface.verts = NULL;
+			record.surface.indexes = NULL;
+			record.surface.widthLodError = NULL;
+			record.surface.heightLodError = NULL;
+			break;
+		default:
+			// flares are parsed again, skipped patches only need the type
+			record.surface.surfaceType = cv->surfaceType;
+			break;
+		}
+		Com_Memcpy( p, &record, sizeof( record ) );
+		p += sizeof( record );
+
+		if ( !R_SurfaceCacheDataSize( &record.surface ) ) {
+			continue;
+		}
+
+		Com_Memcpy( p, cv->verts, cv->numVerts * sizeof( srfVert_t ) );
+		p += cv->numVerts * sizeof( srfVert_t );
+		Com_Memcpy( p, cv->indexes, cv->numIndexes * sizeof( glIndex_t ) );
+		p += cv->numIndexes * sizeof( glIndex_t );
+		if ( cv->surfaceType == SF_GRID ) {
+			Com_Memcpy( p, cv->widthLodError, cv->width * sizeof( float ) );
+			p += cv->width * sizeof( float );
+			Com_Memcpy( p, cv->heightLodError, cv->height * sizeof( float ) );
+			p += cv->height * sizeof( float );
+		}
+	}
+
+	R_SurfaceCacheName( filename );
+	ri.FS_WriteFile( filename, buffer, size );
+	ri.Hunk_FreeTempMemory( buffer );
+}
+
+
 /*
 ===============
 R_LoadSurfaces
@@ -1694,7 +2101,12 @@ static	void R_LoadSurfaces( lump_t *surfs, lump_t *verts, lump_t *indexLump ) {
 	int			numFaces, numMeshes, numTriSurfs, numFlares;
 	int			i;
 	float *hdrVertColors = NULL;
+	int			hdrVertColorsSize = 0;
+	unsigned	checksum, settings;
+	byte		*cache, *cached;
+	int			start;
 
+	start = ri.Milliseconds();
 	numFaces = 0;
 	numMeshes = 0;
 	numTriSurfs = 0;
@@ -1736,9 +2148,17 @@ static	void R_LoadSurfaces( lump_t *surfs, lump_t *verts, lump_t *indexLump ) {
 			//ri.Printf(PRINT_ALL, "Found!\n");
 			if (size != sizeof(float) * 3 * (verts->filelen / sizeof(*dv)))
 				ri.Error(ERR_DROP, "Bad size for %s (%i, expected %i)!", filename, size, (int)((sizeof(float)) * 3 * (verts->filelen / sizeof(*dv))));
+			hdrVertColorsSize = size;
 		}
 	}
 
+	checksum = R_SurfaceCacheChecksum( surfs, verts, indexLump );
+	settings = R_SurfaceCacheSettings( hdrVertColors, hdrVertColorsSize );
+	cache = NULL;
+	if ( r_surfaceCache->integer ) {
+		cache = R_LoadSurfaceCache( checksum, settings, (void *)(fileBase + surfs->fileofs), count );
+	}
+
 
 	// Two passes, allocate surfaces first, then load them full of data
 	// This ensures surfaces are close together to reduce L2 cache misses when using VAOs,
@@ -1766,7 +2186,30 @@ static	void R_LoadSurfaces( lump_t *surfs, lump_t *verts, lump_t *indexLump ) {
 
 	in = (void *)(fileBase + surfs->fileofs);
 	out = s_worldData.surfaces;
+	cached = cache ? cache + sizeof( surfCacheHeader_t ) : NULL;
 	for ( i = 0 ; i < count ; i++, in++, out++ ) {
+		if ( cached ) {
+			if ( LittleLong( in->surfaceType ) == MST_FLARE ) {
+				ParseFlare( in, dv, out, indexes );
+				cached += sizeof( surfCacheRecord_t );
+				numFlares++;
+				continue;
+			}
+			cached = ParseCachedSurface( in, out, cached );
+			switch ( LittleLong( in->surfaceType ) ) {
+			case MST_PATCH:
+				numMeshes++;
+				break;
+			case MST_TRIANGLE_SOUP:
+				numTriSurfs++;
+				break;
+			default:
+				numFaces++;
+				break;
+			}
+			continue;
+		}
+
 		switch ( LittleLong( in->surfaceType ) ) {
 		case MST_PATCH:
 			ParseMesh ( in, dv, hdrVertColors, out );
@@ -1789,23 +2232,37 @@ static	void R_LoadSurfaces( lump_t *surfs, lump_t *verts, lump_t *indexLump ) {
 		}
 	}
 
+	if ( cache )
+	{
+		ri.FS_FreeFile( cache );
+	}
+
 	if (hdrVertColors)
 	{
 		ri.FS_FreeFile(hdrVertColors);
 	}
 
+	if ( !cache )
+	{
 #ifdef PATCH_STITCHING
-	R_StitchAllPatches();
+		R_StitchAllPatches();
 #endif
 
-	R_FixSharedVertexLodError();
+		R_FixSharedVertexLodError();
 
 #ifdef PATCH_STITCHING
-	R_MovePatchSurfacesToHunk();
+		R_MovePatchSurfacesToHunk();
 #endif
 
+		if ( r_surfaceCache->integer ) {
+			R_SaveSurfaceCache( checksum, settings, (void *)(fileBase + surfs->fileofs) );
+		}
+	}
+
 	ri.Printf( PRINT_ALL, "...loaded %d faces, %i meshes, %i trisurfs, %i flares\n", 
 		numFaces, numMeshes, numTriSurfs, numFlares );
+	ri.Printf( PRINT_DEVELOPER, "...surfaces %s in %i msec\n",
+		cache ? "loaded from cache" : "built", ri.Milliseconds() - start );
 }
 
 
@@ -1976,6 +2433,9 @@ static	void R_LoadShaders( lump_t *l ) {
 	for ( i=0 ; i<count ; i++ ) {
 		out[i].surfaceFlags = LittleLong( out[i].surfaceFlags );
 		out[i].contentFlags = LittleLong( out[i].contentFlags );
+
+		// start decoding the textures while the rest of the map loads
+		R_PrefetchShaderImages( out[i].shader );
 	}
 }
 
@@ -2782,6 +3242,8 @@ void RE_LoadWorldMap( const char *name ) {
 	R_LoadMarksurfaces (&header->lumps[LUMP_LEAFSURFACES]);
 	R_LoadNodesAndLeafs (&header->lumps[LUMP_NODES], &header->lumps[LUMP_LEAFS]);
 	R_LoadSubmodels (&header->lumps[LUMP_MODELS]);
+	R_InitWorldJobs( &s_worldData );
+	R_InitOcclusion( &s_worldData );
 	R_LoadVisibility( &header->lumps[LUMP_VISIBILITY] );
 	R_LoadLightGrid( &header->lumps[LUMP_LIGHTGRID] );
 
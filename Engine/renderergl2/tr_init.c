@@ -231,6 +231,15 @@ cvar_t	*r_maxpolys;
 int		max_polys;
 cvar_t	*r_maxpolyverts;
 int		max_polyverts;
+cvar_t	*r_maxpolymem;
+
+cvar_t	*r_shaderCache;
+cvar_t	*r_surfaceCache;
+
+cvar_t	*r_occlusion;
+cvar_t	*r_occlusionTriangles;
+
+cvar_t	*r_md3Lods;
 
 /*
 ** InitOpenGL
@@ -1353,6 +1362,15 @@ void R_Register( void )
 
 	r_maxpolys = ri.Cvar_Get( "r_maxpolys", va("%d", MAX_POLYS), 0);
 	r_maxpolyverts = ri.Cvar_Get( "r_maxpolyverts", va("%d", MAX_POLYVERTS), 0);
+	r_maxpolymem = ri.Cvar_Get( "r_maxpolymem", "8", CVAR_ARCHIVE );
+
+	r_shaderCache = ri.Cvar_Get( "r_shaderCache", "1", CVAR_ARCHIVE );
+	r_surfaceCache = ri.Cvar_Get( "r_surfaceCache", "1", CVAR_ARCHIVE );
+
+	r_occlusion = ri.Cvar_Get( "r_occlusion", "1", CVAR_ARCHIVE );
+	r_occlusionTriangles = ri.Cvar_Get( "r_occlusionTriangles", "4096", CVAR_ARCHIVE );
+
+	r_md3Lods = ri.Cvar_Get( "r_md3Lods", "2", CVAR_ARCHIVE | CVAR_LATCH );
 
 	// make sure all the commands added here are also
 	// removed in R_Shutdown
@@ -1367,6 +1385,10 @@ void R_Register( void )
 	ri.Cmd_AddCommand( "minimize", GLimp_Minimize );
 	ri.Cmd_AddCommand( "gfxmeminfo", GfxMemInfo_f );
 	ri.Cmd_AddCommand( "exportCubemaps", R_ExportCubemaps_f );
+	ri.Cmd_AddCommand( "polyinfo", R_PolyInfo_f );
+	ri.Cmd_AddCommand( "iqmBench", R_IQMBench_f );
+	ri.Cmd_AddCommand( "deformBench", R_DeformBench_f );
+	ri.Cmd_AddCommand( "md3Bench", R_MD3Bench_f );
 }
 
 void R_InitQueries(void)
@@ -1455,16 +1477,19 @@ void R_Init( void ) {
 	if (max_polyverts < MAX_POLYVERTS)
 		max_polyverts = MAX_POLYVERTS;
 
-	ptr = ri.Hunk_Alloc( sizeof( *backEndData ) + sizeof(srfPoly_t) * max_polys + sizeof(polyVert_t) * max_polyverts, h_low);
+	ptr = ri.Hunk_Alloc( sizeof( *backEndData ), h_low);
 	backEndData = (backEndData_t *) ptr;
-	backEndData->polys = (srfPoly_t *) ((char *) ptr + sizeof( *backEndData ));
-	backEndData->polyVerts = (polyVert_t *) ((char *) ptr + sizeof( *backEndData ) + sizeof(srfPoly_t) * max_polys);
+	R_InitScenePolys();
 	R_InitNextFrame();
 
 	InitOpenGL();
 
 	R_InitImages();
 
+	R_InitImageJobs();
+
+	R_InitFrontEndJobs();
+
 	if (glRefConfig.framebufferObject)
 		FBO_Init();
 
@@ -1512,6 +1537,10 @@ void RE_Shutdown( qboolean destroyWindow ) {
 	ri.Cmd_RemoveCommand( "minimize" );
 	ri.Cmd_RemoveCommand( "gfxmeminfo" );
 	ri.Cmd_RemoveCommand( "exportCubemaps" );
+	ri.Cmd_RemoveCommand( "polyinfo" );
+	ri.Cmd_RemoveCommand( "iqmBench" );
+	ri.Cmd_RemoveCommand( "deformBench" );
+	ri.Cmd_RemoveCommand( "md3Bench" );
 
 
 	if ( tr.registered ) {
@@ -1524,6 +1553,14 @@ void RE_Shutdown( qboolean destroyWindow ) {
 		GLSL_ShutdownGPUShaders();
 	}
 
+	R_ShutdownImageJobs();
+
+	R_ShutdownFrontEndJobs();
+
+	R_ShutdownScenePolys();
+
+	R_FreeDeformBatches();
+
 	R_DoneFreeType();
 
 	// shut down platform specific OpenGL stuff
@@ -1546,7 +1583,9 @@ Touch all images to make sure they are resident
 =============
 */
 void RE_EndRegistration( void ) {
+	R_FlushImageJobs();
 	R_IssuePendingRenderCommands();
+	R_SaveShaderStageCache();
 	if (!ri.Sys_LowPhysicalMemory()) {
 		RB_ShowImages();
 	}
@@ -1595,6 +1634,8 @@ refexport_t *GetRefAPI ( int apiVersion, refimport_t *rimp ) {
 
 	re.MarkFragments = R_MarkFragments;
 	re.LerpTag = R_LerpTag;
+	re.TagIndex = R_TagIndex;
+	re.LerpTags = R_LerpTags;
 	re.ModelBounds = R_ModelBounds;
 
 	re.ClearScene = RE_ClearScene;
@@ -1607,6 +1648,7 @@ refexport_t *GetRefAPI ( int apiVersion, refimport_t *rimp ) {
 
 	re.SetColor = RE_SetColor;
 	re.DrawStretchPic = RE_StretchPic;
+	re.DrawString = RE_DrawString;
 	re.DrawStretchRaw = RE_StretchRaw;
 	re.UploadCinematic = RE_UploadCinematic;
 
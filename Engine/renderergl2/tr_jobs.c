@@ -0,0 +1,426 @@
+/*
+===========================================================================
+Copyright (C) 1999-2005 Id Software, Inc.
+
+This file is part of Quake III Arena source code.
+
+Quake III Arena source code is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of the License,
+or (at your option) any later version.
+
+Quake III Arena source code is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Quake III Arena source code; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+===========================================================================
+*/
+// tr_jobs.c -- runs batches of front end work on worker threads
+
+#include "tr_local.h"
+
+/*
+=============================================================
+
+FRONT END JOBS
+
+A batch is a function and a count; every job in it is handed the job
+number and the number of the thread running it, 0 being the main thread.
+The main thread runs jobs too and returns once the whole batch is done,
+so nothing the jobs write has to outlive the call.
+
+Jobs must not call back into the engine.
+
+=============================================================
+*/
+
+typedef struct {
+	int				numThreads;
+	struct sysThread_s		*threads[MAX_FRONTEND_THREADS];
+	struct sysMutex_s		*lock;
+	struct sysSemaphore_s	*work;		// posted to wake workers for a batch
+	struct sysSemaphore_s	*done;		// posted once per finished batch
+	qboolean		quit;
+	qboolean		serial;				// run everything on the main thread
+
+	frontEndJob_t	func;
+	void			*data;
+	int				numJobs;
+	int				nextJob;
+	int				finishedJobs;
+} frontEndJobs_t;
+
+static frontEndJobs_t	r_frontEndJobs;
+static cvar_t			*r_frontEndThreads;
+
+/*
+=================
+R_RunNextFrontEndJob
+
+Returns qfalse once every job in the batch has been handed out.
+=================
+*/
+static qboolean R_RunNextFrontEndJob( int thread ) {
+	frontEndJob_t	func;
+	void			*data;
+	int				job;
+	qboolean		last;
+
+	ri.Sys_LockMutex( r_frontEndJobs.lock );
+	if ( r_frontEndJobs.nextJob >= r_frontEndJobs.numJobs ) {
+		ri.Sys_UnlockMutex( r_frontEndJobs.lock );
+		return qfalse;
+	}
+	job = r_frontEndJobs.nextJob++;
+	func = r_frontEndJobs.func;
+	data = r_frontEndJobs.data;
+	ri.Sys_UnlockMutex( r_frontEndJobs.lock );
+
+	func( data, job, thread );
+
+	ri.Sys_LockMutex( r_frontEndJobs.lock );
+	last = ( ++r_frontEndJobs.finishedJobs == r_frontEndJobs.numJobs );
+	ri.Sys_UnlockMutex( r_frontEndJobs.lock );
+
+	if ( last ) {
+		ri.Sys_PostSemaphore( r_frontEndJobs.done );
+	}
+	return qtrue;
+}
+
+/*
+=================
+R_FrontEndWorker
+=================
+*/
+static int R_FrontEndWorker( void *data ) {
+	int		thread;
+	qboolean	quit;
+
+	thread = (int)(intptr_t)data;
+
+	while ( 1 ) {
+		ri.Sys_WaitSemaphore( r_frontEndJobs.work, -1 );
+
+		ri.Sys_LockMutex( r_frontEndJobs.lock );
+		quit = r_frontEndJobs.quit;
+		ri.Sys_UnlockMutex( r_frontEndJobs.lock );
+		if ( quit ) {
+			break;
+		}
+
+		// a late wakeup finds the batch already handed out
+		while ( R_RunNextFrontEndJob( thread ) ) {
+		}
+	}
+
+	return 0;
+}
+
+/*
+=================
+R_FrontEndThreads
+
+Number of worker threads batches are spread over, not counting the
+main thread.  0 if everything runs on the main thread.
+=================
+*/
+int R_FrontEndThreads( void ) {
+	if ( r_frontEndJobs.serial ) {
+		return 0;
+	}
+	return r_frontEndJobs.numThreads;
+}
+
+/*
+=================
+R_RunFrontEndJobs
+=================
+*/
+void R_RunFrontEndJobs( frontEndJob_t func, void *data, int numJobs ) {
+	int		i, wake;
+
+	if ( numJobs <= 0 ) {
+		return;
+	}
+
+	if ( numJobs == 1 || !R_FrontEndThreads() ) {
+		for ( i = 0; i < numJobs; i++ ) {
+			func( data, i, 0 );
+		}
+		return;
+	}
+
+	ri.Sys_LockMutex( r_frontEndJobs.lock );
+	r_frontEndJobs.func = func;
+	r_frontEndJobs.data = data;
+	r_frontEndJobs.numJobs = numJobs;
+	r_frontEndJobs.nextJob = 0;
+	r_frontEndJobs.finishedJobs = 0;
+	ri.Sys_UnlockMutex( r_frontEndJobs.lock );
+
+	// the main thread takes a share of the batch itself
+	wake = numJobs - 1;
+	if ( wake > r_frontEndJobs.numThreads ) {
+		wake = r_frontEndJobs.numThreads;
+	}
+	for ( i = 0; i < wake; i++ ) {
+		ri.Sys_PostSemaphore( r_frontEndJobs.work );
+	}
+
+	while ( R_RunNextFrontEndJob( 0 ) ) {
+	}
+
+	ri.Sys_WaitSemaphore( r_frontEndJobs.done, -1 );
+}
+
+
+/*
+=============================================================
+
+BENCHMARK
+
+=============================================================
+*/
+
+/*
+=================
+R_BenchFrontEndView
+
+Sets up an orbit around the middle of the world, seen from a third of
+the way out, and culls the world for it.  Nothing is drawn.
+=================
+*/
+static void R_BenchFrontEndView( int frame, int numFrames ) {
+	viewParms_t	parms;
+	vec3_t		center, angles;
+	float		radius, yaw;
+	mnode_t		*root;
+
+	root = tr.world->nodes;
+	VectorAdd( root->mins, root->maxs, center );
+	VectorScale( center, 0.5f, center );
+	radius = ( root->maxs[0] - root->mins[0] + root->maxs[1] - root->mins[1] ) / 6.0f;
+
+	yaw = 360.0f * frame / numFrames;
+
+	Com_Memset( &parms, 0, sizeof( parms ) );
+	parms.viewportWidth = 640;
+	parms.viewportHeight = 480;
+	parms.fovX = 90;
+	parms.fovY = 73.74f;
+	parms.or.origin[0] = center[0] + radius * cos( DEG2RAD( yaw ) );
+	parms.or.origin[1] = center[1] + radius * sin( DEG2RAD( yaw ) );
+	parms.or.origin[2] = center[2];
+
+	// look ahead along the orbit, tilting up and down a little
+	angles[PITCH] = 15.0f * sin( DEG2RAD( yaw * 3 ) );
+	angles[YAW] = yaw + 90;
+	angles[ROLL] = 0;
+	AnglesToAxis( angles, parms.or.axis );
+	VectorCopy( parms.or.origin, parms.pvsOrigin );
+
+	tr.viewCount++;
+	tr.viewParms = parms;
+	R_RotateForViewer();
+	R_SetupProjection( &tr.viewParms, r_zproj->value, tr.viewParms.zFar, qtrue );
+
+	tr.refdef.numDrawSurfs = 0;
+	R_AddWorldSurfaces();
+}
+
+/*
+=================
+R_BenchFrontEndPass
+
+Returns a checksum over the draw surfaces of every frame.
+=================
+*/
+static unsigned R_BenchFrontEndPass( int numFrames, int *msec, int *numDrawSurfs ) {
+	unsigned	sum;
+	int			frame, i, start;
+
+	sum = 2166136261u;
+	*numDrawSurfs = 0;
+	*msec = 0;
+	for ( frame = 0; frame < numFrames; frame++ ) {
+		start = ri.Milliseconds();
+		R_BenchFrontEndView( frame, numFrames );
+		*msec += ri.Milliseconds() - start;
+
+		*numDrawSurfs += tr.refdef.numDrawSurfs;
+		for ( i = 0; i < tr.refdef.numDrawSurfs && i < MAX_DRAWSURFS; i++ ) {
+			sum = ( sum ^ tr.refdef.drawSurfs[i].sort ) * 16777619u;
+			sum = ( sum ^ (unsigned)( (intptr_t)tr.refdef.drawSurfs[i].surface ) ) * 16777619u;
+		}
+	}
+	return sum;
+}
+
+/*
+=================
+R_FrontEndBench_f
+
+frontEndBench [frames]
+
+Culls the loaded world from a scripted camera on the main thread and then
+on the workers, and checks that both come up with the same draw surfaces.
+Nothing is sent to GL.
+=================
+*/
+static void R_FrontEndBench_f( void ) {
+	trRefdef_t	savedRefdef;
+	viewParms_t	savedViewParms;
+	orientationr_t	savedOr;
+	int			numFrames;
+	int			msec[2], drawSurfs[2];
+	unsigned	sum[2];
+	int			pass;
+
+	if ( !tr.world ) {
+		ri.Printf( PRINT_ALL, "frontEndBench: no world loaded\n" );
+		return;
+	}
+
+	numFrames = ri.Cmd_Argc() > 1 ? atoi( ri.Cmd_Argv( 1 ) ) : 500;
+	if ( numFrames < 1 ) {
+		numFrames = 1;
+	}
+
+	savedRefdef = tr.refdef;
+	savedViewParms = tr.viewParms;
+	savedOr = tr.or;
+
+	// a bare scene: no dlights, no shadows, every area open
+	tr.refdef.rdflags = 0;
+	tr.refdef.num_dlights = 0;
+	tr.refdef.num_pshadows = 0;
+	tr.refdef.drawSurfs = backEndData->drawSurfs;
+	Com_Memset( tr.refdef.areamask, 0, sizeof( tr.refdef.areamask ) );
+
+	for ( pass = 0; pass < 2; pass++ ) {
+		r_frontEndJobs.serial = ( pass == 0 );
+		// the vis marks are cached by cluster, so start each pass cold
+		tr.refdef.areamaskModified = qtrue;
+		sum[pass] = R_BenchFrontEndPass( numFrames, &msec[pass], &drawSurfs[pass] );
+	}
+	r_frontEndJobs.serial = qfalse;
+
+	tr.refdef = savedRefdef;
+	tr.viewParms = savedViewParms;
+	tr.or = savedOr;
+
+	ri.Printf( PRINT_ALL, "%i frames, %i draw surfaces a frame\n", numFrames, drawSurfs[0] / numFrames );
+	ri.Printf( PRINT_ALL, "main thread:      %8.3f msec a frame\n", (float)msec[0] / numFrames );
+	ri.Printf( PRINT_ALL, "%2i worker%s:      %8.3f msec a frame\n", r_frontEndJobs.numThreads,
+		r_frontEndJobs.numThreads == 1 ? " " : "s", (float)msec[1] / numFrames );
+	if ( sum[0] != sum[1] || drawSurfs[0] != drawSurfs[1] ) {
+		ri.Printf( PRINT_ALL, S_COLOR_YELLOW "draw surfaces differ between the two: %08x / %08x\n", sum[0], sum[1] );
+	} else {
+		ri.Printf( PRINT_ALL, "draw surfaces match (%08x)\n", sum[0] );
+	}
+}
+
+
+/*
+=============================================================
+
+INIT / SHUTDOWN
+
+=============================================================
+*/
+
+/*
+=================
+R_StopFrontEndWorkers
+=================
+*/
+static void R_StopFrontEndWorkers( void ) {
+	int		i;
+
+	if ( r_frontEndJobs.numThreads ) {
+		ri.Sys_LockMutex( r_frontEndJobs.lock );
+		r_frontEndJobs.quit = qtrue;
+		ri.Sys_UnlockMutex( r_frontEndJobs.lock );
+
+		for ( i = 0; i < r_frontEndJobs.numThreads; i++ ) {
+			ri.Sys_PostSemaphore( r_frontEndJobs.work );
+		}
+		for ( i = 0; i < r_frontEndJobs.numThreads; i++ ) {
+			ri.Sys_WaitThread( r_frontEndJobs.threads[i] );
+		}
+	}
+
+	ri.Sys_DestroySemaphore( r_frontEndJobs.done );
+	ri.Sys_DestroySemaphore( r_frontEndJobs.work );
+	ri.Sys_DestroyMutex( r_frontEndJobs.lock );
+
+	Com_Memset( &r_frontEndJobs, 0, sizeof( r_frontEndJobs ) );
+}
+
+/*
+=================
+R_InitFrontEndJobs
+=================
+*/
+void R_InitFrontEndJobs( void ) {
+	int		numThreads;
+	int		i;
+
+	r_frontEndThreads = ri.Cvar_Get( "r_frontEndThreads", "-1", CVAR_ARCHIVE | CVAR_LATCH );
+	ri.Cmd_AddCommand( "frontEndBench", R_FrontEndBench_f );
+
+	Com_Memset( &r_frontEndJobs, 0, sizeof( r_frontEndJobs ) );
+
+	// -1 leaves one core for the main thread, which works on batches too
+	numThreads = r_frontEndThreads->integer;
+	if ( numThreads < 0 ) {
+		numThreads = ri.Sys_ProcessorCount() - 1;
+	}
+	if ( numThreads > MAX_FRONTEND_THREADS ) {
+		numThreads = MAX_FRONTEND_THREADS;
+	}
+	if ( numThreads <= 0 ) {
+		return;
+	}
+
+	r_frontEndJobs.lock = ri.Sys_CreateMutex();
+	r_frontEndJobs.work = ri.Sys_CreateSemaphore( 0 );
+	r_frontEndJobs.done = ri.Sys_CreateSemaphore( 0 );
+	if ( !r_frontEndJobs.lock || !r_frontEndJobs.work || !r_frontEndJobs.done ) {
+		ri.Printf( PRINT_WARNING, "WARNING: couldn't create front end worker sync objects\n" );
+		R_StopFrontEndWorkers();
+		return;
+	}
+
+	for ( i = 0; i < numThreads; i++ ) {
+		r_frontEndJobs.threads[i] = ri.Sys_CreateThread( "frontEndWorker", R_FrontEndWorker, (void *)(intptr_t)( i + 1 ) );
+		if ( !r_frontEndJobs.threads[i] ) {
+			break;
+		}
+	}
+	r_frontEndJobs.numThreads = i;
+
+	if ( !r_frontEndJobs.numThreads ) {
+		ri.Printf( PRINT_WARNING, "WARNING: couldn't start front end worker threads\n" );
+		R_StopFrontEndWorkers();
+		return;
+	}
+
+	ri.Printf( PRINT_ALL, "Culling the world on %i worker thread%s\n", r_frontEndJobs.numThreads,
+		r_frontEndJobs.numThreads == 1 ? "" : "s" );
+}
+
+/*
+=================
+R_ShutdownFrontEndJobs
+=================
+*/
+void R_ShutdownFrontEndJobs( void ) {
+	ri.Cmd_RemoveCommand( "frontEndBench" );
+	R_StopFrontEndWorkers();
+}
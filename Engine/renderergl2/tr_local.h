@@ -725,7 +725,7 @@ typedef struct {
 	struct dlight_s	*dlights;
 
 	int			numPolys;
-	struct srfPoly_s	*polys;
+	int			firstPoly;			// scene polys are looked up by number
 
 	int			numDrawSurfs;
 	struct drawSurf_s	*drawSurfs;
@@ -861,6 +861,8 @@ typedef struct srfPoly_s {
 	int				fogIndex;
 	int				numVerts;
 	polyVert_t		*verts;
+	int				numIndexes;
+	glIndex_t		*indexes;		// fan over verts, shared by every poly
 } srfPoly_t;
 
 
@@ -1129,6 +1131,15 @@ typedef struct {
 
 	char		*entityString;
 	char		*entityParsePoint;
+
+	// scratch for culling on the front end threads
+	struct worldLeaf_s	*jobLeafs;		// numnodes for each thread
+	drawSurf_t	*jobDrawSurfs;			// numWorldSurfaces
+
+	// surfaces drawn into the occlusion buffer
+	struct occluder_s	*occluders;
+	int			numOccluders;
+	float		*occluderVerts;			// clip space scratch for the largest
 } world_t;
 
 
@@ -1235,10 +1246,16 @@ void		R_ModelInit (void);
 model_t		*R_GetModelByHandle( qhandle_t hModel );
 int			R_LerpTag( orientation_t *tag, qhandle_t handle, int startFrame, int endFrame, 
 					 float frac, const char *tagName );
+int			R_TagIndex( qhandle_t handle, const char *tagName );
+int			R_LerpTags( orientation_t *tags, qhandle_t handle, int startFrame, int endFrame, 
+					 float frac, const int *tagIndexes, int numTags );
 void		R_ModelBounds( qhandle_t handle, vec3_t mins, vec3_t maxs );
 
 void		R_Modellist_f (void);
 
+void		R_CreateMDVVaoSurfaces( mdvModel_t *mdvModel );
+void		R_GenerateMD3Lods( model_t *mod, int levels );
+
 //====================================================
 
 #define	MAX_DRAWIMAGES			2048
@@ -1296,6 +1313,9 @@ typedef struct {
 	int		c_leafs;
 	int		c_dlightSurfaces;
 	int		c_dlightSurfacesCulled;
+
+	int		c_occluders, c_occluderTriangles;
+	int		c_occludedNodes, c_occludedSurfaces, c_occludedEntities;
 } frontEndCounters_t;
 
 #define	FOG_TABLE_SIZE		256
@@ -1764,6 +1784,16 @@ extern	cvar_t	*r_printShaders;
 
 extern cvar_t	*r_marksOnTriangleMeshes;
 
+extern cvar_t	*r_maxpolymem;
+
+extern cvar_t	*r_shaderCache;		// save the indexed shader text and parsed shaders and load them back while the scripts are unchanged
+extern cvar_t	*r_surfaceCache;	// save the world surfaces built from a map and load them back while it is unchanged
+
+extern cvar_t	*r_occlusion;			// cull the world and entities against the biggest world surfaces
+extern cvar_t	*r_occlusionTriangles;	// occluder triangles drawn for each view
+
+extern cvar_t	*r_md3Lods;				// levels of detail made for MD3 models that come with only one
+
 //====================================================================
 
 static ID_INLINE qboolean ShaderRequiresCPUDeforms(const shader_t * shader)
@@ -1813,6 +1843,8 @@ void R_DecomposeSort( unsigned sort, int *entityNum, shader_t **shader,
 
 void R_AddDrawSurf( surfaceType_t *surface, shader_t *shader, 
 				   int fogIndex, int dlightMap, int pshadowMap, int cubemap );
+void R_FillDrawSurf( drawSurf_t *drawSurf, surfaceType_t *surface, shader_t *shader,
+				   int fogIndex, int dlightMap, int pshadowMap, int cubemap );
 
 void R_CalcTexDirs(vec3_t sdir, vec3_t tdir, const vec3_t v1, const vec3_t v2,
 				   const vec3_t v3, const vec2_t w1, const vec2_t w2, const vec2_t w3);
@@ -1830,6 +1862,7 @@ int R_CullPointAndRadiusEx( const vec3_t origin, float radius, const cplane_t* f
 int R_CullPointAndRadius( const vec3_t origin, float radius );
 int R_CullLocalPointAndRadius( const vec3_t origin, float radius );
 
+void R_RotateForViewer( void );
 void R_SetupProjection(viewParms_t *dest, float zProj, float zFar, qboolean computeFrustum);
 void R_RotateForEntity( const trRefEntity_t *ent, const viewParms_t *viewParms, orientationr_t *or );
 
@@ -1926,10 +1959,12 @@ const void *RB_TakeVideoFrameCmd( const void *data );
 // tr_shader.c
 //
 shader_t	*R_FindShader( const char *name, int lightmapIndex, qboolean mipRawImage );
+unsigned	R_BlockChecksum( unsigned checksum, const void *data, int length );
 shader_t	*R_GetShaderByHandle( qhandle_t hShader );
 shader_t	*R_GetShaderByState( int index, long *cycleTime );
 shader_t *R_FindShaderByName( const char *name );
 void		R_InitShaders( void );
+void		R_SaveShaderStageCache( void );
 void		R_ShaderList_f( void );
 void    R_RemapShader(const char *oldShader, const char *newShader, const char *timeOffset);
 
@@ -2009,6 +2044,7 @@ void RB_StageIteratorSky( void );
 void RB_StageIteratorVertexLitTexture( void );
 void RB_StageIteratorLightmappedMultitexture( void );
 
+void RB_CheckVao(vao_t *vao);
 void RB_AddQuadStamp( vec3_t origin, vec3_t left, vec3_t up, float color[4] );
 void RB_AddQuadStampExt( vec3_t origin, vec3_t left, vec3_t up, float color[4], float s1, float t1, float s2, float t2 );
 void RB_InstantQuad( vec4_t quadVerts[4] );
@@ -2028,9 +2064,44 @@ WORLD MAP
 
 void R_AddBrushModelSurfaces( trRefEntity_t *e );
 void R_AddWorldSurfaces( void );
+void R_InitWorldJobs( world_t *world );
 qboolean R_inPVS( const vec3_t p1, const vec3_t p2 );
 
 
+/*
+============================================================
+
+FRONT END JOBS
+
+============================================================
+*/
+
+#define	MAX_FRONTEND_THREADS	8
+
+typedef void (*frontEndJob_t)( void *data, int job, int thread );
+
+void R_InitFrontEndJobs( void );
+void R_ShutdownFrontEndJobs( void );
+int R_FrontEndThreads( void );
+void R_RunFrontEndJobs( frontEndJob_t func, void *data, int numJobs );
+
+
+/*
+============================================================
+
+OCCLUSION CULLING
+
+============================================================
+*/
+
+void R_InitOcclusion( world_t *world );
+void R_RenderOcclusion( void );
+qboolean R_OccludedBox( vec3_t bounds[2] );
+qboolean R_OccludedLocalBox( vec3_t bounds[2] );
+qboolean R_OccludedNode( mnode_t *node );
+qboolean R_OccludedModel( trRefEntity_t *ent, vec3_t oldBounds[2], vec3_t newBounds[2] );
+
+
 /*
 ============================================================
 
@@ -2185,6 +2256,9 @@ SCENE GENERATION
 void R_InitNextFrame( void );
 
 void RE_ClearScene( void );
+void R_InitScenePolys( void );
+void R_ShutdownScenePolys( void );
+void R_PolyInfo_f( void );
 void RE_AddRefEntityToScene( const refEntity_t *ent );
 void RE_AddPolyToScene( qhandle_t hShader , int numVerts, const polyVert_t *verts, int num );
 void RE_AddLightToScene( const vec3_t org, float intensity, float r, float g, float b );
@@ -2228,6 +2302,13 @@ void RB_IQMSurfaceAnim( surfaceType_t *surface );
 int R_IQMLerpTag( orientation_t *tag, iqmData_t *data,
                   int startFrame, int endFrame,
                   float frac, const char *tagName );
+int R_IQMTagIndex( iqmData_t *data, const char *tagName );
+int R_IQMLerpTags( orientation_t *tags, iqmData_t *data,
+                   int startFrame, int endFrame,
+                   float frac, const int *tagIndexes, int numTags );
+void R_ClearIQMPoseCache( void );
+void R_IQMBench_f( void );
+void R_MD3Bench_f( void );
 
 /*
 =============================================================
@@ -2238,6 +2319,8 @@ void	R_TransformModelToClip( const vec3_t src, const float *modelMatrix, const f
 void	R_TransformClipToWindow( const vec4_t clip, const viewParms_t *view, vec4_t normalized, vec4_t window );
 
 void	RB_DeformTessGeometry( void );
+void	R_DeformBench_f( void );
+void	R_FreeDeformBatches( void );
 
 void	RB_CalcFogTexCoords( float *dstTexCoords );
 
@@ -2313,6 +2396,17 @@ typedef struct {
 	float	s2, t2;
 } stretchPicCommand_t;
 
+typedef struct {
+	int		commandId;
+	shader_t	*shader;
+	float	x, y;
+	float	w, h;
+	float	advance;
+	int		maxChars;
+	int		flags;
+	int		length;		// bytes to the next command, the string and its padding
+} drawStringCommand_t;
+
 typedef struct {
 	int		commandId;
 	trRefdef_t	refdef;
@@ -2381,13 +2475,13 @@ typedef enum {
 	RC_CLEARDEPTH,
 	RC_CAPSHADOWMAP,
 	RC_POSTPROCESS,
-	RC_EXPORT_CUBEMAPS
+	RC_EXPORT_CUBEMAPS,
+	RC_DRAW_STRING
 } renderCommand_t;
 
 
-// these are sort of arbitrary limits.
-// the limits apply to the sum of all scenes in a frame --
-// the main view, all the 3D icons, etc
+// room reserved for polys at startup; the sum of all scenes in a frame --
+// the main view, all the 3D icons, etc -- can grow past it up to r_maxpolymem
 #define	MAX_POLYS		600
 #define	MAX_POLYVERTS	3000
 
@@ -2397,8 +2491,6 @@ typedef struct {
 	drawSurf_t	drawSurfs[MAX_DRAWSURFS];
 	dlight_t	dlights[MAX_DLIGHTS];
 	trRefEntity_t	entities[MAX_REFENTITIES];
-	srfPoly_t	*polys;//[MAX_POLYS];
-	polyVert_t	*polyVerts;//[MAX_POLYVERTS];
 	pshadow_t pshadows[MAX_CALC_PSHADOWS];
 	renderCommandList_t	commands;
 } backEndData_t;
@@ -2421,6 +2513,8 @@ void R_AddPostProcessCmd (void);
 void RE_SetColor( const float *rgba );
 void RE_StretchPic ( float x, float y, float w, float h, 
 					  float s1, float t1, float s2, float t2, qhandle_t hShader );
+void RE_DrawString( float x, float y, float w, float h, float advance,
+					const char *string, int maxChars, int flags, qhandle_t hShader );
 void RE_BeginFrame( stereoFrame_t stereoFrame );
 void RE_EndFrame( int *frontEndMsec, int *backEndMsec );
 void RE_SaveJPG(char * filename, int quality, int image_width, int image_height,
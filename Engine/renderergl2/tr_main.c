@@ -1465,14 +1465,26 @@ void R_AddDrawSurf( surfaceType_t *surface, shader_t *shader,
 	// instead of checking for overflow, we just mask the index
 	// so it wraps around
 	index = tr.refdef.numDrawSurfs & DRAWSURF_MASK;
+	R_FillDrawSurf( &tr.refdef.drawSurfs[index], surface, shader, fogIndex, dlightMap, pshadowMap, cubemap );
+	tr.refdef.numDrawSurfs++;
+}
+
+/*
+=================
+R_FillDrawSurf
+
+For the front end threads, which add to lists of their own.
+=================
+*/
+void R_FillDrawSurf( drawSurf_t *drawSurf, surfaceType_t *surface, shader_t *shader,
+				   int fogIndex, int dlightMap, int pshadowMap, int cubemap ) {
 	// the sort data is packed into a single 32 bit value so it can be
 	// compared quickly during the qsorting process
-	tr.refdef.drawSurfs[index].sort = (shader->sortedIndex << QSORT_SHADERNUM_SHIFT) 
+	drawSurf->sort = (shader->sortedIndex << QSORT_SHADERNUM_SHIFT) 
 		| tr.shiftedEntityNum | ( fogIndex << QSORT_FOGNUM_SHIFT ) 
 		| ((int)pshadowMap << QSORT_PSHADOW_SHIFT) | (int)dlightMap;
-	tr.refdef.drawSurfs[index].cubemapIndex = cubemap;
-	tr.refdef.drawSurfs[index].surface = surface;
-	tr.refdef.numDrawSurfs++;
+	drawSurf->cubemapIndex = cubemap;
+	drawSurf->surface = surface;
 }
 
 /*
@@ -333,6 +333,10 @@ void R_AddMD3Surfaces( trRefEntity_t *ent ) {
 		return;
 	}
 
+	if ( R_OccludedModel( ent, model->frames[ent->e.oldframe].bounds, model->frames[ent->e.frame].bounds ) ) {
+		return;
+	}
+
 	//
 	// set up lighting now that we know we aren't culled
 	//
@@ -90,6 +90,10 @@ qhandle_t R_RegisterMD3(const char *name, model_t *mod)
 
 	if(numLoaded)
 	{
+		// only the full detail file, make the other levels from it
+		if(numLoaded == 1 && mod->mdv[0] && r_md3Lods->integer > 0)
+			R_GenerateMD3Lods(mod, r_md3Lods->integer);
+
 		// duplicate into higher lod spots that weren't
 		// loaded, in case the user changes r_lodbias on the fly
 		for(lod--; lod >= 0; lod--)
@@ -365,6 +369,165 @@ qhandle_t RE_RegisterModel( const char *name ) {
 	return hModel;
 }
 
+/*
+=================
+R_CreateMDVVaoSurfaces
+
+Puts the surfaces of a loaded or generated MD3 level in vertex buffers.
+=================
+*/
+void R_CreateMDVVaoSurfaces(mdvModel_t *mdvModel)
+{
+	int             i, j;
+	mdvSurface_t   *surf;
+	mdvVertex_t    *v;
+	mdvSt_t        *st;
+	srfVaoMdvMesh_t *vaoSurf;
+
+	mdvModel->numVaoSurfaces = mdvModel->numSurfaces;
+	mdvModel->vaoSurfaces = ri.Hunk_Alloc(sizeof(*mdvModel->vaoSurfaces) * mdvModel->numSurfaces, h_low);
+
+	vaoSurf = mdvModel->vaoSurfaces;
+	surf = mdvModel->surfaces;
+	for (i = 0; i < mdvModel->numSurfaces; i++, vaoSurf++, surf++)
+	{
+		uint32_t offset_xyz, offset_st, offset_normal, offset_tangent;
+		uint32_t stride_xyz, stride_st, stride_normal, stride_tangent;
+		uint32_t dataSize, dataOfs;
+		uint8_t *data;
+
+		if (mdvModel->numFrames > 1)
+		{
+			// vertex animation, store texcoords first, then position/normal/tangents
+			offset_st      = 0;
+			offset_xyz     = surf->numVerts * sizeof(vec2_t);
+			offset_normal  = offset_xyz + sizeof(vec3_t);
+			offset_tangent = offset_normal + sizeof(int16_t) * 4;
+			stride_st  = sizeof(vec2_t);
+			stride_xyz = sizeof(vec3_t) + sizeof(int16_t) * 4;
+			stride_xyz += sizeof(int16_t) * 4;
+			stride_normal = stride_tangent = stride_xyz;
+
+			dataSize = offset_xyz + surf->numVerts * mdvModel->numFrames * stride_xyz;
+		}
+		else
+		{
+			// no animation, interleave everything
+			offset_xyz     = 0;
+			offset_st      = offset_xyz + sizeof(vec3_t);
+			offset_normal  = offset_st + sizeof(vec2_t);
+			offset_tangent = offset_normal + sizeof(int16_t) * 4;
+			stride_xyz = offset_tangent + sizeof(int16_t) * 4;
+			stride_st = stride_normal = stride_tangent = stride_xyz;
+
+			dataSize = surf->numVerts * stride_xyz;
+		}
+
+
+		data = ri.Malloc(dataSize);
+		dataOfs = 0;
+
+		if (mdvModel->numFrames > 1)
+		{
+			st = surf->st;
+			for ( j = 0 ; j < surf->numVerts ; j++, st++ ) {
+				memcpy(data + dataOfs, &st->st, sizeof(vec2_t));
+				dataOfs += sizeof(st->st);
+			}
+
+			v = surf->verts;
+			for ( j = 0; j < surf->numVerts * mdvModel->numFrames ; j++, v++ )
+			{
+				// xyz
+				memcpy(data + dataOfs, &v->xyz, sizeof(vec3_t));
+				dataOfs += sizeof(vec3_t);
+
+				// normal
+				memcpy(data + dataOfs, &v->normal, sizeof(int16_t) * 4);
+				dataOfs += sizeof(int16_t) * 4;
+
+				// tangent
+				memcpy(data + dataOfs, &v->tangent, sizeof(int16_t) * 4);
+				dataOfs += sizeof(int16_t) * 4;
+			}
+		}
+		else
+		{
+			v = surf->verts;
+			st = surf->st;
+			for ( j = 0; j < surf->numVerts; j++, v++, st++ )
+			{
+				// xyz
+				memcpy(data + dataOfs, &v->xyz, sizeof(vec3_t));
+				dataOfs += sizeof(v->xyz);
+
+				// st
+				memcpy(data + dataOfs, &st->st, sizeof(vec2_t));
+				dataOfs += sizeof(st->st);
+
+				// normal
+				memcpy(data + dataOfs, &v->normal, sizeof(int16_t) * 4);
+				dataOfs += sizeof(int16_t) * 4;
+
+				// tangent
+				memcpy(data + dataOfs, &v->tangent, sizeof(int16_t) * 4);
+				dataOfs += sizeof(int16_t) * 4;
+			}
+		}
+
+		vaoSurf->surfaceType = SF_VAO_MDVMESH;
+		vaoSurf->mdvModel = mdvModel;
+		vaoSurf->mdvSurface = surf;
+		vaoSurf->numIndexes = surf->numIndexes;
+		vaoSurf->numVerts = surf->numVerts;
+		
+		vaoSurf->vao = R_CreateVao(va("staticMD3Mesh_VAO '%s'", surf->name), data, dataSize, (byte *)surf->indexes, surf->numIndexes * sizeof(*surf->indexes), VAO_USAGE_STATIC);
+
+		vaoSurf->vao->attribs[ATTR_INDEX_POSITION].enabled = 1;
+		vaoSurf->vao->attribs[ATTR_INDEX_TEXCOORD].enabled = 1;
+		vaoSurf->vao->attribs[ATTR_INDEX_NORMAL  ].enabled = 1;
+		vaoSurf->vao->attribs[ATTR_INDEX_TANGENT ].enabled = 1;
+
+		vaoSurf->vao->attribs[ATTR_INDEX_POSITION].count = 3;
+		vaoSurf->vao->attribs[ATTR_INDEX_TEXCOORD].count = 2;
+		vaoSurf->vao->attribs[ATTR_INDEX_NORMAL  ].count = 4;
+		vaoSurf->vao->attribs[ATTR_INDEX_TANGENT ].count = 4;
+
+		vaoSurf->vao->attribs[ATTR_INDEX_POSITION].type = GL_FLOAT;
+		vaoSurf->vao->attribs[ATTR_INDEX_TEXCOORD].type = GL_FLOAT;
+		vaoSurf->vao->attribs[ATTR_INDEX_NORMAL  ].type = GL_SHORT;
+		vaoSurf->vao->attribs[ATTR_INDEX_TANGENT ].type = GL_SHORT;
+
+		vaoSurf->vao->attribs[ATTR_INDEX_POSITION].normalized = GL_FALSE;
+		vaoSurf->vao->attribs[ATTR_INDEX_TEXCOORD].normalized = GL_FALSE;
+		vaoSurf->vao->attribs[ATTR_INDEX_NORMAL  ].normalized = GL_TRUE;
+		vaoSurf->vao->attribs[ATTR_INDEX_TANGENT ].normalized = GL_TRUE;
+
+		vaoSurf->vao->attribs[ATTR_INDEX_POSITION].offset = offset_xyz;
+		vaoSurf->vao->attribs[ATTR_INDEX_TEXCOORD].offset = offset_st;
+		vaoSurf->vao->attribs[ATTR_INDEX_NORMAL  ].offset = offset_normal;
+		vaoSurf->vao->attribs[ATTR_INDEX_TANGENT ].offset = offset_tangent;
+
+		vaoSurf->vao->attribs[ATTR_INDEX_POSITION].stride = stride_xyz;
+		vaoSurf->vao->attribs[ATTR_INDEX_TEXCOORD].stride = stride_st;
+		vaoSurf->vao->attribs[ATTR_INDEX_NORMAL  ].stride = stride_normal;
+		vaoSurf->vao->attribs[ATTR_INDEX_TANGENT ].stride = stride_tangent;
+
+		if (mdvModel->numFrames > 1)
+		{
+			vaoSurf->vao->attribs[ATTR_INDEX_POSITION2] = vaoSurf->vao->attribs[ATTR_INDEX_POSITION];
+			vaoSurf->vao->attribs[ATTR_INDEX_NORMAL2  ] = vaoSurf->vao->attribs[ATTR_INDEX_NORMAL  ];
+			vaoSurf->vao->attribs[ATTR_INDEX_TANGENT2 ] = vaoSurf->vao->attribs[ATTR_INDEX_TANGENT ];
+
+			vaoSurf->vao->frameSize = stride_xyz    * surf->numVerts;
+		}
+
+		Vao_SetVertexPointers(vaoSurf->vao);
+
+		ri.Free(data);
+	}
+}
+
 /*
 =================
 R_LoadMD3
@@ -664,152 +827,7 @@ static qboolean R_LoadMD3(model_t * mod, int lod, void *buffer, int bufferSize,
 		surf++;
 	}
 
-	{
-		srfVaoMdvMesh_t *vaoSurf;
-
-		mdvModel->numVaoSurfaces = mdvModel->numSurfaces;
-		mdvModel->vaoSurfaces = ri.Hunk_Alloc(sizeof(*mdvModel->vaoSurfaces) * mdvModel->numSurfaces, h_low);
-
-		vaoSurf = mdvModel->vaoSurfaces;
-		surf = mdvModel->surfaces;
-		for (i = 0; i < mdvModel->numSurfaces; i++, vaoSurf++, surf++)
-		{
-			uint32_t offset_xyz, offset_st, offset_normal, offset_tangent;
-			uint32_t stride_xyz, stride_st, stride_normal, stride_tangent;
-			uint32_t dataSize, dataOfs;
-			uint8_t *data;
-
-			if (mdvModel->numFrames > 1)
-			{
-				// vertex animation, store texcoords first, then position/normal/tangents
-				offset_st      = 0;
-				offset_xyz     = surf->numVerts * sizeof(vec2_t);
-				offset_normal  = offset_xyz + sizeof(vec3_t);
-				offset_tangent = offset_normal + sizeof(int16_t) * 4;
-				stride_st  = sizeof(vec2_t);
-				stride_xyz = sizeof(vec3_t) + sizeof(int16_t) * 4;
-				stride_xyz += sizeof(int16_t) * 4;
-				stride_normal = stride_tangent = stride_xyz;
-
-				dataSize = offset_xyz + surf->numVerts * mdvModel->numFrames * stride_xyz;
-			}
-			else
-			{
-				// no animation, interleave everything
-				offset_xyz     = 0;
-				offset_st      = offset_xyz + sizeof(vec3_t);
-				offset_normal  = offset_st + sizeof(vec2_t);
-				offset_tangent = offset_normal + sizeof(int16_t) * 4;
-				stride_xyz = offset_tangent + sizeof(int16_t) * 4;
-				stride_st = stride_normal = stride_tangent = stride_xyz;
-
-				dataSize = surf->numVerts * stride_xyz;
-			}
-
-
-			data = ri.Malloc(dataSize);
-			dataOfs = 0;
-
-			if (mdvModel->numFrames > 1)
-			{
-				st = surf->st;
-				for ( j = 0 ; j < surf->numVerts ; j++, st++ ) {
-					memcpy(data + dataOfs, &st->st, sizeof(vec2_t));
-					dataOfs += sizeof(st->st);
-				}
-
-				v = surf->verts;
-				for ( j = 0; j < surf->numVerts * mdvModel->numFrames ; j++, v++ )
-				{
-					// xyz
-					memcpy(data + dataOfs, &v->xyz, sizeof(vec3_t));
-					dataOfs += sizeof(vec3_t);
-
-					// normal
-					memcpy(data + dataOfs, &v->normal, sizeof(int16_t) * 4);
-					dataOfs += sizeof(int16_t) * 4;
-
-					// tangent
-					memcpy(data + dataOfs, &v->tangent, sizeof(int16_t) * 4);
-					dataOfs += sizeof(int16_t) * 4;
-				}
-			}
-			else
-			{
-				v = surf->verts;
-				st = surf->st;
-				for ( j = 0; j < surf->numVerts; j++, v++, st++ )
-				{
-					// xyz
-					memcpy(data + dataOfs, &v->xyz, sizeof(vec3_t));
-					dataOfs += sizeof(v->xyz);
-
-					// st
-					memcpy(data + dataOfs, &st->st, sizeof(vec2_t));
-					dataOfs += sizeof(st->st);
-
-					// normal
-					memcpy(data + dataOfs, &v->normal, sizeof(int16_t) * 4);
-					dataOfs += sizeof(int16_t) * 4;
-
-					// tangent
-					memcpy(data + dataOfs, &v->tangent, sizeof(int16_t) * 4);
-					dataOfs += sizeof(int16_t) * 4;
-				}
-			}
-
-			vaoSurf->surfaceType = SF_VAO_MDVMESH;
-			vaoSurf->mdvModel = mdvModel;
-			vaoSurf->mdvSurface = surf;
-			vaoSurf->numIndexes = surf->numIndexes;
-			vaoSurf->numVerts = surf->numVerts;
-			
-			vaoSurf->vao = R_CreateVao(va("staticMD3Mesh_VAO '%s'", surf->name), data, dataSize, (byte *)surf->indexes, surf->numIndexes * sizeof(*surf->indexes), VAO_USAGE_STATIC);
-
-			vaoSurf->vao->attribs[ATTR_INDEX_POSITION].enabled = 1;
-			vaoSurf->vao->attribs[ATTR_INDEX_TEXCOORD].enabled = 1;
-			vaoSurf->vao->attribs[ATTR_INDEX_NORMAL  ].enabled = 1;
-			vaoSurf->vao->attribs[ATTR_INDEX_TANGENT ].enabled = 1;
-
-			vaoSurf->vao->attribs[ATTR_INDEX_POSITION].count = 3;
-			vaoSurf->vao->attribs[ATTR_INDEX_TEXCOORD].count = 2;
-			vaoSurf->vao->attribs[ATTR_INDEX_NORMAL  ].count = 4;
-			vaoSurf->vao->attribs[ATTR_INDEX_TANGENT ].count = 4;
-
-			vaoSurf->vao->attribs[ATTR_INDEX_POSITION].type = GL_FLOAT;
-			vaoSurf->vao->attribs[ATTR_INDEX_TEXCOORD].type = GL_FLOAT;
-			vaoSurf->vao->attribs[ATTR_INDEX_NORMAL  ].type = GL_SHORT;
-			vaoSurf->vao->attribs[ATTR_INDEX_TANGENT ].type = GL_SHORT;
-
-			vaoSurf->vao->attribs[ATTR_INDEX_POSITION].normalized = GL_FALSE;
-			vaoSurf->vao->attribs[ATTR_INDEX_TEXCOORD].normalized = GL_FALSE;
-			vaoSurf->vao->attribs[ATTR_INDEX_NORMAL  ].normalized = GL_TRUE;
-			vaoSurf->vao->attribs[ATTR_INDEX_TANGENT ].normalized = GL_TRUE;
-
-			vaoSurf->vao->attribs[ATTR_INDEX_POSITION].offset = offset_xyz;
-			vaoSurf->vao->attribs[ATTR_INDEX_TEXCOORD].offset = offset_st;
-			vaoSurf->vao->attribs[ATTR_INDEX_NORMAL  ].offset = offset_normal;
-			vaoSurf->vao->attribs[ATTR_INDEX_TANGENT ].offset = offset_tangent;
-
-			vaoSurf->vao->attribs[ATTR_INDEX_POSITION].stride = stride_xyz;
-			vaoSurf->vao->attribs[ATTR_INDEX_TEXCOORD].stride = stride_st;
-			vaoSurf->vao->attribs[ATTR_INDEX_NORMAL  ].stride = stride_normal;
-			vaoSurf->vao->attribs[ATTR_INDEX_TANGENT ].stride = stride_tangent;
-
-			if (mdvModel->numFrames > 1)
-			{
-				vaoSurf->vao->attribs[ATTR_INDEX_POSITION2] = vaoSurf->vao->attribs[ATTR_INDEX_POSITION];
-				vaoSurf->vao->attribs[ATTR_INDEX_NORMAL2  ] = vaoSurf->vao->attribs[ATTR_INDEX_NORMAL  ];
-				vaoSurf->vao->attribs[ATTR_INDEX_TANGENT2 ] = vaoSurf->vao->attribs[ATTR_INDEX_TANGENT ];
-
-				vaoSurf->vao->frameSize = stride_xyz    * surf->numVerts;
-			}
-
-			Vao_SetVertexPointers(vaoSurf->vao);
-
-			ri.Free(data);
-		}
-	}
+	R_CreateMDVVaoSurfaces(mdvModel);
 
 	return qtrue;
 }
@@ -1197,6 +1215,8 @@ void R_ModelInit( void ) {
 	// leave a space for NULL model
 	tr.numModels = 0;
 
+	R_ClearIQMPoseCache();
+
 	mod = R_AllocModel();
 	mod->type = MOD_BAD;
 }
@@ -1240,70 +1260,181 @@ void R_Modellist_f( void ) {
 
 /*
 ================
-R_GetTag
+R_GetTagIndex
 ================
 */
-static mdvTag_t *R_GetTag( mdvModel_t *mod, int frame, const char *_tagName ) {
+static int R_GetTagIndex( mdvModel_t *mod, const char *_tagName ) {
 	int             i;
-	mdvTag_t       *tag;
 	mdvTagName_t   *tagName;
 
+	tagName = mod->tagNames;
+	for(i = 0; i < mod->numTags; i++, tagName++)
+	{
+		if(!strcmp(tagName->name, _tagName))
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+static mdvTag_t *R_GetTagByIndex( mdvModel_t *mod, int frame, int index ) {
+	if ( index < 0 || index >= mod->numTags ) {
+		return NULL;
+	}
+
 	if ( frame >= mod->numFrames ) {
 		// it is possible to have a bad frame while changing models, so don't error
 		frame = mod->numFrames - 1;
 	}
 
-	tag = mod->tags + frame * mod->numTags;
-	tagName = mod->tagNames;
-	for(i = 0; i < mod->numTags; i++, tag++, tagName++)
+	return mod->tags + frame * mod->numTags + index;
+}
+
+static int R_GetAnimTagIndex( mdrHeader_t *mod, const char *tagName )
+{
+	int				i;
+	mdrTag_t		*tag;
+
+	tag = (mdrTag_t *)((byte *)mod + mod->ofsTags);
+	for ( i = 0 ; i < mod->numTags ; i++, tag++ )
 	{
-		if(!strcmp(tagName->name, _tagName))
+		if ( !strcmp( tag->name, tagName ) )
 		{
-			return tag;
+			return i;
 		}
 	}
 
-	return NULL;
+	return -1;
 }
 
-mdvTag_t *R_GetAnimTag( mdrHeader_t *mod, int framenum, const char *tagName, mdvTag_t * dest)
+static mdvTag_t *R_GetAnimTagByIndex( mdrHeader_t *mod, int framenum, int index, mdvTag_t * dest)
 {
-	int				i, j, k;
+	int				j, k;
 	int				frameSize;
 	mdrFrame_t		*frame;
 	mdrTag_t		*tag;
 
+	if ( index < 0 || index >= mod->numTags ) {
+		return NULL;
+	}
+
 	if ( framenum >= mod->numFrames ) 
 	{
 		// it is possible to have a bad frame while changing models, so don't error
 		framenum = mod->numFrames - 1;
 	}
 
-	tag = (mdrTag_t *)((byte *)mod + mod->ofsTags);
-	for ( i = 0 ; i < mod->numTags ; i++, tag++ )
+	tag = (mdrTag_t *)((byte *)mod + mod->ofsTags) + index;
+
+	// uncompressed model...
+	//
+	frameSize = (intptr_t)( &((mdrFrame_t *)0)->bones[ mod->numBones ] );
+	frame = (mdrFrame_t *)((byte *)mod + mod->ofsFrames + framenum * frameSize );
+
+	for (j = 0; j < 3; j++)
 	{
-		if ( !strcmp( tag->name, tagName ) )
-		{
-			// uncompressed model...
-			//
-			frameSize = (intptr_t)( &((mdrFrame_t *)0)->bones[ mod->numBones ] );
-			frame = (mdrFrame_t *)((byte *)mod + mod->ofsFrames + framenum * frameSize );
+		for (k = 0; k < 3; k++)
+			dest->axis[j][k]=frame->bones[tag->boneIndex].matrix[k][j];
+	}
 
-			for (j = 0; j < 3; j++)
-			{
-				for (k = 0; k < 3; k++)
-					dest->axis[j][k]=frame->bones[tag->boneIndex].matrix[k][j];
-			}
+	dest->origin[0]=frame->bones[tag->boneIndex].matrix[0][3];
+	dest->origin[1]=frame->bones[tag->boneIndex].matrix[1][3];
+	dest->origin[2]=frame->bones[tag->boneIndex].matrix[2][3];				
+
+	return dest;
+}
 
-			dest->origin[0]=frame->bones[tag->boneIndex].matrix[0][3];
-			dest->origin[1]=frame->bones[tag->boneIndex].matrix[1][3];
-			dest->origin[2]=frame->bones[tag->boneIndex].matrix[2][3];				
+static void R_LerpTagOrientation( orientation_t *tag, const mdvTag_t *start, const mdvTag_t *end, float frac ) {
+	int		i;
+	float		frontLerp, backLerp;
+
+	frontLerp = frac;
+	backLerp = 1.0f - frac;
 
-			return dest;
+	for ( i = 0 ; i < 3 ; i++ ) {
+		tag->origin[i] = start->origin[i] * backLerp +  end->origin[i] * frontLerp;
+		tag->axis[0][i] = start->axis[0][i] * backLerp +  end->axis[0][i] * frontLerp;
+		tag->axis[1][i] = start->axis[1][i] * backLerp +  end->axis[1][i] * frontLerp;
+		tag->axis[2][i] = start->axis[2][i] * backLerp +  end->axis[2][i] * frontLerp;
+	}
+	VectorNormalize( tag->axis[0] );
+	VectorNormalize( tag->axis[1] );
+	VectorNormalize( tag->axis[2] );
+}
+
+/*
+================
+R_TagIndex
+
+Returns the number the model knows the named tag by, for R_LerpTags,
+or -1 if it has no such tag.  The number stays good for as long as
+the model handle does.
+================
+*/
+int R_TagIndex( qhandle_t handle, const char *tagName ) {
+	model_t		*model;
+
+	model = R_GetModelByHandle( handle );
+	if ( model->mdv[0] ) {
+		return R_GetTagIndex( model->mdv[0], tagName );
+	}
+	if ( model->type == MOD_MDR ) {
+		return R_GetAnimTagIndex( (mdrHeader_t *)model->modelData, tagName );
+	}
+	if ( model->type == MOD_IQM ) {
+		return R_IQMTagIndex( model->modelData, tagName );
+	}
+	return -1;
+}
+
+/*
+================
+R_LerpTags
+
+Lerps any number of tags, given by R_TagIndex numbers, between the same
+two frames.  Tags the model doesn't have are cleared.  Returns the number
+of tags found.
+================
+*/
+int R_LerpTags( orientation_t *tags, qhandle_t handle, int startFrame, int endFrame, 
+					 float frac, const int *tagIndexes, int numTags ) {
+	mdvTag_t	*start, *end;
+	mdvTag_t	start_space, end_space;
+	model_t		*model;
+	int		i, found;
+
+	model = R_GetModelByHandle( handle );
+	if ( !model->mdv[0] && model->type == MOD_IQM ) {
+		return R_IQMLerpTags( tags, model->modelData,
+				startFrame, endFrame,
+				frac, tagIndexes, numTags );
+	}
+
+	found = 0;
+	for ( i = 0 ; i < numTags ; i++ ) {
+		if ( model->mdv[0] ) {
+			start = R_GetTagByIndex( model->mdv[0], startFrame, tagIndexes[i] );
+			end = R_GetTagByIndex( model->mdv[0], endFrame, tagIndexes[i] );
+		} else if ( model->type == MOD_MDR ) {
+			start = R_GetAnimTagByIndex( (mdrHeader_t *)model->modelData, startFrame, tagIndexes[i], &start_space );
+			end = R_GetAnimTagByIndex( (mdrHeader_t *)model->modelData, endFrame, tagIndexes[i], &end_space );
+		} else {
+			start = end = NULL;
+		}
+
+		if ( !start || !end ) {
+			AxisClear( tags[i].axis );
+			VectorClear( tags[i].origin );
+			continue;
 		}
+
+		R_LerpTagOrientation( &tags[i], start, end, frac );
+		found++;
 	}
 
-	return NULL;
+	return found;
 }
 
 /*
@@ -1315,8 +1446,6 @@ int R_LerpTag( orientation_t *tag, qhandle_t handle, int startFrame, int endFram
 					 float frac, const char *tagName ) {
 	mdvTag_t	*start, *end;
 	mdvTag_t	start_space, end_space;
-	int		i;
-	float		frontLerp, backLerp;
 	model_t		*model;
 
 	model = R_GetModelByHandle( handle );
@@ -1324,8 +1453,10 @@ int R_LerpTag( orientation_t *tag, qhandle_t handle, int startFrame, int endFram
 	{
 		if(model->type == MOD_MDR)
 		{
-			start = R_GetAnimTag((mdrHeader_t *) model->modelData, startFrame, tagName, &start_space);
-			end = R_GetAnimTag((mdrHeader_t *) model->modelData, endFrame, tagName, &end_space);
+			mdrHeader_t *mdr = (mdrHeader_t *) model->modelData;
+
+			start = R_GetAnimTagByIndex(mdr, startFrame, R_GetAnimTagIndex(mdr, tagName), &start_space);
+			end = R_GetAnimTagByIndex(mdr, endFrame, R_GetAnimTagIndex(mdr, tagName), &end_space);
 		}
 		else if( model->type == MOD_IQM ) {
 			return R_IQMLerpTag( tag, model->modelData,
@@ -1337,8 +1468,10 @@ int R_LerpTag( orientation_t *tag, qhandle_t handle, int startFrame, int endFram
 	}
 	else
 	{
-		start = R_GetTag( model->mdv[0], startFrame, tagName );
-		end = R_GetTag( model->mdv[0], endFrame, tagName );
+		int index = R_GetTagIndex( model->mdv[0], tagName );
+
+		start = R_GetTagByIndex( model->mdv[0], startFrame, index );
+		end = R_GetTagByIndex( model->mdv[0], endFrame, index );
 	}
 
 	if ( !start || !end ) {
@@ -1347,18 +1480,7 @@ int R_LerpTag( orientation_t *tag, qhandle_t handle, int startFrame, int endFram
 		return qfalse;
 	}
 
-	frontLerp = frac;
-	backLerp = 1.0f - frac;
-
-	for ( i = 0 ; i < 3 ; i++ ) {
-		tag->origin[i] = start->origin[i] * backLerp +  end->origin[i] * frontLerp;
-		tag->axis[0][i] = start->axis[0][i] * backLerp +  end->axis[0][i] * frontLerp;
-		tag->axis[1][i] = start->axis[1][i] * backLerp +  end->axis[1][i] * frontLerp;
-		tag->axis[2][i] = start->axis[2][i] * backLerp +  end->axis[2][i] * frontLerp;
-	}
-	VectorNormalize( tag->axis[0] );
-	VectorNormalize( tag->axis[1] );
-	VectorNormalize( tag->axis[2] );
+	R_LerpTagOrientation( tag, start, end, frac );
 	return qtrue;
 }
 
@@ -883,6 +883,10 @@ void R_AddIQMSurfaces( trRefEntity_t *ent ) {
 		return;
 	}
 
+	if ( data->bounds && R_OccludedModel( ent, (vec3_t *)( data->bounds + 6 * ent->e.oldframe ), (vec3_t *)( data->bounds + 6 * ent->e.frame ) ) ) {
+		return;
+	}
+
 	//
 	// set up lighting now that we know we aren't culled
 	//
@@ -987,69 +991,176 @@ static void ComputePoseMats( iqmData_t *data, int frame, int oldframe,
 				
 			} else {
 				InterpolateMatrix( mat1 + 12*i, mat2 + 12*i,
-						   backlerp, mat );
+						   backlerp, mat + 12*i );
 			}
 		}
 	}
 }
 
-static void ComputeJointMats( iqmData_t *data, int frame, int oldframe,
-			      float backlerp, float *mat ) {
-	float	*mat1;
-	int	i;
 
-	ComputePoseMats( data, frame, oldframe, backlerp, mat );
+/*
+=============================================================
+
+POSE CACHE
 
-	for( i = 0; i < data->num_joints; i++ ) {
-		float outmat[12];
-		mat1 = mat + 12 * i;
+A pose is looked up by model, frames and lerp, so every surface of an
+entity and every tag asked of the same pose share one evaluation.  The
+cache is a small two way set associative table that is simply overwritten
+as poses go out of use; it is flushed whenever models are loaded, since
+a new model can take the place of a freed one.
 
-		Com_Memcpy(outmat, mat1, sizeof(outmat));
+=============================================================
+*/
+
+#define	POSE_CACHE_SETS		64		// power of two
+#define	POSE_CACHE_WAYS		2
+
+typedef struct {
+	iqmData_t	*data;
+	int			frame, oldframe;
+	float		backlerp;
+	unsigned	lastUsed;
+	float		mats[IQM_MAX_JOINTS * 12];
+} poseCacheEntry_t;
+
+static poseCacheEntry_t	poseCache[POSE_CACHE_SETS][POSE_CACHE_WAYS];
+static unsigned			poseCacheClock;
+static qboolean			poseCacheDisabled;	// for iqmBench
+static int				poseCacheHits, poseCacheMisses;
+
+/*
+=================
+R_ClearIQMPoseCache
+=================
+*/
+void R_ClearIQMPoseCache( void ) {
+	int		i, j;
 
-		Matrix34Multiply_OnlySetOrigin( outmat, data->jointMats + 12 * i, mat1 );
+	for ( i = 0; i < POSE_CACHE_SETS; i++ ) {
+		for ( j = 0; j < POSE_CACHE_WAYS; j++ ) {
+			poseCache[i][j].data = NULL;
+		}
 	}
 }
 
-
 /*
 =================
-RB_AddIQMSurfaces
+R_IQMPose
 
-Compute vertices for this model surface
+Returns the pose matrices for the frames, evaluating them only if they
+aren't cached.  When the cache is off, scratch is filled and returned.
 =================
 */
-void RB_IQMSurfaceAnim( surfaceType_t *surface ) {
-	srfIQModel_t	*surf = (srfIQModel_t *)surface;
-	iqmData_t	*data = surf->data;
-	float		jointMats[IQM_MAX_JOINTS * 12];
-	int		i;
+static const float *R_IQMPose( iqmData_t *data, int frame, int oldframe, float backlerp, float *scratch ) {
+	poseCacheEntry_t	*set, *entry;
+	unsigned			hash;
+	int					i;
+
+	if ( poseCacheDisabled ) {
+		ComputePoseMats( data, frame, oldframe, backlerp, scratch );
+		return scratch;
+	}
 
-	vec4_t		*outXYZ;
-	int16_t	*outNormal;
-	int16_t	*outTangent;
-	vec2_t		*outTexCoord;
-	uint16_t *outColor;
+	// a lerp of zero or one picks a single frame either way
+	if ( backlerp == 0.0f ) {
+		oldframe = frame;
+	}
 
-	int	frame = data->num_frames ? backEnd.currentEntity->e.frame % data->num_frames : 0;
-	int	oldframe = data->num_frames ? backEnd.currentEntity->e.oldframe % data->num_frames : 0;
-	float	backlerp = backEnd.currentEntity->e.backlerp;
+	hash = (unsigned)( (intptr_t)data >> 4 ) ^ ( frame * 31 ) ^ ( oldframe * 131 );
+	hash ^= (unsigned)( backlerp * 65536.0f );
+	hash ^= hash >> 11;
+	set = poseCache[hash & ( POSE_CACHE_SETS - 1 )];
+
+	entry = &set[0];
+	for ( i = 0; i < POSE_CACHE_WAYS; i++ ) {
+		if ( set[i].data == data && set[i].frame == frame && set[i].oldframe == oldframe && set[i].backlerp == backlerp ) {
+			set[i].lastUsed = ++poseCacheClock;
+			poseCacheHits++;
+			return set[i].mats;
+		}
+		if ( set[i].lastUsed < entry->lastUsed ) {
+			entry = &set[i];
+		}
+	}
 
-	int		*tri;
-	glIndex_t	*ptr;
-	glIndex_t	base;
+	poseCacheMisses++;
+	ComputePoseMats( data, frame, oldframe, backlerp, entry->mats );
+	entry->data = data;
+	entry->frame = frame;
+	entry->oldframe = oldframe;
+	entry->backlerp = backlerp;
+	entry->lastUsed = ++poseCacheClock;
+	return entry->mats;
+}
 
-	RB_CHECKOVERFLOW( surf->num_vertexes, surf->num_triangles * 3 );
 
-	outXYZ = &tess.xyz[tess.numVertexes];
-	outNormal = tess.normal[tess.numVertexes];
-	outTangent = tess.tangent[tess.numVertexes];
-	outTexCoord = &tess.texCoords[tess.numVertexes];
-	outColor = tess.color[tess.numVertexes];
+/*
+=============================================================
 
-	// compute interpolated joint matrices
-	if ( data->num_poses > 0 ) {
-		ComputePoseMats( data, frame, oldframe, backlerp, jointMats );
+SKINNING
+
+=============================================================
+*/
+
+#if defined(__SSE2__) || idx64
+#define idsse2 1
+#include <emmintrin.h>
+#else
+#define idsse2 0
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define idneon 1
+#include <arm_neon.h>
+#else
+#define idneon 0
+#endif
+
+static qboolean	skinScalar;		// for iqmBench
+
+typedef struct {
+	vec4_t		*xyz;
+	int16_t		*normal;
+	int16_t		*tangent;
+	vec2_t		*texCoords;
+	uint16_t	*color;
+} iqmSkinOutput_t;
+
+/*
+=================
+IQM_BlendWeights
+
+Returns the number of joints the vertex is weighted to.
+=================
+*/
+static ID_INLINE int IQM_BlendWeights( iqmData_t *data, int vtx, float *blendWeights ) {
+	int		numWeights;
+
+	for ( numWeights = 0; numWeights < 4; numWeights++ ) {
+		if ( data->blendWeightsType == IQM_FLOAT )
+			blendWeights[numWeights] = data->blendWeights.f[4*vtx + numWeights];
+		else
+			blendWeights[numWeights] = (float)data->blendWeights.b[4*vtx + numWeights] / 255.0f;
+
+		if ( blendWeights[numWeights] <= 0 )
+			break;
 	}
+	return numWeights;
+}
+
+/*
+=================
+IQM_SkinVertexesScalar
+=================
+*/
+static void IQM_SkinVertexesScalar( srfIQModel_t *surf, const float *jointMats, iqmSkinOutput_t *out ) {
+	iqmData_t	*data = surf->data;
+	vec4_t		*outXYZ = out->xyz;
+	int16_t		*outNormal = out->normal;
+	int16_t		*outTangent = out->tangent;
+	vec2_t		*outTexCoord = out->texCoords;
+	uint16_t	*outColor = out->color;
+	int			i;
 
 	// transform vertexes and fill other data
 	for( i = 0; i < surf->num_vertexes;
@@ -1061,15 +1172,7 @@ void RB_IQMSurfaceAnim( surfaceType_t *surface ) {
 		float	blendWeights[4];
 		int		numWeights;
 
-		for ( numWeights = 0; numWeights < 4; numWeights++ ) {
-			if ( data->blendWeightsType == IQM_FLOAT )
-				blendWeights[numWeights] = data->blendWeights.f[4*vtx + numWeights];
-			else
-				blendWeights[numWeights] = (float)data->blendWeights.b[4*vtx + numWeights] / 255.0f;
-
-			if ( blendWeights[numWeights] <= 0 )
-				break;
-		}
+		numWeights = IQM_BlendWeights( data, vtx, blendWeights );
 
 		if ( data->num_poses == 0 || numWeights == 0 ) {
 			// no blend joint, use identity matrix.
@@ -1141,6 +1244,194 @@ void RB_IQMSurfaceAnim( surfaceType_t *surface ) {
 		outColor[2] = data->colors[4*vtx+2] * 257;
 		outColor[3] = data->colors[4*vtx+3] * 257;
 	}
+}
+
+#if idsse2 || idneon
+
+#if idsse2
+typedef __m128 v4f;
+#define	V4Load( p )			_mm_loadu_ps( p )
+#define	V4Store( p, v )		_mm_storeu_ps( p, v )
+#define	V4Splat( x )		_mm_set1_ps( x )
+#define	V4Zero()			_mm_setzero_ps()
+#define	V4Add( a, b )		_mm_add_ps( a, b )
+#define	V4Sub( a, b )		_mm_sub_ps( a, b )
+#define	V4Mul( a, b )		_mm_mul_ps( a, b )
+
+// columns of the 3x4 matrix with rows a, b, c; w is left zero
+static ID_INLINE void V4Columns( v4f a, v4f b, v4f c, v4f *col ) {
+	v4f		d = _mm_setzero_ps();
+
+	_MM_TRANSPOSE4_PS( a, b, c, d );
+	col[0] = a;
+	col[1] = b;
+	col[2] = c;
+	col[3] = d;
+}
+#else
+typedef float32x4_t v4f;
+#define	V4Load( p )			vld1q_f32( p )
+#define	V4Store( p, v )		vst1q_f32( p, v )
+#define	V4Splat( x )		vdupq_n_f32( x )
+#define	V4Zero()			vdupq_n_f32( 0.0f )
+#define	V4Add( a, b )		vaddq_f32( a, b )
+#define	V4Sub( a, b )		vsubq_f32( a, b )
+#define	V4Mul( a, b )		vmulq_f32( a, b )
+
+// columns of the 3x4 matrix with rows a, b, c; w is left zero
+static ID_INLINE void V4Columns( v4f a, v4f b, v4f c, v4f *col ) {
+	float32x4x2_t	ab = vtrnq_f32( a, b );
+	float32x4x2_t	cd = vtrnq_f32( c, vdupq_n_f32( 0.0f ) );
+
+	col[0] = vcombine_f32( vget_low_f32( ab.val[0] ), vget_low_f32( cd.val[0] ) );
+	col[1] = vcombine_f32( vget_low_f32( ab.val[1] ), vget_low_f32( cd.val[1] ) );
+	col[2] = vcombine_f32( vget_high_f32( ab.val[0] ), vget_high_f32( cd.val[0] ) );
+	col[3] = vcombine_f32( vget_high_f32( ab.val[1] ), vget_high_f32( cd.val[1] ) );
+}
+#endif
+
+/*
+=================
+IQM_SkinVertexesVector
+
+Four lanes at a time, one vertex a loop.  Every sum is taken in the same
+order as the scalar loop, so the results match it bit for bit: the
+position is built from the matrix columns, and the normal matrix columns
+come out of cross products of columns taken with their rows rotated.
+=================
+*/
+static void IQM_SkinVertexesVector( srfIQModel_t *surf, const float *jointMats, iqmSkinOutput_t *out ) {
+	iqmData_t	*data = surf->data;
+	vec4_t		*outXYZ = out->xyz;
+	int16_t		*outNormal = out->normal;
+	int16_t		*outTangent = out->tangent;
+	vec2_t		*outTexCoord = out->texCoords;
+	uint16_t	*outColor = out->color;
+	int			i;
+
+	for( i = 0; i < surf->num_vertexes;
+	     i++, outXYZ++, outNormal+=4, outTangent+=4, outTexCoord++, outColor+=4 ) {
+		int			j;
+		int			vtx = i + surf->first_vertex;
+		float		blendWeights[4];
+		int			numWeights;
+		v4f			row[3], w;
+		v4f			col[4], colYZX[4], colZXY[4];
+		v4f			nrmA, nrmB, nrmC, v;
+		const float	*m, *in;
+		vec4_t		result;
+
+		numWeights = IQM_BlendWeights( data, vtx, blendWeights );
+
+		if ( data->num_poses == 0 || numWeights == 0 ) {
+			row[0] = V4Load( identityMatrix + 0 );
+			row[1] = V4Load( identityMatrix + 4 );
+			row[2] = V4Load( identityMatrix + 8 );
+		} else {
+			row[0] = row[1] = row[2] = V4Zero();
+			for( j = 0; j < numWeights; j++ ) {
+				m = jointMats + 12*data->blendIndexes[4*vtx + j];
+				w = V4Splat( blendWeights[j] );
+				row[0] = V4Add( row[0], V4Mul( w, V4Load( m + 0 ) ) );
+				row[1] = V4Add( row[1], V4Mul( w, V4Load( m + 4 ) ) );
+				row[2] = V4Add( row[2], V4Mul( w, V4Load( m + 8 ) ) );
+			}
+		}
+
+		V4Columns( row[0], row[1], row[2], col );
+		V4Columns( row[1], row[2], row[0], colYZX );
+		V4Columns( row[2], row[0], row[1], colZXY );
+
+		// columns of the normal matrix
+		nrmA = V4Sub( V4Mul( colYZX[1], colZXY[2] ), V4Mul( colZXY[1], colYZX[2] ) );
+		nrmB = V4Sub( V4Mul( colYZX[2], colZXY[0] ), V4Mul( colZXY[2], colYZX[0] ) );
+		nrmC = V4Sub( V4Mul( colYZX[0], colZXY[1] ), V4Mul( colZXY[0], colYZX[1] ) );
+
+		(*outTexCoord)[0] = data->texcoords[2*vtx + 0];
+		(*outTexCoord)[1] = data->texcoords[2*vtx + 1];
+
+		in = &data->positions[3*vtx];
+		v = V4Add( V4Mul( col[0], V4Splat( in[0] ) ), V4Mul( col[1], V4Splat( in[1] ) ) );
+		v = V4Add( v, V4Mul( col[2], V4Splat( in[2] ) ) );
+		v = V4Add( v, col[3] );
+		V4Store( *outXYZ, v );
+		(*outXYZ)[3] = 1.0f;
+
+		in = &data->normals[3*vtx];
+		v = V4Add( V4Mul( nrmA, V4Splat( in[0] ) ), V4Mul( nrmB, V4Splat( in[1] ) ) );
+		v = V4Add( v, V4Mul( nrmC, V4Splat( in[2] ) ) );
+		V4Store( result, v );
+		R_VaoPackNormal( outNormal, result );
+
+		in = &data->tangents[4*vtx];
+		v = V4Add( V4Mul( nrmA, V4Splat( in[0] ) ), V4Mul( nrmB, V4Splat( in[1] ) ) );
+		v = V4Add( v, V4Mul( nrmC, V4Splat( in[2] ) ) );
+		V4Store( result, v );
+		result[3] = in[3];
+		R_VaoPackTangent( outTangent, result );
+
+		outColor[0] = data->colors[4*vtx+0] * 257;
+		outColor[1] = data->colors[4*vtx+1] * 257;
+		outColor[2] = data->colors[4*vtx+2] * 257;
+		outColor[3] = data->colors[4*vtx+3] * 257;
+	}
+}
+#endif
+
+/*
+=================
+IQM_SkinVertexes
+=================
+*/
+static void IQM_SkinVertexes( srfIQModel_t *surf, const float *jointMats, iqmSkinOutput_t *out ) {
+#if idsse2 || idneon
+	if ( !skinScalar ) {
+		IQM_SkinVertexesVector( surf, jointMats, out );
+		return;
+	}
+#endif
+	IQM_SkinVertexesScalar( surf, jointMats, out );
+}
+
+
+/*
+=================
+RB_AddIQMSurfaces
+
+Compute vertices for this model surface
+=================
+*/
+void RB_IQMSurfaceAnim( surfaceType_t *surface ) {
+	srfIQModel_t	*surf = (srfIQModel_t *)surface;
+	iqmData_t	*data = surf->data;
+	float		scratch[IQM_MAX_JOINTS * 12];
+	const float	*jointMats;
+	int		i;
+	iqmSkinOutput_t	out;
+
+	int	frame = data->num_frames ? backEnd.currentEntity->e.frame % data->num_frames : 0;
+	int	oldframe = data->num_frames ? backEnd.currentEntity->e.oldframe % data->num_frames : 0;
+	float	backlerp = backEnd.currentEntity->e.backlerp;
+
+	int		*tri;
+	glIndex_t	*ptr;
+	glIndex_t	base;
+
+	RB_CHECKOVERFLOW( surf->num_vertexes, surf->num_triangles * 3 );
+
+	out.xyz = &tess.xyz[tess.numVertexes];
+	out.normal = tess.normal[tess.numVertexes];
+	out.tangent = tess.tangent[tess.numVertexes];
+	out.texCoords = &tess.texCoords[tess.numVertexes];
+	out.color = tess.color[tess.numVertexes];
+
+	// interpolated joint matrices, shared with the entity's other surfaces
+	jointMats = NULL;
+	if ( data->num_poses > 0 ) {
+		jointMats = R_IQMPose( data, frame, oldframe, backlerp, scratch );
+	}
+
+	IQM_SkinVertexes( surf, jointMats, &out );
 
 	tri = data->triangles + 3 * surf->first_triangle;
 	ptr = &tess.indexes[tess.numIndexes];
@@ -1156,39 +1447,293 @@ void RB_IQMSurfaceAnim( surfaceType_t *surface ) {
 	tess.numVertexes += surf->num_vertexes;
 }
 
-int R_IQMLerpTag( orientation_t *tag, iqmData_t *data,
-		  int startFrame, int endFrame, 
-		  float frac, const char *tagName ) {
-	float	jointMats[IQM_MAX_JOINTS * 12];
+/*
+=================
+R_IQMTagIndex
+
+Joint number of the named tag, or -1.
+=================
+*/
+int R_IQMTagIndex( iqmData_t *data, const char *tagName ) {
 	int	joint;
 	char	*names = data->names;
 
 	// get joint number by reading the joint names
 	for( joint = 0; joint < data->num_joints; joint++ ) {
 		if( !strcmp( tagName, names ) )
-			break;
+			return joint;
 		names += strlen( names ) + 1;
 	}
-	if( joint >= data->num_joints ) {
-		AxisClear( tag->axis );
-		VectorClear( tag->origin );
-		return qfalse;
+	return -1;
+}
+
+static void R_IQMJointTag( orientation_t *tag, iqmData_t *data, const float *poseMats, int joint ) {
+	float	jointMat[12];
+
+	// only the one joint is needed out of the pose
+	Com_Memcpy( jointMat, poseMats + 12 * joint, sizeof( jointMat ) );
+	Matrix34Multiply_OnlySetOrigin( (float *)poseMats + 12 * joint, data->jointMats + 12 * joint, jointMat );
+
+	tag->axis[0][0] = jointMat[0];
+	tag->axis[1][0] = jointMat[1];
+	tag->axis[2][0] = jointMat[2];
+	tag->origin[0] = jointMat[3];
+	tag->axis[0][1] = jointMat[4];
+	tag->axis[1][1] = jointMat[5];
+	tag->axis[2][1] = jointMat[6];
+	tag->origin[1] = jointMat[7];
+	tag->axis[0][2] = jointMat[8];
+	tag->axis[1][2] = jointMat[9];
+	tag->axis[2][2] = jointMat[10];
+	tag->origin[2] = jointMat[11];
+}
+
+int R_IQMLerpTag( orientation_t *tag, iqmData_t *data,
+		  int startFrame, int endFrame, 
+		  float frac, const char *tagName ) {
+	int	joint;
+
+	joint = R_IQMTagIndex( data, tagName );
+	return R_IQMLerpTags( tag, data, startFrame, endFrame, frac, &joint, 1 );
+}
+
+/*
+=================
+R_IQMLerpTags
+
+All the tags come off the one pose, which is evaluated once.
+=================
+*/
+int R_IQMLerpTags( orientation_t *tags, iqmData_t *data,
+		  int startFrame, int endFrame, 
+		  float frac, const int *tagIndexes, int numTags ) {
+	float	scratch[IQM_MAX_JOINTS * 12];
+	const float	*poseMats;
+	int	i, found;
+
+	if ( data->num_frames ) {
+		startFrame %= data->num_frames;
+		endFrame %= data->num_frames;
+	}
+
+	poseMats = NULL;
+	found = 0;
+	for ( i = 0; i < numTags; i++ ) {
+		if ( tagIndexes[i] < 0 || tagIndexes[i] >= data->num_joints ) {
+			AxisClear( tags[i].axis );
+			VectorClear( tags[i].origin );
+			continue;
+		}
+		if ( !poseMats ) {
+			poseMats = R_IQMPose( data, startFrame, endFrame, frac, scratch );
+		}
+		R_IQMJointTag( &tags[i], data, poseMats, tagIndexes[i] );
+		found++;
 	}
 
-	ComputeJointMats( data, startFrame, endFrame, frac, jointMats );
+	return found;
+}
 
-	tag->axis[0][0] = jointMats[12 * joint + 0];
-	tag->axis[1][0] = jointMats[12 * joint + 1];
-	tag->axis[2][0] = jointMats[12 * joint + 2];
-	tag->origin[0] = jointMats[12 * joint + 3];
-	tag->axis[0][1] = jointMats[12 * joint + 4];
-	tag->axis[1][1] = jointMats[12 * joint + 5];
-	tag->axis[2][1] = jointMats[12 * joint + 6];
-	tag->origin[1] = jointMats[12 * joint + 7];
-	tag->axis[0][2] = jointMats[12 * joint + 8];
-	tag->axis[1][2] = jointMats[12 * joint + 9];
-	tag->axis[2][2] = jointMats[12 * joint + 10];
-	tag->origin[2] = jointMats[12 * joint + 11];
 
-	return qtrue;
+/*
+=============================================================
+
+BENCHMARK
+
+=============================================================
+*/
+
+#define	IQMBENCH_TAGS		48		// a player's aura tags
+
+typedef struct {
+	vec4_t		*xyz;
+	int16_t		*normal;
+	int16_t		*tangent;
+	vec2_t		*texCoords;
+	uint16_t	*color;
+} iqmBenchBuffer_t;
+
+static void R_IQMBenchAlloc( iqmBenchBuffer_t *buf, int numVerts ) {
+	buf->xyz = ri.Hunk_AllocateTempMemory( numVerts * sizeof( *buf->xyz ) );
+	buf->normal = ri.Hunk_AllocateTempMemory( numVerts * 4 * sizeof( *buf->normal ) );
+	buf->tangent = ri.Hunk_AllocateTempMemory( numVerts * 4 * sizeof( *buf->tangent ) );
+	buf->texCoords = ri.Hunk_AllocateTempMemory( numVerts * sizeof( *buf->texCoords ) );
+	buf->color = ri.Hunk_AllocateTempMemory( numVerts * 4 * sizeof( *buf->color ) );
+}
+
+static void R_IQMBenchFree( iqmBenchBuffer_t *buf ) {
+	// temp memory comes back in the reverse order
+	ri.Hunk_FreeTempMemory( buf->color );
+	ri.Hunk_FreeTempMemory( buf->texCoords );
+	ri.Hunk_FreeTempMemory( buf->tangent );
+	ri.Hunk_FreeTempMemory( buf->normal );
+	ri.Hunk_FreeTempMemory( buf->xyz );
+}
+
+static qboolean R_IQMBenchSame( iqmBenchBuffer_t *a, iqmBenchBuffer_t *b, int numVerts ) {
+	return !memcmp( a->xyz, b->xyz, numVerts * sizeof( *a->xyz ) )
+		&& !memcmp( a->normal, b->normal, numVerts * 4 * sizeof( *a->normal ) )
+		&& !memcmp( a->tangent, b->tangent, numVerts * 4 * sizeof( *a->tangent ) )
+		&& !memcmp( a->texCoords, b->texCoords, numVerts * sizeof( *a->texCoords ) )
+		&& !memcmp( a->color, b->color, numVerts * 4 * sizeof( *a->color ) );
+}
+
+/*
+=================
+R_IQMBenchFrame
+
+One entity's worth of work on the model: every surface skinned from the
+pose, if there is a buffer to skin into, and the tags looked up.
+=================
+*/
+static void R_IQMBenchFrame( iqmData_t *data, int frame, const char **tags, iqmBenchBuffer_t *buf ) {
+	float			scratch[IQM_MAX_JOINTS * 12];
+	const float		*jointMats;
+	orientation_t	tag;
+	iqmSkinOutput_t	out;
+	srfIQModel_t	*surf;
+	int				f, oldf;
+	float			backlerp;
+	int				i;
+
+	f = data->num_frames ? frame % data->num_frames : 0;
+	oldf = data->num_frames ? ( frame + 1 ) % data->num_frames : 0;
+	backlerp = ( frame % 8 ) / 8.0f;
+
+	for ( i = 0, surf = data->surfaces; i < data->num_surfaces; i++, surf++ ) {
+		jointMats = NULL;
+		if ( data->num_poses > 0 ) {
+			jointMats = R_IQMPose( data, f, oldf, backlerp, scratch );
+		}
+		if ( !buf ) {
+			continue;
+		}
+		out.xyz = buf->xyz + surf->first_vertex;
+		out.normal = buf->normal + 4 * surf->first_vertex;
+		out.tangent = buf->tangent + 4 * surf->first_vertex;
+		out.texCoords = buf->texCoords + surf->first_vertex;
+		out.color = buf->color + 4 * surf->first_vertex;
+		IQM_SkinVertexes( surf, jointMats, &out );
+	}
+
+	for ( i = 0; i < IQMBENCH_TAGS; i++ ) {
+		R_IQMLerpTag( &tag, data, f, oldf, backlerp, tags[i] );
+	}
+}
+
+/*
+=================
+R_IQMBench_f
+
+iqmBench <model> [frames]
+
+Times the pose evaluation a player's model costs each frame, with every
+surface and 48 tag lookups evaluating it again and then through the pose
+cache, and times skinning with the scalar and vector code, checking that
+the two agree.  Nothing is drawn.
+=================
+*/
+void R_IQMBench_f( void ) {
+	model_t				*model;
+	iqmData_t			*data;
+	const char			*tags[IQMBENCH_TAGS];
+	char				*names;
+	iqmBenchBuffer_t	scalarBuf, vectorBuf;
+	int					numFrames, frame, i, start;
+	int					msec[4];
+	qboolean			same;
+
+	if ( ri.Cmd_Argc() < 2 ) {
+		ri.Printf( PRINT_ALL, "usage: iqmBench <model> [frames]\n" );
+		return;
+	}
+
+	model = R_GetModelByHandle( RE_RegisterModel( ri.Cmd_Argv( 1 ) ) );
+	if ( model->type != MOD_IQM ) {
+		ri.Printf( PRINT_ALL, "iqmBench: %s is not an IQM model\n", ri.Cmd_Argv( 1 ) );
+		return;
+	}
+	data = model->modelData;
+
+	numFrames = ri.Cmd_Argc() > 2 ? atoi( ri.Cmd_Argv( 2 ) ) : 1000;
+	if ( numFrames < 1 ) {
+		numFrames = 1;
+	}
+
+	// cycle through the joints for the tags, missing ones cost a lookup too
+	names = data->names;
+	for ( i = 0; i < IQMBENCH_TAGS; i++ ) {
+		if ( !data->num_joints ) {
+			tags[i] = "tag_none";
+			continue;
+		}
+		if ( i % data->num_joints == 0 ) {
+			names = data->names;
+		}
+		tags[i] = names;
+		names += strlen( names ) + 1;
+	}
+
+	// poses, every lookup evaluating it and then the cache
+	for ( i = 0; i < 2; i++ ) {
+		poseCacheDisabled = ( i == 0 );
+		R_ClearIQMPoseCache();
+		poseCacheHits = poseCacheMisses = 0;
+		start = ri.Milliseconds();
+		for ( frame = 0; frame < numFrames; frame++ ) {
+			R_IQMBenchFrame( data, frame, tags, NULL );
+		}
+		msec[i] = ri.Milliseconds() - start;
+	}
+	poseCacheDisabled = qfalse;
+
+	ri.Printf( PRINT_ALL, "%s: %i surfaces, %i joints, %i vertexes, %i frames\n", model->name,
+		data->num_surfaces, data->num_joints, data->num_vertexes, numFrames );
+	ri.Printf( PRINT_ALL, "poses, %i surfaces + %i tags a frame:\n", data->num_surfaces, IQMBENCH_TAGS );
+	ri.Printf( PRINT_ALL, "  uncached:   %8.4f msec a frame\n", (float)msec[0] / numFrames );
+	ri.Printf( PRINT_ALL, "  cached:     %8.4f msec a frame, %i evaluations for %i lookups\n",
+		(float)msec[1] / numFrames, poseCacheMisses, poseCacheHits + poseCacheMisses );
+
+	if ( !data->num_vertexes ) {
+		return;
+	}
+
+	R_IQMBenchAlloc( &scalarBuf, data->num_vertexes );
+	R_IQMBenchAlloc( &vectorBuf, data->num_vertexes );
+
+	// skinning, through the cache
+	for ( i = 0; i < 2; i++ ) {
+		skinScalar = ( i == 0 );
+		R_ClearIQMPoseCache();
+		start = ri.Milliseconds();
+		for ( frame = 0; frame < numFrames; frame++ ) {
+			R_IQMBenchFrame( data, frame, tags, skinScalar ? &scalarBuf : &vectorBuf );
+		}
+		msec[2 + i] = ri.Milliseconds() - start;
+	}
+
+	// the same frames through both
+	same = qtrue;
+	for ( frame = 0; frame < 64 && same; frame++ ) {
+		skinScalar = qtrue;
+		R_IQMBenchFrame( data, frame, tags, &scalarBuf );
+		skinScalar = qfalse;
+		R_IQMBenchFrame( data, frame, tags, &vectorBuf );
+		same = R_IQMBenchSame( &scalarBuf, &vectorBuf, data->num_vertexes );
+	}
+	skinScalar = qfalse;
+
+	R_IQMBenchFree( &vectorBuf );
+	R_IQMBenchFree( &scalarBuf );
+
+	ri.Printf( PRINT_ALL, "skinning and tags:\n" );
+	ri.Printf( PRINT_ALL, "  scalar:     %8.4f msec a frame\n", (float)msec[2] / numFrames );
+#if idsse2 || idneon
+	ri.Printf( PRINT_ALL, "  vector:     %8.4f msec a frame\n", (float)msec[3] / numFrames );
+	if ( !same ) {
+		ri.Printf( PRINT_ALL, S_COLOR_RED "scalar and vector skinning produced different vertexes at frame %i\n", frame - 1 );
+	}
+#else
+	ri.Printf( PRINT_ALL, "  (no vector skinning on this platform)\n" );
+#endif
 }
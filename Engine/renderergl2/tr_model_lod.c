@@ -0,0 +1,714 @@
+/*
+===========================================================================
+Copyright (C) 1999-2005 Id Software, Inc.
+
+This file is part of Quake III Arena source code.
+
+Quake III Arena source code is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of the License,
+or (at your option) any later version.
+
+Quake III Arena source code is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Quake III Arena source code; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+===========================================================================
+*/
+// tr_model_lod.c -- levels of detail for MD3 models that come without them
+
+#include "tr_local.h"
+
+/*
+=============================================================
+
+MD3 LEVELS OF DETAIL
+
+An MD3 model that comes with only its full detail file gets up to
+r_md3Lods more levels made from it when it is loaded, each with about
+half the triangles of the one before.  R_ComputeLOD picks between them
+by the projected size of the model, as it does for models that come
+with their own.
+
+Vertexes are collapsed into one of their neighbours, cheapest first.  The
+cost is the squared distance of the neighbour from the planes of the
+triangles around the vertex, summed over a few frames spread through
+the animation.  Nothing is moved, so every frame of the vertexes that are
+left still holds.  Vertexes on an open edge, which takes in every
+texture seam, are never collapsed, and neither are ones that would turn
+a triangle over in any of those frames or pinch the mesh.
+
+=============================================================
+*/
+
+#define	LOD_SAMPLE_FRAMES	4		// frames the cost is measured in
+#define	LOD_KEEP			0.5f	// of the triangles of the level before
+#define	LOD_MIN_TRIANGLES	12		// no surface is taken below this
+#define	LOD_MIN_SAVING		0.9f	// a level has to get under this much of the one before
+#define	LOD_MIN_COS			0.2f	// how far a triangle may turn in a collapse
+
+typedef struct {
+	double		a2, ab, ac, ad, b2, bc, bd, c2, cd, d2;
+} lodQuadric_t;
+
+typedef struct {
+	double		cost;
+	int			v;
+	int			version;		// of the vertex when it was pushed
+} lodCandidate_t;
+
+typedef struct {
+	const mdvSurface_t	*surf;
+	int					numSamples;
+	int					samples[LOD_SAMPLE_FRAMES];
+
+	int					numTris;
+	int					numLiveTris;
+	int					*tris;			// collapsed vertexes are replaced as they go
+	byte				*triDead;
+
+	int					*refFirst;		// per vertex, the triangles it is in,
+	int					*refNext;		// which may include dead ones
+	int					*refTri;
+
+	lodQuadric_t		*quadrics;		// numSamples for each vertex
+	double				*cost;
+	int					*target;		// -1 if the vertex can't be collapsed
+	byte				*locked;
+	int					*stamp;
+	int					stampCount;
+	int					*touched;
+
+	int					*version;		// per vertex, bumped each time its cost is found
+	lodCandidate_t		*heap;			// cheapest first, entries from an old
+	int					numHeap;		// version are skipped when they come up
+	int					maxHeap;
+} lodMesh_t;
+
+typedef struct {
+	int			numIndexes;
+	glIndex_t	*indexes;				// into the full detail surface
+} lodSurface_t;
+
+#define	LodPos( m, s, v )	( (m)->surf->verts[(m)->samples[s] * (m)->surf->numVerts + (v)].xyz )
+
+static void LodAddPlane( lodQuadric_t *q, const vec3_t n, double d, double w ) {
+	q->a2 += w * n[0] * n[0];
+	q->ab += w * n[0] * n[1];
+	q->ac += w * n[0] * n[2];
+	q->ad += w * n[0] * d;
+	q->b2 += w * n[1] * n[1];
+	q->bc += w * n[1] * n[2];
+	q->bd += w * n[1] * d;
+	q->c2 += w * n[2] * n[2];
+	q->cd += w * n[2] * d;
+	q->d2 += w * d * d;
+}
+
+static void LodAddQuadric( lodQuadric_t *q, const lodQuadric_t *add ) {
+	q->a2 += add->a2;
+	q->ab += add->ab;
+	q->ac += add->ac;
+	q->ad += add->ad;
+	q->b2 += add->b2;
+	q->bc += add->bc;
+	q->bd += add->bd;
+	q->c2 += add->c2;
+	q->cd += add->cd;
+	q->d2 += add->d2;
+}
+
+static double LodQuadricError( const lodQuadric_t *q, const float *p ) {
+	double	x = p[0], y = p[1], z = p[2];
+
+	return q->a2 * x * x + 2 * q->ab * x * y + 2 * q->ac * x * z + 2 * q->ad * x
+		+ q->b2 * y * y + 2 * q->bc * y * z + 2 * q->bd * y
+		+ q->c2 * z * z + 2 * q->cd * z
+		+ q->d2;
+}
+
+static void LodTriangleNormal( const float *p0, const float *p1, const float *p2, vec3_t n ) {
+	vec3_t	e1, e2;
+
+	VectorSubtract( p1, p0, e1 );
+	VectorSubtract( p2, p0, e2 );
+	CrossProduct( e2, e1, n );
+}
+
+/*
+=================
+LodCollapseCost
+
+What collapsing v into u costs, or -1 if it would turn a triangle over.
+=================
+*/
+static double LodCollapseCost( lodMesh_t *m, int v, int u ) {
+	const int	*tri;
+	const float	*p[3];
+	vec3_t		n0, n1;
+	double		error;
+	float		len0, len1;
+	int			r, s, k;
+
+	for ( r = m->refFirst[v]; r >= 0; r = m->refNext[r] ) {
+		if ( m->triDead[m->refTri[r]] ) {
+			continue;
+		}
+		tri = m->tris + m->refTri[r] * 3;
+		if ( tri[0] == u || tri[1] == u || tri[2] == u ) {
+			// goes away
+			continue;
+		}
+		for ( s = 0; s < m->numSamples; s++ ) {
+			for ( k = 0; k < 3; k++ ) {
+				p[k] = LodPos( m, s, tri[k] );
+			}
+			LodTriangleNormal( p[0], p[1], p[2], n0 );
+			for ( k = 0; k < 3; k++ ) {
+				if ( tri[k] == v ) {
+					p[k] = LodPos( m, s, u );
+				}
+			}
+			LodTriangleNormal( p[0], p[1], p[2], n1 );
+
+			len0 = VectorLength( n0 );
+			len1 = VectorLength( n1 );
+			if ( len0 > 0 && DotProduct( n0, n1 ) <= LOD_MIN_COS * len0 * len1 ) {
+				return -1;
+			}
+		}
+	}
+
+	error = 0;
+	for ( s = 0; s < m->numSamples; s++ ) {
+		error += LodQuadricError( &m->quadrics[v * m->numSamples + s], LodPos( m, s, u ) );
+	}
+	return error;
+}
+
+/*
+=================
+LodKeepsManifold
+
+Collapsing v into u mustn't join two parts of the mesh that only touch
+through the edge between them.  The neighbours the two share have to be
+just the ones across that edge.
+=================
+*/
+static qboolean LodKeepsManifold( lodMesh_t *m, int v, int u ) {
+	const int	*tri;
+	int			mark, shared, common;
+	int			r, k, w;
+
+	mark = ++m->stampCount;
+	m->stampCount++;
+
+	shared = 0;
+	for ( r = m->refFirst[v]; r >= 0; r = m->refNext[r] ) {
+		if ( m->triDead[m->refTri[r]] ) {
+			continue;
+		}
+		tri = m->tris + m->refTri[r] * 3;
+		if ( tri[0] == u || tri[1] == u || tri[2] == u ) {
+			shared++;
+		}
+		for ( k = 0; k < 3; k++ ) {
+			m->stamp[tri[k]] = mark;
+		}
+	}
+
+	common = 0;
+	for ( r = m->refFirst[u]; r >= 0; r = m->refNext[r] ) {
+		if ( m->triDead[m->refTri[r]] ) {
+			continue;
+		}
+		tri = m->tris + m->refTri[r] * 3;
+		for ( k = 0; k < 3; k++ ) {
+			w = tri[k];
+			if ( w != u && w != v && m->stamp[w] == mark ) {
+				m->stamp[w] = mark + 1;
+				common++;
+			}
+		}
+	}
+
+	return common <= shared;
+}
+
+/*
+=================
+LodHeapPush
+=================
+*/
+static void LodHeapPush( lodMesh_t *m, int v ) {
+	lodCandidate_t	*heap, c;
+	int				i, parent;
+
+	if ( m->numHeap == m->maxHeap ) {
+		heap = ri.Malloc( sizeof( *heap ) * m->maxHeap * 2 );
+		Com_Memcpy( heap, m->heap, sizeof( *heap ) * m->numHeap );
+		ri.Free( m->heap );
+		m->heap = heap;
+		m->maxHeap *= 2;
+	}
+
+	c.cost = m->cost[v];
+	c.v = v;
+	c.version = m->version[v];
+
+	for ( i = m->numHeap++; i > 0; i = parent ) {
+		parent = ( i - 1 ) / 2;
+		if ( m->heap[parent].cost <= c.cost ) {
+			break;
+		}
+		m->heap[i] = m->heap[parent];
+	}
+	m->heap[i] = c;
+}
+
+/*
+=================
+LodHeapPop
+
+Takes the cheapest candidate off the heap, qfalse when it is empty.
+=================
+*/
+static qboolean LodHeapPop( lodMesh_t *m, lodCandidate_t *out ) {
+	lodCandidate_t	last;
+	int				i, child;
+
+	if ( !m->numHeap ) {
+		return qfalse;
+	}
+
+	*out = m->heap[0];
+	last = m->heap[--m->numHeap];
+	for ( i = 0; ( child = i * 2 + 1 ) < m->numHeap; i = child ) {
+		if ( child + 1 < m->numHeap && m->heap[child + 1].cost < m->heap[child].cost ) {
+			child++;
+		}
+		if ( last.cost <= m->heap[child].cost ) {
+			break;
+		}
+		m->heap[i] = m->heap[child];
+	}
+	m->heap[i] = last;
+
+	return qtrue;
+}
+
+/*
+=================
+LodVertexCost
+
+Finds the cheapest neighbour to collapse v into, and queues the
+collapse.  Anything queued for v before is stale from here on.
+=================
+*/
+static void LodVertexCost( lodMesh_t *m, int v ) {
+	const int	*tri;
+	double		cost;
+	int			r, k, u;
+
+	m->version[v]++;
+	m->target[v] = -1;
+	if ( m->locked[v] ) {
+		return;
+	}
+
+	for ( r = m->refFirst[v]; r >= 0; r = m->refNext[r] ) {
+		if ( m->triDead[m->refTri[r]] ) {
+			continue;
+		}
+		tri = m->tris + m->refTri[r] * 3;
+		for ( k = 0; k < 3; k++ ) {
+			u = tri[k];
+			if ( u == v || u == m->target[v] ) {
+				continue;
+			}
+			cost = LodCollapseCost( m, v, u );
+			if ( cost < 0 || ( m->target[v] >= 0 && cost >= m->cost[v] ) ) {
+				continue;
+			}
+			if ( !LodKeepsManifold( m, v, u ) ) {
+				continue;
+			}
+			m->target[v] = u;
+			m->cost[v] = cost;
+		}
+	}
+
+	if ( m->target[v] >= 0 ) {
+		LodHeapPush( m, v );
+	}
+}
+
+/*
+=================
+LodCollapse
+=================
+*/
+static void LodCollapse( lodMesh_t *m, int v, int u ) {
+	int		*tri;
+	int		r, next, t, k, s;
+	int		numTouched;
+
+	for ( r = m->refFirst[v]; r >= 0; r = next ) {
+		next = m->refNext[r];
+		t = m->refTri[r];
+		if ( m->triDead[t] ) {
+			continue;
+		}
+		tri = m->tris + t * 3;
+		if ( tri[0] == u || tri[1] == u || tri[2] == u ) {
+			m->triDead[t] = 1;
+			m->numLiveTris--;
+			continue;
+		}
+		for ( k = 0; k < 3; k++ ) {
+			if ( tri[k] == v ) {
+				tri[k] = u;
+			}
+		}
+		m->refNext[r] = m->refFirst[u];
+		m->refFirst[u] = r;
+	}
+	m->refFirst[v] = -1;
+	m->target[v] = -1;
+	m->locked[v] = 1;
+
+	for ( s = 0; s < m->numSamples; s++ ) {
+		LodAddQuadric( &m->quadrics[u * m->numSamples + s], &m->quadrics[v * m->numSamples + s] );
+	}
+
+	// everything around u can have a different best collapse now,
+	// including anything that was going to collapse into v
+	m->stampCount++;
+	numTouched = 0;
+	m->stamp[u] = m->stampCount;
+	m->touched[numTouched++] = u;
+	for ( r = m->refFirst[u]; r >= 0; r = m->refNext[r] ) {
+		if ( m->triDead[m->refTri[r]] ) {
+			continue;
+		}
+		tri = m->tris + m->refTri[r] * 3;
+		for ( k = 0; k < 3; k++ ) {
+			if ( m->stamp[tri[k]] != m->stampCount ) {
+				m->stamp[tri[k]] = m->stampCount;
+				m->touched[numTouched++] = tri[k];
+			}
+		}
+	}
+	for ( k = 0; k < numTouched; k++ ) {
+		LodVertexCost( m, m->touched[k] );
+	}
+}
+
+/*
+=================
+LodInitMesh
+=================
+*/
+static void LodInitMesh( lodMesh_t *m, const mdvSurface_t *surf, int numFrames ) {
+	const int	*tri;
+	const float	*p[3];
+	vec3_t		n;
+	float		area;
+	int			numVerts;
+	int			t, v, s, k, r, r2, w, count;
+
+	Com_Memset( m, 0, sizeof( *m ) );
+	m->surf = surf;
+	numVerts = surf->numVerts;
+
+	if ( numFrames <= LOD_SAMPLE_FRAMES ) {
+		m->numSamples = numFrames;
+		for ( s = 0; s < numFrames; s++ ) {
+			m->samples[s] = s;
+		}
+	} else {
+		m->numSamples = LOD_SAMPLE_FRAMES;
+		for ( s = 0; s < LOD_SAMPLE_FRAMES; s++ ) {
+			m->samples[s] = s * ( numFrames - 1 ) / ( LOD_SAMPLE_FRAMES - 1 );
+		}
+	}
+
+	m->numTris = surf->numIndexes / 3;
+	m->tris = ri.Malloc( sizeof( *m->tris ) * m->numTris * 3 );
+	m->triDead = ri.Malloc( m->numTris );
+	m->refFirst = ri.Malloc( sizeof( *m->refFirst ) * numVerts );
+	m->refNext = ri.Malloc( sizeof( *m->refNext ) * m->numTris * 3 );
+	m->refTri = ri.Malloc( sizeof( *m->refTri ) * m->numTris * 3 );
+	m->quadrics = ri.Malloc( sizeof( *m->quadrics ) * numVerts * m->numSamples );
+	m->cost = ri.Malloc( sizeof( *m->cost ) * numVerts );
+	m->target = ri.Malloc( sizeof( *m->target ) * numVerts );
+	m->locked = ri.Malloc( numVerts );
+	m->stamp = ri.Malloc( sizeof( *m->stamp ) * numVerts );
+	m->touched = ri.Malloc( sizeof( *m->touched ) * numVerts );
+	m->version = ri.Malloc( sizeof( *m->version ) * numVerts );
+	m->maxHeap = numVerts * 2 + 16;
+	m->heap = ri.Malloc( sizeof( *m->heap ) * m->maxHeap );
+	m->numHeap = 0;
+
+	Com_Memset( m->quadrics, 0, sizeof( *m->quadrics ) * numVerts * m->numSamples );
+	Com_Memset( m->locked, 0, numVerts );
+	Com_Memset( m->stamp, 0, sizeof( *m->stamp ) * numVerts );
+	Com_Memset( m->version, 0, sizeof( *m->version ) * numVerts );
+	for ( v = 0; v < numVerts; v++ ) {
+		m->refFirst[v] = -1;
+		m->target[v] = -1;
+	}
+
+	m->numLiveTris = 0;
+	for ( t = 0; t < m->numTris; t++ ) {
+		for ( k = 0; k < 3; k++ ) {
+			m->tris[t * 3 + k] = surf->indexes[t * 3 + k];
+		}
+		tri = m->tris + t * 3;
+		m->triDead[t] = ( tri[0] == tri[1] || tri[1] == tri[2] || tri[2] == tri[0] );
+		if ( m->triDead[t] ) {
+			continue;
+		}
+		m->numLiveTris++;
+
+		for ( k = 0; k < 3; k++ ) {
+			r = t * 3 + k;
+			m->refTri[r] = t;
+			m->refNext[r] = m->refFirst[tri[k]];
+			m->refFirst[tri[k]] = r;
+		}
+
+		// the planes of the triangle, weighted by its area
+		for ( s = 0; s < m->numSamples; s++ ) {
+			for ( k = 0; k < 3; k++ ) {
+				p[k] = LodPos( m, s, tri[k] );
+			}
+			LodTriangleNormal( p[0], p[1], p[2], n );
+			area = VectorNormalize( n ) * 0.5f;
+			if ( !area ) {
+				continue;
+			}
+			for ( k = 0; k < 3; k++ ) {
+				LodAddPlane( &m->quadrics[tri[k] * m->numSamples + s], n, -DotProduct( n, p[0] ), area );
+			}
+		}
+	}
+
+	// lock everything on an open edge
+	for ( v = 0; v < numVerts; v++ ) {
+		for ( r = m->refFirst[v]; r >= 0 && !m->locked[v]; r = m->refNext[r] ) {
+			tri = m->tris + m->refTri[r] * 3;
+			for ( k = 0; k < 3; k++ ) {
+				w = tri[k];
+				if ( w == v ) {
+					continue;
+				}
+				count = 0;
+				for ( r2 = m->refFirst[v]; r2 >= 0; r2 = m->refNext[r2] ) {
+					const int *tri2 = m->tris + m->refTri[r2] * 3;
+
+					if ( tri2[0] == w || tri2[1] == w || tri2[2] == w ) {
+						count++;
+					}
+				}
+				if ( count == 1 ) {
+					m->locked[v] = 1;
+					break;
+				}
+			}
+		}
+	}
+
+	for ( v = 0; v < numVerts; v++ ) {
+		LodVertexCost( m, v );
+	}
+}
+
+static void LodFreeMesh( lodMesh_t *m ) {
+	ri.Free( m->tris );
+	ri.Free( m->triDead );
+	ri.Free( m->refFirst );
+	ri.Free( m->refNext );
+	ri.Free( m->refTri );
+	ri.Free( m->quadrics );
+	ri.Free( m->cost );
+	ri.Free( m->target );
+	ri.Free( m->locked );
+	ri.Free( m->stamp );
+	ri.Free( m->touched );
+	ri.Free( m->version );
+	ri.Free( m->heap );
+}
+
+/*
+=================
+LodSimplify
+
+Collapses the cheapest vertexes until there are no more than numTris
+triangles left, or nothing more can go.  Collapses that were found again
+since they were queued are skipped, LodVertexCost queued the new one.
+=================
+*/
+static void LodSimplify( lodMesh_t *m, int numTris ) {
+	lodCandidate_t	c;
+
+	while ( m->numLiveTris > numTris ) {
+		if ( !LodHeapPop( m, &c ) ) {
+			break;
+		}
+		if ( c.version != m->version[c.v] || m->target[c.v] < 0 ) {
+			continue;
+		}
+		LodCollapse( m, c.v, m->target[c.v] );
+	}
+}
+
+/*
+=================
+LodBuildModel
+
+Makes a level from the full detail one, keeping the vertexes the
+triangles of each surface still use, in the order they are first used.
+=================
+*/
+static mdvModel_t *LodBuildModel( model_t *mod, const mdvModel_t *base, const lodSurface_t *lodSurfs ) {
+	mdvModel_t			*mdv;
+	mdvSurface_t		*surf;
+	const mdvSurface_t	*baseSurf;
+	int					*remap, *order;
+	int					i, j, f, numVerts, maxVerts;
+
+	mdv = ri.Hunk_Alloc( sizeof( *mdv ), h_low );
+	*mdv = *base;
+	mdv->surfaces = surf = ri.Hunk_Alloc( sizeof( *surf ) * base->numSurfaces, h_low );
+
+	maxVerts = 1;
+	for ( i = 0; i < base->numSurfaces; i++ ) {
+		maxVerts = MAX( maxVerts, base->surfaces[i].numVerts );
+	}
+	remap = ri.Malloc( sizeof( *remap ) * maxVerts );
+	order = ri.Malloc( sizeof( *order ) * maxVerts );
+
+	baseSurf = base->surfaces;
+	for ( i = 0; i < base->numSurfaces; i++, surf++, baseSurf++, lodSurfs++ ) {
+		*surf = *baseSurf;
+		surf->model = mdv;
+
+		for ( j = 0; j < baseSurf->numVerts; j++ ) {
+			remap[j] = -1;
+		}
+		numVerts = 0;
+		for ( j = 0; j < lodSurfs->numIndexes; j++ ) {
+			if ( remap[lodSurfs->indexes[j]] < 0 ) {
+				remap[lodSurfs->indexes[j]] = numVerts;
+				order[numVerts++] = lodSurfs->indexes[j];
+			}
+		}
+
+		surf->numIndexes = lodSurfs->numIndexes;
+		surf->indexes = ri.Hunk_Alloc( sizeof( *surf->indexes ) * surf->numIndexes, h_low );
+		for ( j = 0; j < surf->numIndexes; j++ ) {
+			surf->indexes[j] = remap[lodSurfs->indexes[j]];
+		}
+
+		surf->numVerts = numVerts;
+		surf->verts = ri.Hunk_Alloc( sizeof( *surf->verts ) * numVerts * base->numFrames, h_low );
+		surf->st = ri.Hunk_Alloc( sizeof( *surf->st ) * numVerts, h_low );
+		for ( j = 0; j < numVerts; j++ ) {
+			surf->st[j] = baseSurf->st[order[j]];
+		}
+		for ( f = 0; f < base->numFrames; f++ ) {
+			for ( j = 0; j < numVerts; j++ ) {
+				surf->verts[f * numVerts + j] = baseSurf->verts[f * baseSurf->numVerts + order[j]];
+			}
+		}
+
+		mod->dataSize += sizeof( *surf->indexes ) * surf->numIndexes
+			+ ( sizeof( *surf->verts ) * base->numFrames + sizeof( *surf->st ) ) * numVerts;
+	}
+
+	ri.Free( remap );
+	ri.Free( order );
+
+	R_CreateMDVVaoSurfaces( mdv );
+
+	return mdv;
+}
+
+/*
+=================
+R_GenerateMD3Lods
+
+Fills in mod->mdv[1] and on from mod->mdv[0], stopping early once a
+level would save too little to be worth keeping.
+=================
+*/
+void R_GenerateMD3Lods( model_t *mod, int levels ) {
+	mdvModel_t		*base;
+	lodMesh_t		mesh;
+	lodSurface_t	*lodSurfs, *ls;
+	int				total[MD3_MAX_LODS];
+	int				numLevels, level, i, t, numTris;
+
+	base = mod->mdv[0];
+	if ( levels > MD3_MAX_LODS - 1 ) {
+		levels = MD3_MAX_LODS - 1;
+	}
+
+	lodSurfs = ri.Malloc( sizeof( *lodSurfs ) * levels * base->numSurfaces );
+	total[0] = 0;
+	for ( level = 1; level <= levels; level++ ) {
+		total[level] = 0;
+	}
+
+	// each surface goes down through all the levels in one run
+	for ( i = 0; i < base->numSurfaces; i++ ) {
+		LodInitMesh( &mesh, &base->surfaces[i], base->numFrames );
+		total[0] += mesh.numLiveTris;
+
+		numTris = mesh.numLiveTris;
+		for ( level = 0; level < levels; level++ ) {
+			numTris = MAX( numTris * LOD_KEEP, LOD_MIN_TRIANGLES );
+			LodSimplify( &mesh, numTris );
+
+			ls = &lodSurfs[level * base->numSurfaces + i];
+			ls->numIndexes = 0;
+			ls->indexes = ri.Malloc( sizeof( *ls->indexes ) * mesh.numLiveTris * 3 );
+			for ( t = 0; t < mesh.numTris; t++ ) {
+				if ( !mesh.triDead[t] ) {
+					ls->indexes[ls->numIndexes++] = mesh.tris[t * 3 + 0];
+					ls->indexes[ls->numIndexes++] = mesh.tris[t * 3 + 1];
+					ls->indexes[ls->numIndexes++] = mesh.tris[t * 3 + 2];
+				}
+			}
+			total[level + 1] += mesh.numLiveTris;
+		}
+
+		LodFreeMesh( &mesh );
+	}
+
+	for ( numLevels = 0; numLevels < levels; numLevels++ ) {
+		if ( total[numLevels + 1] >= total[numLevels] * LOD_MIN_SAVING ) {
+			break;
+		}
+	}
+
+	for ( level = 0; level < numLevels; level++ ) {
+		mod->mdv[level + 1] = LodBuildModel( mod, base, &lodSurfs[level * base->numSurfaces] );
+	}
+	mod->numLods += numLevels;
+
+	for ( i = 0; i < levels * base->numSurfaces; i++ ) {
+		ri.Free( lodSurfs[i].indexes );
+	}
+	ri.Free( lodSurfs );
+
+	if ( numLevels ) {
+		ri.Printf( PRINT_DEVELOPER, "%s: %i triangles, made %i levels of detail down to %i\n",
+			mod->name, total[0], numLevels, total[numLevels] );
+	}
+}
@@ -0,0 +1,774 @@
+/*
+===========================================================================
+Copyright (C) 1999-2005 Id Software, Inc.
+
+This file is part of Quake III Arena source code.
+
+Quake III Arena source code is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 2 of the License,
+or (at your option) any later version.
+
+Quake III Arena source code is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Quake III Arena source code; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+===========================================================================
+*/
+// tr_occlusion.c -- software occlusion culling against the biggest world surfaces
+
+#include "tr_local.h"
+
+/*
+=============================================================
+
+OCCLUSION CULLING
+
+The biggest opaque world surfaces are picked as occluders when the map is
+loaded.  Each view that draws the world rasterizes the ones in the frustum
+that cover the most of it into a small buffer of inverse depths, nearest
+first until r_occlusionTriangles is used up, and builds a pyramid over it
+that holds the farthest depth under each block.  World nodes, world
+surfaces and entities whose bounds are entirely behind the pyramid under
+their screen rectangle are dropped before they are added.
+
+Shadow, orthographic and portal views are not tested.
+
+=============================================================
+*/
+
+#if defined(__SSE2__) || idx64
+#define idsse2 1
+#include <emmintrin.h>
+#else
+#define idsse2 0
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define idneon 1
+#include <arm_neon.h>
+#else
+#define idneon 0
+#endif
+
+#define	OCC_WIDTH			256			// multiple of 4 << ( OCC_LEVELS - 1 )
+#define	OCC_HEIGHT			128
+#define	OCC_LEVELS			6			// down to 8 by 4
+
+#define	OCC_NEAR			1.0f		// triangles are clipped here
+#define	OCC_DEPTH_BIAS		1.01f		// bounds must be this much farther than the occluder
+
+#define	MAX_OCCLUDERS		1024
+#define	MIN_OCCLUDER_AREA	( 128.0f * 128.0f )
+
+typedef struct occluder_s {
+	msurface_t	*surf;
+	float		area;
+} occluder_t;
+
+typedef struct {
+	float		score;
+	int			num;
+} occluderSort_t;
+
+static struct {
+	int			viewCount;			// the view the buffer was drawn for
+	mat4_t		mvp;
+	float		*levels[OCC_LEVELS];
+	float		depth[OCC_WIDTH * OCC_HEIGHT];
+	float		pyramid[OCC_WIDTH * OCC_HEIGHT / 3];
+} occ;
+
+static occluderSort_t	occluderSort[MAX_OCCLUDERS];
+
+/*
+================
+R_OccluderShader
+
+Only surfaces that always hide what is behind them can be occluders.
+================
+*/
+static qboolean R_OccluderShader( shader_t *shader ) {
+	int		i;
+
+	if ( shader->sort != SS_OPAQUE || shader->isSky || shader->isPortal
+		|| shader->numDeforms || shader->polygonOffset ) {
+		return qfalse;
+	}
+
+	for ( i = 0 ; i < MAX_SHADER_STAGES ; i++ ) {
+		if ( !shader->stages[i] || !shader->stages[i]->active ) {
+			break;
+		}
+		if ( shader->stages[i]->stateBits & GLS_ATEST_BITS ) {
+			return qfalse;
+		}
+	}
+
+	return qtrue;
+}
+
+/*
+================
+R_OccluderArea
+================
+*/
+static float R_OccluderArea( srfBspSurface_t *cv ) {
+	vec3_t		d1, d2, cross;
+	glIndex_t	*tri;
+	float		area;
+	int			i;
+
+	area = 0;
+	for ( i = 0, tri = cv->indexes ; i + 2 < cv->numIndexes ; i += 3, tri += 3 ) {
+		VectorSubtract( cv->verts[tri[1]].xyz, cv->verts[tri[0]].xyz, d1 );
+		VectorSubtract( cv->verts[tri[2]].xyz, cv->verts[tri[0]].xyz, d2 );
+		CrossProduct( d1, d2, cross );
+		area += 0.5f * VectorLength( cross );
+	}
+
+	return area;
+}
+
+static int R_SortOccluders( const void *a, const void *b ) {
+	float	sa, sb;
+
+	sa = ((const occluderSort_t *)a)->score;
+	sb = ((const occluderSort_t *)b)->score;
+	if ( sa > sb ) {
+		return -1;
+	}
+	if ( sa < sb ) {
+		return 1;
+	}
+	return ((const occluderSort_t *)a)->num - ((const occluderSort_t *)b)->num;
+}
+
+/*
+================
+R_InitOcclusion
+
+Picks the occluders once the world surfaces are loaded.
+================
+*/
+void R_InitOcclusion( world_t *world ) {
+	occluderSort_t	*candidates;
+	msurface_t		*surf;
+	srfBspSurface_t	*cv;
+	int				i, numCandidates, maxVerts;
+
+	world->occluders = NULL;
+	world->numOccluders = 0;
+	world->occluderVerts = NULL;
+	occ.viewCount = 0;
+
+	candidates = ri.Hunk_AllocateTempMemory( world->numWorldSurfaces * sizeof( *candidates ) );
+	numCandidates = 0;
+
+	for ( i = 0 ; i < world->numWorldSurfaces ; i++ ) {
+		surf = world->surfaces + i;
+		switch ( *surf->data ) {
+		case SF_FACE:
+		case SF_TRIANGLES:
+		case SF_GRID:
+			break;
+		default:
+			continue;
+		}
+
+		cv = (srfBspSurface_t *)surf->data;
+		if ( cv->numIndexes < 3 || !R_OccluderShader( surf->shader ) ) {
+			continue;
+		}
+
+		candidates[numCandidates].score = R_OccluderArea( cv );
+		candidates[numCandidates].num = i;
+		if ( candidates[numCandidates].score >= MIN_OCCLUDER_AREA ) {
+			numCandidates++;
+		}
+	}
+
+	qsort( candidates, numCandidates, sizeof( *candidates ), R_SortOccluders );
+	if ( numCandidates > MAX_OCCLUDERS ) {
+		numCandidates = MAX_OCCLUDERS;
+	}
+
+	if ( numCandidates ) {
+		world->occluders = ri.Hunk_Alloc( numCandidates * sizeof( *world->occluders ), h_low );
+		world->numOccluders = numCandidates;
+
+		maxVerts = 0;
+		for ( i = 0 ; i < numCandidates ; i++ ) {
+			world->occluders[i].surf = world->surfaces + candidates[i].num;
+			world->occluders[i].area = candidates[i].score;
+
+			cv = (srfBspSurface_t *)world->occluders[i].surf->data;
+			if ( cv->numVerts > maxVerts ) {
+				maxVerts = cv->numVerts;
+			}
+		}
+		world->occluderVerts = ri.Hunk_Alloc( maxVerts * 3 * sizeof( float ), h_low );
+	}
+
+	ri.Hunk_FreeTempMemory( candidates );
+
+	ri.Printf( PRINT_DEVELOPER, "...%i occluders\n", world->numOccluders );
+}
+
+
+/*
+=============================================================
+
+RASTERIZATION
+
+=============================================================
+*/
+
+/*
+================
+R_RasterizeOccluderTriangle
+
+Takes screen space vertexes, x and y in pixels and the inverse depth, and
+keeps the nearest depth of every pixel whose center it covers.  Only
+triangles wound so their area is positive are drawn.
+================
+*/
+static void R_RasterizeOccluderTriangle( const float *v0, const float *v1, const float *v2 ) {
+	float	area;
+	float	a0, b0, a1, b1, a2, b2;
+	float	aw, bw, cw;
+	float	e0, e1, e2, w;
+	float	px, py;
+	float	*row;
+	int		minX, maxX, minY, maxY;
+	int		x, y, startX;
+
+	area = ( v1[0] - v0[0] ) * ( v2[1] - v0[1] ) - ( v2[0] - v0[0] ) * ( v1[1] - v0[1] );
+	if ( area <= 0 ) {
+		return;
+	}
+
+	// clamp before converting, vertexes near the near plane can be far off the screen
+	minX = (int)floor( Com_Clamp( 0, OCC_WIDTH, MIN( v0[0], MIN( v1[0], v2[0] ) ) ) );
+	maxX = (int)ceil( Com_Clamp( -1, OCC_WIDTH - 1, MAX( v0[0], MAX( v1[0], v2[0] ) ) ) );
+	minY = (int)floor( Com_Clamp( 0, OCC_HEIGHT, MIN( v0[1], MIN( v1[1], v2[1] ) ) ) );
+	maxY = (int)ceil( Com_Clamp( -1, OCC_HEIGHT - 1, MAX( v0[1], MAX( v1[1], v2[1] ) ) ) );
+	if ( minX > maxX || minY > maxY ) {
+		return;
+	}
+
+	// edge functions, each positive on the inside of the edge opposite
+	// its vertex and evaluated from a vertex on the edge
+	a0 = v1[1] - v2[1];
+	b0 = v2[0] - v1[0];
+	a1 = v2[1] - v0[1];
+	b1 = v0[0] - v2[0];
+	a2 = v0[1] - v1[1];
+	b2 = v1[0] - v0[0];
+
+	// inverse depth is linear in screen space
+	aw = ( a0 * v0[2] + a1 * v1[2] + a2 * v2[2] ) / area;
+	bw = ( b0 * v0[2] + b1 * v1[2] + b2 * v2[2] ) / area;
+	cw = v0[2] - aw * v0[0] - bw * v0[1];
+
+	startX = minX & ~3;
+	for ( y = minY ; y <= maxY ; y++ ) {
+		py = y + 0.5f;
+		px = startX + 0.5f;
+		e0 = a0 * ( px - v1[0] ) + b0 * ( py - v1[1] );
+		e1 = a1 * ( px - v2[0] ) + b1 * ( py - v2[1] );
+		e2 = a2 * ( px - v0[0] ) + b2 * ( py - v0[1] );
+		w = aw * px + bw * py + cw;
+		row = occ.depth + y * OCC_WIDTH;
+
+#if idsse2
+		{
+			const __m128	lane = _mm_set_ps( 3, 2, 1, 0 );
+			const __m128	zero = _mm_setzero_ps();
+			__m128	ve0, ve1, ve2, vw;
+			__m128	se0, se1, se2, sw;
+			__m128	mask, d;
+
+			ve0 = _mm_add_ps( _mm_set1_ps( e0 ), _mm_mul_ps( _mm_set1_ps( a0 ), lane ) );
+			ve1 = _mm_add_ps( _mm_set1_ps( e1 ), _mm_mul_ps( _mm_set1_ps( a1 ), lane ) );
+			ve2 = _mm_add_ps( _mm_set1_ps( e2 ), _mm_mul_ps( _mm_set1_ps( a2 ), lane ) );
+			vw = _mm_add_ps( _mm_set1_ps( w ), _mm_mul_ps( _mm_set1_ps( aw ), lane ) );
+			se0 = _mm_set1_ps( a0 * 4 );
+			se1 = _mm_set1_ps( a1 * 4 );
+			se2 = _mm_set1_ps( a2 * 4 );
+			sw = _mm_set1_ps( aw * 4 );
+
+			for ( x = startX ; x <= maxX ; x += 4 ) {
+				mask = _mm_and_ps( _mm_and_ps( _mm_cmpge_ps( ve0, zero ), _mm_cmpge_ps( ve1, zero ) ), _mm_cmpge_ps( ve2, zero ) );
+				if ( _mm_movemask_ps( mask ) ) {
+					d = _mm_loadu_ps( row + x );
+					d = _mm_or_ps( _mm_and_ps( mask, _mm_max_ps( d, vw ) ), _mm_andnot_ps( mask, d ) );
+					_mm_storeu_ps( row + x, d );
+				}
+				ve0 = _mm_add_ps( ve0, se0 );
+				ve1 = _mm_add_ps( ve1, se1 );
+				ve2 = _mm_add_ps( ve2, se2 );
+				vw = _mm_add_ps( vw, sw );
+			}
+		}
+#elif idneon
+		{
+			static const float	laneValues[4] = { 0, 1, 2, 3 };
+			const float32x4_t	lane = vld1q_f32( laneValues );
+			const float32x4_t	zero = vdupq_n_f32( 0 );
+			float32x4_t	ve0, ve1, ve2, vw;
+			float32x4_t	se0, se1, se2, sw;
+			float32x4_t	d;
+			uint32x4_t	mask;
+			uint32x2_t	any;
+
+			ve0 = vmlaq_f32( vdupq_n_f32( e0 ), vdupq_n_f32( a0 ), lane );
+			ve1 = vmlaq_f32( vdupq_n_f32( e1 ), vdupq_n_f32( a1 ), lane );
+			ve2 = vmlaq_f32( vdupq_n_f32( e2 ), vdupq_n_f32( a2 ), lane );
+			vw = vmlaq_f32( vdupq_n_f32( w ), vdupq_n_f32( aw ), lane );
+			se0 = vdupq_n_f32( a0 * 4 );
+			se1 = vdupq_n_f32( a1 * 4 );
+			se2 = vdupq_n_f32( a2 * 4 );
+			sw = vdupq_n_f32( aw * 4 );
+
+			for ( x = startX ; x <= maxX ; x += 4 ) {
+				mask = vandq_u32( vandq_u32( vcgeq_f32( ve0, zero ), vcgeq_f32( ve1, zero ) ), vcgeq_f32( ve2, zero ) );
+				any = vorr_u32( vget_low_u32( mask ), vget_high_u32( mask ) );
+				if ( vget_lane_u32( any, 0 ) | vget_lane_u32( any, 1 ) ) {
+					d = vld1q_f32( row + x );
+					d = vbslq_f32( mask, vmaxq_f32( d, vw ), d );
+					vst1q_f32( row + x, d );
+				}
+				ve0 = vaddq_f32( ve0, se0 );
+				ve1 = vaddq_f32( ve1, se1 );
+				ve2 = vaddq_f32( ve2, se2 );
+				vw = vaddq_f32( vw, sw );
+			}
+		}
+#else
+		for ( x = startX ; x <= maxX ; x++ ) {
+			if ( e0 >= 0 && e1 >= 0 && e2 >= 0 && w > row[x] ) {
+				row[x] = w;
+			}
+			e0 += a0;
+			e1 += a1;
+			e2 += a2;
+			w += aw;
+		}
+#endif
+	}
+}
+
+/*
+================
+R_ProjectOccluderVert
+
+Clip space x, y and w to screen space
+================
+*/
+static void R_ProjectOccluderVert( const float *clip, float *out ) {
+	float	iw;
+
+	iw = 1.0f / clip[2];
+	out[0] = ( clip[0] * iw * 0.5f + 0.5f ) * OCC_WIDTH;
+	out[1] = ( 0.5f - clip[1] * iw * 0.5f ) * OCC_HEIGHT;
+	out[2] = iw;
+}
+
+/*
+================
+R_DrawOccluderTriangle
+
+Clips against the near plane and skips faces the shader culls.
+================
+*/
+static void R_DrawOccluderTriangle( const float *c0, const float *c1, const float *c2, cullType_t cullType ) {
+	const float	*in[3];
+	float		clipped[4][3];
+	float		screen[4][3];
+	float		frac, area;
+	int			i, j, numPoints;
+
+	if ( c0[2] >= OCC_NEAR && c1[2] >= OCC_NEAR && c2[2] >= OCC_NEAR ) {
+		R_ProjectOccluderVert( c0, screen[0] );
+		R_ProjectOccluderVert( c1, screen[1] );
+		R_ProjectOccluderVert( c2, screen[2] );
+		numPoints = 3;
+	} else {
+		in[0] = c0;
+		in[1] = c1;
+		in[2] = c2;
+		numPoints = 0;
+		for ( i = 0 ; i < 3 ; i++ ) {
+			const float	*a = in[i];
+			const float	*b = in[( i + 1 ) % 3];
+
+			if ( a[2] >= OCC_NEAR ) {
+				VectorCopy( a, clipped[numPoints] );
+				numPoints++;
+			}
+			if ( ( a[2] >= OCC_NEAR ) != ( b[2] >= OCC_NEAR ) ) {
+				frac = ( OCC_NEAR - a[2] ) / ( b[2] - a[2] );
+				for ( j = 0 ; j < 3 ; j++ ) {
+					clipped[numPoints][j] = a[j] + frac * ( b[j] - a[j] );
+				}
+				clipped[numPoints][2] = OCC_NEAR;
+				numPoints++;
+			}
+		}
+		if ( numPoints < 3 ) {
+			return;
+		}
+		for ( i = 0 ; i < numPoints ; i++ ) {
+			R_ProjectOccluderVert( clipped[i], screen[i] );
+		}
+	}
+
+	// screen y is down, so faces that are drawn with back face culling
+	// have a positive area
+	area = ( screen[1][0] - screen[0][0] ) * ( screen[2][1] - screen[0][1] )
+		- ( screen[2][0] - screen[0][0] ) * ( screen[1][1] - screen[0][1] );
+	if ( area == 0 ) {
+		return;
+	}
+	if ( ( area < 0 && cullType == CT_FRONT_SIDED ) || ( area > 0 && cullType == CT_BACK_SIDED ) ) {
+		return;
+	}
+
+	// clipping keeps the winding, so the fan is wound the same way
+	if ( area > 0 ) {
+		R_RasterizeOccluderTriangle( screen[0], screen[1], screen[2] );
+		if ( numPoints == 4 ) {
+			R_RasterizeOccluderTriangle( screen[0], screen[2], screen[3] );
+		}
+	} else {
+		R_RasterizeOccluderTriangle( screen[0], screen[2], screen[1] );
+		if ( numPoints == 4 ) {
+			R_RasterizeOccluderTriangle( screen[0], screen[3], screen[2] );
+		}
+	}
+}
+
+/*
+================
+R_DrawOccluder
+================
+*/
+static void R_DrawOccluder( msurface_t *surf ) {
+	srfBspSurface_t	*cv;
+	glIndex_t		*tri;
+	float			*clip;
+	int				i;
+
+	cv = (srfBspSurface_t *)surf->data;
+	clip = tr.world->occluderVerts;
+
+	for ( i = 0 ; i < cv->numVerts ; i++, clip += 3 ) {
+		const float	*v = cv->verts[i].xyz;
+		const float	*m = occ.mvp;
+
+		clip[0] = m[0] * v[0] + m[4] * v[1] + m[ 8] * v[2] + m[12];
+		clip[1] = m[1] * v[0] + m[5] * v[1] + m[ 9] * v[2] + m[13];
+		clip[2] = m[3] * v[0] + m[7] * v[1] + m[11] * v[2] + m[15];
+	}
+
+	clip = tr.world->occluderVerts;
+	for ( i = 0, tri = cv->indexes ; i + 2 < cv->numIndexes ; i += 3, tri += 3 ) {
+		R_DrawOccluderTriangle( clip + tri[0] * 3, clip + tri[1] * 3, clip + tri[2] * 3, surf->shader->cullType );
+	}
+
+	tr.pc.c_occluders++;
+	tr.pc.c_occluderTriangles += cv->numIndexes / 3;
+}
+
+/*
+================
+R_BuildOcclusionPyramid
+================
+*/
+static void R_BuildOcclusionPyramid( void ) {
+	float	*in, *out;
+	int		level, width, height;
+	int		x, y;
+
+	occ.levels[0] = occ.depth;
+	out = occ.pyramid;
+	width = OCC_WIDTH;
+	height = OCC_HEIGHT;
+	for ( level = 1 ; level < OCC_LEVELS ; level++ ) {
+		in = occ.levels[level - 1];
+		occ.levels[level] = out;
+		width >>= 1;
+		height >>= 1;
+		for ( y = 0 ; y < height ; y++ ) {
+			const float	*r0 = in + y * 2 * width * 2;
+			const float	*r1 = r0 + width * 2;
+
+			for ( x = 0 ; x < width ; x++ ) {
+				out[x] = MIN( MIN( r0[x * 2], r0[x * 2 + 1] ), MIN( r1[x * 2], r1[x * 2 + 1] ) );
+			}
+			out += width;
+		}
+	}
+}
+
+/*
+================
+R_RenderOcclusion
+
+Called before the world is walked for every view.
+================
+*/
+void R_RenderOcclusion( void ) {
+	occluder_t	*occluder;
+	msurface_t	*surf;
+	vec3_t		closest;
+	float		dist;
+	int			i, j, count, budget;
+
+	occ.viewCount = 0;
+
+	if ( !r_occlusion->integer || r_nocull->integer || !tr.world->numOccluders ) {
+		return;
+	}
+	if ( tr.viewParms.isPortal
+		|| ( tr.viewParms.flags & ( VPF_SHADOWMAP | VPF_DEPTHSHADOW | VPF_ORTHOGRAPHIC ) ) ) {
+		return;
+	}
+
+	// the occluders that cover the most of the view go first
+	count = 0;
+	for ( i = 0, occluder = tr.world->occluders ; i < tr.world->numOccluders ; i++, occluder++ ) {
+		surf = occluder->surf;
+		if ( r_nocurves->integer && *surf->data == SF_GRID ) {
+			continue;
+		}
+		if ( R_CullBox( surf->cullinfo.bounds ) == CULL_OUT ) {
+			continue;
+		}
+
+		for ( j = 0 ; j < 3 ; j++ ) {
+			closest[j] = tr.viewParms.or.origin[j];
+			if ( closest[j] < surf->cullinfo.bounds[0][j] ) {
+				closest[j] = surf->cullinfo.bounds[0][j];
+			} else if ( closest[j] > surf->cullinfo.bounds[1][j] ) {
+				closest[j] = surf->cullinfo.bounds[1][j];
+			}
+		}
+		dist = DistanceSquared( closest, tr.viewParms.or.origin );
+
+		occluderSort[count].score = occluder->area / ( dist + 1.0f );
+		occluderSort[count].num = i;
+		count++;
+	}
+
+	if ( !count ) {
+		return;
+	}
+	qsort( occluderSort, count, sizeof( occluderSort[0] ), R_SortOccluders );
+
+	Mat4Multiply( tr.viewParms.projectionMatrix, tr.viewParms.world.modelMatrix, occ.mvp );
+	Com_Memset( occ.depth, 0, sizeof( occ.depth ) );
+
+	budget = r_occlusionTriangles->integer;
+	for ( i = 0 ; i < count && budget > 0 ; i++ ) {
+		surf = tr.world->occluders[occluderSort[i].num].surf;
+		R_DrawOccluder( surf );
+		budget -= ((srfBspSurface_t *)surf->data)->numIndexes / 3;
+	}
+
+	R_BuildOcclusionPyramid();
+	occ.viewCount = tr.viewCount;
+}
+
+
+/*
+=============================================================
+
+TESTS
+
+=============================================================
+*/
+
+/*
+================
+R_OccludedBounds
+
+Returns qtrue if the box is behind the occluders everywhere it covers the
+screen.  Boxes that cross the near plane or are off the screen are never
+occluded.
+================
+*/
+static qboolean R_OccludedBounds( const vec3_t mins, const vec3_t maxs ) {
+	const float	*m = occ.mvp;
+	float		base[3], axis[3][3];
+	float		clip[3];
+	float		sx, sy, minX, maxX, minY, maxY, minW;
+	float		iw, *level;
+	int			x0, x1, y0, y1;
+	int			i, j, l, x, y, width;
+
+	if ( occ.viewCount != tr.viewCount ) {
+		return qfalse;
+	}
+
+	// project the corners, clip space being linear in each axis
+	base[0] = m[0] * mins[0] + m[4] * mins[1] + m[ 8] * mins[2] + m[12];
+	base[1] = m[1] * mins[0] + m[5] * mins[1] + m[ 9] * mins[2] + m[13];
+	base[2] = m[3] * mins[0] + m[7] * mins[1] + m[11] * mins[2] + m[15];
+	for ( i = 0 ; i < 3 ; i++ ) {
+		float	size = maxs[i] - mins[i];
+
+		axis[i][0] = m[i * 4 + 0] * size;
+		axis[i][1] = m[i * 4 + 1] * size;
+		axis[i][2] = m[i * 4 + 3] * size;
+	}
+
+	minX = minY = minW = 1e30f;
+	maxX = maxY = -1e30f;
+	for ( i = 0 ; i < 8 ; i++ ) {
+		for ( j = 0 ; j < 3 ; j++ ) {
+			clip[j] = base[j];
+			if ( i & 1 ) {
+				clip[j] += axis[0][j];
+			}
+			if ( i & 2 ) {
+				clip[j] += axis[1][j];
+			}
+			if ( i & 4 ) {
+				clip[j] += axis[2][j];
+			}
+		}
+		if ( clip[2] < OCC_NEAR ) {
+			return qfalse;
+		}
+
+		iw = 1.0f / clip[2];
+		sx = ( clip[0] * iw * 0.5f + 0.5f ) * OCC_WIDTH;
+		sy = ( 0.5f - clip[1] * iw * 0.5f ) * OCC_HEIGHT;
+		minX = MIN( minX, sx );
+		maxX = MAX( maxX, sx );
+		minY = MIN( minY, sy );
+		maxY = MAX( maxY, sy );
+		minW = MIN( minW, clip[2] );
+	}
+
+	if ( maxX < 0 || maxY < 0 || minX >= OCC_WIDTH || minY >= OCC_HEIGHT ) {
+		return qfalse;
+	}
+
+	// widen by a texel on every side, the rasterizer fills texels whose
+	// centers a triangle covers, so the edge texels can't be trusted
+	x0 = minX < 1 ? 0 : (int)minX - 1;
+	x1 = maxX >= OCC_WIDTH - 1 ? OCC_WIDTH - 1 : (int)maxX + 1;
+	y0 = minY < 1 ? 0 : (int)minY - 1;
+	y1 = maxY >= OCC_HEIGHT - 1 ? OCC_HEIGHT - 1 : (int)maxY + 1;
+
+	// the nearest the box can be
+	iw = OCC_DEPTH_BIAS / minW;
+
+	// go up the pyramid until the rectangle is a few texels across
+	for ( l = 0 ; l < OCC_LEVELS - 1 ; l++ ) {
+		if ( ( x1 >> l ) - ( x0 >> l ) < 4 && ( y1 >> l ) - ( y0 >> l ) < 4 ) {
+			break;
+		}
+	}
+
+	level = occ.levels[l];
+	width = OCC_WIDTH >> l;
+	for ( y = y0 >> l ; y <= ( y1 >> l ) ; y++ ) {
+		for ( x = x0 >> l ; x <= ( x1 >> l ) ; x++ ) {
+			if ( level[y * width + x] <= iw ) {
+				return qfalse;
+			}
+		}
+	}
+
+	return qtrue;
+}
+
+/*
+================
+R_OccludedBox
+
+World space bounds
+================
+*/
+qboolean R_OccludedBox( vec3_t bounds[2] ) {
+	return R_OccludedBounds( bounds[0], bounds[1] );
+}
+
+/*
+================
+R_OccludedNode
+================
+*/
+qboolean R_OccludedNode( mnode_t *node ) {
+	return R_OccludedBounds( node->mins, node->maxs );
+}
+
+/*
+================
+R_OccludedLocalBox
+
+Bounds in the coordinate system of tr.or
+================
+*/
+qboolean R_OccludedLocalBox( vec3_t bounds[2] ) {
+	vec3_t	v, transformed;
+	vec3_t	worldBounds[2];
+	int		i;
+
+	if ( occ.viewCount != tr.viewCount ) {
+		return qfalse;
+	}
+
+	ClearBounds( worldBounds[0], worldBounds[1] );
+	for ( i = 0 ; i < 8 ; i++ ) {
+		v[0] = bounds[i & 1][0];
+		v[1] = bounds[( i >> 1 ) & 1][1];
+		v[2] = bounds[( i >> 2 ) & 1][2];
+
+		R_LocalPointToWorld( v, transformed );
+		AddPointToBounds( transformed, worldBounds[0], worldBounds[1] );
+	}
+
+	return R_OccludedBounds( worldBounds[0], worldBounds[1] );
+}
+
+/*
+================
+R_OccludedModel
+
+Tests the bounds of both frames a model is lerped between.  Weapon models
+drawn with a depth hack are never occluded, nor are models whose stencil
+or projected shadows could still be seen.
+================
+*/
+qboolean R_OccludedModel( trRefEntity_t *ent, vec3_t oldBounds[2], vec3_t newBounds[2] ) {
+	vec3_t	bounds[2];
+	int		i;
+
+	if ( occ.viewCount != tr.viewCount || ( ent->e.renderfx & RF_DEPTHHACK ) ) {
+		return qfalse;
+	}
+	if ( ( r_shadows->integer == 2 || r_shadows->integer == 3 ) && !( ent->e.renderfx & RF_NOSHADOW ) ) {
+		return qfalse;
+	}
+
+	for ( i = 0 ; i < 3 ; i++ ) {
+		bounds[0][i] = MIN( oldBounds[0][i], newBounds[0][i] );
+		bounds[1][i] = MAX( oldBounds[1][i], newBounds[1][i] );
+	}
+
+	if ( R_OccludedLocalBox( bounds ) ) {
+		tr.pc.c_occludedEntities++;
+		return qtrue;
+	}
+
+	return qfalse;
+}
@@ -36,6 +36,251 @@ int			r_firstScenePoly;
 int			r_numpolyverts;
 
 
+/*
+===========================================================================
+
+SCENE POLY STORAGE
+
+Polys and their verts are handed out from blocks that are kept from one
+frame to the next.  When a frame needs more than the blocks hold, another
+block is allocated, up to r_maxpolymem megabytes; only past that are polys
+dropped.  Blocks never move once handed out, since draw surfaces point
+into them.
+
+Every poly is a fan, so they all share one packed index list.
+
+===========================================================================
+*/
+
+#define	POLY_BLOCK_SHIFT	10
+#define	POLY_BLOCK_SIZE		( 1 << POLY_BLOCK_SHIFT )
+#define	POLY_BLOCK_MASK		( POLY_BLOCK_SIZE - 1 )
+#define	POLYVERT_BLOCK_SIZE	4096		// also the most verts a single poly can have
+#define	MAX_POLY_BLOCKS		1024
+
+static srfPoly_t	*polyBlocks[MAX_POLY_BLOCKS];
+static int			numPolyBlocks;
+
+static polyVert_t	*polyVertBlocks[MAX_POLY_BLOCKS];
+static int			numPolyVertBlocks;
+static int			polyVertBlock;		// block the next verts come from
+static int			polyVertOffset;
+
+static int			polyMemory;			// bytes held by the blocks
+
+static glIndex_t	polyFanIndexes[3 * ( POLYVERT_BLOCK_SIZE - 2 )];
+
+typedef struct {
+	int		dropped;			// this frame
+
+	int		peakPolys;
+	int		peakVerts;
+	int		peakDropped;
+	int		framesDropping;
+	int		totalDropped;
+	int		frames;
+} polyStats_t;
+
+static polyStats_t	polyStats;
+
+#define	R_ScenePoly( n )	( &polyBlocks[(n) >> POLY_BLOCK_SHIFT][(n) & POLY_BLOCK_MASK] )
+
+/*
+====================
+R_PolyMemoryBudget
+====================
+*/
+static int R_PolyMemoryBudget( void ) {
+	if ( r_maxpolymem->integer < 1 ) {
+		return 1024 * 1024;
+	}
+	return r_maxpolymem->integer * 1024 * 1024;
+}
+
+/*
+====================
+R_AllocPolyBlock
+
+Returns qfalse if the budget is spent.  The blocks reserved at startup
+don't count against it.
+====================
+*/
+static qboolean R_AllocPolyBlock( qboolean reserve ) {
+	int		size;
+
+	size = POLY_BLOCK_SIZE * sizeof( srfPoly_t );
+	if ( numPolyBlocks == MAX_POLY_BLOCKS ) {
+		return qfalse;
+	}
+	if ( !reserve && polyMemory + size > R_PolyMemoryBudget() ) {
+		return qfalse;
+	}
+	polyBlocks[numPolyBlocks++] = ri.Malloc( size );
+	polyMemory += size;
+	return qtrue;
+}
+
+/*
+====================
+R_AllocPolyVertBlock
+====================
+*/
+static qboolean R_AllocPolyVertBlock( qboolean reserve ) {
+	int		size;
+
+	size = POLYVERT_BLOCK_SIZE * sizeof( polyVert_t );
+	if ( numPolyVertBlocks == MAX_POLY_BLOCKS ) {
+		return qfalse;
+	}
+	if ( !reserve && polyMemory + size > R_PolyMemoryBudget() ) {
+		return qfalse;
+	}
+	polyVertBlocks[numPolyVertBlocks++] = ri.Malloc( size );
+	polyMemory += size;
+	return qtrue;
+}
+
+/*
+====================
+R_InitScenePolys
+
+Reserves room for r_maxpolys polys and r_maxpolyverts verts up front.
+====================
+*/
+void R_InitScenePolys( void ) {
+	int		i;
+
+	R_ShutdownScenePolys();
+
+	for ( i = 0 ; i < POLYVERT_BLOCK_SIZE - 2 ; i++ ) {
+		polyFanIndexes[i*3+0] = 0;
+		polyFanIndexes[i*3+1] = i + 1;
+		polyFanIndexes[i*3+2] = i + 2;
+	}
+
+	while ( numPolyBlocks * POLY_BLOCK_SIZE < max_polys && R_AllocPolyBlock( qtrue ) ) {
+	}
+	while ( numPolyVertBlocks * POLYVERT_BLOCK_SIZE < max_polyverts && R_AllocPolyVertBlock( qtrue ) ) {
+	}
+}
+
+/*
+====================
+R_ShutdownScenePolys
+====================
+*/
+void R_ShutdownScenePolys( void ) {
+	int		i;
+
+	for ( i = 0 ; i < numPolyBlocks ; i++ ) {
+		ri.Free( polyBlocks[i] );
+	}
+	for ( i = 0 ; i < numPolyVertBlocks ; i++ ) {
+		ri.Free( polyVertBlocks[i] );
+	}
+	numPolyBlocks = 0;
+	numPolyVertBlocks = 0;
+	polyVertBlock = 0;
+	polyVertOffset = 0;
+	polyMemory = 0;
+	Com_Memset( &polyStats, 0, sizeof( polyStats ) );
+}
+
+/*
+====================
+R_AllocScenePoly
+
+Returns NULL if the poly doesn't fit in the budget.
+====================
+*/
+static srfPoly_t *R_AllocScenePoly( int numVerts ) {
+	srfPoly_t	*poly;
+
+	if ( numVerts > POLYVERT_BLOCK_SIZE ) {
+		return NULL;
+	}
+
+	if ( r_numpolys == numPolyBlocks * POLY_BLOCK_SIZE && !R_AllocPolyBlock( qfalse ) ) {
+		return NULL;
+	}
+
+	// a poly's verts never straddle two blocks
+	if ( polyVertOffset + numVerts > POLYVERT_BLOCK_SIZE ) {
+		if ( polyVertBlock + 1 == numPolyVertBlocks && !R_AllocPolyVertBlock( qfalse ) ) {
+			return NULL;
+		}
+		polyVertBlock++;
+		polyVertOffset = 0;
+	}
+	if ( polyVertBlock == numPolyVertBlocks && !R_AllocPolyVertBlock( qfalse ) ) {
+		return NULL;
+	}
+
+	poly = R_ScenePoly( r_numpolys );
+	poly->numVerts = numVerts;
+	poly->verts = &polyVertBlocks[polyVertBlock][polyVertOffset];
+	poly->numIndexes = numVerts > 2 ? 3 * ( numVerts - 2 ) : 0;
+	poly->indexes = polyFanIndexes;
+
+	r_numpolys++;
+	r_numpolyverts += numVerts;
+	polyVertOffset += numVerts;
+
+	return poly;
+}
+
+/*
+====================
+R_EndFramePolys
+
+Folds this frame's poly traffic into the stats and starts the blocks over.
+====================
+*/
+static void R_EndFramePolys( void ) {
+	if ( r_numpolys > polyStats.peakPolys ) {
+		polyStats.peakPolys = r_numpolys;
+	}
+	if ( r_numpolyverts > polyStats.peakVerts ) {
+		polyStats.peakVerts = r_numpolyverts;
+	}
+	if ( polyStats.dropped ) {
+		if ( polyStats.dropped > polyStats.peakDropped ) {
+			polyStats.peakDropped = polyStats.dropped;
+		}
+		polyStats.framesDropping++;
+		polyStats.totalDropped += polyStats.dropped;
+		ri.Printf( PRINT_DEVELOPER, "WARNING: %i polys dropped this frame, r_maxpolymem reached\n", polyStats.dropped );
+	}
+	polyStats.dropped = 0;
+	polyStats.frames++;
+
+	polyVertBlock = 0;
+	polyVertOffset = 0;
+}
+
+/*
+====================
+R_PolyInfo_f
+
+polyinfo [reset]
+====================
+*/
+void R_PolyInfo_f( void ) {
+	if ( ri.Cmd_Argc() > 1 && !Q_stricmp( ri.Cmd_Argv( 1 ), "reset" ) ) {
+		Com_Memset( &polyStats, 0, sizeof( polyStats ) );
+		ri.Printf( PRINT_ALL, "poly stats reset\n" );
+		return;
+	}
+
+	ri.Printf( PRINT_ALL, "%i frames\n", polyStats.frames );
+	ri.Printf( PRINT_ALL, "peak polys:    %6i of %i held\n", polyStats.peakPolys, numPolyBlocks * POLY_BLOCK_SIZE );
+	ri.Printf( PRINT_ALL, "peak verts:    %6i of %i held\n", polyStats.peakVerts, numPolyVertBlocks * POLYVERT_BLOCK_SIZE );
+	ri.Printf( PRINT_ALL, "memory:        %6i KB of %i KB\n", polyMemory / 1024, R_PolyMemoryBudget() / 1024 );
+	ri.Printf( PRINT_ALL, "dropped:       %6i in %i frames, at most %i in one\n",
+		polyStats.totalDropped, polyStats.framesDropping, polyStats.peakDropped );
+}
+
+
 /*
 ====================
 R_InitNextFrame
@@ -45,6 +290,8 @@ R_InitNextFrame
 void R_InitNextFrame( void ) {
 	backEndData->commands.used = 0;
 
+	R_EndFramePolys();
+
 	r_firstSceneDrawSurf = 0;
 
 	r_numdlights = 0;
@@ -97,7 +344,8 @@ void R_AddPolygonSurfaces( void ) {
 	tr.shiftedEntityNum = tr.currentEntityNum << QSORT_REFENTITYNUM_SHIFT;
 	fogMask = -((tr.refdef.rdflags & RDF_NOFOG) == 0);
 
-	for ( i = 0, poly = tr.refdef.polys; i < tr.refdef.numPolys ; i++, poly++ ) {
+	for ( i = 0 ; i < tr.refdef.numPolys ; i++ ) {
+		poly = R_ScenePoly( tr.refdef.firstPoly + i );
 		sh = R_GetShaderByHandle( poly->hShader );
 		R_AddDrawSurf( ( void * )poly, sh, poly->fogIndex & fogMask, qfalse, qfalse, 0 /*cubeMap*/  );
 	}
@@ -128,23 +376,16 @@ void RE_AddPolyToScene( qhandle_t hShader, int numVerts, const polyVert_t *verts
 	}
 
 	for ( j = 0; j < numPolys; j++ ) {
-		if ( r_numpolyverts + numVerts > max_polyverts || r_numpolys >= max_polys ) {
-      /*
-      NOTE TTimo this was initially a PRINT_WARNING
-      but it happens a lot with high fighting scenes and particles
-      since we don't plan on changing the const and making for room for those effects
-      simply cut this message to developer only
-      */
-			ri.Printf( PRINT_DEVELOPER, "WARNING: RE_AddPolyToScene: r_max_polys or r_max_polyverts reached\n");
+		poly = R_AllocScenePoly( numVerts );
+		if ( !poly ) {
+			// counted and reported once the frame is done
+			polyStats.dropped += numPolys - j;
 			return;
 		}
 
-		poly = &backEndData->polys[r_numpolys];
 		poly->surfaceType = SF_POLY;
 		poly->hShader = hShader;
-		poly->numVerts = numVerts;
-		poly->verts = &backEndData->polyVerts[r_numpolyverts];
-		
+
 		Com_Memcpy( poly->verts, &verts[numVerts*j], numVerts * sizeof( *verts ) );
 
 		if ( glConfig.hardwareType == GLHW_RAGEPRO ) {
@@ -153,9 +394,6 @@ void RE_AddPolyToScene( qhandle_t hShader, int numVerts, const polyVert_t *verts
 			poly->verts->modulate[2] = 255;
 			poly->verts->modulate[3] = 255;
 		}
-		// done.
-		r_numpolys++;
-		r_numpolyverts += numVerts;
 
 		// if no world is loaded
 		if ( tr.world == NULL ) {
@@ -412,7 +650,7 @@ void RE_BeginScene(const refdef_t *fd)
 	tr.refdef.dlights = &backEndData->dlights[r_firstSceneDlight];
 
 	tr.refdef.numPolys = r_numpolys - r_firstScenePoly;
-	tr.refdef.polys = &backEndData->polys[r_firstScenePoly];
+	tr.refdef.firstPoly = r_firstScenePoly;
 
 	tr.refdef.num_pshadows = 0;
 	tr.refdef.pshadows = &backEndData->pshadows[0];
@@ -26,6 +26,24 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #include <altivec.h>
 #endif
 
+#if defined(__SSE2__) || idx64
+#define idsse2 1
+#include <emmintrin.h>
+#else
+#define idsse2 0
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define idneon 1
+#include <arm_neon.h>
+#else
+#define idneon 0
+#endif
+
+static qboolean	deformScalar;		// for deformBench
+
+static void R_CaptureDeformBatch( void );
+
 
 #define	WAVEVALUE( table, base, amplitude, phase, freq )  ((base) + table[ ( (int64_t) ( ( (phase) + tess.shaderTime * (freq) ) * FUNCTABLE_SIZE ) ) & FUNCTABLE_MASK ] * (amplitude))
 
@@ -104,6 +122,175 @@ DEFORMATIONS
 ====================================================================
 */
 
+#if idsse2 || idneon
+// per vertex scales for the wave and bulge deforms
+static float	deformScales[SHADER_MAX_VERTEXES] QALIGN(16);
+
+/*
+========================
+RB_OffsetAlongNormals
+
+Moves every vertex along its normal by its own scale, or by scale for
+all of them if scales is NULL.  The w of the position is left alone.
+========================
+*/
+static void RB_OffsetAlongNormals( const float *scales, float scale )
+{
+	float	*xyz = ( float * ) tess.xyz;
+	int16_t	*normal = tess.normal[0];
+	int		i;
+#if idsse2
+	const __m128	xyzMask = _mm_castsi128_ps( _mm_set_epi32( 0, -1, -1, -1 ) );
+	const __m128	unpack = _mm_set1_ps( 1.0f / 32767.0f );
+	__m128			s, n;
+	__m128i			n16;
+
+	s = _mm_set1_ps( scale );
+	for ( i = 0; i < tess.numVertexes; i++, xyz += 4, normal += 4 )
+	{
+		if ( scales )
+		{
+			s = _mm_set1_ps( scales[i] );
+		}
+		n16 = _mm_loadl_epi64( ( const __m128i * ) normal );
+		n = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpacklo_epi16( n16, n16 ), 16 ) );
+		n = _mm_and_ps( _mm_mul_ps( n, unpack ), xyzMask );
+		_mm_store_ps( xyz, _mm_add_ps( _mm_load_ps( xyz ), _mm_mul_ps( n, s ) ) );
+	}
+#else
+	static const uint32_t	xyzBits[4] = { 0xffffffff, 0xffffffff, 0xffffffff, 0 };
+	const uint32x4_t		xyzMask = vld1q_u32( xyzBits );
+	float32x4_t				n;
+
+	for ( i = 0; i < tess.numVertexes; i++, xyz += 4, normal += 4 )
+	{
+		if ( scales )
+		{
+			scale = scales[i];
+		}
+		n = vcvtq_f32_s32( vmovl_s16( vld1_s16( normal ) ) );
+		n = vmulq_n_f32( n, 1.0f / 32767.0f );
+		n = vreinterpretq_f32_u32( vandq_u32( vreinterpretq_u32_f32( n ), xyzMask ) );
+		vst1q_f32( xyz, vmlaq_n_f32( vld1q_f32( xyz ), n, scale ) );
+	}
+#endif
+}
+
+/*
+========================
+RB_WaveScales
+
+The wave of each vertex for RB_CalcDeformVertexes.  The spread is summed
+four vertexes at a time; the table index is still taken in double, as
+the scalar code does, so the same entries come out of the table.
+========================
+*/
+static void RB_WaveScales( const deformStage_t *ds, const float *table, float *scales )
+{
+	const float	*xyz = ( const float * ) tess.xyz;
+	double		now;
+	float		phase[4] QALIGN(16);
+	float		value[4] QALIGN(16);
+	int			i, j;
+#if idsse2
+	__m128		x, y, z, w;
+#else
+	float32x4x4_t	v;
+#endif
+
+	now = tess.shaderTime * ds->deformationWave.frequency;
+
+	for ( i = 0; i + 4 <= tess.numVertexes; i += 4, xyz += 16 )
+	{
+#if idsse2
+		x = _mm_load_ps( xyz );
+		y = _mm_load_ps( xyz + 4 );
+		z = _mm_load_ps( xyz + 8 );
+		w = _mm_load_ps( xyz + 12 );
+		_MM_TRANSPOSE4_PS( x, y, z, w );
+		x = _mm_mul_ps( _mm_add_ps( _mm_add_ps( x, y ), z ), _mm_set1_ps( ds->deformationSpread ) );
+		_mm_store_ps( phase, _mm_add_ps( _mm_set1_ps( ds->deformationWave.phase ), x ) );
+#else
+		v = vld4q_f32( xyz );
+		v.val[0] = vmulq_n_f32( vaddq_f32( vaddq_f32( v.val[0], v.val[1] ), v.val[2] ), ds->deformationSpread );
+		vst1q_f32( phase, vaddq_f32( vdupq_n_f32( ds->deformationWave.phase ), v.val[0] ) );
+#endif
+		for ( j = 0; j < 4; j++ )
+		{
+			value[j] = table[ ( (int64_t) ( ( phase[j] + now ) * FUNCTABLE_SIZE ) ) & FUNCTABLE_MASK ];
+		}
+#if idsse2
+		_mm_store_ps( scales + i, _mm_add_ps( _mm_set1_ps( ds->deformationWave.base ),
+			_mm_mul_ps( _mm_load_ps( value ), _mm_set1_ps( ds->deformationWave.amplitude ) ) ) );
+#else
+		vst1q_f32( scales + i, vmlaq_n_f32( vdupq_n_f32( ds->deformationWave.base ),
+			vld1q_f32( value ), ds->deformationWave.amplitude ) );
+#endif
+	}
+
+	for ( ; i < tess.numVertexes; i++, xyz += 4 )
+	{
+		float off = ( xyz[0] + xyz[1] + xyz[2] ) * ds->deformationSpread;
+
+		scales[i] = WAVEVALUE( table, ds->deformationWave.base, 
+			ds->deformationWave.amplitude,
+			ds->deformationWave.phase + off,
+			ds->deformationWave.frequency );
+	}
+}
+
+/*
+========================
+RB_BulgeScales
+
+The bulge of each vertex for RB_CalcBulgeVertexes, along the same lines
+as RB_WaveScales.
+========================
+*/
+static void RB_BulgeScales( const deformStage_t *ds, double now, float *scales )
+{
+	const float	*st = ( const float * ) tess.texCoords[0];
+	float		width[4] QALIGN(16);
+	float		value[4] QALIGN(16);
+	int64_t		off;
+	int			i, j;
+#if idsse2
+	__m128		a, b;
+#else
+	float32x4x2_t	v;
+#endif
+
+	for ( i = 0; i + 4 <= tess.numVertexes; i += 4, st += 8 )
+	{
+#if idsse2
+		a = _mm_load_ps( st );
+		b = _mm_load_ps( st + 4 );
+		a = _mm_shuffle_ps( a, b, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+		_mm_store_ps( width, _mm_mul_ps( a, _mm_set1_ps( ds->bulgeWidth ) ) );
+#else
+		v = vld2q_f32( st );
+		vst1q_f32( width, vmulq_n_f32( v.val[0], ds->bulgeWidth ) );
+#endif
+		for ( j = 0; j < 4; j++ )
+		{
+			off = (float)( FUNCTABLE_SIZE / (M_PI*2) ) * ( width[j] + now );
+			value[j] = tr.sinTable[ off & FUNCTABLE_MASK ];
+		}
+#if idsse2
+		_mm_store_ps( scales + i, _mm_mul_ps( _mm_load_ps( value ), _mm_set1_ps( ds->bulgeHeight ) ) );
+#else
+		vst1q_f32( scales + i, vmulq_n_f32( vld1q_f32( value ), ds->bulgeHeight ) );
+#endif
+	}
+
+	for ( ; i < tess.numVertexes; i++, st += 2 )
+	{
+		off = (float)( FUNCTABLE_SIZE / (M_PI*2) ) * ( st[0] * ds->bulgeWidth + now );
+		scales[i] = tr.sinTable[ off & FUNCTABLE_MASK ] * ds->bulgeHeight;
+	}
+}
+#endif
+
 /*
 ========================
 RB_CalcDeformVertexes
@@ -119,6 +306,22 @@ void RB_CalcDeformVertexes( deformStage_t *ds )
 	int16_t	*normal = tess.normal[0];
 	float	*table;
 
+#if idsse2 || idneon
+	if ( !deformScalar )
+	{
+		if ( ds->deformationWave.frequency == 0 )
+		{
+			RB_OffsetAlongNormals( NULL, EvalWaveForm( &ds->deformationWave ) );
+		}
+		else
+		{
+			RB_WaveScales( ds, TableForFunc( ds->deformationWave.func ), deformScales );
+			RB_OffsetAlongNormals( deformScales, 0 );
+		}
+		return;
+	}
+#endif
+
 	if ( ds->deformationWave.frequency == 0 )
 	{
 		scale = EvalWaveForm( &ds->deformationWave );
@@ -208,6 +411,14 @@ void RB_CalcBulgeVertexes( deformStage_t *ds ) {
 
 	now = backEnd.refdef.time * 0.001 * ds->bulgeSpeed;
 
+#if idsse2 || idneon
+	if ( !deformScalar ) {
+		RB_BulgeScales( ds, now, deformScales );
+		RB_OffsetAlongNormals( deformScales, 0 );
+		return;
+	}
+#endif
+
 	for ( i = 0; i < tess.numVertexes; i++, xyz += 4, st += 2, normal += 4 ) {
 		int64_t off;
 		float scale;
@@ -346,6 +557,162 @@ static void GlobalVectorToLocal( const vec3_t in, vec3_t out ) {
 	out[2] = DotProduct( in, backEnd.or.axis[2] );
 }
 
+#if idsse2 || idneon
+/*
+=====================
+AutospriteDeformVector
+
+AutospriteDeform with the corners of each sprite worked out four floats
+at a time, and what is the same for every sprite worked out only once.
+The numbers that come out are the ones RB_AddQuadStamp would write.
+=====================
+*/
+static void AutospriteDeformVector( int oldVerts, const vec3_t leftDir, const vec3_t upDir ) {
+	int			i, j;
+	float		*xyz;
+	float		radius;
+	float		axisLength;
+	vec4_t		delta, color;
+	vec3_t		normal;
+	int16_t		iNormal[4];
+	uint16_t	iColor[4];
+	glIndex_t	*index;
+#if idsse2
+	const __m128	wMask = _mm_castsi128_ps( _mm_set_epi32( -1, 0, 0, 0 ) );
+	__m128		a, b, c, d;
+	__m128		mid, left, up, lDir, uDir, axisScale;
+#else
+	static const uint32_t	wBits[4] = { 0, 0, 0, 0xffffffff };
+	const uint32x4_t	wMask = vld1q_u32( wBits );
+	float32x4_t	a, b, c, d;
+	float32x4_t	mid, left, up, lDir, uDir;
+#endif
+
+	RB_CheckVao( tess.vao );
+
+	// compensate for scale in the axes if necessary
+	axisLength = 1.0f;
+	if ( backEnd.currentEntity->e.nonNormalizedAxes ) {
+		axisLength = VectorLength( backEnd.currentEntity->e.axis[0] );
+		if ( !axisLength ) {
+			axisLength = 0;
+		} else {
+			axisLength = 1.0f / axisLength;
+		}
+	}
+
+	// constant normal all the way around
+	VectorSubtract( vec3_origin, backEnd.viewParms.or.axis[0], normal );
+	R_VaoPackNormal( iNormal, normal );
+
+#if idsse2
+	lDir = _mm_set_ps( 0, leftDir[2], leftDir[1], leftDir[0] );
+	uDir = _mm_set_ps( 0, upDir[2], upDir[1], upDir[0] );
+	axisScale = _mm_set1_ps( axisLength );
+#else
+	lDir = vsetq_lane_f32( leftDir[0], vdupq_n_f32( 0 ), 0 );
+	lDir = vsetq_lane_f32( leftDir[1], lDir, 1 );
+	lDir = vsetq_lane_f32( leftDir[2], lDir, 2 );
+	uDir = vsetq_lane_f32( upDir[0], vdupq_n_f32( 0 ), 0 );
+	uDir = vsetq_lane_f32( upDir[1], uDir, 1 );
+	uDir = vsetq_lane_f32( upDir[2], uDir, 2 );
+#endif
+
+	for ( i = 0 ; i < oldVerts ; i+=4 ) {
+		xyz = tess.xyz[i];
+
+#if idsse2
+		a = _mm_load_ps( xyz );
+		b = _mm_load_ps( xyz + 4 );
+		c = _mm_load_ps( xyz + 8 );
+		d = _mm_load_ps( xyz + 12 );
+
+		// find the midpoint
+		mid = _mm_mul_ps( _mm_set1_ps( 0.25f ), _mm_add_ps( _mm_add_ps( _mm_add_ps( a, b ), c ), d ) );
+		_mm_storeu_ps( delta, _mm_sub_ps( a, mid ) );
+		radius = VectorLength( delta ) * 0.707f;		// / sqrt(2)
+
+		left = _mm_mul_ps( lDir, _mm_set1_ps( radius ) );
+		up = _mm_mul_ps( uDir, _mm_set1_ps( radius ) );
+		if ( backEnd.viewParms.isMirror ) {
+			left = _mm_sub_ps( _mm_setzero_ps(), left );
+		}
+		if ( backEnd.currentEntity->e.nonNormalizedAxes ) {
+			left = _mm_mul_ps( left, axisScale );
+			up = _mm_mul_ps( up, axisScale );
+		}
+
+		// the corners, keeping each vertex's w
+		a = _mm_or_ps( _mm_and_ps( a, wMask ), _mm_andnot_ps( wMask, _mm_add_ps( _mm_add_ps( mid, left ), up ) ) );
+		b = _mm_or_ps( _mm_and_ps( b, wMask ), _mm_andnot_ps( wMask, _mm_add_ps( _mm_sub_ps( mid, left ), up ) ) );
+		c = _mm_or_ps( _mm_and_ps( c, wMask ), _mm_andnot_ps( wMask, _mm_sub_ps( _mm_sub_ps( mid, left ), up ) ) );
+		d = _mm_or_ps( _mm_and_ps( d, wMask ), _mm_andnot_ps( wMask, _mm_sub_ps( _mm_add_ps( mid, left ), up ) ) );
+
+		_mm_store_ps( xyz, a );
+		_mm_store_ps( xyz + 4, b );
+		_mm_store_ps( xyz + 8, c );
+		_mm_store_ps( xyz + 12, d );
+#else
+		a = vld1q_f32( xyz );
+		b = vld1q_f32( xyz + 4 );
+		c = vld1q_f32( xyz + 8 );
+		d = vld1q_f32( xyz + 12 );
+
+		// find the midpoint
+		mid = vmulq_n_f32( vaddq_f32( vaddq_f32( vaddq_f32( a, b ), c ), d ), 0.25f );
+		vst1q_f32( delta, vsubq_f32( a, mid ) );
+		radius = VectorLength( delta ) * 0.707f;		// / sqrt(2)
+
+		left = vmulq_n_f32( lDir, radius );
+		up = vmulq_n_f32( uDir, radius );
+		if ( backEnd.viewParms.isMirror ) {
+			left = vsubq_f32( vdupq_n_f32( 0 ), left );
+		}
+		if ( backEnd.currentEntity->e.nonNormalizedAxes ) {
+			left = vmulq_n_f32( left, axisLength );
+			up = vmulq_n_f32( up, axisLength );
+		}
+
+		// the corners, keeping each vertex's w
+		vst1q_f32( xyz, vbslq_f32( wMask, a, vaddq_f32( vaddq_f32( mid, left ), up ) ) );
+		vst1q_f32( xyz + 4, vbslq_f32( wMask, b, vaddq_f32( vsubq_f32( mid, left ), up ) ) );
+		vst1q_f32( xyz + 8, vbslq_f32( wMask, c, vsubq_f32( vsubq_f32( mid, left ), up ) ) );
+		vst1q_f32( xyz + 12, vbslq_f32( wMask, d, vsubq_f32( vaddq_f32( mid, left ), up ) ) );
+#endif
+
+		VectorScale4( tess.color[i], 1.0f / 65535.0f, color );
+		R_VaoPackColor( iColor, color );
+
+		for ( j = 0 ; j < 4 ; j++ ) {
+			VectorCopy4( iNormal, tess.normal[i + j] );
+			VectorCopy4( iColor, tess.color[i + j] );
+		}
+
+		// standard square texture coordinates
+		VectorSet2( tess.texCoords[i], 0, 0 );
+		VectorSet2( tess.lightCoords[i], 0, 0 );
+		VectorSet2( tess.texCoords[i + 1], 1, 0 );
+		VectorSet2( tess.lightCoords[i + 1], 1, 0 );
+		VectorSet2( tess.texCoords[i + 2], 1, 1 );
+		VectorSet2( tess.lightCoords[i + 2], 1, 1 );
+		VectorSet2( tess.texCoords[i + 3], 0, 1 );
+		VectorSet2( tess.lightCoords[i + 3], 0, 1 );
+
+		// triangle indexes for a simple quad
+		index = tess.indexes + tess.numIndexes;
+		index[0] = i;
+		index[1] = i + 1;
+		index[2] = i + 3;
+		index[3] = i + 3;
+		index[4] = i + 1;
+		index[5] = i + 2;
+
+		tess.numVertexes += 4;
+		tess.numIndexes += 6;
+	}
+}
+#endif
+
 /*
 =====================
 AutospriteDeform
@@ -383,6 +750,13 @@ static void AutospriteDeform( void ) {
 		VectorCopy( backEnd.viewParms.or.axis[2], upDir );
 	}
 
+#if idsse2 || idneon
+	if ( !deformScalar ) {
+		AutospriteDeformVector( oldVerts, leftDir, upDir );
+		return;
+	}
+#endif
+
 	for ( i = 0 ; i < oldVerts ; i+=4 ) {
 		vec4_t color;
 		// find the midpoint
@@ -437,11 +811,91 @@ int edgeVerts[6][2] = {
 	{ 2, 3 }
 };
 
+/*
+=====================
+Autosprite2EdgeLengths
+
+The squared lengths of the six edges of a quad, in edgeVerts order.
+=====================
+*/
+static void Autosprite2EdgeLengths( const float *xyz, float *lengths ) {
+	int		j;
+#if idsse2
+	__m128	a, b, c, d;
+	__m128	e0, e1, e2, e3, e4, e5, zero;
+
+	if ( !deformScalar ) {
+		a = _mm_load_ps( xyz );
+		b = _mm_load_ps( xyz + 4 );
+		c = _mm_load_ps( xyz + 8 );
+		d = _mm_load_ps( xyz + 12 );
+
+		e0 = _mm_sub_ps( a, b );
+		e1 = _mm_sub_ps( a, c );
+		e2 = _mm_sub_ps( a, d );
+		e3 = _mm_sub_ps( b, c );
+		e4 = _mm_sub_ps( b, d );
+		e5 = _mm_sub_ps( c, d );
+		zero = _mm_setzero_ps();
+
+		// x, y and z of four edges to a register, then the last two
+		_MM_TRANSPOSE4_PS( e0, e1, e2, e3 );
+		_mm_storeu_ps( lengths, _mm_add_ps( _mm_add_ps( _mm_mul_ps( e0, e0 ), _mm_mul_ps( e1, e1 ) ), _mm_mul_ps( e2, e2 ) ) );
+		a = zero;
+		b = zero;
+		_MM_TRANSPOSE4_PS( e4, e5, a, b );
+		_mm_storel_pi( (__m64 *)( lengths + 4 ),
+			_mm_add_ps( _mm_add_ps( _mm_mul_ps( e4, e4 ), _mm_mul_ps( e5, e5 ) ), _mm_mul_ps( a, a ) ) );
+		return;
+	}
+#elif idneon
+	float32x4_t	a, b, c, d, e;
+	float		m[6][4] QALIGN(16);
+
+	if ( !deformScalar ) {
+		a = vld1q_f32( xyz );
+		b = vld1q_f32( xyz + 4 );
+		c = vld1q_f32( xyz + 8 );
+		d = vld1q_f32( xyz + 12 );
+
+		e = vsubq_f32( a, b );
+		vst1q_f32( m[0], vmulq_f32( e, e ) );
+		e = vsubq_f32( a, c );
+		vst1q_f32( m[1], vmulq_f32( e, e ) );
+		e = vsubq_f32( a, d );
+		vst1q_f32( m[2], vmulq_f32( e, e ) );
+		e = vsubq_f32( b, c );
+		vst1q_f32( m[3], vmulq_f32( e, e ) );
+		e = vsubq_f32( b, d );
+		vst1q_f32( m[4], vmulq_f32( e, e ) );
+		e = vsubq_f32( c, d );
+		vst1q_f32( m[5], vmulq_f32( e, e ) );
+
+		for ( j = 0 ; j < 6 ; j++ ) {
+			lengths[j] = m[j][0] + m[j][1] + m[j][2];
+		}
+		return;
+	}
+#endif
+
+	for ( j = 0 ; j < 6 ; j++ ) {
+		const float	*v1, *v2;
+		vec3_t		temp;
+
+		v1 = xyz + 4 * edgeVerts[j][0];
+		v2 = xyz + 4 * edgeVerts[j][1];
+
+		VectorSubtract( v1, v2, temp );
+		lengths[j] = DotProduct( temp, temp );
+	}
+}
+
 static void Autosprite2Deform( void ) {
 	int		i, j, k;
 	int		indexes;
 	float	*xyz;
 	vec3_t	forward;
+	float	edgeLengths[6];
 
 	if ( tess.numVertexes & 3 ) {
 		ri.Printf( PRINT_WARNING, "Autosprite2 shader %s had odd vertex count\n", tess.shader->name );
@@ -473,16 +927,11 @@ static void Autosprite2Deform( void ) {
 		nums[0] = nums[1] = 0;
 		lengths[0] = lengths[1] = 999999;
 
+		Autosprite2EdgeLengths( xyz, edgeLengths );
 		for ( j = 0 ; j < 6 ; j++ ) {
 			float	l;
-			vec3_t	temp;
-
-			v1 = xyz + 4 * edgeVerts[j][0];
-			v2 = xyz + 4 * edgeVerts[j][1];
 
-			VectorSubtract( v1, v2, temp );
-			
-			l = DotProduct( temp, temp );
+			l = edgeLengths[j];
 			if ( l < lengths[0] ) {
 				nums[1] = nums[0];
 				lengths[1] = lengths[0];
@@ -556,6 +1005,8 @@ void RB_DeformTessGeometry( void ) {
 		return;
 	}
 
+	R_CaptureDeformBatch();
+
 	for ( i = 0 ; i < tess.shader->numDeforms ; i++ ) {
 		ds = &tess.shader->deforms[ i ];
 
@@ -819,3 +1270,270 @@ void RB_CalcRotateTexMatrix( float degsPerSecond, float *matrix )
 	matrix[0] = cosValue; matrix[2] = -sinValue; matrix[4] = 0.5 - 0.5 * cosValue + 0.5 * sinValue;
 	matrix[1] = sinValue; matrix[3] = cosValue;  matrix[5] = 0.5 - 0.5 * sinValue - 0.5 * cosValue;
 }
+
+/*
+====================================================================
+
+BENCHMARK
+
+====================================================================
+*/
+
+#define	DEFORMBENCH_BATCHES		256
+
+typedef struct {
+	int			shader;			// by index, in case the renderer restarts
+	int			numVertexes;
+	int			numIndexes;
+	double		shaderTime;
+	int			time;
+	float		floatTime;
+	vec4_t		*xyz;
+	int16_t		*normal;
+	vec2_t		*texCoords;
+	uint16_t	*color;
+	glIndex_t	*indexes;
+} deformBatch_t;
+
+static deformBatch_t	deformBatches[DEFORMBENCH_BATCHES];
+static int				numDeformBatches;
+static qboolean			deformCapture;
+
+/*
+=================
+R_CaptureDeformBatch
+
+Keeps a copy of the batch about to be deformed, while deformBench is
+capturing.
+=================
+*/
+static void R_CaptureDeformBatch( void ) {
+	deformBatch_t	*b;
+	byte			*buf;
+	int				numVerts;
+
+	if ( !deformCapture ) {
+		return;
+	}
+
+	numVerts = tess.numVertexes;
+	buf = ri.Malloc( numVerts * ( sizeof( vec4_t ) + 4 * sizeof( int16_t ) + sizeof( vec2_t ) + 4 * sizeof( uint16_t ) )
+		+ tess.numIndexes * sizeof( glIndex_t ) );
+
+	b = &deformBatches[numDeformBatches++];
+	b->shader = tess.shader->index;
+	b->numVertexes = numVerts;
+	b->numIndexes = tess.numIndexes;
+	b->shaderTime = tess.shaderTime;
+	b->time = backEnd.refdef.time;
+	b->floatTime = backEnd.refdef.floatTime;
+	b->xyz = (vec4_t *)buf;
+	b->normal = (int16_t *)( b->xyz + numVerts );
+	b->texCoords = (vec2_t *)( b->normal + 4 * numVerts );
+	b->color = (uint16_t *)( b->texCoords + numVerts );
+	b->indexes = (glIndex_t *)( b->color + 4 * numVerts );
+
+	Com_Memcpy( b->xyz, tess.xyz, numVerts * sizeof( vec4_t ) );
+	Com_Memcpy( b->normal, tess.normal, numVerts * 4 * sizeof( int16_t ) );
+	Com_Memcpy( b->texCoords, tess.texCoords, numVerts * sizeof( vec2_t ) );
+	Com_Memcpy( b->color, tess.color, numVerts * 4 * sizeof( uint16_t ) );
+	Com_Memcpy( b->indexes, tess.indexes, tess.numIndexes * sizeof( glIndex_t ) );
+
+	if ( numDeformBatches == DEFORMBENCH_BATCHES ) {
+		deformCapture = qfalse;
+		ri.Printf( PRINT_ALL, "deformBench: captured %i batches\n", numDeformBatches );
+	}
+}
+
+/*
+=================
+R_FreeDeformBatches
+=================
+*/
+void R_FreeDeformBatches( void ) {
+	int		i;
+
+	for ( i = 0; i < numDeformBatches; i++ ) {
+		ri.Free( deformBatches[i].xyz );
+	}
+	numDeformBatches = 0;
+	deformCapture = qfalse;
+}
+
+/*
+=================
+R_ReplayDeformBatch
+
+Puts a captured batch back in tess and deforms it again, as it was
+deformed when it was captured.  The copy is the same work either way,
+so it is timed on its own too.
+=================
+*/
+static void R_ReplayDeformBatch( const deformBatch_t *b, qboolean deform ) {
+	Com_Memcpy( tess.xyz, b->xyz, b->numVertexes * sizeof( vec4_t ) );
+	Com_Memcpy( tess.normal, b->normal, b->numVertexes * 4 * sizeof( int16_t ) );
+	Com_Memcpy( tess.texCoords, b->texCoords, b->numVertexes * sizeof( vec2_t ) );
+	Com_Memcpy( tess.color, b->color, b->numVertexes * 4 * sizeof( uint16_t ) );
+	Com_Memcpy( tess.indexes, b->indexes, b->numIndexes * sizeof( glIndex_t ) );
+	tess.numVertexes = b->numVertexes;
+	tess.numIndexes = b->numIndexes;
+	tess.firstIndex = 0;
+
+	if ( !deform ) {
+		return;
+	}
+	tess.shader = tr.shaders[b->shader];
+	tess.shaderTime = b->shaderTime;
+	backEnd.refdef.time = b->time;
+	backEnd.refdef.floatTime = b->floatTime;
+	RB_DeformTessGeometry();
+}
+
+/*
+=================
+R_DeformBenchPass
+=================
+*/
+static int R_DeformBenchPass( int iterations, qboolean deform ) {
+	int		i, j, start;
+
+	start = ri.Milliseconds();
+	for ( i = 0; i < iterations; i++ ) {
+		for ( j = 0; j < numDeformBatches; j++ ) {
+			R_ReplayDeformBatch( &deformBatches[j], deform );
+		}
+	}
+	return ri.Milliseconds() - start;
+}
+
+/*
+=================
+R_DeformBench_f
+
+deformBench [capture | iterations]
+
+Captures the next batches that get deformed on the CPU, then replays
+them through the scalar and vector deforms, timing both and checking
+what they make against each other.  Positions are allowed to be off
+in the last bits; everything else has to match.
+=================
+*/
+void R_DeformBench_f( void ) {
+	vec4_t		*xyz;
+	int16_t		*normal;
+	vec2_t		*texCoords;
+	uint16_t	*color;
+	glIndex_t	*indexes;
+	int			iterations, numVerts, i, j;
+	int			msec[3];
+	float		d, maxDiff;
+	qboolean	same;
+	trRefEntity_t	*entity;
+	vao_t		*vao;
+	int			time;
+	float		floatTime;
+
+	if ( !numDeformBatches || ( ri.Cmd_Argc() > 1 && !Q_stricmp( ri.Cmd_Argv( 1 ), "capture" ) ) ) {
+		R_FreeDeformBatches();
+		deformCapture = qtrue;
+		ri.Printf( PRINT_ALL, "deformBench: capturing the next %i batches deformed on the CPU, "
+			"run deformBench again to time them\n", DEFORMBENCH_BATCHES );
+		return;
+	}
+
+	iterations = ri.Cmd_Argc() > 1 ? atoi( ri.Cmd_Argv( 1 ) ) : 1000;
+	if ( iterations < 1 ) {
+		iterations = 1;
+	}
+	deformCapture = qfalse;
+
+	R_IssuePendingRenderCommands();
+
+	// nothing is drawn, so keep the replays off whatever is bound
+	entity = backEnd.currentEntity;
+	time = backEnd.refdef.time;
+	floatTime = backEnd.refdef.floatTime;
+	vao = tess.vao;
+	backEnd.currentEntity = &tr.worldEntity;
+	tess.vao = glState.currentVao;
+
+	numVerts = 0;
+	for ( i = 0; i < numDeformBatches; i++ ) {
+		numVerts += deformBatches[i].numVertexes;
+	}
+
+	msec[0] = R_DeformBenchPass( iterations, qfalse );
+	deformScalar = qtrue;
+	msec[1] = R_DeformBenchPass( iterations, qtrue );
+	deformScalar = qfalse;
+	msec[2] = R_DeformBenchPass( iterations, qtrue );
+
+	// each batch through both
+	xyz = ri.Hunk_AllocateTempMemory( SHADER_MAX_VERTEXES * sizeof( *xyz ) );
+	normal = ri.Hunk_AllocateTempMemory( SHADER_MAX_VERTEXES * 4 * sizeof( *normal ) );
+	texCoords = ri.Hunk_AllocateTempMemory( SHADER_MAX_VERTEXES * sizeof( *texCoords ) );
+	color = ri.Hunk_AllocateTempMemory( SHADER_MAX_VERTEXES * 4 * sizeof( *color ) );
+	indexes = ri.Hunk_AllocateTempMemory( SHADER_MAX_INDEXES * sizeof( *indexes ) );
+
+	same = qtrue;
+	maxDiff = 0;
+	for ( i = 0; i < numDeformBatches; i++ ) {
+		deformScalar = qtrue;
+		R_ReplayDeformBatch( &deformBatches[i], qtrue );
+		deformScalar = qfalse;
+		numVerts = tess.numVertexes;
+		j = tess.numIndexes;
+		Com_Memcpy( xyz, tess.xyz, numVerts * sizeof( *xyz ) );
+		Com_Memcpy( normal, tess.normal, numVerts * 4 * sizeof( *normal ) );
+		Com_Memcpy( texCoords, tess.texCoords, numVerts * sizeof( *texCoords ) );
+		Com_Memcpy( color, tess.color, numVerts * 4 * sizeof( *color ) );
+		Com_Memcpy( indexes, tess.indexes, j * sizeof( *indexes ) );
+
+		R_ReplayDeformBatch( &deformBatches[i], qtrue );
+		if ( tess.numVertexes != numVerts || tess.numIndexes != j
+			|| memcmp( normal, tess.normal, numVerts * 4 * sizeof( *normal ) )
+			|| memcmp( texCoords, tess.texCoords, numVerts * sizeof( *texCoords ) )
+			|| memcmp( color, tess.color, numVerts * 4 * sizeof( *color ) )
+			|| memcmp( indexes, tess.indexes, j * sizeof( *indexes ) ) ) {
+			same = qfalse;
+			continue;
+		}
+		for ( j = 0; j < numVerts * 4; j++ ) {
+			d = fabs( xyz[0][j] - tess.xyz[0][j] ) / ( 1.0f + fabs( xyz[0][j] ) );
+			if ( d > maxDiff ) {
+				maxDiff = d;
+			}
+		}
+	}
+
+	ri.Hunk_FreeTempMemory( indexes );
+	ri.Hunk_FreeTempMemory( color );
+	ri.Hunk_FreeTempMemory( texCoords );
+	ri.Hunk_FreeTempMemory( normal );
+	ri.Hunk_FreeTempMemory( xyz );
+
+	tess.numVertexes = 0;
+	tess.numIndexes = 0;
+	tess.vao = vao;
+	backEnd.currentEntity = entity;
+	backEnd.refdef.time = time;
+	backEnd.refdef.floatTime = floatTime;
+
+	numVerts = 0;
+	for ( i = 0; i < numDeformBatches; i++ ) {
+		numVerts += deformBatches[i].numVertexes;
+	}
+	ri.Printf( PRINT_ALL, "%i batches, %i vertexes, %i iterations\n", numDeformBatches, numVerts, iterations );
+	ri.Printf( PRINT_ALL, "  copy only:  %8.4f msec an iteration\n", (float)msec[0] / iterations );
+	ri.Printf( PRINT_ALL, "  scalar:     %8.4f msec an iteration, %8.4f deforming\n",
+		(float)msec[1] / iterations, (float)( msec[1] - msec[0] ) / iterations );
+	ri.Printf( PRINT_ALL, "  vector:     %8.4f msec an iteration, %8.4f deforming\n",
+		(float)msec[2] / iterations, (float)( msec[2] - msec[0] ) / iterations );
+	if ( !same ) {
+		ri.Printf( PRINT_ALL, S_COLOR_RED "  scalar and vector deforms DIFFER\n" );
+	} else if ( maxDiff > 1e-5f ) {
+		ri.Printf( PRINT_ALL, S_COLOR_RED "  positions differ by up to %g\n", maxDiff );
+	} else {
+		ri.Printf( PRINT_ALL, "  scalar and vector deforms agree, positions to within %g\n", maxDiff );
+	}
+}
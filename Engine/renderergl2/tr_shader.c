@@ -37,6 +37,24 @@ static	shader_t*		hashTable[FILE_HASH_SIZE];
 #define MAX_SHADERTEXT_HASH		2048
 static char **shaderTextHashTable[MAX_SHADERTEXT_HASH];
 
+// the images asked for while parsing a shader, so the shader cache can save
+// their names instead of pointers
+#define	MAX_PARSED_IMAGES		( MAX_SHADER_STAGES * MAX_IMAGE_ANIMATIONS + 12 )
+
+typedef struct {
+	char		name[MAX_QPATH];
+	int			type;
+	int			flags;
+} shaderCacheImage_t;
+
+static	shaderCacheImage_t	parsedImageNames[MAX_PARSED_IMAGES];
+static	image_t				*parsedImages[MAX_PARSED_IMAGES];
+static	int					numParsedImages;
+static	qboolean			shaderUncacheable;	// set by keywords that do more than fill in the shader
+
+static qboolean R_RestoreCachedShader( void );
+static void R_CacheParsedShader( void );
+
 /*
 ================
 return a hash value for the filename
@@ -593,6 +611,32 @@ static void ParseTexMod( char *_text, shaderStage_t *stage )
 }
 
 
+/*
+===================
+FindShaderImage
+
+R_FindImageFile, remembering what was asked for
+===================
+*/
+static image_t *FindShaderImage( const char *name, imgType_t type, imgFlags_t flags )
+{
+	image_t *image;
+
+	image = R_FindImageFile( name, type, flags );
+
+	if ( image && numParsedImages < MAX_PARSED_IMAGES && strlen( name ) < MAX_QPATH )
+	{
+		Q_strncpyz( parsedImageNames[numParsedImages].name, name, MAX_QPATH );
+		parsedImageNames[numParsedImages].type = type;
+		parsedImageNames[numParsedImages].flags = flags;
+		parsedImages[numParsedImages] = image;
+		numParsedImages++;
+	}
+
+	return image;
+}
+
+
 /*
 ===================
 ParseStage
@@ -654,6 +698,9 @@ static qboolean ParseStage( shaderStage_t *stage, char **text )
 					return qfalse;
 				}
 
+				// depends on the map being loaded
+				shaderUncacheable = qtrue;
+
 				stage->bundle[0].isLightmap = qtrue;
 				if ( shader.lightmapIndex < 0 ) {
 					stage->bundle[0].image[0] = tr.whiteImage;
@@ -687,7 +734,7 @@ static qboolean ParseStage( shaderStage_t *stage, char **text )
 						flags |= IMGFLAG_GENNORMALMAP;
 				}
 
-				stage->bundle[0].image[0] = R_FindImageFile( token, type, flags );
+				stage->bundle[0].image[0] = FindShaderImage( token, type, flags );
 
 				if ( !stage->bundle[0].image[0] )
 				{
@@ -732,7 +779,7 @@ static qboolean ParseStage( shaderStage_t *stage, char **text )
 			}
 
 
-			stage->bundle[0].image[0] = R_FindImageFile( token, type, flags );
+			stage->bundle[0].image[0] = FindShaderImage( token, type, flags );
 			if ( !stage->bundle[0].image[0] )
 			{
 				ri.Printf( PRINT_WARNING, "WARNING: R_FindImageFile could not find '%s' in shader '%s'\n", token, shader.name );
@@ -772,7 +819,7 @@ static qboolean ParseStage( shaderStage_t *stage, char **text )
 					if (!shader.noPicMip)
 						flags |= IMGFLAG_PICMIP;
 
-					stage->bundle[0].image[num] = R_FindImageFile( token, IMGTYPE_COLORALPHA, flags );
+					stage->bundle[0].image[num] = FindShaderImage( token, IMGTYPE_COLORALPHA, flags );
 					if ( !stage->bundle[0].image[num] )
 					{
 						ri.Printf( PRINT_WARNING, "WARNING: R_FindImageFile could not find '%s' in shader '%s'\n", token, shader.name );
@@ -797,6 +844,7 @@ static qboolean ParseStage( shaderStage_t *stage, char **text )
 				return qfalse;
 			}
 			stage->bundle[0].videoMapHandle = ri.CIN_PlayCinematic( token, 0, 0, 256, 256, (CIN_loop | CIN_silent | CIN_shader));
+			shaderUncacheable = qtrue;
 			if (stage->bundle[0].videoMapHandle != -1) {
 				stage->bundle[0].isVideoMap = qtrue;
 				stage->bundle[0].image[0] = tr.scratchImage[stage->bundle[0].videoMapHandle];
@@ -1584,7 +1632,7 @@ static void ParseSkyParms( char **text ) {
 		for (i=0 ; i<6 ; i++) {
 			Com_sprintf( pathname, sizeof(pathname), "%s_%s.tga"
 				, token, suf[i] );
-			shader.sky.outerbox[i] = R_FindImageFile( ( char * ) pathname, IMGTYPE_COLORALPHA, imgFlags | IMGFLAG_CLAMPTOEDGE );
+			shader.sky.outerbox[i] = FindShaderImage( pathname, IMGTYPE_COLORALPHA, imgFlags | IMGFLAG_CLAMPTOEDGE );
 
 			if ( !shader.sky.outerbox[i] ) {
 				shader.sky.outerbox[i] = tr.defaultImage;
@@ -1615,7 +1663,7 @@ static void ParseSkyParms( char **text ) {
 		for (i=0 ; i<6 ; i++) {
 			Com_sprintf( pathname, sizeof(pathname), "%s_%s.tga"
 				, token, suf[i] );
-			shader.sky.innerbox[i] = R_FindImageFile( ( char * ) pathname, IMGTYPE_COLORALPHA, imgFlags );
+			shader.sky.innerbox[i] = FindShaderImage( pathname, IMGTYPE_COLORALPHA, imgFlags );
 			if ( !shader.sky.innerbox[i] ) {
 				shader.sky.innerbox[i] = tr.defaultImage;
 			}
@@ -1807,6 +1855,8 @@ static qboolean ParseShader( char **text )
 			float	a, b;
 			qboolean isGL2Sun = qfalse;
 
+			shaderUncacheable = qtrue;
+
 			if (!Q_stricmp( token, "q3gl2_sun" ) && r_sunShadows->integer )
 			{
 				isGL2Sun = qtrue;
@@ -1854,6 +1904,8 @@ static qboolean ParseShader( char **text )
 		}
 		// tonemap parms
 		else if ( !Q_stricmp( token, "q3gl2_tonemap" ) ) {
+			shaderUncacheable = qtrue;
+
 			token = COM_ParseExt( text, qfalse );
 			tr.toneMinAvgMaxLevel[0] = atof( token );
 			token = COM_ParseExt( text, qfalse );
@@ -2660,6 +2712,12 @@ static void FixRenderCommandList( int newShader ) {
 				curCmd = (const void *)(sp_cmd + 1);
 				break;
 				}
+			case RC_DRAW_STRING:
+				{
+				const drawStringCommand_t *st_cmd = (const drawStringCommand_t *)curCmd;
+				curCmd = (const void *)((const char *)(st_cmd + 1) + st_cmd->length);
+				break;
+				}
 			case RC_DRAW_SURFS:
 				{
 				int i;
@@ -3207,6 +3265,77 @@ shader_t *R_FindShaderByName( const char *name ) {
 	return tr.defaultShader;
 }
 
+/*
+====================
+R_PrefetchShaderImages
+
+Hands the images a shader is going to load to the image workers, so
+they decode while registration gets on with everything else.
+====================
+*/
+static qboolean PrefetchKeyword( const char *token, const char *keyword ) {
+	int		len = strlen( keyword );
+
+	if ( Q_stricmpn( token, keyword, len ) ) {
+		return qfalse;
+	}
+
+	// map2, animMap3 and so on
+	return !token[len] || ( token[len] >= '0' && token[len] <= '9' && !token[len+1] );
+}
+
+void R_PrefetchShaderImages( const char *shaderName ) {
+	char		strippedName[MAX_QPATH];
+	char		*p, *token;
+	int			depth;
+
+	if ( !R_ImageJobsActive() || !shaderName || !shaderName[0] ) {
+		return;
+	}
+
+	COM_StripExtension( shaderName, strippedName, sizeof( strippedName ) );
+	if ( R_FindShaderByName( strippedName ) != tr.defaultShader ) {
+		return;
+	}
+
+	p = FindShaderInShaderText( strippedName );
+	if ( !p ) {
+		// no shader text, so R_FindShader will look for an image
+		R_PrefetchImage( shaderName );
+		return;
+	}
+
+	depth = 0;
+	while ( 1 ) {
+		token = COM_ParseExt( &p, qtrue );
+		if ( !token[0] ) {
+			break;
+		}
+
+		if ( token[0] == '{' ) {
+			depth++;
+		} else if ( token[0] == '}' ) {
+			if ( --depth <= 0 ) {
+				break;
+			}
+		} else if ( PrefetchKeyword( token, "map" ) || PrefetchKeyword( token, "clampmap" ) ) {
+			token = COM_ParseExt( &p, qfalse );
+			if ( token[0] && token[0] != '$' && token[0] != '*' ) {
+				R_PrefetchImage( token );
+			}
+		} else if ( PrefetchKeyword( token, "animMap" ) || PrefetchKeyword( token, "clampAnimMap" ) ) {
+			COM_ParseExt( &p, qfalse );		// frequency
+			while ( 1 ) {
+				token = COM_ParseExt( &p, qfalse );
+				if ( !token[0] ) {
+					break;
+				}
+				R_PrefetchImage( token );
+			}
+		}
+	}
+}
+
 
 /*
 ===============
@@ -3289,9 +3418,18 @@ shader_t *R_FindShader( const char *name, int lightmapIndex, qboolean mipRawImag
 			ri.Printf( PRINT_ALL, "*SHADER* %s\n", name );
 		}
 
+		if ( R_RestoreCachedShader() ) {
+			return FinishShader();
+		}
+
+		numParsedImages = 0;
+		shaderUncacheable = qfalse;
+
 		if ( !ParseShader( &shaderText ) ) {
 			// had errors, so use default shader
 			shader.defaultShader = qtrue;
+		} else {
+			R_CacheParsedShader();
 		}
 		sh = FinishShader();
 		return sh;
@@ -3641,6 +3779,661 @@ void	R_ShaderList_f (void) {
 	ri.Printf (PRINT_ALL, "------------------\n");
 }
 
+/*
+====================
+Shader cache
+
+The combined shader text and its name index are saved once they have been
+built, along with a checksum of the name, pak checksum or modification
+time, and size of every script they came from.  As long as the scripts are
+the same, startup loads the text and index back instead of reading,
+validating, compressing and indexing the scripts again.
+
+Shaders parsed from the text are saved too, with the names of their images
+in place of pointers, so registering a shader the next time only looks up
+its images instead of parsing it again.  Lightmap stages are kept as
+markers and resolved against the map being loaded.  Shaders that do more
+than fill in the shader while parsing, like setting the sun or playing a
+video, are always parsed.
+====================
+*/
+#define	SHADERCACHE_FILE		"shadercache.dat"
+#define	SHADERCACHE_IDENT		(('C'<<24)+('H'<<16)+('S'<<8)+'R')
+#define	SHADERCACHE_VERSION		2
+
+typedef struct {
+	int			ident;
+	int			version;
+	int			hashSize;		// MAX_SHADERTEXT_HASH
+	unsigned	checksum;		// of every script's name, stamp and size
+	int			numShaders;
+	int			textLength;		// including the terminating 0
+	// followed by numShaders pairs of name offset into the text and hash
+	// value, in the order the hash table holds them, then the text
+} shaderCacheHeader_t;
+
+unsigned R_BlockChecksum( unsigned checksum, const void *data, int length ) {
+	const byte	*p = data;
+	int			i;
+
+	// FNV-1a
+	for ( i = 0; i < length; i++ ) {
+		checksum = ( checksum ^ p[i] ) * 16777619u;
+	}
+	return checksum;
+}
+
+/*
+====================
+R_LoadShaderCache
+
+Sets up s_shaderText and the hash table from the cache, if it was built
+from the same scripts.
+====================
+*/
+static qboolean R_LoadShaderCache( unsigned checksum ) {
+	union {
+		shaderCacheHeader_t	*header;
+		void				*v;
+	} buf;
+	int		length, numShaders, textLength;
+	int		*entries;
+	char	*text, *hashMem;
+	int		sizes[MAX_SHADERTEXT_HASH];
+	int		i, hash;
+
+	length = ri.FS_ReadFile( SHADERCACHE_FILE, &buf.v );
+	if ( !buf.v ) {
+		return qfalse;
+	}
+
+	if ( length < (int)sizeof( shaderCacheHeader_t )
+		|| buf.header->ident != SHADERCACHE_IDENT
+		|| buf.header->version != SHADERCACHE_VERSION
+		|| buf.header->hashSize != MAX_SHADERTEXT_HASH
+		|| buf.header->checksum != checksum ) {
+		ri.FS_FreeFile( buf.v );
+		return qfalse;
+	}
+
+	numShaders = buf.header->numShaders;
+	textLength = buf.header->textLength;
+	if ( numShaders < 0 || numShaders > length / 8 || textLength < 1 || textLength > length
+		|| length != (int)sizeof( shaderCacheHeader_t ) + numShaders * 2 * (int)sizeof( int ) + textLength ) {
+		ri.FS_FreeFile( buf.v );
+		return qfalse;
+	}
+
+	entries = (int *)( buf.header + 1 );
+	text = (char *)( entries + numShaders * 2 );
+	if ( text[textLength - 1] ) {
+		ri.FS_FreeFile( buf.v );
+		return qfalse;
+	}
+
+	Com_Memset( sizes, 0, sizeof( sizes ) );
+	for ( i = 0; i < numShaders; i++ ) {
+		if ( entries[i * 2] < 0 || entries[i * 2] >= textLength
+			|| entries[i * 2 + 1] < 0 || entries[i * 2 + 1] >= MAX_SHADERTEXT_HASH ) {
+			ri.FS_FreeFile( buf.v );
+			return qfalse;
+		}
+		sizes[entries[i * 2 + 1]]++;
+	}
+
+	s_shaderText = ri.Hunk_Alloc( textLength, h_low );
+	Com_Memcpy( s_shaderText, text, textLength );
+
+	hashMem = ri.Hunk_Alloc( ( numShaders + MAX_SHADERTEXT_HASH ) * sizeof( char * ), h_low );
+	for ( i = 0; i < MAX_SHADERTEXT_HASH; i++ ) {
+		shaderTextHashTable[i] = (char **) hashMem;
+		hashMem = ((char *) hashMem) + ((sizes[i] + 1) * sizeof(char *));
+	}
+
+	Com_Memset( sizes, 0, sizeof( sizes ) );
+	for ( i = 0; i < numShaders; i++ ) {
+		hash = entries[i * 2 + 1];
+		shaderTextHashTable[hash][sizes[hash]++] = s_shaderText + entries[i * 2];
+	}
+
+	ri.FS_FreeFile( buf.v );
+	return qtrue;
+}
+
+/*
+====================
+R_SaveShaderCache
+====================
+*/
+static void R_SaveShaderCache( unsigned checksum, int numShaders ) {
+	shaderCacheHeader_t	*header;
+	int		*entries;
+	int		textLength, size;
+	int		i, j;
+
+	textLength = strlen( s_shaderText ) + 1;
+	size = sizeof( shaderCacheHeader_t ) + numShaders * 2 * sizeof( int ) + textLength;
+	header = ri.Hunk_AllocateTempMemory( size );
+
+	header->ident = SHADERCACHE_IDENT;
+	header->version = SHADERCACHE_VERSION;
+	header->hashSize = MAX_SHADERTEXT_HASH;
+	header->checksum = checksum;
+	header->numShaders = numShaders;
+	header->textLength = textLength;
+
+	entries = (int *)( header + 1 );
+	for ( i = 0; i < MAX_SHADERTEXT_HASH; i++ ) {
+		for ( j = 0; shaderTextHashTable[i][j]; j++ ) {
+			*entries++ = shaderTextHashTable[i][j] - s_shaderText;
+			*entries++ = i;
+		}
+	}
+	Com_Memcpy( entries, s_shaderText, textLength );
+
+	ri.FS_WriteFile( SHADERCACHE_FILE, header, size );
+	ri.Hunk_FreeTempMemory( header );
+}
+
+#define	SHADERSTAGES_FILE		"shaderstages.dat"
+#define	SHADERSTAGES_IDENT		(('T'<<24)+('S'<<16)+('H'<<8)+'S')
+#define	SHADERSTAGES_VERSION	1
+
+typedef struct {
+	int			ident;
+	int			version;
+	unsigned	checksum;		// the same as the text cache's
+	unsigned	settings;		// of the cvars parsing depends on
+	int			shaderSize;		// the records hold raw structures
+	int			stageSize;
+	int			texModSize;
+	int			numRecords;
+} shaderStagesHeader_t;
+
+typedef struct {
+	int			size;			// of the record, including what follows it
+	char		name[MAX_QPATH];
+	int			lightmapIndex;	// LIGHTMAP_*, or 0 for any lightmap of the map
+	int			numStages;
+	int			numImages;
+	// followed by the parsed shader_t, numStages shaderStage_t, their rows
+	// of texMods, then numImages shaderCacheImage_t; image pointers hold an
+	// index into the images plus one
+} shaderStagesRecord_t;
+
+typedef struct cachedShader_s {
+	shaderStagesRecord_t	record;		// copied out, the data isn't aligned
+	const byte				*data;		// the record as saved
+	struct cachedShader_s	*next;
+} cachedShader_t;
+
+static	qboolean		s_shaderCacheActive;
+static	unsigned		s_shaderCacheChecksum;
+static	cachedShader_t	*s_cachedShaders[FILE_HASH_SIZE];
+static	int				s_numNewCachedShaders;	// parsed since the cache was saved
+
+/*
+====================
+R_ShaderSettingsChecksum
+====================
+*/
+static unsigned R_ShaderSettingsChecksum( void ) {
+	char	settings[256];
+
+	Com_sprintf( settings, sizeof( settings ), "%i %i %i %g %g %g %g %g %g",
+		r_parallaxMapping->integer, r_pbr->integer, r_genNormalMaps->integer,
+		r_baseNormalX->value, r_baseNormalY->value, r_baseParallax->value,
+		r_baseSpecular->value, r_baseGloss->value, r_greyscale->value );
+
+	return R_BlockChecksum( 2166136261u, settings, strlen( settings ) );
+}
+
+/*
+====================
+R_CachedShaderRecordSize
+====================
+*/
+static int R_CachedShaderRecordSize( int numStages, int numImages ) {
+	return sizeof( shaderStagesRecord_t ) + sizeof( shader_t )
+		+ numStages * ( sizeof( shaderStage_t ) + sizeof( texMods[0] ) )
+		+ numImages * sizeof( shaderCacheImage_t );
+}
+
+/*
+====================
+R_FindCachedShader
+
+Lightmapped shaders are cached once for every lightmap
+====================
+*/
+static cachedShader_t *R_FindCachedShader( const char *name, int lightmapIndex ) {
+	cachedShader_t	*cached;
+
+	if ( lightmapIndex > 0 ) {
+		lightmapIndex = 0;
+	}
+
+	for ( cached = s_cachedShaders[generateHashValue( name, FILE_HASH_SIZE )]; cached; cached = cached->next ) {
+		if ( cached->record.lightmapIndex == lightmapIndex && !Q_stricmp( cached->record.name, name ) ) {
+			return cached;
+		}
+	}
+
+	return NULL;
+}
+
+/*
+====================
+R_AddCachedShader
+====================
+*/
+static void R_AddCachedShader( const byte *data ) {
+	shaderStagesRecord_t	record;
+	cachedShader_t			*cached;
+	int						hash;
+
+	Com_Memcpy( &record, data, sizeof( record ) );
+
+	cached = R_FindCachedShader( record.name, record.lightmapIndex );
+	if ( !cached ) {
+		hash = generateHashValue( record.name, FILE_HASH_SIZE );
+		cached = ri.Hunk_Alloc( sizeof( *cached ), h_low );
+		cached->next = s_cachedShaders[hash];
+		s_cachedShaders[hash] = cached;
+	}
+
+	cached->record = record;
+	cached->data = data;
+}
+
+/*
+====================
+R_LoadShaderStageCache
+
+Indexes the parsed shaders saved from the same scripts and settings
+====================
+*/
+static void R_LoadShaderStageCache( void ) {
+	shaderStagesHeader_t	header;
+	shaderStagesRecord_t	record;
+	byte	*buf, *data, *p;
+	int		length, remaining, i;
+
+	length = ri.FS_ReadFile( SHADERSTAGES_FILE, (void **)&buf );
+	if ( !buf ) {
+		return;
+	}
+
+	if ( length < (int)sizeof( header ) ) {
+		ri.FS_FreeFile( buf );
+		return;
+	}
+
+	Com_Memcpy( &header, buf, sizeof( header ) );
+	if ( header.ident != SHADERSTAGES_IDENT
+		|| header.version != SHADERSTAGES_VERSION
+		|| header.checksum != s_shaderCacheChecksum
+		|| header.settings != R_ShaderSettingsChecksum()
+		|| header.shaderSize != sizeof( shader_t )
+		|| header.stageSize != sizeof( shaderStage_t )
+		|| header.texModSize != sizeof( texModInfo_t )
+		|| header.numRecords < 0 ) {
+		ri.FS_FreeFile( buf );
+		return;
+	}
+
+	// check every record before indexing any of them
+	p = buf + sizeof( header );
+	remaining = length - sizeof( header );
+	for ( i = 0; i < header.numRecords; i++ ) {
+		if ( remaining < (int)sizeof( record ) ) {
+			break;
+		}
+
+		Com_Memcpy( &record, p, sizeof( record ) );
+		if ( record.numStages < 0 || record.numStages > MAX_SHADER_STAGES
+			|| record.numImages < 0 || record.numImages > MAX_PARSED_IMAGES
+			|| record.size != R_CachedShaderRecordSize( record.numStages, record.numImages )
+			|| record.size > remaining
+			|| record.lightmapIndex > 0
+			|| !memchr( record.name, 0, sizeof( record.name ) ) ) {
+			break;
+		}
+
+		p += record.size;
+		remaining -= record.size;
+	}
+
+	if ( i != header.numRecords || remaining ) {
+		ri.Printf( PRINT_WARNING, "WARNING: %s is damaged, parsing shaders again\n", SHADERSTAGES_FILE );
+		ri.FS_FreeFile( buf );
+		return;
+	}
+
+	length -= sizeof( header );
+	data = ri.Hunk_Alloc( length, h_low );
+	Com_Memcpy( data, buf + sizeof( header ), length );
+	ri.FS_FreeFile( buf );
+
+	for ( i = 0, p = data; i < header.numRecords; i++ ) {
+		R_AddCachedShader( p );
+		Com_Memcpy( &record, p, sizeof( record ) );
+		p += record.size;
+	}
+}
+
+/*
+====================
+R_SaveShaderStageCache
+
+Saves the parsed shaders if any were added since the cache was loaded
+====================
+*/
+void R_SaveShaderStageCache( void ) {
+	shaderStagesHeader_t	header;
+	cachedShader_t	*cached;
+	byte	*buf, *p;
+	int		size, i;
+
+	if ( !s_shaderCacheActive || !s_numNewCachedShaders ) {
+		return;
+	}
+
+	header.ident = SHADERSTAGES_IDENT;
+	header.version = SHADERSTAGES_VERSION;
+	header.checksum = s_shaderCacheChecksum;
+	header.settings = R_ShaderSettingsChecksum();
+	header.shaderSize = sizeof( shader_t );
+	header.stageSize = sizeof( shaderStage_t );
+	header.texModSize = sizeof( texModInfo_t );
+	header.numRecords = 0;
+
+	size = sizeof( header );
+	for ( i = 0; i < FILE_HASH_SIZE; i++ ) {
+		for ( cached = s_cachedShaders[i]; cached; cached = cached->next ) {
+			size += cached->record.size;
+			header.numRecords++;
+		}
+	}
+
+	buf = ri.Hunk_AllocateTempMemory( size );
+	Com_Memcpy( buf, &header, sizeof( header ) );
+	p = buf + sizeof( header );
+	for ( i = 0; i < FILE_HASH_SIZE; i++ ) {
+		for ( cached = s_cachedShaders[i]; cached; cached = cached->next ) {
+			Com_Memcpy( p, cached->data, cached->record.size );
+			p += cached->record.size;
+		}
+	}
+
+	ri.FS_WriteFile( SHADERSTAGES_FILE, buf, size );
+	ri.Hunk_FreeTempMemory( buf );
+
+	s_numNewCachedShaders = 0;
+}
+
+/*
+====================
+R_CacheImageName
+
+Swaps an image pointer for its index in the cached images plus one
+====================
+*/
+static qboolean R_CacheImageName( image_t **slot, qboolean isLightmap, shaderCacheImage_t *images, int *numImages ) {
+	shaderCacheImage_t	image;
+	int		i;
+
+	if ( !*slot ) {
+		return qtrue;
+	}
+
+	Com_Memset( &image, 0, sizeof( image ) );
+	if ( isLightmap ) {
+		Q_strncpyz( image.name, "$lightmap", sizeof( image.name ) );
+	} else if ( *slot == tr.whiteImage ) {
+		Q_strncpyz( image.name, "$whiteimage", sizeof( image.name ) );
+	} else if ( *slot == tr.defaultImage ) {
+		Q_strncpyz( image.name, "$default", sizeof( image.name ) );
+	} else {
+		for ( i = 0; i < numParsedImages; i++ ) {
+			if ( parsedImages[i] == *slot ) {
+				break;
+			}
+		}
+		if ( i == numParsedImages ) {
+			return qfalse;
+		}
+		image = parsedImageNames[i];
+	}
+
+	for ( i = 0; i < *numImages; i++ ) {
+		if ( !strcmp( images[i].name, image.name ) && images[i].type == image.type && images[i].flags == image.flags ) {
+			break;
+		}
+	}
+	if ( i == *numImages ) {
+		if ( *numImages == MAX_PARSED_IMAGES ) {
+			return qfalse;
+		}
+		images[( *numImages )++] = image;
+	}
+
+	*slot = (image_t *)(intptr_t)( i + 1 );
+	return qtrue;
+}
+
+/*
+====================
+R_CacheParsedShader
+
+Adds the shader ParseShader just filled in to the cache
+====================
+*/
+static void R_CacheParsedShader( void ) {
+	shader_t			cachedShader;
+	shaderStage_t		cachedStages[MAX_SHADER_STAGES];
+	shaderCacheImage_t	images[MAX_PARSED_IMAGES];
+	shaderStagesRecord_t	record;
+	textureBundle_t		*bundle;
+	byte	*data, *p;
+	int		numStages, numImages;
+	int		i, b, k;
+
+	if ( !s_shaderCacheActive || shaderUncacheable ) {
+		return;
+	}
+
+	numImages = 0;
+
+	cachedShader = shader;
+	Com_Memset( cachedShader.stages, 0, sizeof( cachedShader.stages ) );
+	cachedShader.optimalStageIteratorFunc = NULL;
+	cachedShader.remappedShader = NULL;
+	cachedShader.next = NULL;
+
+	for ( i = 0; i < 6; i++ ) {
+		if ( !R_CacheImageName( &cachedShader.sky.outerbox[i], qfalse, images, &numImages )
+			|| !R_CacheImageName( &cachedShader.sky.innerbox[i], qfalse, images, &numImages ) ) {
+			return;
+		}
+	}
+
+	for ( numStages = 0; numStages < MAX_SHADER_STAGES && stages[numStages].active; numStages++ ) {
+		cachedStages[numStages] = stages[numStages];
+		cachedStages[numStages].glslShaderGroup = NULL;
+
+		for ( b = 0; b < NUM_TEXTURE_BUNDLES; b++ ) {
+			bundle = &cachedStages[numStages].bundle[b];
+			bundle->texMods = NULL;
+
+			for ( k = 0; k < MAX_IMAGE_ANIMATIONS; k++ ) {
+				if ( !R_CacheImageName( &bundle->image[k], bundle->isLightmap, images, &numImages ) ) {
+					return;
+				}
+			}
+		}
+	}
+
+	Com_Memset( &record, 0, sizeof( record ) );
+	record.size = R_CachedShaderRecordSize( numStages, numImages );
+	Q_strncpyz( record.name, shader.name, sizeof( record.name ) );
+	record.lightmapIndex = shader.lightmapIndex > 0 ? 0 : shader.lightmapIndex;
+	record.numStages = numStages;
+	record.numImages = numImages;
+
+	data = p = ri.Hunk_Alloc( record.size, h_low );
+	Com_Memcpy( p, &record, sizeof( record ) );
+	p += sizeof( record );
+	Com_Memcpy( p, &cachedShader, sizeof( cachedShader ) );
+	p += sizeof( cachedShader );
+	Com_Memcpy( p, cachedStages, numStages * sizeof( cachedStages[0] ) );
+	p += numStages * sizeof( cachedStages[0] );
+	Com_Memcpy( p, texMods, numStages * sizeof( texMods[0] ) );
+	p += numStages * sizeof( texMods[0] );
+	Com_Memcpy( p, images, numImages * sizeof( images[0] ) );
+
+	R_AddCachedShader( data );
+	s_numNewCachedShaders++;
+}
+
+/*
+====================
+R_CachedImage
+====================
+*/
+static qboolean R_CachedImage( image_t **slot, image_t **images, int numImages ) {
+	intptr_t	index;
+
+	index = (intptr_t)*slot;
+	if ( !index ) {
+		return qtrue;
+	}
+
+	if ( index < 1 || index > numImages ) {
+		return qfalse;
+	}
+
+	*slot = images[index - 1];
+	return qtrue;
+}
+
+/*
+====================
+R_RestoreCachedShader
+
+Fills in the shader InitShader set up from the cache instead of parsing
+it.  Returns qfalse and leaves it untouched if it isn't cached or its
+images are gone.
+====================
+*/
+static qboolean R_RestoreCachedShader( void ) {
+	cachedShader_t		*cached;
+	shaderCacheImage_t	image;
+	image_t		*images[MAX_PARSED_IMAGES];
+	char		name[MAX_QPATH];
+	int			lightmapIndex;
+	const byte	*p;
+	int			i, b, k;
+
+	if ( !s_shaderCacheActive ) {
+		return qfalse;
+	}
+
+	cached = R_FindCachedShader( shader.name, shader.lightmapIndex );
+	if ( !cached ) {
+		return qfalse;
+	}
+
+	// find the images first, so a miss leaves the shader to be parsed
+	p = cached->data + R_CachedShaderRecordSize( cached->record.numStages, 0 );
+	for ( i = 0; i < cached->record.numImages; i++, p += sizeof( image ) ) {
+		Com_Memcpy( &image, p, sizeof( image ) );
+		image.name[sizeof( image.name ) - 1] = 0;
+
+		if ( !strcmp( image.name, "$lightmap" ) ) {
+			if ( shader.lightmapIndex < 0 || !tr.lightmaps ) {
+				images[i] = tr.whiteImage;
+			} else {
+				images[i] = tr.lightmaps[shader.lightmapIndex];
+			}
+		} else if ( !strcmp( image.name, "$whiteimage" ) ) {
+			images[i] = tr.whiteImage;
+		} else if ( !strcmp( image.name, "$default" ) ) {
+			images[i] = tr.defaultImage;
+		} else {
+			images[i] = R_FindImageFile( image.name, image.type, image.flags );
+		}
+
+		if ( !images[i] ) {
+			return qfalse;
+		}
+	}
+
+	Q_strncpyz( name, shader.name, sizeof( name ) );
+	lightmapIndex = shader.lightmapIndex;
+
+	p = cached->data + sizeof( shaderStagesRecord_t );
+	Com_Memcpy( &shader, p, sizeof( shader ) );
+	p += sizeof( shader );
+	Com_Memcpy( stages, p, cached->record.numStages * sizeof( stages[0] ) );
+	p += cached->record.numStages * sizeof( stages[0] );
+	Com_Memcpy( texMods, p, cached->record.numStages * sizeof( texMods[0] ) );
+
+	Q_strncpyz( shader.name, name, sizeof( shader.name ) );
+	shader.lightmapIndex = lightmapIndex;
+
+	for ( i = 0; i < 6; i++ ) {
+		if ( !R_CachedImage( &shader.sky.outerbox[i], images, cached->record.numImages )
+			|| !R_CachedImage( &shader.sky.innerbox[i], images, cached->record.numImages ) ) {
+			InitShader( name, lightmapIndex );
+			return qfalse;
+		}
+	}
+
+	for ( i = 0; i < cached->record.numStages; i++ ) {
+		for ( b = 0; b < NUM_TEXTURE_BUNDLES; b++ ) {
+			for ( k = 0; k < MAX_IMAGE_ANIMATIONS; k++ ) {
+				if ( !R_CachedImage( &stages[i].bundle[b].image[k], images, cached->record.numImages ) ) {
+					InitShader( name, lightmapIndex );
+					return qfalse;
+				}
+			}
+		}
+		stages[i].bundle[0].texMods = texMods[i];
+	}
+
+	if ( shader.isSky ) {
+		R_InitSkyTexCoords( shader.sky.cloudHeight );
+	}
+
+	return qtrue;
+}
+
+/*
+====================
+ShaderScriptName
+
+Looks for a .mtr file first, and gets the stamp of the script it picks
+====================
+*/
+static qboolean ShaderScriptName( char filename[MAX_QPATH], const char *shaderFile, int stamp[2] ) {
+	char *ext;
+
+	Com_sprintf( filename, MAX_QPATH, "scripts/%s", shaderFile );
+	if ( (ext = strrchr(filename, '.')) )
+	{
+		strcpy(ext, ".mtr");
+	}
+
+	if ( ri.FS_FileStamp( filename, &stamp[0], &stamp[1] ) && stamp[1] > 0 )
+	{
+		return qtrue;
+	}
+
+	Com_sprintf( filename, MAX_QPATH, "scripts/%s", shaderFile );
+	return ri.FS_FileStamp( filename, &stamp[0], &stamp[1] );
+}
+
 /*
 ====================
 ScanAndLoadShaderFiles
@@ -3654,6 +4447,7 @@ static void ScanAndLoadShaderFiles( void )
 {
 	char **shaderFiles;
 	char *buffers[MAX_SHADER_FILES] = {NULL};
+	int lengths[MAX_SHADER_FILES];
 	char *p;
 	int numShaderFiles;
 	int i;
@@ -3661,8 +4455,14 @@ static void ScanAndLoadShaderFiles( void )
 	int shaderTextHashTableSizes[MAX_SHADERTEXT_HASH], hash, size;
 	char shaderName[MAX_QPATH];
 	int shaderLine;
+	unsigned checksum;
+	int stamp[2];
+	int start;
+
+	long sum = 0;
+
+	start = ri.Milliseconds();
 
-	long sum = 0, summand;
 	// scan for shader files
 	shaderFiles = ri.FS_ListFiles( "scripts", ".shader", &numShaderFiles );
 
@@ -3676,32 +4476,56 @@ static void ScanAndLoadShaderFiles( void )
 		numShaderFiles = MAX_SHADER_FILES;
 	}
 
-	// load and parse shader files
+	// identify the scripts without reading them
+	checksum = 2166136261u;
 	for ( i = 0; i < numShaderFiles; i++ )
 	{
 		char filename[MAX_QPATH];
 
-		// look for a .mtr file first
+		if ( !ShaderScriptName( filename, shaderFiles[i], stamp ) )
+			ri.Error( ERR_DROP, "Couldn't load %s", filename );
+
+		checksum = R_BlockChecksum( checksum, filename, strlen( filename ) + 1 );
+		checksum = R_BlockChecksum( checksum, stamp, sizeof( stamp ) );
+	}
+
+	if ( r_shaderCache->integer )
+	{
+		s_shaderCacheActive = qtrue;
+		s_shaderCacheChecksum = checksum;
+
+		if ( R_LoadShaderCache( checksum ) )
 		{
-			char *ext;
-			Com_sprintf( filename, sizeof( filename ), "scripts/%s", shaderFiles[i] );
-			if ( (ext = strrchr(filename, '.')) )
-			{
-				strcpy(ext, ".mtr");
-			}
+			R_LoadShaderStageCache();
+			ri.FS_FreeFileList( shaderFiles );
 
-			if ( ri.FS_ReadFile( filename, NULL ) <= 0 )
-			{
-				Com_sprintf( filename, sizeof( filename ), "scripts/%s", shaderFiles[i] );
-			}
+			ri.Printf( PRINT_DEVELOPER, "...%i shader files from %s in %i msec\n",
+				numShaderFiles, SHADERCACHE_FILE, ri.Milliseconds() - start );
+			return;
 		}
-		
+	}
+
+	// load shader files
+	for ( i = 0; i < numShaderFiles; i++ )
+	{
+		char filename[MAX_QPATH];
+
+		ShaderScriptName( filename, shaderFiles[i], stamp );
+
 		ri.Printf( PRINT_DEVELOPER, "...loading '%s'\n", filename );
-		summand = ri.FS_ReadFile( filename, (void **)&buffers[i] );
-		
+		lengths[i] = ri.FS_ReadFile( filename, (void **)&buffers[i] );
+
 		if ( !buffers[i] )
 			ri.Error( ERR_DROP, "Couldn't load %s", filename );
-		
+	}
+
+	// parse shader files
+	for ( i = 0; i < numShaderFiles; i++ )
+	{
+		char filename[MAX_QPATH];
+
+		ShaderScriptName( filename, shaderFiles[i], stamp );
+
 		// Do a simple check on the shader structure in that file to make sure one bad shader file cannot fuck up all other shaders.
 		p = buffers[i];
 		COM_BeginParseSession(filename);
@@ -3742,7 +4566,7 @@ static void ScanAndLoadShaderFiles( void )
 			
 		
 		if (buffers[i])
-			sum += summand;		
+			sum += lengths[i];
 	}
 
 	// build single large buffer
@@ -3810,8 +4634,12 @@ static void ScanAndLoadShaderFiles( void )
 		SkipBracedSection(&p, 0);
 	}
 
-	return;
+	if ( r_shaderCache->integer ) {
+		R_SaveShaderCache( checksum, size - MAX_SHADERTEXT_HASH );
+	}
 
+	ri.Printf( PRINT_DEVELOPER, "...%i shader files parsed in %i msec\n",
+		numShaderFiles, ri.Milliseconds() - start );
 }
 
 
@@ -3886,6 +4714,11 @@ void R_InitShaders( void ) {
 
 	Com_Memset(hashTable, 0, sizeof(hashTable));
 
+	// the cached shaders lived on the hunk that was just cleared
+	s_shaderCacheActive = qfalse;
+	Com_Memset( s_cachedShaders, 0, sizeof( s_cachedShaders ) );
+	s_numNewCachedShaders = 0;
+
 	CreateInternalShaders();
 
 	ScanAndLoadShaderFiles();
@@ -25,6 +25,22 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #include <altivec.h>
 #endif
 
+#if defined(__SSE2__) || idx64
+#define idsse2 1
+#include <emmintrin.h>
+#else
+#define idsse2 0
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define idneon 1
+#include <arm_neon.h>
+#else
+#define idneon 0
+#endif
+
+static qboolean	lerpScalar;		// for md3Bench
+
 /*
 
   THIS ENTIRE FILE IS BACK END
@@ -288,7 +304,7 @@ static void RB_SurfacePolychain( srfPoly_t *p ) {
 
 	RB_CheckVao(tess.vao);
 
-	RB_CHECKOVERFLOW( p->numVerts, 3*(p->numVerts - 2) );
+	RB_CHECKOVERFLOW( p->numVerts, p->numIndexes );
 
 	// fan triangles into the tess array
 	numv = tess.numVertexes;
@@ -304,13 +320,11 @@ static void RB_SurfacePolychain( srfPoly_t *p ) {
 		numv++;
 	}
 
-	// generate fan indexes into the tess array
-	for ( i = 0; i < p->numVerts-2; i++ ) {
-		tess.indexes[tess.numIndexes + 0] = tess.numVertexes;
-		tess.indexes[tess.numIndexes + 1] = tess.numVertexes + i + 1;
-		tess.indexes[tess.numIndexes + 2] = tess.numVertexes + i + 2;
-		tess.numIndexes += 3;
+	// the packed fan indexes only need moving past what is already there
+	for ( i = 0; i < p->numIndexes; i++ ) {
+		tess.indexes[tess.numIndexes + i] = tess.numVertexes + p->indexes[i];
 	}
+	tess.numIndexes += p->numIndexes;
 
 	tess.numVertexes = numv;
 }
@@ -775,7 +789,10 @@ static void RB_SurfaceLightningBolt( void ) {
 }
 
 
-static void LerpMeshVertexes(mdvSurface_t *surf, float backlerp)
+/*
+** LerpMeshVertexes
+*/
+static void LerpMeshVertexes_scalar(mdvSurface_t *surf, float backlerp)
 {
 	float *outXyz;
 	int16_t *outNormal, *outTangent;
@@ -841,6 +858,127 @@ static void LerpMeshVertexes(mdvSurface_t *surf, float backlerp)
 }
 
 
+#if idsse2 || idneon
+/*
+** LerpMeshVertexes_simd
+**
+** The position of each vertex is lerped in one register, and its normal
+** and tangent in two more.  Gives the same results as the scalar code.
+*/
+static void LerpMeshVertexes_simd(mdvSurface_t *surf, float backlerp)
+{
+	float *outXyz;
+	int16_t *outNormal, *outTangent;
+	mdvVertex_t *newVerts, *oldVerts;
+	int		vertNum;
+#if idsse2
+	const __m128	wMask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+	const __m128i	keepMask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);	// all but normal[3] and tangent[3]
+	const __m128i	signMask = _mm_set_epi16(-1, 0, 0, 0, 0, 0, 0, 0);		// tangent[3]
+	__m128			frontLerp, backLerp, xyz, lo, hi;
+	__m128i			newVecs, oldVecs;
+#else
+	float32x4_t		xyz, lo, hi;
+	int16x8_t		newVecs, oldVecs, outVecs;
+#endif
+
+	newVerts = surf->verts + backEnd.currentEntity->e.frame * surf->numVerts;
+
+	outXyz =     tess.xyz[tess.numVertexes];
+	outNormal =  tess.normal[tess.numVertexes];
+	outTangent = tess.tangent[tess.numVertexes];
+
+	// xyz is loaded with the first half of the normal behind it, the normal
+	// and tangent together, and the w of the output position is kept
+	if (backlerp == 0)
+	{
+		for (vertNum=0 ; vertNum < surf->numVerts ; vertNum++)
+		{
+#if idsse2
+			xyz = _mm_loadu_ps(newVerts->xyz);
+			_mm_store_ps(outXyz, _mm_or_ps(_mm_andnot_ps(wMask, xyz), _mm_and_ps(wMask, _mm_load_ps(outXyz))));
+
+			newVecs = _mm_loadu_si128((const __m128i *)newVerts->normal);
+			_mm_storel_epi64((__m128i *)outNormal, newVecs);
+			_mm_storel_epi64((__m128i *)outTangent, _mm_unpackhi_epi64(newVecs, newVecs));
+#else
+			xyz = vld1q_f32(newVerts->xyz);
+			vst1q_f32(outXyz, vsetq_lane_f32(outXyz[3], xyz, 3));
+
+			newVecs = vld1q_s16(newVerts->normal);
+			vst1_s16(outNormal, vget_low_s16(newVecs));
+			vst1_s16(outTangent, vget_high_s16(newVecs));
+#endif
+			newVerts++;
+			outXyz += 4;
+			outNormal += 4;
+			outTangent += 4;
+		}
+		return;
+	}
+
+	oldVerts = surf->verts + backEnd.currentEntity->e.oldframe * surf->numVerts;
+
+#if idsse2
+	frontLerp = _mm_set1_ps(1.0f - backlerp);
+	backLerp = _mm_set1_ps(backlerp);
+#endif
+
+	for (vertNum=0 ; vertNum < surf->numVerts ; vertNum++)
+	{
+#if idsse2
+		xyz = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(newVerts->xyz), frontLerp), _mm_mul_ps(_mm_loadu_ps(oldVerts->xyz), backLerp));
+		_mm_store_ps(outXyz, _mm_or_ps(_mm_andnot_ps(wMask, xyz), _mm_and_ps(wMask, _mm_load_ps(outXyz))));
+
+		newVecs = _mm_loadu_si128((const __m128i *)newVerts->normal);
+		oldVecs = _mm_loadu_si128((const __m128i *)oldVerts->normal);
+		lo = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(newVecs, newVecs), 16)), frontLerp),
+			_mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(oldVecs, oldVecs), 16)), backLerp));
+		hi = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(newVecs, newVecs), 16)), frontLerp),
+			_mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(oldVecs, oldVecs), 16)), backLerp));
+		oldVecs = _mm_packs_epi32(_mm_cvttps_epi32(lo), _mm_cvttps_epi32(hi));
+		oldVecs = _mm_or_si128(_mm_and_si128(oldVecs, keepMask), _mm_and_si128(newVecs, signMask));
+
+		_mm_storel_epi64((__m128i *)outNormal, oldVecs);
+		_mm_storel_epi64((__m128i *)outTangent, _mm_unpackhi_epi64(oldVecs, oldVecs));
+#else
+		xyz = vaddq_f32(vmulq_n_f32(vld1q_f32(newVerts->xyz), 1.0f - backlerp), vmulq_n_f32(vld1q_f32(oldVerts->xyz), backlerp));
+		vst1q_f32(outXyz, vsetq_lane_f32(outXyz[3], xyz, 3));
+
+		newVecs = vld1q_s16(newVerts->normal);
+		oldVecs = vld1q_s16(oldVerts->normal);
+		lo = vaddq_f32(vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(newVecs))), 1.0f - backlerp),
+			vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(oldVecs))), backlerp));
+		hi = vaddq_f32(vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(newVecs))), 1.0f - backlerp),
+			vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(oldVecs))), backlerp));
+		outVecs = vcombine_s16(vmovn_s32(vcvtq_s32_f32(lo)), vmovn_s32(vcvtq_s32_f32(hi)));
+		outVecs = vsetq_lane_s16(0, outVecs, 3);
+		outVecs = vsetq_lane_s16(vgetq_lane_s16(newVecs, 7), outVecs, 7);
+
+		vst1_s16(outNormal, vget_low_s16(outVecs));
+		vst1_s16(outTangent, vget_high_s16(outVecs));
+#endif
+		newVerts++;
+		oldVerts++;
+		outXyz += 4;
+		outNormal += 4;
+		outTangent += 4;
+	}
+}
+#endif
+
+static void LerpMeshVertexes(mdvSurface_t *surf, float backlerp)
+{
+#if idsse2 || idneon
+	if (!lerpScalar)
+	{
+		LerpMeshVertexes_simd(surf, backlerp);
+		return;
+	}
+#endif
+	LerpMeshVertexes_scalar(surf, backlerp);
+}
+
 /*
 =============
 RB_SurfaceMesh
@@ -1317,3 +1455,145 @@ void (*rb_surfaceTable[SF_NUM_SURFACE_TYPES])( void *) = {
 	(void(*)(void*))RB_SurfaceEntity,		// SF_ENTITY
 	(void(*)(void*))RB_SurfaceVaoMdvMesh,   // SF_VAO_MDVMESH
 };
+
+
+/*
+==============================================================================
+
+BENCHMARK
+
+==============================================================================
+*/
+
+/*
+=================
+R_MD3BenchLerp
+
+Lerps every surface of a level the way RB_SurfaceMesh does.
+=================
+*/
+static void R_MD3BenchLerp( mdvModel_t *mdv, int frame ) {
+	mdvSurface_t	*surf;
+	int				i;
+
+	backEnd.currentEntity->e.frame = frame % mdv->numFrames;
+	backEnd.currentEntity->e.oldframe = ( frame + 1 ) % mdv->numFrames;
+	for ( i = 0, surf = mdv->surfaces; i < mdv->numSurfaces; i++, surf++ ) {
+		tess.numVertexes = 0;
+		LerpMeshVertexes( surf, 0.5f );
+	}
+}
+
+/*
+=================
+R_MD3Bench_f
+
+md3Bench <model> [frames]
+
+Times lerping every level of detail of an MD3 model on the CPU with the
+scalar and vector code, and checks that the two agree.  Nothing is drawn.
+=================
+*/
+void R_MD3Bench_f( void ) {
+	model_t			*model;
+	mdvModel_t		*mdv;
+	mdvSurface_t	*surf;
+	trRefEntity_t	entity, *oldEntity;
+	vec4_t			*xyz;
+	int16_t			(*normal)[4], (*tangent)[4];
+	int				numFrames, lod, frame, mode, i, j, start;
+	int				numTris, numVerts;
+	int				msec[2];
+	float			d, maxDiff;
+	qboolean		same;
+
+	if ( ri.Cmd_Argc() < 2 ) {
+		ri.Printf( PRINT_ALL, "usage: md3Bench <model> [frames]\n" );
+		return;
+	}
+
+	model = R_GetModelByHandle( RE_RegisterModel( ri.Cmd_Argv( 1 ) ) );
+	if ( model->type != MOD_MESH ) {
+		ri.Printf( PRINT_ALL, "md3Bench: %s is not an MD3 model\n", ri.Cmd_Argv( 1 ) );
+		return;
+	}
+
+	numFrames = ri.Cmd_Argc() > 2 ? atoi( ri.Cmd_Argv( 2 ) ) : 1000;
+	if ( numFrames < 1 ) {
+		numFrames = 1;
+	}
+
+	xyz = ri.Hunk_AllocateTempMemory( sizeof( *xyz ) * SHADER_MAX_VERTEXES );
+	normal = ri.Hunk_AllocateTempMemory( sizeof( *normal ) * SHADER_MAX_VERTEXES );
+	tangent = ri.Hunk_AllocateTempMemory( sizeof( *tangent ) * SHADER_MAX_VERTEXES );
+
+	Com_Memset( &entity, 0, sizeof( entity ) );
+	oldEntity = backEnd.currentEntity;
+	backEnd.currentEntity = &entity;
+
+	ri.Printf( PRINT_ALL, "%s: %i frames, %i levels of detail, %i frames lerped\n",
+		model->name, model->mdv[0]->numFrames, model->numLods, numFrames );
+	ri.Printf( PRINT_ALL, "lod  triangles  vertexes   scalar msec/frame   vector msec/frame\n" );
+
+	same = qtrue;
+	maxDiff = 0;
+	for ( lod = 0; lod < model->numLods; lod++ ) {
+		mdv = model->mdv[lod];
+
+		for ( mode = 0; mode < 2; mode++ ) {
+			lerpScalar = ( mode == 0 );
+			start = ri.Milliseconds();
+			for ( frame = 0; frame < numFrames; frame++ ) {
+				R_MD3BenchLerp( mdv, frame );
+			}
+			msec[mode] = ri.Milliseconds() - start;
+		}
+
+		numTris = numVerts = 0;
+		entity.e.frame = 0;
+		entity.e.oldframe = 1 % mdv->numFrames;
+		for ( i = 0, surf = mdv->surfaces; i < mdv->numSurfaces; i++, surf++ ) {
+			numTris += surf->numIndexes / 3;
+			numVerts += surf->numVerts;
+
+			lerpScalar = qtrue;
+			tess.numVertexes = 0;
+			LerpMeshVertexes( surf, 0.5f );
+			Com_Memcpy( xyz, tess.xyz, surf->numVerts * sizeof( *xyz ) );
+			Com_Memcpy( normal, tess.normal, surf->numVerts * sizeof( *normal ) );
+			Com_Memcpy( tangent, tess.tangent, surf->numVerts * sizeof( *tangent ) );
+
+			lerpScalar = qfalse;
+			LerpMeshVertexes( surf, 0.5f );
+			if ( memcmp( normal, tess.normal, surf->numVerts * sizeof( *normal ) )
+				|| memcmp( tangent, tess.tangent, surf->numVerts * sizeof( *tangent ) ) ) {
+				same = qfalse;
+			}
+			for ( j = 0; j < surf->numVerts; j++ ) {
+				d = Distance( xyz[j], tess.xyz[j] ) / ( 1.0f + VectorLength( xyz[j] ) );
+				if ( d > maxDiff ) {
+					maxDiff = d;
+				}
+			}
+		}
+
+		ri.Printf( PRINT_ALL, "%3i  %9i  %8i   %17.4f   %17.4f\n", lod, numTris, numVerts,
+			(float)msec[0] / numFrames, (float)msec[1] / numFrames );
+	}
+
+	lerpScalar = qfalse;
+	tess.numVertexes = 0;
+	backEnd.currentEntity = oldEntity;
+
+	ri.Hunk_FreeTempMemory( tangent );
+	ri.Hunk_FreeTempMemory( normal );
+	ri.Hunk_FreeTempMemory( xyz );
+
+	if ( !same ) {
+		ri.Printf( PRINT_ALL, S_COLOR_RED "  scalar and vector normals DIFFER\n" );
+	} else if ( maxDiff > 1e-5f ) {
+		ri.Printf( PRINT_ALL, S_COLOR_RED "  positions differ by up to %g\n", maxDiff );
+	} else {
+		ri.Printf( PRINT_ALL, "  scalar and vector lerps agree, positions to within %g\n", maxDiff );
+	}
+}
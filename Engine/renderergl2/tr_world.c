@@ -145,6 +145,22 @@ static qboolean	R_CullSurface( msurface_t *surf ) {
 }
 
 
+/*
+================
+R_OccludedSurface
+
+Only world surfaces are tested, brush models are tested as a whole.
+================
+*/
+static qboolean R_OccludedSurface( msurface_t *surf ) {
+	if ( tr.currentEntityNum != REFENTITYNUM_WORLD || !( surf->cullinfo.type & CULLINFO_BOX ) ) {
+		return qfalse;
+	}
+
+	return R_OccludedBox( surf->cullinfo.bounds );
+}
+
+
 /*
 ====================
 R_DlightSurface
@@ -221,12 +237,6 @@ static int R_DlightSurface( msurface_t *surf, int dlightBits ) {
 			break;
 	}
 
-	if ( dlightBits ) {
-		tr.pc.c_dlightSurfaces++;
-	} else {
-		tr.pc.c_dlightSurfacesCulled++;
-	}
-
 	return dlightBits;
 }
 
@@ -327,10 +337,20 @@ static void R_AddWorldSurface( msurface_t *surf, int dlightBits, int pshadowBits
 		return;
 	}
 
+	if ( R_OccludedSurface( surf ) ) {
+		tr.pc.c_occludedSurfaces++;
+		return;
+	}
+
 	// check for dlighting
 	/*if ( dlightBits ) */{
 		dlightBits = R_DlightSurface( surf, dlightBits );
 		dlightBits = ( dlightBits != 0 );
+		if ( dlightBits ) {
+			tr.pc.c_dlightSurfaces++;
+		} else {
+			tr.pc.c_dlightSurfacesCulled++;
+		}
 	}
 
 	// check for pshadows
@@ -369,6 +389,10 @@ void R_AddBrushModelSurfaces ( trRefEntity_t *ent ) {
 	if ( clip == CULL_OUT ) {
 		return;
 	}
+
+	if ( R_OccludedModel( ent, bmodel->bounds, bmodel->bounds ) ) {
+		return;
+	}
 	
 	R_SetupEntityLighting( &tr.refdef, ent );
 	R_DlightBmodel( bmodel );
@@ -396,77 +420,192 @@ void R_AddBrushModelSurfaces ( trRefEntity_t *ent ) {
 
 /*
 ================
-R_RecursiveWorldNode
+R_CullWorldNode
+
+Returns qtrue if nothing under the node can be seen.  Clears the frustum
+planes that everything under the node is in front of.  Nodes hidden by
+the occluders are counted in occluded.
 ================
 */
-static void R_RecursiveWorldNode( mnode_t *node, uint32_t planeBits, uint32_t dlightBits, uint32_t pshadowBits ) {
+static qboolean R_CullWorldNode( mnode_t *node, uint32_t *planeBits, int *occluded ) {
+	int		i, r;
 
-	do {
-		uint32_t newDlights[2];
-		uint32_t newPShadows[2];
+	// if the node wasn't marked as potentially visible, exit
+	// pvs is skipped for depth shadows
+	if (!(tr.viewParms.flags & VPF_DEPTHSHADOW) && node->visCounts[tr.visIndex] != tr.visCounts[tr.visIndex]) {
+		return qtrue;
+	}
 
-		// if the node wasn't marked as potentially visible, exit
-		// pvs is skipped for depth shadows
-		if (!(tr.viewParms.flags & VPF_DEPTHSHADOW) && node->visCounts[tr.visIndex] != tr.visCounts[tr.visIndex]) {
-			return;
+	// if the bounding volume is outside the frustum, nothing
+	// inside can be visible OPTIMIZE: don't do this all the way to leafs?
+	if ( r_nocull->integer ) {
+		return qfalse;
+	}
+
+	for ( i = 0 ; i < 5 ; i++ ) {
+		if ( *planeBits & ( 1 << i ) ) {
+			r = BoxOnPlaneSide(node->mins, node->maxs, &tr.viewParms.frustum[i]);
+			if (r == 2) {
+				return qtrue;					// culled
+			}
+			if ( r == 1 ) {
+				*planeBits &= ~( 1 << i );		// all descendants will also be in front
+			}
 		}
+	}
 
-		// if the bounding volume is outside the frustum, nothing
-		// inside can be visible OPTIMIZE: don't do this all the way to leafs?
+	if ( R_OccludedNode( node ) ) {
+		( *occluded )++;
+		return qtrue;
+	}
 
-		if ( !r_nocull->integer ) {
-			int		r;
+	return qfalse;
+}
 
-			if ( planeBits & 1 ) {
-				r = BoxOnPlaneSide(node->mins, node->maxs, &tr.viewParms.frustum[0]);
-				if (r == 2) {
-					return;						// culled
-				}
-				if ( r == 1 ) {
-					planeBits &= ~1;			// all descendants will also be in front
-				}
-			}
+/*
+================
+R_SplitNodeLights
 
-			if ( planeBits & 2 ) {
-				r = BoxOnPlaneSide(node->mins, node->maxs, &tr.viewParms.frustum[1]);
-				if (r == 2) {
-					return;						// culled
-				}
-				if ( r == 1 ) {
-					planeBits &= ~2;			// all descendants will also be in front
-				}
-			}
+Determines which dlights and pshadows reach each side of the node.
+================
+*/
+static void R_SplitNodeLights( mnode_t *node, uint32_t dlightBits, uint32_t pshadowBits, uint32_t newDlights[2], uint32_t newPShadows[2] ) {
+	newDlights[0] = 0;
+	newDlights[1] = 0;
+	if ( dlightBits ) {
+		int	i;
 
-			if ( planeBits & 4 ) {
-				r = BoxOnPlaneSide(node->mins, node->maxs, &tr.viewParms.frustum[2]);
-				if (r == 2) {
-					return;						// culled
+		for ( i = 0 ; i < tr.refdef.num_dlights ; i++ ) {
+			dlight_t	*dl;
+			float		dist;
+
+			if ( dlightBits & ( 1 << i ) ) {
+				dl = &tr.refdef.dlights[i];
+				dist = DotProduct( dl->origin, node->plane->normal ) - node->plane->dist;
+				
+				if ( dist > -dl->radius ) {
+					newDlights[0] |= ( 1 << i );
 				}
-				if ( r == 1 ) {
-					planeBits &= ~4;			// all descendants will also be in front
+				if ( dist < dl->radius ) {
+					newDlights[1] |= ( 1 << i );
 				}
 			}
+		}
+	}
 
-			if ( planeBits & 8 ) {
-				r = BoxOnPlaneSide(node->mins, node->maxs, &tr.viewParms.frustum[3]);
-				if (r == 2) {
-					return;						// culled
-				}
-				if ( r == 1 ) {
-					planeBits &= ~8;			// all descendants will also be in front
-				}
-			}
+	newPShadows[0] = 0;
+	newPShadows[1] = 0;
+	if ( pshadowBits ) {
+		int	i;
 
-			if ( planeBits & 16 ) {
-				r = BoxOnPlaneSide(node->mins, node->maxs, &tr.viewParms.frustum[4]);
-				if (r == 2) {
-					return;						// culled
+		for ( i = 0 ; i < tr.refdef.num_pshadows ; i++ ) {
+			pshadow_t	*shadow;
+			float		dist;
+
+			if ( pshadowBits & ( 1 << i ) ) {
+				shadow = &tr.refdef.pshadows[i];
+				dist = DotProduct( shadow->lightOrigin, node->plane->normal ) - node->plane->dist;
+				
+				if ( dist > -shadow->lightRadius ) {
+					newPShadows[0] |= ( 1 << i );
 				}
-				if ( r == 1 ) {
-					planeBits &= ~16;			// all descendants will also be in front
+				if ( dist < shadow->lightRadius ) {
+					newPShadows[1] |= ( 1 << i );
 				}
 			}
 		}
+	}
+}
+
+/*
+================
+R_AddLeafToVisBounds
+================
+*/
+static void R_AddLeafToVisBounds( mnode_t *node, vec3_t visBounds[2] ) {
+	if ( node->mins[0] < visBounds[0][0] ) {
+		visBounds[0][0] = node->mins[0];
+	}
+	if ( node->mins[1] < visBounds[0][1] ) {
+		visBounds[0][1] = node->mins[1];
+	}
+	if ( node->mins[2] < visBounds[0][2] ) {
+		visBounds[0][2] = node->mins[2];
+	}
+
+	if ( node->maxs[0] > visBounds[1][0] ) {
+		visBounds[1][0] = node->maxs[0];
+	}
+	if ( node->maxs[1] > visBounds[1][1] ) {
+		visBounds[1][1] = node->maxs[1];
+	}
+	if ( node->maxs[2] > visBounds[1][2] ) {
+		visBounds[1][2] = node->maxs[2];
+	}
+}
+
+/*
+================
+R_MarkLeafSurfaces
+================
+*/
+static void R_MarkLeafSurfaces( mnode_t *node, uint32_t dlightBits, uint32_t pshadowBits ) {
+	int			c;
+	int surf, *view;
+
+	view = tr.world->marksurfaces + node->firstmarksurface;
+
+	c = node->nummarksurfaces;
+	while (c--) {
+		// just mark it as visible, so we don't jump out of the cache derefencing the surface
+		surf = *view;
+		if (tr.world->surfacesViewCount[surf] != tr.viewCount)
+		{
+			tr.world->surfacesViewCount[surf] = tr.viewCount;
+			tr.world->surfacesDlightBits[surf] = dlightBits;
+			tr.world->surfacesPshadowBits[surf] = pshadowBits;
+		}
+		else
+		{
+			tr.world->surfacesDlightBits[surf] |= dlightBits;
+			tr.world->surfacesPshadowBits[surf] |= pshadowBits;
+		}
+		view++;
+	}
+}
+
+// a visible leaf found by a front end thread
+typedef struct worldLeaf_s {
+	mnode_t		*node;
+	uint32_t	dlightBits;
+	uint32_t	pshadowBits;
+} worldLeaf_t;
+
+typedef struct {
+	worldLeaf_t	*leafs;
+	int			numLeafs;
+	vec3_t		visBounds[2];
+	int			c_occludedNodes;
+} worldWalk_t;
+
+/*
+================
+R_RecursiveWorldNode
+
+With a walk, leaves are only collected for R_AddWorldSurfacesThreaded
+to mark, since the same surface can be under leaves walked on different
+threads.
+================
+*/
+static void R_RecursiveWorldNode( worldWalk_t *walk, mnode_t *node, uint32_t planeBits, uint32_t dlightBits, uint32_t pshadowBits ) {
+
+	do {
+		uint32_t newDlights[2];
+		uint32_t newPShadows[2];
+
+		if ( R_CullWorldNode( node, &planeBits, walk ? &walk->c_occludedNodes : &tr.pc.c_occludedNodes ) ) {
+			return;
+		}
 
 		if ( node->contents != -1 ) {
 			break;
@@ -476,54 +615,10 @@ static void R_RecursiveWorldNode( mnode_t *node, uint32_t planeBits, uint32_t dl
 		// since we don't care about sort orders, just go positive to negative
 
 		// determine which dlights are needed
-		newDlights[0] = 0;
-		newDlights[1] = 0;
-		if ( dlightBits ) {
-			int	i;
-
-			for ( i = 0 ; i < tr.refdef.num_dlights ; i++ ) {
-				dlight_t	*dl;
-				float		dist;
-
-				if ( dlightBits & ( 1 << i ) ) {
-					dl = &tr.refdef.dlights[i];
-					dist = DotProduct( dl->origin, node->plane->normal ) - node->plane->dist;
-					
-					if ( dist > -dl->radius ) {
-						newDlights[0] |= ( 1 << i );
-					}
-					if ( dist < dl->radius ) {
-						newDlights[1] |= ( 1 << i );
-					}
-				}
-			}
-		}
-
-		newPShadows[0] = 0;
-		newPShadows[1] = 0;
-		if ( pshadowBits ) {
-			int	i;
-
-			for ( i = 0 ; i < tr.refdef.num_pshadows ; i++ ) {
-				pshadow_t	*shadow;
-				float		dist;
-
-				if ( pshadowBits & ( 1 << i ) ) {
-					shadow = &tr.refdef.pshadows[i];
-					dist = DotProduct( shadow->lightOrigin, node->plane->normal ) - node->plane->dist;
-					
-					if ( dist > -shadow->lightRadius ) {
-						newPShadows[0] |= ( 1 << i );
-					}
-					if ( dist < shadow->lightRadius ) {
-						newPShadows[1] |= ( 1 << i );
-					}
-				}
-			}
-		}
+		R_SplitNodeLights( node, dlightBits, pshadowBits, newDlights, newPShadows );
 
 		// recurse down the children, front side first
-		R_RecursiveWorldNode (node->children[0], planeBits, newDlights[0], newPShadows[0] );
+		R_RecursiveWorldNode (walk, node->children[0], planeBits, newDlights[0], newPShadows[0] );
 
 		// tail recurse
 		node = node->children[1];
@@ -531,56 +626,268 @@ static void R_RecursiveWorldNode( mnode_t *node, uint32_t planeBits, uint32_t dl
 		pshadowBits = newPShadows[1];
 	} while ( 1 );
 
-	{
-		// leaf node, so add mark surfaces
-		int			c;
-		int surf, *view;
+	// leaf node, so add mark surfaces
+	if ( walk ) {
+		worldLeaf_t	*leaf;
 
-		tr.pc.c_leafs++;
+		leaf = &walk->leafs[walk->numLeafs++];
+		leaf->node = node;
+		leaf->dlightBits = dlightBits;
+		leaf->pshadowBits = pshadowBits;
 
-		// add to z buffer bounds
-		if ( node->mins[0] < tr.viewParms.visBounds[0][0] ) {
-			tr.viewParms.visBounds[0][0] = node->mins[0];
-		}
-		if ( node->mins[1] < tr.viewParms.visBounds[0][1] ) {
-			tr.viewParms.visBounds[0][1] = node->mins[1];
-		}
-		if ( node->mins[2] < tr.viewParms.visBounds[0][2] ) {
-			tr.viewParms.visBounds[0][2] = node->mins[2];
+		R_AddLeafToVisBounds( node, walk->visBounds );
+		return;
+	}
+
+	tr.pc.c_leafs++;
+
+	// add to z buffer bounds
+	R_AddLeafToVisBounds( node, tr.viewParms.visBounds );
+
+	// add surfaces
+	R_MarkLeafSurfaces( node, dlightBits, pshadowBits );
+}
+
+
+/*
+=============================================================
+
+	THREADED WORLD CULLING
+
+The node walk is split into subtrees near the root, which are walked on
+the front end threads into lists of visible leaves, and the leaves'
+surfaces are marked here.  The marked surfaces are then culled in ranges,
+each into its own part of a scratch list, and the parts are added in
+order, so the draw surfaces come out exactly as the serial path has them.
+
+=============================================================
+*/
+
+#define	MAX_WORLD_JOBS			64
+#define	MIN_THREADED_SURFACES	512		// not worth waking the threads for
+
+typedef struct {
+	mnode_t		*node;
+	uint32_t	planeBits;
+	uint32_t	dlightBits;
+	uint32_t	pshadowBits;
+} worldNodeJob_t;
+
+typedef struct {
+	int			firstSurface;
+	int			numSurfaces;
+
+	int			numDrawSurfs;
+	int			dlightMask;
+	int			c_dlightSurfaces;
+	int			c_dlightSurfacesCulled;
+	int			c_occludedSurfaces;
+} worldSurfaceJob_t;
+
+static worldNodeJob_t		worldNodeJobs[MAX_WORLD_JOBS];
+static int					numWorldNodeJobs;
+static worldWalk_t			worldWalks[MAX_FRONTEND_THREADS + 1];
+static worldSurfaceJob_t	worldSurfaceJobs[MAX_WORLD_JOBS];
+
+/*
+================
+R_InitWorldJobs
+
+Called once the nodes and submodels are loaded.
+================
+*/
+void R_InitWorldJobs( world_t *world ) {
+	int		numThreads;
+
+	world->jobLeafs = NULL;
+	world->jobDrawSurfs = NULL;
+
+	numThreads = R_FrontEndThreads();
+	if ( !numThreads ) {
+		return;
+	}
+
+	world->jobLeafs = ri.Hunk_Alloc( ( numThreads + 1 ) * world->numnodes * sizeof( *world->jobLeafs ), h_low );
+	world->jobDrawSurfs = ri.Hunk_Alloc( world->numWorldSurfaces * sizeof( *world->jobDrawSurfs ), h_low );
+}
+
+/*
+================
+R_SplitWorldNode
+
+Culls the top of the tree here and makes a job of each subtree below
+the given depth.
+================
+*/
+static void R_SplitWorldNode( mnode_t *node, uint32_t planeBits, uint32_t dlightBits, uint32_t pshadowBits, int depth ) {
+	uint32_t		newDlights[2];
+	uint32_t		newPShadows[2];
+	worldNodeJob_t	*job;
+
+	if ( R_CullWorldNode( node, &planeBits, &tr.pc.c_occludedNodes ) ) {
+		return;
+	}
+
+	if ( node->contents != -1 || depth == 0 ) {
+		job = &worldNodeJobs[numWorldNodeJobs++];
+		job->node = node;
+		job->planeBits = planeBits;
+		job->dlightBits = dlightBits;
+		job->pshadowBits = pshadowBits;
+		return;
+	}
+
+	R_SplitNodeLights( node, dlightBits, pshadowBits, newDlights, newPShadows );
+
+	R_SplitWorldNode( node->children[0], planeBits, newDlights[0], newPShadows[0], depth - 1 );
+	R_SplitWorldNode( node->children[1], planeBits, newDlights[1], newPShadows[1], depth - 1 );
+}
+
+/*
+================
+R_WalkWorldJob
+================
+*/
+static void R_WalkWorldJob( void *data, int job, int thread ) {
+	worldNodeJob_t	*nodeJob;
+
+	(void)data;
+
+	nodeJob = &worldNodeJobs[job];
+	R_RecursiveWorldNode( &worldWalks[thread], nodeJob->node, nodeJob->planeBits, nodeJob->dlightBits, nodeJob->pshadowBits );
+}
+
+/*
+================
+R_CullWorldSurfacesJob
+
+The same as the loop at the end of R_AddWorldSurfaces, over one range.
+================
+*/
+static void R_CullWorldSurfacesJob( void *data, int job, int thread ) {
+	worldSurfaceJob_t	*surfJob;
+	drawSurf_t			*out;
+	msurface_t			*surf;
+	int					i, last;
+	int					dlightBits, pshadowBits;
+
+	(void)data;
+	(void)thread;
+
+	surfJob = &worldSurfaceJobs[job];
+	out = tr.world->jobDrawSurfs + surfJob->firstSurface;
+	last = surfJob->firstSurface + surfJob->numSurfaces;
+
+	for ( i = surfJob->firstSurface ; i < last ; i++ ) {
+		if ( tr.world->surfacesViewCount[i] != tr.viewCount ) {
+			continue;
 		}
 
-		if ( node->maxs[0] > tr.viewParms.visBounds[1][0] ) {
-			tr.viewParms.visBounds[1][0] = node->maxs[0];
+		surfJob->dlightMask |= tr.world->surfacesDlightBits[i];
+
+		surf = tr.world->surfaces + i;
+		if ( R_CullSurface( surf ) ) {
+			continue;
 		}
-		if ( node->maxs[1] > tr.viewParms.visBounds[1][1] ) {
-			tr.viewParms.visBounds[1][1] = node->maxs[1];
+
+		if ( R_OccludedSurface( surf ) ) {
+			surfJob->c_occludedSurfaces++;
+			continue;
 		}
-		if ( node->maxs[2] > tr.viewParms.visBounds[1][2] ) {
-			tr.viewParms.visBounds[1][2] = node->maxs[2];
+
+		dlightBits = R_DlightSurface( surf, tr.world->surfacesDlightBits[i] );
+		dlightBits = ( dlightBits != 0 );
+		if ( dlightBits ) {
+			surfJob->c_dlightSurfaces++;
+		} else {
+			surfJob->c_dlightSurfacesCulled++;
 		}
 
-		// add surfaces
-		view = tr.world->marksurfaces + node->firstmarksurface;
+		pshadowBits = R_PshadowSurface( surf, tr.world->surfacesPshadowBits[i] );
+		pshadowBits = ( pshadowBits != 0 );
 
-		c = node->nummarksurfaces;
-		while (c--) {
-			// just mark it as visible, so we don't jump out of the cache derefencing the surface
-			surf = *view;
-			if (tr.world->surfacesViewCount[surf] != tr.viewCount)
-			{
-				tr.world->surfacesViewCount[surf] = tr.viewCount;
-				tr.world->surfacesDlightBits[surf] = dlightBits;
-				tr.world->surfacesPshadowBits[surf] = pshadowBits;
-			}
-			else
-			{
-				tr.world->surfacesDlightBits[surf] |= dlightBits;
-				tr.world->surfacesPshadowBits[surf] |= pshadowBits;
-			}
-			view++;
+		R_FillDrawSurf( &out[surfJob->numDrawSurfs++], surf->data, surf->shader, surf->fogIndex, dlightBits, pshadowBits, surf->cubemapIndex );
+	}
+}
+
+/*
+================
+R_AddWorldSurfacesThreaded
+================
+*/
+static void R_AddWorldSurfacesThreaded( uint32_t planeBits, uint32_t dlightBits, uint32_t pshadowBits ) {
+	int					numThreads, numJobs, depth;
+	int					i, j, count;
+	worldWalk_t			*walk;
+	worldLeaf_t			*leaf;
+	worldSurfaceJob_t	*surfJob;
+	drawSurf_t			*in;
+
+	numThreads = R_FrontEndThreads() + 1;
+
+	// a few subtrees for each thread, so they come out even
+	for ( depth = 0 ; ( 1 << depth ) < numThreads * 4 && ( 2 << depth ) <= MAX_WORLD_JOBS ; depth++ ) {
+	}
+
+	for ( i = 0 ; i < numThreads ; i++ ) {
+		walk = &worldWalks[i];
+		walk->leafs = tr.world->jobLeafs + i * tr.world->numnodes;
+		walk->numLeafs = 0;
+		walk->c_occludedNodes = 0;
+		ClearBounds( walk->visBounds[0], walk->visBounds[1] );
+	}
+
+	numWorldNodeJobs = 0;
+	R_SplitWorldNode( tr.world->nodes, planeBits, dlightBits, pshadowBits, depth );
+	R_RunFrontEndJobs( R_WalkWorldJob, NULL, numWorldNodeJobs );
+
+	for ( i = 0 ; i < numThreads ; i++ ) {
+		walk = &worldWalks[i];
+		for ( j = 0, leaf = walk->leafs ; j < walk->numLeafs ; j++, leaf++ ) {
+			R_MarkLeafSurfaces( leaf->node, leaf->dlightBits, leaf->pshadowBits );
+		}
+		tr.pc.c_leafs += walk->numLeafs;
+		tr.pc.c_occludedNodes += walk->c_occludedNodes;
+		if ( walk->numLeafs ) {
+			AddPointToBounds( walk->visBounds[0], tr.viewParms.visBounds[0], tr.viewParms.visBounds[1] );
+			AddPointToBounds( walk->visBounds[1], tr.viewParms.visBounds[0], tr.viewParms.visBounds[1] );
 		}
 	}
 
+	// now cull the marked surfaces in even ranges
+	numJobs = numThreads * 4;
+	if ( numJobs > MAX_WORLD_JOBS ) {
+		numJobs = MAX_WORLD_JOBS;
+	}
+	count = ( tr.world->numWorldSurfaces + numJobs - 1 ) / numJobs;
+	for ( i = 0 ; i < numJobs ; i++ ) {
+		surfJob = &worldSurfaceJobs[i];
+		Com_Memset( surfJob, 0, sizeof( *surfJob ) );
+		surfJob->firstSurface = i * count;
+		surfJob->numSurfaces = count;
+		if ( surfJob->firstSurface + count > tr.world->numWorldSurfaces ) {
+			surfJob->numSurfaces = tr.world->numWorldSurfaces - surfJob->firstSurface;
+		}
+		if ( surfJob->numSurfaces < 0 ) {
+			surfJob->numSurfaces = 0;
+		}
+	}
+	R_RunFrontEndJobs( R_CullWorldSurfacesJob, NULL, numJobs );
+
+	tr.refdef.dlightMask = 0;
+	for ( i = 0 ; i < numJobs ; i++ ) {
+		surfJob = &worldSurfaceJobs[i];
+		in = tr.world->jobDrawSurfs + surfJob->firstSurface;
+		for ( j = 0 ; j < surfJob->numDrawSurfs ; j++ ) {
+			tr.refdef.drawSurfs[tr.refdef.numDrawSurfs & DRAWSURF_MASK] = in[j];
+			tr.refdef.numDrawSurfs++;
+		}
+		tr.refdef.dlightMask |= surfJob->dlightMask;
+		tr.pc.c_dlightSurfaces += surfJob->c_dlightSurfaces;
+		tr.pc.c_dlightSurfacesCulled += surfJob->c_dlightSurfacesCulled;
+		tr.pc.c_occludedSurfaces += surfJob->c_occludedSurfaces;
+	}
+	tr.refdef.dlightMask = ~tr.refdef.dlightMask;
 }
 
 
@@ -786,7 +1093,15 @@ void R_AddWorldSurfaces (void) {
 		pshadowBits = 0;
 	}
 
-	R_RecursiveWorldNode( tr.world->nodes, planeBits, dlightBits, pshadowBits);
+	// draw the occluders for this view
+	R_RenderOcclusion();
+
+	if ( tr.world->jobLeafs && R_FrontEndThreads() && tr.world->numWorldSurfaces >= MIN_THREADED_SURFACES ) {
+		R_AddWorldSurfacesThreaded( planeBits, dlightBits, pshadowBits );
+		return;
+	}
+
+	R_RecursiveWorldNode( NULL, tr.world->nodes, planeBits, dlightBits, pshadowBits);
 
 	// now add all the potentially visible surfaces
 	// also mask invisible dlights for next frame
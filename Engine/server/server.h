@@ -76,14 +76,16 @@ typedef struct {
 	int				timeResidual;		// <= 1000 / sv_frame->value
 	int				nextFrameTime;		// when time > nextFrameTime, process world
 	char			*configstrings[MAX_CONFIGSTRINGS];
-	svEntity_t		svEntities[MAX_GENTITIES];
+	svEntity_t		*svEntities;		// sv_maxEntities of them, on the hunk
+	int				maxEntities;
+	int				*entityUpdateTimes;	// svs.time each entity was last sent fresh, per client
 
 	char			*entityParsePoint;	// used during game VM init
 
 	// the game virtual machine will update these on init and changes
 	sharedEntity_t	*gentities;
 	int				gentitySize;
-	int				num_entities;		// current number, <= MAX_GENTITIES
+	int				num_entities;		// current number, <= sv.maxEntities
 
 	playerState_t	*gameClients;
 	int				gameClientSize;		// will be > sizeof(playerState_t) due to game private data
@@ -171,6 +173,7 @@ typedef struct client_s {
 	int				ping;
 	int				rate;				// bytes / second
 	int				snapshotMsec;		// requests a snapshot every snapshotMsec unless rate choked
+	float			snapshotPressure;	// how far over its rate the last snapshots ran, 1 when not
 	int				pureAuthentic;
 	qboolean  gotCP; // TTimo - additional flag to distinguish between a bad pure checksum, and no cp command at all
 	netchan_t		netchan;
@@ -283,6 +286,10 @@ extern	cvar_t	*sv_gametype;
 extern	cvar_t	*sv_pure;
 extern	cvar_t	*sv_floodProtect;
 extern	cvar_t	*sv_lanForceRate;
+extern	cvar_t	*sv_maxEntities;
+extern	cvar_t	*sv_snapshotNear;
+extern	cvar_t	*sv_snapshotFarMsec;
+extern	cvar_t	*sv_snapshotFarError;
 extern	cvar_t	*sv_banFile;
 
 extern	serverBan_t serverBans[SERVER_MAXBANS];
@@ -330,6 +337,7 @@ void SV_RemoveOperatorCommands (void);
 
 
 void SV_MasterShutdown (void);
+int SV_ClientRate(client_t *client);
 int SV_RateMsec(client_t *client);
 
 
@@ -385,6 +393,7 @@ void SV_WriteFrameToClient (client_t *client, msg_t *msg);
 void SV_SendMessageToClient( msg_t *msg, client_t *client );
 void SV_SendClientMessages( void );
 void SV_SendClientSnapshot( client_t *client );
+void SV_ClearEntityUpdateTimes( client_t *client );
 
 //
 // sv_game.c
@@ -450,6 +459,9 @@ void SV_Trace( trace_t *results, const vec3_t start, vec3_t mins, vec3_t maxs, c
 
 // passEntityNum is explicitly excluded from clipping checks (normally ENTITYNUM_NONE)
 
+void SV_TraceBatch( batchTrace_t *traces, int count );
+// the same as calling SV_Trace for each, but shares the entity gathering
+
 
 void SV_ClipToEntity( trace_t *trace, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int entityNum, int contentmask, int capsule );
 // clip to a specific entity
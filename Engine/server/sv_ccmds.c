@@ -257,8 +257,8 @@ static void SV_MapRestart_f( void ) {
 	}
 
 	// check for changes in variables that can't just be restarted
-	// check for maxclients change
-	if ( sv_maxclients->modified || sv_gametype->modified ) {
+	// check for maxclients or entity limit change
+	if ( sv_maxclients->modified || sv_gametype->modified || sv_maxEntities->modified ) {
 		char	mapname[MAX_QPATH];
 
 		Com_Printf( "variable change -- restarting.\n" );
@@ -50,7 +50,7 @@ playerState_t *SV_GameClientNum( int num ) {
 }
 
 svEntity_t	*SV_SvEntityForGentity( sharedEntity_t *gEnt ) {
-	if ( !gEnt || gEnt->s.number < 0 || gEnt->s.number >= MAX_GENTITIES ) {
+	if ( !gEnt || gEnt->s.number < 0 || gEnt->s.number >= sv.maxEntities ) {
 		Com_Error( ERR_DROP, "SV_SvEntityForGentity: bad gEnt" );
 	}
 	return &sv.svEntities[ gEnt->s.number ];
@@ -248,6 +248,9 @@ SV_LocateGameData
 */
 void SV_LocateGameData( sharedEntity_t *gEnts, int numGEntities, int sizeofGEntity_t,
 					   playerState_t *clients, int sizeofGameClient ) {
+	if ( numGEntities > sv.maxEntities ) {
+		Com_Error( ERR_DROP, "SV_LocateGameData: %i entities with sv_maxEntities %i", numGEntities, sv.maxEntities );
+	}
 	sv.gentities = gEnts;
 	sv.gentitySize = sizeofGEntity_t;
 	sv.num_entities = numGEntities;
@@ -361,6 +364,9 @@ intptr_t SV_GameSystemCalls( intptr_t *args ) {
 	case G_TRACECAPSULE:
 		SV_Trace( VMA(1), VMA(2), VMA(3), VMA(4), VMA(5), args[6], args[7], /*int capsule*/ qtrue );
 		return 0;
+	case G_TRACE_BATCH:
+		SV_TraceBatch( VMA(1), args[2] );
+		return 0;
 	case G_POINT_CONTENTS:
 		return SV_PointContents( VMA(1), args[2] );
 	case G_SET_BRUSH_MODEL:
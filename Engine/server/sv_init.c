@@ -233,6 +233,22 @@ static void SV_CreateBaseline( void ) {
 }
 
 
+/*
+===============
+SV_BoundMaxEntities
+===============
+*/
+static void SV_BoundMaxEntities( void ) {
+	// get the current value, picking up a latched change
+	Cvar_Get( "sv_maxEntities", "2048", CVAR_SERVERINFO | CVAR_LATCH );
+
+	if ( sv_maxEntities->integer < 2 * MAX_CLIENTS ) {
+		Cvar_Set( "sv_maxEntities", va("%i", 2 * MAX_CLIENTS) );
+	} else if ( sv_maxEntities->integer > ENTITYNUM_MAX_NORMAL ) {
+		Cvar_Set( "sv_maxEntities", va("%i", ENTITYNUM_MAX_NORMAL) );
+	}
+}
+
 /*
 ===============
 SV_BoundMaxClients
@@ -463,6 +479,14 @@ void SV_SpawnServer( char *server ) {
 		sv.configstrings[i] = CopyString("");
 	}
 
+	// size the entity storage for this level
+	SV_BoundMaxEntities();
+	sv.maxEntities = sv_maxEntities->integer;
+	sv.svEntities = Hunk_Alloc( sizeof(svEntity_t) * sv.maxEntities, h_high );
+	sv.entityUpdateTimes = Hunk_Alloc( sizeof(int) * sv.maxEntities * sv_maxclients->integer, h_high );
+	// a map_restart has to respawn the server to pick up a change
+	sv_maxEntities->modified = qfalse;
+
 	// make sure we are not paused
 	Cvar_Set("cl_paused", "0");
 
@@ -612,6 +636,7 @@ void SV_Init (void)
 	sv_privateClients = Cvar_Get ("sv_privateClients", "0", CVAR_SERVERINFO);
 	sv_hostname = Cvar_Get ("sv_hostname", "noname", CVAR_SERVERINFO | CVAR_ARCHIVE );
 	sv_maxclients = Cvar_Get ("sv_maxclients", "8", CVAR_SERVERINFO | CVAR_LATCH);
+	sv_maxEntities = Cvar_Get ("sv_maxEntities", "2048", CVAR_SERVERINFO | CVAR_LATCH);
 
 	sv_minRate = Cvar_Get ("sv_minRate", "0", CVAR_ARCHIVE | CVAR_SERVERINFO );
 	sv_maxRate = Cvar_Get ("sv_maxRate", "0", CVAR_ARCHIVE | CVAR_SERVERINFO );
@@ -656,6 +681,9 @@ void SV_Init (void)
 	sv_killserver = Cvar_Get ("sv_killserver", "0", 0);
 	sv_mapChecksum = Cvar_Get ("sv_mapChecksum", "", CVAR_ROM);
 	sv_lanForceRate = Cvar_Get ("sv_lanForceRate", "1", CVAR_ARCHIVE );
+	sv_snapshotNear = Cvar_Get ("sv_snapshotNear", "2048", CVAR_ARCHIVE );
+	sv_snapshotFarMsec = Cvar_Get ("sv_snapshotFarMsec", "200", CVAR_ARCHIVE );
+	sv_snapshotFarError = Cvar_Get ("sv_snapshotFarError", "24", CVAR_ARCHIVE );
 	sv_banFile = Cvar_Get("sv_banFile", "serverbans.dat", CVAR_ARCHIVE);
 
 
@@ -426,6 +426,174 @@ static void SV_AddEntitiesVisibleFromPoint( vec3_t origin, clientSnapshot_t *fra
 	}
 }
 
+/*
+=============
+SV_EntityHoldMsec
+
+How long the entity may go without a fresh state in this client's
+snapshots.  Fighters and everything else close by, the client's lock-on
+target and anything the game flags SVF_FULLRATE are never held.  Past
+sv_snapshotNear the allowance grows with distance up to sv_snapshotFarMsec,
+stretched further while the client's snapshots run over its rate.
+=============
+*/
+static int SV_EntityHoldMsec( client_t *client, clientSnapshot_t *frame, sharedEntity_t *ent, vec3_t org ) {
+	vec3_t	delta;
+	float	near, dist;
+
+	if ( ent->r.svFlags & SVF_FULLRATE ) {
+		return 0;
+	}
+	if ( frame->ps.lockedTarget > 0 && ent->s.number == frame->ps.lockedTarget - 1 ) {
+		return 0;
+	}
+
+	near = sv_snapshotNear->value;
+	if ( near < 1 ) {
+		near = 1;
+	}
+	VectorAdd( ent->r.absmin, ent->r.absmax, delta );
+	VectorMA( org, -0.5f, delta, delta );
+	dist = VectorLength( delta );
+	if ( dist <= near ) {
+		return 0;
+	}
+
+	dist = ( dist - near ) / ( 3 * near );
+	if ( dist > 1 ) {
+		dist = 1;
+	}
+	return dist * sv_snapshotFarMsec->value * client->snapshotPressure;
+}
+
+/*
+=============
+SV_PredictedPosition
+
+Where a client will put a trajectory at the given time, for the types
+simple enough to follow here.  Returns qfalse for the rest.
+=============
+*/
+static qboolean SV_PredictedPosition( const trajectory_t *tr, int atTime, vec3_t result ) {
+	float	deltaTime;
+
+	switch ( tr->trType ) {
+	case TR_STATIONARY:
+	case TR_INTERPOLATE:
+		VectorCopy( tr->trBase, result );
+		return qtrue;
+	case TR_LINEAR_STOP:
+		if ( atTime > tr->trTime + tr->trDuration ) {
+			atTime = tr->trTime + tr->trDuration;
+		}
+		if ( atTime < tr->trTime ) {
+			atTime = tr->trTime;
+		}
+		// fall through
+	case TR_LINEAR:
+		deltaTime = ( atTime - tr->trTime ) * 0.001f;
+		VectorMA( tr->trBase, deltaTime, tr->trDelta, result );
+		return qtrue;
+	default:
+		return qfalse;
+	}
+}
+
+/*
+=============
+SV_TrajectoryDrifted
+
+True if a client following the held trajectory would end up further than
+sv_snapshotFarError from the real one, in units or, for angles, degrees.
+Trajectories that can't be followed here have to match exactly.
+=============
+*/
+static qboolean SV_TrajectoryDrifted( const trajectory_t *held, const trajectory_t *real, qboolean angles ) {
+	vec3_t	a, b;
+	int		i;
+
+	if ( held->trType != real->trType ) {
+		return qtrue;
+	}
+	if ( !SV_PredictedPosition( held, sv.time, a ) || !SV_PredictedPosition( real, sv.time, b ) ) {
+		return held->trTime != real->trTime || held->trDuration != real->trDuration
+			|| !VectorCompare( held->trBase, real->trBase ) || !VectorCompare( held->trDelta, real->trDelta );
+	}
+
+	if ( angles ) {
+		for ( i = 0 ; i < 3 ; i++ ) {
+			if ( fabs( AngleDelta( a[i], b[i] ) ) > sv_snapshotFarError->value ) {
+				return qtrue;
+			}
+		}
+		return qfalse;
+	}
+	return DistanceSquared( a, b ) > Square( sv_snapshotFarError->value );
+}
+
+/*
+=============
+SV_HeldEntityState
+
+Returns the state this client was last sent for the entity if it can make
+do with that for this snapshot, which costs nothing to delta.  oldframe
+is walked in step with the sorted entity numbers through *oldindex.  A
+state is only held while the client would still put the entity within
+sv_snapshotFarError of where it really is.
+=============
+*/
+static entityState_t *SV_HeldEntityState( client_t *client, clientSnapshot_t *frame, clientSnapshot_t *oldframe,
+									int *oldindex, sharedEntity_t *ent, vec3_t org ) {
+	entityState_t	*old;
+	int				holdMsec;
+
+	old = NULL;
+	while ( *oldindex < oldframe->num_entities ) {
+		old = &svs.snapshotEntities[( oldframe->first_entity + *oldindex ) % svs.numSnapshotEntities];
+		if ( old->number >= ent->s.number ) {
+			break;
+		}
+		( *oldindex )++;
+	}
+	if ( *oldindex == oldframe->num_entities || old->number != ent->s.number ) {
+		return NULL;		// new to this client
+	}
+
+	// events, type changes and anything that moves it too differently always go out
+	if ( old->event != ent->s.event || old->eType != ent->s.eType || old->eFlags != ent->s.eFlags ) {
+		return NULL;
+	}
+	if ( SV_TrajectoryDrifted( &old->pos, &ent->s.pos, qfalse ) || SV_TrajectoryDrifted( &old->apos, &ent->s.apos, qtrue ) ) {
+		return NULL;
+	}
+	// the slot may be overwritten by this very snapshot
+	if ( oldframe->first_entity + *oldindex <= svs.nextSnapshotEntities - svs.numSnapshotEntities ) {
+		return NULL;
+	}
+
+	holdMsec = SV_EntityHoldMsec( client, frame, ent, org );
+	if ( svs.time - sv.entityUpdateTimes[( client - svs.clients ) * sv.maxEntities + ent->s.number] >= holdMsec ) {
+		return NULL;
+	}
+	return old;
+}
+
+/*
+=============
+SV_ClearEntityUpdateTimes
+
+Forgets when entities were last sent to whoever had the slot before, so
+nothing is held from a snapshot this client never got
+=============
+*/
+void SV_ClearEntityUpdateTimes( client_t *client ) {
+	if ( !sv.entityUpdateTimes ) {
+		return;
+	}
+	Com_Memset( sv.entityUpdateTimes + ( client - svs.clients ) * sv.maxEntities, 0,
+		sv.maxEntities * sizeof( *sv.entityUpdateTimes ) );
+}
+
 /*
 =============
 SV_BuildClientSnapshot
@@ -450,6 +618,9 @@ static void SV_BuildClientSnapshot( client_t *client ) {
 	sharedEntity_t				*clent;
 	int							clientNum;
 	playerState_t				*ps;
+	clientSnapshot_t			*oldframe;
+	entityState_t				*held;
+	int							oldindex;
 
 	// bump the counter used to prevent double adding
 	sv.snapshotCounter++;
@@ -476,7 +647,7 @@ static void SV_BuildClientSnapshot( client_t *client ) {
 	// never send client's own entity, because it can
 	// be regenerated from the playerstate
 	clientNum = frame->ps.clientNum;
-	if ( clientNum < 0 || clientNum >= MAX_GENTITIES ) {
+	if ( clientNum < 0 || clientNum >= sv.maxEntities ) {
 		Com_Error( ERR_DROP, "SV_SvEntityForGentity: bad gEnt" );
 	}
 	svEnt = &sv.svEntities[ clientNum ];
@@ -504,13 +675,35 @@ static void SV_BuildClientSnapshot( client_t *client ) {
 		((int *)frame->areabits)[i] = ((int *)frame->areabits)[i] ^ -1;
 	}
 
+	// distant entities can be held at what the last snapshot sent them as,
+	// once the client is receiving deltas in this gamestate
+	oldframe = NULL;
+	oldindex = 0;
+	if ( sv_snapshotFarMsec->integer > 0 && client->state == CS_ACTIVE && client->deltaMessage > 0
+		&& client->netchan.remoteAddress.type != NA_LOOPBACK ) {
+		oldframe = &client->frames[( client->netchan.outgoingSequence - 1 ) & PACKET_MASK];
+		if ( oldframe->first_entity >= svs.nextSnapshotEntities
+			|| oldframe->first_entity <= svs.nextSnapshotEntities - svs.numSnapshotEntities ) {
+			oldframe = NULL;
+		}
+	}
+
 	// copy the entity states out
 	frame->num_entities = 0;
 	frame->first_entity = svs.nextSnapshotEntities;
 	for ( i = 0 ; i < entityNumbers.numSnapshotEntities ; i++ ) {
 		ent = SV_GentityNum(entityNumbers.snapshotEntities[i]);
 		state = &svs.snapshotEntities[svs.nextSnapshotEntities % svs.numSnapshotEntities];
-		*state = ent->s;
+		held = NULL;
+		if ( oldframe ) {
+			held = SV_HeldEntityState( client, frame, oldframe, &oldindex, ent, org );
+		}
+		if ( held ) {
+			*state = *held;
+		} else {
+			*state = ent->s;
+			sv.entityUpdateTimes[( client - svs.clients ) * sv.maxEntities + ent->s.number] = svs.time;
+		}
 		svs.nextSnapshotEntities++;
 		// this should never hit, map should always be restarted first in SV_Frame
 		if ( svs.nextSnapshotEntities >= 0x7FFFFFFE ) {
@@ -586,6 +779,30 @@ void SV_SendMessageToClient(msg_t *msg, client_t *client)
 }
 
 
+/*
+=======================
+SV_UpdateSnapshotPressure
+
+Holds distant entities back for longer while snapshots run over the
+client's share of its rate, and eases off again once they fit.
+=======================
+*/
+static void SV_UpdateSnapshotPressure( client_t *client, msg_t *msg ) {
+	int		budget;
+
+	budget = SV_ClientRate( client ) * client->snapshotMsec / 1000;
+	if ( msg->overflowed || msg->cursize > budget ) {
+		client->snapshotPressure *= 1.5f;
+	} else if ( msg->cursize < budget / 2 ) {
+		client->snapshotPressure /= 1.25f;
+	}
+	if ( client->snapshotPressure < 1 ) {
+		client->snapshotPressure = 1;
+	} else if ( client->snapshotPressure > 8 ) {
+		client->snapshotPressure = 8;
+	}
+}
+
 /*
 =======================
 SV_SendClientSnapshot
@@ -619,6 +836,8 @@ void SV_SendClientSnapshot( client_t *client ) {
 	SV_WriteVoipToClient( client, &msg );
 #endif
 
+	SV_UpdateSnapshotPressure( client, &msg );
+
 	// check for overflow
 	if ( msg.overflowed ) {
 		Com_Printf ("WARNING: msg overflowed for %s\n", client->name);
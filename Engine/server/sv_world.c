@@ -503,17 +503,14 @@ SV_ClipMoveToEntities
 
 ====================
 */
-static void SV_ClipMoveToEntities( moveclip_t *clip ) {
-	int			i, num;
-	int			touchlist[MAX_GENTITIES];
+static void SV_ClipMoveToEntities( moveclip_t *clip, const int *touchlist, int num ) {
+	int			i;
 	sharedEntity_t *touch;
 	int			passOwnerNum;
 	trace_t		trace;
 	clipHandle_t	clipHandle;
 	float		*origin, *angles;
 
-	num = SV_AreaEntities( clip->boxmins, clip->boxmaxs, touchlist, MAX_GENTITIES);
-
 	if ( clip->passEntityNum != ENTITYNUM_NONE ) {
 		passOwnerNum = ( SV_GentityNum( clip->passEntityNum ) )->r.ownerNum;
 		if ( passOwnerNum == ENTITYNUM_NONE ) {
@@ -585,6 +582,64 @@ static void SV_ClipMoveToEntities( moveclip_t *clip ) {
 }
 
 
+/*
+==================
+SV_MoveBounds
+
+The bounding box of the entire move
+==================
+*/
+static void SV_MoveBounds( const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, vec3_t boxmins, vec3_t boxmaxs ) {
+	int			i;
+
+	for ( i=0 ; i<3 ; i++ ) {
+		if ( end[i] > start[i] ) {
+			boxmins[i] = start[i] + mins[i] - 1;
+			boxmaxs[i] = end[i] + maxs[i] + 1;
+		} else {
+			boxmins[i] = end[i] + mins[i] - 1;
+			boxmaxs[i] = start[i] + maxs[i] + 1;
+		}
+	}
+}
+
+
+/*
+==================
+SV_StartMoveClip
+
+Clips the move to the world and sets up the clip for the entities.
+Returns qfalse if the world blocks it immediately.
+==================
+*/
+static qboolean SV_StartMoveClip( moveclip_t *clip, const vec3_t start, vec3_t mins, vec3_t maxs, const vec3_t end, int passEntityNum, int contentmask, int capsule ) {
+	Com_Memset ( clip, 0, sizeof ( moveclip_t ) );
+
+	// clip to world
+	CM_BoxTrace( &clip->trace, start, end, mins, maxs, 0, contentmask, capsule );
+	clip->trace.entityNum = clip->trace.fraction != 1.0 ? ENTITYNUM_WORLD : ENTITYNUM_NONE;
+	if ( clip->trace.fraction == 0 ) {
+		return qfalse;		// blocked immediately by the world
+	}
+
+	clip->contentmask = contentmask;
+	clip->start = start;
+//	VectorCopy( clip->trace.endpos, clip->end );
+	VectorCopy( end, clip->end );
+	clip->mins = mins;
+	clip->maxs = maxs;
+	clip->passEntityNum = passEntityNum;
+	clip->capsule = capsule;
+
+	// we could limit the box to the part of the move not
+	// already clipped off by the world, which can be
+	// a significant savings for line of sight and shot traces
+	SV_MoveBounds( clip->start, clip->mins, clip->maxs, clip->end, clip->boxmins, clip->boxmaxs );
+
+	return qtrue;
+}
+
+
 /*
 ==================
 SV_Trace
@@ -595,7 +650,8 @@ passEntityNum and entities owned by passEntityNum are explicitly not checked.
 */
 void SV_Trace( trace_t *results, const vec3_t start, vec3_t mins, vec3_t maxs, const vec3_t end, int passEntityNum, int contentmask, int capsule ) {
 	moveclip_t	clip;
-	int			i;
+	int			touchlist[MAX_GENTITIES];
+	int			num;
 
 	if ( !mins ) {
 		mins = vec3_origin;
@@ -604,43 +660,138 @@ void SV_Trace( trace_t *results, const vec3_t start, vec3_t mins, vec3_t maxs, c
 		maxs = vec3_origin;
 	}
 
-	Com_Memset ( &clip, 0, sizeof ( moveclip_t ) );
+	if ( SV_StartMoveClip( &clip, start, mins, maxs, end, passEntityNum, contentmask, capsule ) ) {
+		// clip to other solid entities
+		num = SV_AreaEntities( clip.boxmins, clip.boxmaxs, touchlist, MAX_GENTITIES );
+		SV_ClipMoveToEntities( &clip, touchlist, num );
+	}
 
-	// clip to world
-	CM_BoxTrace( &clip.trace, start, end, mins, maxs, 0, contentmask, capsule );
-	clip.trace.entityNum = clip.trace.fraction != 1.0 ? ENTITYNUM_WORLD : ENTITYNUM_NONE;
-	if ( clip.trace.fraction == 0 ) {
-		*results = clip.trace;
-		return;		// blocked immediately by the world
-	}
-
-	clip.contentmask = contentmask;
-	clip.start = start;
-//	VectorCopy( clip.trace.endpos, clip.end );
-	VectorCopy( end, clip.end );
-	clip.mins = mins;
-	clip.maxs = maxs;
-	clip.passEntityNum = passEntityNum;
-	clip.capsule = capsule;
-
-	// create the bounding box of the entire move
-	// we can limit it to the part of the move not
-	// already clipped off by the world, which can be
-	// a significant savings for line of sight and shot traces
-	for ( i=0 ; i<3 ; i++ ) {
-		if ( end[i] > start[i] ) {
-			clip.boxmins[i] = clip.start[i] + clip.mins[i] - 1;
-			clip.boxmaxs[i] = clip.end[i] + clip.maxs[i] + 1;
+	*results = clip.trace;
+}
+
+
+typedef struct {
+	float		absmin;			// along x
+	int			order;			// index in the SV_AreaEntities list
+} sweepEntity_t;
+
+static int SV_SweepCompare( const void *a, const void *b ) {
+	const sweepEntity_t	*ea = (const sweepEntity_t *)a;
+	const sweepEntity_t	*eb = (const sweepEntity_t *)b;
+
+	if ( ea->absmin < eb->absmin ) {
+		return -1;
+	}
+	if ( ea->absmin > eb->absmin ) {
+		return 1;
+	}
+	return ea->order - eb->order;
+}
+
+static int SV_OrderCompare( const void *a, const void *b ) {
+	return *(const int *)a - *(const int *)b;
+}
+
+/*
+==================
+SV_SweepFirst
+
+Index of the first sorted entity whose absmin is at least value
+==================
+*/
+static int SV_SweepFirst( const sweepEntity_t *sweep, int num, float value ) {
+	int		lo, hi, mid;
+
+	lo = 0;
+	hi = num;
+	while ( lo < hi ) {
+		mid = ( lo + hi ) >> 1;
+		if ( sweep[mid].absmin < value ) {
+			lo = mid + 1;
 		} else {
-			clip.boxmins[i] = clip.end[i] + clip.mins[i] - 1;
-			clip.boxmaxs[i] = clip.start[i] + clip.maxs[i] + 1;
+			hi = mid;
 		}
 	}
+	return lo;
+}
 
-	// clip to other solid entities
-	SV_ClipMoveToEntities ( &clip );
+/*
+==================
+SV_TraceBatch
 
-	*results = clip.trace;
+Runs a set of traces in one call.  The entities near any of the moves
+are gathered from the sector tree once and sorted along x, so each trace
+only looks at the ones whose x extent can reach its own move.  They are
+clipped in the order SV_AreaEntities would have listed them, so every
+result matches a separate SV_Trace.
+==================
+*/
+void SV_TraceBatch( batchTrace_t *traces, int count ) {
+	moveclip_t	clip;
+	batchTrace_t	*t;
+	int			touchlist[MAX_GENTITIES];
+	int			cliplist[MAX_GENTITIES];
+	sweepEntity_t	sweep[MAX_GENTITIES];
+	vec3_t		boxmins, boxmaxs;
+	vec3_t		allmins, allmaxs;
+	sharedEntity_t	*touch;
+	float		maxWidth;
+	int			i, j, num, clipnum, first;
+
+	if ( count <= 0 ) {
+		return;
+	}
+
+	ClearBounds( allmins, allmaxs );
+	for ( i = 0, t = traces ; i < count ; i++, t++ ) {
+		SV_MoveBounds( t->start, t->mins, t->maxs, t->end, boxmins, boxmaxs );
+		AddPointToBounds( boxmins, allmins, allmaxs );
+		AddPointToBounds( boxmaxs, allmins, allmaxs );
+	}
+
+	num = SV_AreaEntities( allmins, allmaxs, touchlist, MAX_GENTITIES );
+
+	// an entity can only reach a box if its absmin is within the widest
+	// entity of the box's x range, with a unit of slack for rounding
+	maxWidth = 0;
+	for ( j = 0 ; j < num ; j++ ) {
+		touch = SV_GentityNum( touchlist[j] );
+		sweep[j].absmin = touch->r.absmin[0];
+		sweep[j].order = j;
+		maxWidth = MAX( maxWidth, touch->r.absmax[0] - touch->r.absmin[0] );
+	}
+	qsort( sweep, num, sizeof( sweep[0] ), SV_SweepCompare );
+
+	for ( i = 0, t = traces ; i < count ; i++, t++ ) {
+		if ( !SV_StartMoveClip( &clip, t->start, t->mins, t->maxs, t->end, t->passEntityNum, t->contentmask, qfalse ) ) {
+			t->trace = clip.trace;
+			continue;
+		}
+
+		// the same test SV_AreaEntities_r makes
+		clipnum = 0;
+		first = SV_SweepFirst( sweep, num, clip.boxmins[0] - maxWidth - 1 );
+		for ( j = first ; j < num && sweep[j].absmin <= clip.boxmaxs[0] ; j++ ) {
+			touch = SV_GentityNum( touchlist[sweep[j].order] );
+			if ( touch->r.absmax[0] < clip.boxmins[0]
+			|| touch->r.absmin[1] > clip.boxmaxs[1]
+			|| touch->r.absmin[2] > clip.boxmaxs[2]
+			|| touch->r.absmax[1] < clip.boxmins[1]
+			|| touch->r.absmax[2] < clip.boxmins[2] ) {
+				continue;
+			}
+			cliplist[clipnum++] = sweep[j].order;
+		}
+
+		// back into the sector tree order
+		qsort( cliplist, clipnum, sizeof( cliplist[0] ), SV_OrderCompare );
+		for ( j = 0 ; j < clipnum ; j++ ) {
+			cliplist[j] = touchlist[cliplist[j]];
+		}
+
+		SV_ClipMoveToEntities( &clip, cliplist, clipnum );
+		t->trace = clip.trace;
+	}
 }
 
 
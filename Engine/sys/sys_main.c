@@ -156,6 +156,182 @@ char *Sys_GetClipboardData(void)
 #endif
 }
 
+#ifndef DEDICATED
+/*
+==============================================================
+
+THREADS
+
+Thin wrappers over the SDL threading primitives so the client
+subsystems can run work off the main thread without including SDL.
+
+==============================================================
+*/
+
+/*
+==================
+Sys_CreateThread
+==================
+*/
+sysThread_t *Sys_CreateThread( const char *name, int (*function)( void *data ), void *data )
+{
+	SDL_Thread *thread = SDL_CreateThread( function, name, data );
+
+	if( !thread )
+		Com_Printf( "Sys_CreateThread: couldn't start %s: %s\n", name, SDL_GetError( ) );
+
+	return (sysThread_t *)thread;
+}
+
+/*
+==================
+Sys_WaitThread
+==================
+*/
+int Sys_WaitThread( sysThread_t *thread )
+{
+	int status = 0;
+
+	if( thread )
+		SDL_WaitThread( (SDL_Thread *)thread, &status );
+
+	return status;
+}
+
+/*
+==================
+Sys_CreateMutex
+==================
+*/
+sysMutex_t *Sys_CreateMutex( void )
+{
+	return (sysMutex_t *)SDL_CreateMutex( );
+}
+
+/*
+==================
+Sys_DestroyMutex
+==================
+*/
+void Sys_DestroyMutex( sysMutex_t *mutex )
+{
+	if( mutex )
+		SDL_DestroyMutex( (SDL_mutex *)mutex );
+}
+
+/*
+==================
+Sys_LockMutex
+==================
+*/
+void Sys_LockMutex( sysMutex_t *mutex )
+{
+	if( mutex )
+		SDL_LockMutex( (SDL_mutex *)mutex );
+}
+
+/*
+==================
+Sys_UnlockMutex
+==================
+*/
+void Sys_UnlockMutex( sysMutex_t *mutex )
+{
+	if( mutex )
+		SDL_UnlockMutex( (SDL_mutex *)mutex );
+}
+
+/*
+==================
+Sys_CreateSemaphore
+==================
+*/
+sysSemaphore_t *Sys_CreateSemaphore( int value )
+{
+	return (sysSemaphore_t *)SDL_CreateSemaphore( value );
+}
+
+/*
+==================
+Sys_DestroySemaphore
+==================
+*/
+void Sys_DestroySemaphore( sysSemaphore_t *sem )
+{
+	if( sem )
+		SDL_DestroySemaphore( (SDL_sem *)sem );
+}
+
+/*
+==================
+Sys_PostSemaphore
+==================
+*/
+void Sys_PostSemaphore( sysSemaphore_t *sem )
+{
+	if( sem )
+		SDL_SemPost( (SDL_sem *)sem );
+}
+
+/*
+==================
+Sys_WaitSemaphore
+
+Blocks until the semaphore is posted or msec expires; a negative
+msec waits forever.  Returns qfalse on timeout.
+==================
+*/
+qboolean Sys_WaitSemaphore( sysSemaphore_t *sem, int msec )
+{
+	if( !sem )
+		return qfalse;
+
+	if( msec < 0 )
+		return SDL_SemWait( (SDL_sem *)sem ) == 0;
+
+	return SDL_SemWaitTimeout( (SDL_sem *)sem, msec ) == 0;
+}
+
+/*
+==================
+Sys_AtomicGet
+
+Load with acquire semantics: reads issued after this observe
+everything written before the matching Sys_AtomicSet.
+==================
+*/
+int Sys_AtomicGet( const volatile int *value )
+{
+	int result = *value;
+
+	SDL_MemoryBarrierAcquire( );
+	return result;
+}
+
+/*
+==================
+Sys_AtomicSet
+
+Store with release semantics
+==================
+*/
+void Sys_AtomicSet( volatile int *value, int newValue )
+{
+	SDL_MemoryBarrierRelease( );
+	*value = newValue;
+}
+
+/*
+==================
+Sys_ProcessorCount
+==================
+*/
+int Sys_ProcessorCount( void )
+{
+	return SDL_GetCPUCount( );
+}
+#endif
+
 #ifdef DEDICATED
 #	define PID_FILENAME PRODUCT_NAME "_server.pid"
 #else
@@ -65,20 +65,17 @@ CG_Aura_GetHullPoints
 =======================
   Reads and prepares the positions of the tags for a convex hull aura.
 */
-#define MAX_AURATAGNAME 12
 static void CG_Aura_GetHullPoints(centity_t *clientEntity,auraState_t *state,auraConfig_t *config){
-	char tagName[MAX_AURATAGNAME];
+	orientation_t tagOrients[MAX_AURATAGS];
+	qboolean found[MAX_AURATAGS];
 	int hullIndex = 0;
-	for(int bodyPart=0;bodyPart<3;bodyPart++){
-		for(int tagIndex=0;tagIndex<config->numTags[bodyPart];tagIndex++){
-			orientation_t tagOrient;
-			Com_sprintf(tagName,sizeof(tagName),"tag_aura%d",tagIndex);
-			if(!CG_TryLerpPlayerTag(clientEntity,tagName,&tagOrient)){continue;}
-			VectorCopy(tagOrient.origin,state->convexHull[hullIndex].pos_world);
-			if(CG_WorldCoordToScreenCoordVec(state->convexHull[hullIndex].pos_world,state->convexHull[hullIndex].pos_screen)){
-				state->convexHull[hullIndex].is_tail = qfalse;
-				hullIndex++;
-			}
+	CG_LerpPlayerTags(clientEntity,config->hullTags,config->numHullTags,tagOrients,found);
+	for(int tagIndex=0;tagIndex<config->numHullTags;tagIndex++){
+		if(!found[tagIndex]){continue;}
+		VectorCopy(tagOrients[tagIndex].origin,state->convexHull[hullIndex].pos_world);
+		if(CG_WorldCoordToScreenCoordVec(state->convexHull[hullIndex].pos_world,state->convexHull[hullIndex].pos_screen)){
+			state->convexHull[hullIndex].is_tail = qfalse;
+			hullIndex++;
 		}
 	}
 	// Find the aura's tail point
@@ -814,6 +811,20 @@ void parseAura(char* path,auraConfig_t* aura){
 		}
 	}
 }
+/*
+=======================
+CG_Aura_RegisterHullTags
+=======================
+  Every body part counts its tags from tag_aura0.
+*/
+static void CG_Aura_RegisterHullTags(auraConfig_t *config){
+	config->numHullTags = 0;
+	for(int bodyPart=0;bodyPart<3;bodyPart++){
+		for(int tagIndex=0;tagIndex<config->numTags[bodyPart] && config->numHullTags<MAX_AURATAGS;tagIndex++){
+			config->hullTags[config->numHullTags++] = CG_RegisterTag(va("tag_aura%d",tagIndex));
+		}
+	}
+}
 void CG_RegisterClientAura(int clientNum,clientInfo_t *ci){
 	char filename[MAX_QPATH*2];
 	memset(&(auraStates[clientNum]),0,sizeof(auraState_t));
@@ -824,6 +835,7 @@ void CG_RegisterClientAura(int clientNum,clientInfo_t *ci){
 		parseAura(filename,ci->auraConfig[i]);
 		Com_sprintf(filename,sizeof(filename),"players/%s/tier%i/tier.cfg",ci->modelName,i+1);
 		parseAura(filename,ci->auraConfig[i]);
+		CG_Aura_RegisterHullTags(ci->auraConfig[i]);
 	}
 }
 /*
@@ -36,6 +36,8 @@ typedef struct auraConfig_s{
 	qhandle_t boostLoopSound;
 	char particleSystem[MAX_QPATH];
 	int numTags[3]; // 0 = Legs, 1 = Torso, 2 = Head
+	int hullTags[MAX_AURATAGS]; // CG_RegisterTag handles of the tags above, in order
+	int numHullTags;
 }auraConfig_t;
 typedef struct auraState_s{
 	qboolean isActive;
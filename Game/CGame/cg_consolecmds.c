@@ -144,6 +144,7 @@ static consoleCommand_t	commands[] = {
 	{"startOrbit",	CG_StartOrbit_f},
 	{"draw2D",		CG_Draw2D_f},
 	{"draw2d",		CG_Draw2D_f},
+	{"predictStats",	CG_PredictStats_f},
 };
 
 /*
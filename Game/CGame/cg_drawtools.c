@@ -142,51 +142,27 @@ Coordinates are at 640 by 480 virtual resolution
 void CG_DrawStringExt(int spacing, int x, int y, const char *string, const float *setColor, qboolean forceColor,
 						qboolean shadow, int charWidth, int charHeight, int maxChars){
 	vec4_t		color;
-	const char	*s;
-	int			xx;
-	int			cnt;
+	float		ax, ay, aw, ah,
+				advance;
 
-	if(maxChars <= 0) maxChars = 32767; // do them all!
+	if(!charWidth) return;
 	spacing = spacing == -1 ? charWidth : spacing;
+	ax = x;
+	ay = y;
+	aw = charWidth;
+	ah = charHeight;
+	CG_AdjustFrom640(&ax, &ay, &aw, &ah, qtrue);
+	advance = aw * spacing / charWidth;
 	// draw the drop shadow
 	if(shadow){
 		color[0] = color[1] = color[2] = 0;
 		color[3] = .5f;
 		trap_R_SetColor(color);
-		s = string;
-		xx = x;
-		cnt = 0;
-		while(*s && cnt < maxChars){
-			if(Q_IsColorString(s)){
-				s += 2;
-				continue;
-			}
-			CG_DrawChar(xx+1, y+1, charWidth, charHeight, *s);
-			cnt++;
-			xx += spacing;
-			s++;
-		}
+		trap_R_DrawString(ax + cgs.screenXScale, ay + cgs.screenYScale, aw, ah, advance, string, maxChars, DS_FORCECOLOR, cgs.media.charsetShader);
 	}
 	// draw the colored text
-	s = string;
-	xx = x;
-	cnt = 0;
 	trap_R_SetColor(setColor);
-	while(*s && cnt < maxChars){
-		if(Q_IsColorString(s)){
-			if(!forceColor){
-				memcpy(color, g_color_table[ColorIndex(*(s+1))], sizeof(color));
-				color[3] = setColor[3];
-				trap_R_SetColor(color);
-			}
-			s += 2;
-			continue;
-		}
-		CG_DrawChar(xx, y, charWidth, charHeight, *s);
-		xx += spacing;
-		cnt++;
-		s++;
-	}
+	trap_R_DrawString(ax, ay, aw, ah, advance, string, maxChars, forceColor ? DS_FORCECOLOR : 0, cgs.media.charsetShader);
 	trap_R_SetColor(NULL);
 }
 
@@ -107,8 +107,8 @@ void CG_GetTagPosition(refEntity_t *parent, char *tagName, vec3_t outpos){
 	int				i;
 
 	// lerp the tag
-	trap_R_LerpTag(&lerped, parent->hModel, parent->oldframe, parent->frame,
-					1.f -parent->backlerp, tagName);
+	CG_LerpModelTag(&lerped, parent->hModel, parent->oldframe, parent->frame,
+					1.f -parent->backlerp, CG_RegisterTag(tagName));
 	VectorCopy(parent->origin, outpos);
 	for(i=0;i<3;i++)
 		VectorMA(outpos, lerped.origin[i], parent->axis[i], outpos);
@@ -126,8 +126,8 @@ void CG_GetTagOrientation(refEntity_t *parent, char *tagName, vec3_t dir){
 	vec3_t			temp_axis[3];
 
 	// lerp the tag
-	trap_R_LerpTag(&lerped, parent->hModel, parent->oldframe, parent->frame,
-					1.f -parent->backlerp, tagName);
+	CG_LerpModelTag(&lerped, parent->hModel, parent->oldframe, parent->frame,
+					1.f -parent->backlerp, CG_RegisterTag(tagName));
 	MatrixMultiply(lerped.axis, ((refEntity_t *)parent)->axis, temp_axis);
 	VectorCopy(temp_axis[0], dir);
 }
@@ -146,8 +146,8 @@ void CG_PositionEntityOnTag(refEntity_t *entity, const refEntity_t *parent,
 	int				i;
 	
 	// lerp the tag
-	trap_R_LerpTag(&lerped, parentModel, parent->oldframe, parent->frame,
-					1.f -parent->backlerp, tagName);
+	CG_LerpModelTag(&lerped, parentModel, parent->oldframe, parent->frame,
+					1.f -parent->backlerp, CG_RegisterTag(tagName));
 	// FIXME: allow origin offsets along tag?
 	VectorCopy(parent->origin, entity->origin);
 	for(i=0;i<3;i++)
@@ -172,8 +172,8 @@ void CG_PositionRotatedEntityOnTag(refEntity_t *entity, const refEntity_t *paren
 	int				i;
 
 	// lerp the tag
-	trap_R_LerpTag(&lerped, parentModel, parent->oldframe, parent->frame,
-					1.f -parent->backlerp, tagName);
+	CG_LerpModelTag(&lerped, parentModel, parent->oldframe, parent->frame,
+					1.f -parent->backlerp, CG_RegisterTag(tagName));
 	// FIXME: allow origin offsets along tag?
 	VectorCopy( parent->origin, entity->origin );
 	for(i=0;i<3;i++)
@@ -314,7 +314,7 @@ void CG_TrailFunc_StraightBeam(centity_t *ent){
 	Com_Clamp(0.0f,1.0f,radiusScale);
 	// Obtain the scale the missile must have.
 	radius = weaponGraphics->missileTrailRadius ? weaponGraphics->missileTrailRadius * radiusScale : 10;
-	if(CG_TryLerpPlayerTag(owner_ent,weaponGraphics->chargeTag[0],&orient)){
+	if(CG_LerpPlayerTag(owner_ent,weaponGraphics->chargeTagHandle[0],&orient)){
 		CG_DrawLine(orient.origin, ent->lerpOrigin, radius, weaponGraphics->missileTrailShader,radiusScale);
 	}
 }
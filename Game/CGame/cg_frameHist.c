@@ -18,7 +18,7 @@ void CG_FrameHist_Init(void){
 void CG_FrameHist_NextFrame(void){
 	int i;
 
-	for(i=0;i<MAX_GENTITIES;i++){
+	for(i=0;i<cgs.maxEntities;i++){
 		frHist_lastFrame[i].inPVS = frHist_thisFrame[i].inPVS;
 		frHist_thisFrame[i].inPVS = qfalse;
 		frHist_lastFrame[i].hasAura = frHist_thisFrame[i].hasAura;
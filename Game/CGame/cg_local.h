@@ -440,6 +440,7 @@ typedef struct{
 // all cg.stepTime, cg.duckTime, cg.landTime, etc are set to cg.time when the action
 // occurs, and they will have visible effects for #define STEP_TIME or whatever msec after
 #define MAX_PREDICTED_EVENTS	16
+#define NUM_SAVED_STATES		( CMD_BACKUP + 2 )
 #if EARTHQUAKE_SYSTEM	// JUHOX: definitions
 typedef struct{
 	vec3_t	origin;
@@ -491,6 +492,21 @@ typedef struct{
 	qboolean		validPPS;				// clear until the first call to CG_PredictPlayerState
 	int				predictedErrorTime;
 	vec3_t			predictedError;
+	// every predicted state since the last snapshot, so that a snapshot
+	// agreeing with one of them only needs the commands after it predicted
+	playerState_t	savedPmoveStates[NUM_SAVED_STATES];
+	int				stateHead,
+					stateTail,
+					lastPredictedCommand,
+					lastServerTime;
+	// counted until predictStats is run
+	int				predictFrames,
+					predictSnapshots,
+					predictSnapshotsMatched,
+					predictCommandsRun,
+					predictCommandsReused,
+					predictErrors;
+	float			predictErrorTotal;
 	int				eventSequence,
 					predictableEvents[MAX_PREDICTED_EVENTS];
 	float			stepChange;				// for stair up smoothing
@@ -731,6 +747,11 @@ typedef struct{
 					waterSplashExtraLarge1,
 					waterSplashExtraLarge2;
 				// END ADDING
+	// CG_RegisterTag handles
+	int				eyesTag,
+					headTag,
+					camTag,
+					camTarTag;
 } cgMedia_t;
 
 // The client game static (cgs) structure holds everything
@@ -754,7 +775,8 @@ typedef struct{
 								fraglimit,
 								capturelimit,
 								timelimit,
-								maxclients;
+								maxclients,
+								maxEntities;
 	char						mapname[MAX_QPATH],
 								redTeam[MAX_QPATH],
 								blueTeam[MAX_QPATH],
@@ -867,6 +889,7 @@ extern	vmCvar_t		cg_centertime,
 						cg_nopredict,
 						cg_noPlayerAnims,
 						cg_showmiss,
+						cg_optimizePrediction,
 						cg_footsteps,
 						cg_addMarks,
 						cg_brassTime,
@@ -1054,6 +1077,13 @@ sfxHandle_t		CG_CustomSound(int clientNum, const char *soundName);
 qboolean		CG_ParseAnimationFile(const char *filename, clientInfo_t *ci, qboolean isCamera);
 clientInfo_t*	CG_GetClientInfo(centity_t* clientEntity);
 qboolean		CG_TryLerpPlayerTag(centity_t* clientEntity,char *tagName,orientation_t* out);
+void			CG_InitModelTags(void),
+				CG_ResolveModelTags(qhandle_t model);
+int				CG_RegisterTag(const char *tagName),
+				CG_ModelTagIndex(qhandle_t model, int tag),
+				CG_LerpPlayerTags(centity_t *clientEntity, const int *tags, int numTags, orientation_t *out, qboolean *found);
+qboolean		CG_LerpModelTag(orientation_t *out, qhandle_t model, int startFrame, int endFrame, float frac, int tag),
+				CG_LerpPlayerTag(centity_t *clientEntity, int tag, orientation_t *out);
 
 //
 // cg_predict.c
@@ -1066,6 +1096,7 @@ void			CG_BuildSolidList(void),
 				CG_SmoothTrace(trace_t *result, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int skipNumber, int mask),
 #endif
 				CG_PredictPlayerState(void),
+				CG_PredictStats_f(void),
 //
 // cg_events.c
 //
@@ -1270,8 +1301,11 @@ int				trap_R_LightForPoint(vec3_t point, vec3_t ambientLight, vec3_t directedLi
 void			trap_R_RenderScene(const refdef_t *fd),
 				trap_R_SetColor(const float *rgba),	// NULL = 1,1,1,1
 				trap_R_DrawStretchPic(float x, float y, float w, float h, float s1, float t1, float s2, float t2, qhandle_t hShader),
+				trap_R_DrawString(float x, float y, float w, float h, float advance, const char *string, int maxChars, int flags, qhandle_t hShader),
 				trap_R_ModelBounds(clipHandle_t model, vec3_t mins, vec3_t maxs, int frame);
-int				trap_R_LerpTag(orientation_t *tag, clipHandle_t mod, int startFrame, int endFrame, float frac, const char *tagName);
+int				trap_R_LerpTag(orientation_t *tag, clipHandle_t mod, int startFrame, int endFrame, float frac, const char *tagName),
+				trap_R_TagIndex(clipHandle_t mod, const char *tagName),
+				trap_R_LerpTags(orientation_t *tags, clipHandle_t mod, int startFrame, int endFrame, float frac, const int *tagIndexes, int numTags);
 void			trap_R_RemapShader(const char *oldShader, const char *newShader, const char *timeOffset),
 // The glconfig_t will not change during the life of a cgame.
 // If it needs to change, the entire cgame will be restarted, because
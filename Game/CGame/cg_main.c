@@ -104,6 +104,7 @@ vmCvar_t			cg_railTrailTime,
 					cg_nopredict,
 					cg_noPlayerAnims,
 					cg_showmiss,
+					cg_optimizePrediction,
 					cg_footsteps,
 					cg_addMarks,
 					cg_brassTime,
@@ -234,6 +235,7 @@ static cvarTable_t cvarTable[] = {
 	{&cg_nopredict,						"cg_nopredict",						"0",		0},
 	{&cg_noPlayerAnims,					"cg_noplayeranims",					"0",		CVAR_CHEAT},
 	{&cg_showmiss,						"cg_showmiss",						"0",		0},
+	{&cg_optimizePrediction,			"cg_optimizePrediction",			"1",		CVAR_ARCHIVE},
 	{&cg_footsteps,						"cg_footsteps",						"1",		CVAR_CHEAT},
 	{&cg_lockedRange,					"cg_lockedRange",					"30",		CVAR_ARCHIVE},
 	{&cg_lockedAngle,					"cg_lockedAngle",					"320",		0},
@@ -509,6 +511,10 @@ static void CG_RegisterGraphics(void){
 	cgs.media.chatBubble =							trap_R_RegisterShader("chatBubble");
 	for(i=0;i<NUM_CROSSHAIRS;i++)
 		cgs.media.crosshairShader[i] =				trap_R_RegisterShader(va("crosshair%c", 'a'+i));
+	cgs.media.eyesTag =								CG_RegisterTag("tag_eyes");
+	cgs.media.headTag =								CG_RegisterTag("tag_head");
+	cgs.media.camTag =								CG_RegisterTag("tag_cam");
+	cgs.media.camTarTag =							CG_RegisterTag("tag_camTar");
 	cgs.media.speedLineShader =						trap_R_RegisterShaderNoMip("speedLines");
 	cgs.media.speedLineSpinShader =					trap_R_RegisterShaderNoMip("speedLinesSpin");
 	cgs.media.waterSplashSkin =						trap_R_RegisterSkin("effects/water/waterSplash.skin");
@@ -655,6 +661,7 @@ void CG_Init(int serverMessageNum, int serverCommandSequence, int clientNum){
 	trap_CM_LoadMap(cgs.mapname);
 	// force players to load instead of defer
 	cg.loading = qtrue;	
+	CG_InitModelTags();
 	CG_LoadingString("sounds");
 	CG_RegisterSounds();
 	CG_LoadingString("graphics");
@@ -299,7 +299,7 @@ static void CG_LoadClientInfo(clientInfo_t *ci){
 	// reset any existing players and bodies, because they might be in bad
 	// frames for this new model
 	clientNum = ci - cgs.clientinfo;
-	for(i=0;i<MAX_GENTITIES;i++)
+	for(i=0;i<cgs.maxEntities;i++)
 		if(cg_entities[i].currentState.clientNum == clientNum && (cg_entities[i].currentState.eType == ET_INVISIBLE || cg_entities[i].currentState.eType == ET_PLAYER))
 			CG_ResetPlayerEntity(&cg_entities[i]);
 	// REFPOINT: Load the additional tiers' clientInfo here
@@ -310,6 +310,13 @@ static void CG_LoadClientInfo(clientInfo_t *ci){
 		Com_sprintf(filename, sizeof(filename), "players/%s/%s.grfx", ci->modelName, ci->skinName);
 		CG_weapGfx_Parse(filename, clientNum);
 	}
+	// the aura and weapons have registered their tags by now
+	for(tier=0;tier<8;tier++){
+		for(i=0;i<3;i++)
+			for(count=0;count<10;count++)
+				CG_ResolveModelTags(ci->modelDamageState[tier][i][count]);
+		CG_ResolveModelTags(ci->cameraModel[tier]);
+	}
 }
 
 /*======================
@@ -1308,58 +1315,204 @@ void CG_Player(centity_t *cent){
 
 /*
 ===============
-CG_TryLerpPlayerTag
+Model tags
 
-If the entity in question is of the type ET_PLAYER, this gets the orientation of a tag on the player's model
-and stores it. If the entity is of a different type, the tag is not found, or the model is on
-the bodyQue and belongs to a disconnected client with invalid clientInfo, false is returned. In other cases, true is returned.
+Tag names are registered once, by whatever parses or loads the thing that
+needs them, and referred to by handle afterwards.  A model resolves every
+registered name to its own tag number the first time it is asked about any
+of them, so lerping a tag never searches a model's tag names again, and all
+the tags wanted off one model come from a single trap_R_LerpTags call.
+Handle 0 is no tag, so cleared structures hold none.
 ===============
 */
-qboolean CG_TryLerpPlayerTag(centity_t *clientEntity,char *tagName,orientation_t *out){
-	playerEntity_t* playerEntity;
-	// The client number is stored in clientNum.  It can't be derived
-	// from the entity number, because a single client may have
-	// multiple corpses on the level using the same clientinfo
-	int clientNumber = clientEntity->currentState.clientNum;
-	playerEntity = NULL;
-	if(!tagName[0]){
-		//CG_Printf("^3CG_TryLerpPlayerTag(): tagName is empty\n");
-		return qfalse;
+#define	MAX_MODEL_TAGS		128		// distinct tag names
+#define	MAX_TAGGED_MODELS	1024	// model handles, as the renderer's MAX_MOD_KNOWN
+#define	MODEL_TAG_HASH		256
+
+static char		modelTagNames[MAX_MODEL_TAGS][MAX_QPATH];
+static int		modelTagHashNext[MAX_MODEL_TAGS];
+static int		modelTagHash[MODEL_TAG_HASH];
+static int		numModelTags;
+static qboolean	modelTagsFull;		// the warning has been given
+// tag numbers each model knows the registered names by, -1 if it lacks one
+static short	modelTagIndexes[MAX_TAGGED_MODELS][MAX_MODEL_TAGS];
+static int		modelTagsResolved[MAX_TAGGED_MODELS];
+
+static int CG_ModelTagHash(const char *tagName){
+	unsigned hash = 0;
+	while(*tagName){hash = hash * 31 + (unsigned char)*tagName++;}
+	return hash & (MODEL_TAG_HASH - 1);
+}
+
+/*
+===============
+CG_InitModelTags
+===============
+*/
+void CG_InitModelTags(void){
+	numModelTags = 1;
+	modelTagsFull = qfalse;
+	memset(modelTagHash, -1, sizeof(modelTagHash));
+	for(int model=0;model<MAX_TAGGED_MODELS;model++){modelTagsResolved[model] = 1;}
+}
+
+/*
+===============
+CG_RegisterTag
+
+Returns the handle for a tag name, or 0 if the name is empty.
+===============
+*/
+int CG_RegisterTag(const char *tagName){
+	int hash, tag;
+	if(!tagName || !tagName[0]){return 0;}
+	hash = CG_ModelTagHash(tagName);
+	for(tag=modelTagHash[hash];tag >= 0;tag=modelTagHashNext[tag]){
+		if(!strcmp(modelTagNames[tag], tagName)){return tag;}
 	}
-	if(clientEntity->currentState.eType != ET_PLAYER){
-		//CG_Printf("^3CG_TryLerpPlayerTag(): entity is not of player type\n");
-		return qfalse;
+	if(numModelTags == MAX_MODEL_TAGS){
+		if(!modelTagsFull){
+			CG_Printf("^3CG_RegisterTag(): MAX_MODEL_TAGS hit, ignoring '%s' and any other new tags\n", tagName);
+			modelTagsFull = qtrue;
+		}
+		return 0;
 	}
-	if(clientNumber < 0 || clientNumber >= MAX_CLIENTS){
-		//CG_Printf("^3CG_TryLerpPlayerTag(): Bad clientNumber.\n");
-		return qfalse;
+	tag = numModelTags++;
+	Q_strncpyz(modelTagNames[tag], tagName, sizeof(modelTagNames[tag]));
+	modelTagHashNext[tag] = modelTagHash[hash];
+	modelTagHash[hash] = tag;
+	return tag;
+}
+
+/*
+===============
+CG_ResolveModelTags
+
+Looks up any names registered since the model was last asked about.
+Models are resolved as they are registered, tags registered later are
+picked up the first time they are asked for.
+===============
+*/
+void CG_ResolveModelTags(qhandle_t model){
+	if(model <= 0 || model >= MAX_TAGGED_MODELS){return;}
+	for(;modelTagsResolved[model] < numModelTags;modelTagsResolved[model]++){
+		int tag = modelTagsResolved[model];
+		modelTagIndexes[model][tag] = trap_R_TagIndex(model, modelTagNames[tag]);
+	}
+}
+
+/*
+===============
+CG_ModelTagIndex
+
+The model's own number for a registered tag, -1 if it has no such tag.
+===============
+*/
+int CG_ModelTagIndex(qhandle_t model, int tag){
+	if(tag <= 0 || tag >= numModelTags){return -1;}
+	if(model <= 0 || model >= MAX_TAGGED_MODELS){
+		return model ? trap_R_TagIndex(model, modelTagNames[tag]) : -1;
 	}
-	// It is possible to see corpses from disconnected players that may
-	// not have valid clientinfo
-	if(!cgs.clientinfo[clientNumber].infoValid){
-		//CG_Printf("^3CG_TryLerpPlayerTag(): invalid clientInfo.\n");
+	if(modelTagsResolved[model] <= tag){CG_ResolveModelTags(model);}
+	return modelTagIndexes[model][tag];
+}
+
+/*
+===============
+CG_LerpModelTag
+
+trap_R_LerpTag for a registered tag.
+===============
+*/
+qboolean CG_LerpModelTag(orientation_t *out, qhandle_t model, int startFrame, int endFrame, float frac, int tag){
+	int index = CG_ModelTagIndex(model, tag);
+	if(index < 0){
+		AxisClear(out->axis);
+		VectorClear(out->origin);
 		return qfalse;
 	}
-	// HACK: Use this copy, which is sure to be stored correctly, unlike
-	//       reading it from cg_entities, which tends to clear out its
-	//       fields every now and then. WTF?!
+	return trap_R_LerpTags(out, model, startFrame, endFrame, frac, &index, 1) > 0;
+}
+
+/*
+===============
+CG_LerpPlayerTags
+
+Lerps a set of registered tags on a player's model, trying each of its
+model parts in turn, with one trap_R_LerpTags call per part that has any
+of them.  found[i] tells whether out[i] was
+set.  Returns the number of tags found.
+===============
+*/
+int CG_LerpPlayerTags(centity_t *clientEntity, const int *tags, int numTags, orientation_t *out, qboolean *found){
+	playerEntity_t *playerEntity;
+	orientation_t lerped[MAX_MODEL_TAGS];
+	int partIndexes[MAX_MODEL_TAGS];
+	int partSlots[MAX_MODEL_TAGS];
+	int clientNumber = clientEntity->currentState.clientNum;
+	int numFound = 0;
+	if(numTags > MAX_MODEL_TAGS){numTags = MAX_MODEL_TAGS;}
+	for(int i=0;i<numTags;i++){found[i] = qfalse;}
+	if(clientEntity->currentState.eType != ET_PLAYER){return 0;}
+	if(clientNumber < 0 || clientNumber >= MAX_CLIENTS){return 0;}
+	if(!cgs.clientinfo[clientNumber].infoValid){return 0;}
 	playerEntity = &playerInfoDuplicate[clientNumber];
-	for(int modelPart=0;modelPart<4;modelPart++){
-		orientation_t	lerped;
-		vec3_t			tempAxis[3];
-		AxisClear(out->axis);
-		if(trap_R_LerpTag(&lerped,playerEntity->modelEntities[modelPart].hModel,playerEntity->modelLerpFrames[modelPart].oldFrame,
-							playerEntity->modelLerpFrames[modelPart].frame,1.0f - playerEntity->modelLerpFrames[modelPart].backlerp,tagName)){
-			VectorCopy(playerEntity->modelEntities[modelPart].origin,out->origin);
+	for(int modelPart=0;modelPart<4 && numFound < numTags;modelPart++){
+		refEntity_t *part = &playerEntity->modelEntities[modelPart];
+		lerpFrame_t *frames = &playerEntity->modelLerpFrames[modelPart];
+		int count = 0;
+		for(int i=0;i<numTags;i++){
+			int index;
+			if(found[i]){continue;}
+			index = CG_ModelTagIndex(part->hModel, tags[i]);
+			if(index < 0){continue;}
+			partIndexes[count] = index;
+			partSlots[count] = i;
+			count++;
+		}
+		if(!count){continue;}
+		trap_R_LerpTags(lerped, part->hModel, frames->oldFrame, frames->frame, 1.0f - frames->backlerp, partIndexes, count);
+		for(int j=0;j<count;j++){
+			orientation_t *tagOut = &out[partSlots[j]];
+			vec3_t tempAxis[3];
+			AxisClear(tagOut->axis);
+			VectorCopy(part->origin, tagOut->origin);
 			for(int axisIndex=0;axisIndex<3;axisIndex++){
-				VectorMA(out->origin,lerped.origin[axisIndex],playerEntity->modelEntities[modelPart].axis[axisIndex],out->origin);
+				VectorMA(tagOut->origin, lerped[j].origin[axisIndex], part->axis[axisIndex], tagOut->origin);
 			}
-			MatrixMultiply(out->axis,lerped.axis,tempAxis);
-			MatrixMultiply(tempAxis,playerEntity->modelEntities[modelPart].axis,out->axis);
-			return qtrue;
+			MatrixMultiply(tagOut->axis, lerped[j].axis, tempAxis);
+			MatrixMultiply(tempAxis, part->axis, tagOut->axis);
+			found[partSlots[j]] = qtrue;
+			numFound++;
 		}
 	}
-	return qfalse;
+	return numFound;
+}
+
+/*
+===============
+CG_LerpPlayerTag
+===============
+*/
+qboolean CG_LerpPlayerTag(centity_t *clientEntity, int tag, orientation_t *out){
+	qboolean found;
+	if(tag <= 0){return qfalse;}
+	CG_LerpPlayerTags(clientEntity, &tag, 1, out, &found);
+	return found;
+}
+
+/*
+===============
+CG_TryLerpPlayerTag
+
+If the entity in question is of the type ET_PLAYER, this gets the orientation of a tag on the player's model
+and stores it. If the entity is of a different type, the tag is not found, or the model is on
+the bodyQue and belongs to a disconnected client with invalid clientInfo, false is returned. In other cases, true is returned.
+Callers that ask every frame should register the tag once and use CG_LerpPlayerTag instead.
+===============
+*/
+qboolean CG_TryLerpPlayerTag(centity_t *clientEntity,char *tagName,orientation_t *out){
+	return CG_LerpPlayerTag(clientEntity, CG_RegisterTag(tagName), out);
 }
 
 /*
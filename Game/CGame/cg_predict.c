@@ -197,6 +197,66 @@ static void CG_TouchTriggerPrediction(void){
 		cg.predictedPlayerState.jumppad_ent = 0;
 	}
 }
+#define PSOFS(x) ((int)(size_t)&((playerState_t*)0)->x)
+static qboolean CG_SameWords(const void *a, const void *b, int bytes){
+	const int *x = a, *y = b;
+	for(bytes/=4;bytes>0;bytes--){
+		if(*x++ != *y++){return qfalse;}
+	}
+	return qtrue;
+}
+//Compares everything the server sends of the two states, which leaves out
+//lockTimer, the lock pointers and the fields that are never sent at all
+static qboolean CG_SamePrediction(const playerState_t *a, const playerState_t *b){
+	return CG_SameWords(a, b, PSOFS(lockTimer))
+		&& CG_SameWords(&a->movementDir, &b->movementDir, PSOFS(lockedPlayer) - PSOFS(movementDir))
+		&& CG_SameWords(&a->soarLimit, &b->soarLimit, PSOFS(attackPowerTotal) - PSOFS(soarLimit));
+}
+//Finds the saved prediction for the commandTime of the new snapshot's state
+//and, if the server agrees with it, takes it as the starting point.
+//Returns the first command that still has to be predicted.
+static int CG_MatchSavedPrediction(int current){
+	int i;
+	cg.predictSnapshots++;
+	for(i=cg.stateHead;i!=cg.stateTail;i=(i+1) % NUM_SAVED_STATES){
+		if(cg.savedPmoveStates[i].commandTime != cg.predictedPlayerState.commandTime){continue;}
+		if(!CG_SamePrediction(&cg.predictedPlayerState, &cg.savedPmoveStates[i])){
+			if(cg_showmiss.integer){CG_Printf("saved prediction differs from snapshot\n");}
+			break;
+		}
+		cg.predictedPlayerState = cg.savedPmoveStates[i];
+		cg.stateHead = (i+1) % NUM_SAVED_STATES;
+		cg.predictSnapshotsMatched++;
+		return cg.lastPredictedCommand + 1;
+	}
+	// start over from the snapshot
+	cg.lastPredictedCommand = 0;
+	cg.stateTail = cg.stateHead;
+	return current - CMD_BACKUP + 1;
+}
+/*
+===================
+CG_PredictStats_f
+
+Prints how much of the prediction was reused since the last time.
+===================
+*/
+void CG_PredictStats_f(void){
+	int frames = cg.predictFrames ? cg.predictFrames : 1;
+	CG_Printf("%i frames predicted\n", cg.predictFrames);
+	CG_Printf("%i snapshots, %i matched a saved prediction\n", cg.predictSnapshots, cg.predictSnapshotsMatched);
+	CG_Printf("%.2f commands run and %.2f reused a frame\n", (float)cg.predictCommandsRun / frames, (float)cg.predictCommandsReused / frames);
+	CG_Printf("%i prediction errors", cg.predictErrors);
+	if(cg.predictErrors){CG_Printf(", %.2f units on average", cg.predictErrorTotal / cg.predictErrors);}
+	CG_Printf("\n");
+	cg.predictFrames = 0;
+	cg.predictSnapshots = 0;
+	cg.predictSnapshotsMatched = 0;
+	cg.predictCommandsRun = 0;
+	cg.predictCommandsReused = 0;
+	cg.predictErrors = 0;
+	cg.predictErrorTotal = 0;
+}
 /*
 Generates cg.predictedPlayerState for the current cg.time
 cg.predictedPlayerState is guaranteed to be valid after exiting.
@@ -208,14 +268,16 @@ Each new snapshot will usually have one or more new usercmd over the last,
 but we simulate all unacknowledged commands each time, not just the new ones.
 This means that on an internet connection, quite a few pmoves may be issued
 each frame.
-OPTIMIZE: don't re-simulate unless the newly arrived snapshot playerState_t
-differs from the predicted one.  Would require saving all intermediate
-playerState_t during prediction.
+With cg_optimizePrediction, every predicted playerState_t is saved, and
+when a new snapshot agrees with the one saved for its commandTime only
+the commands after it are predicted again; the saved states are copied in
+for the rest.
 We detect prediction errors and allow them to be decayed off over several frames
 to ease the jerk.
 */
 void CG_PredictPlayerState(void){
-	int				cmdNum, current;
+	int				cmdNum, current, predictCmd, stateIndex;
+	qboolean		optimize;
 	playerState_t	oldPlayerState;
 	qboolean		moved;
 	usercmd_t		oldestCmd;
@@ -267,6 +329,23 @@ void CG_PredictPlayerState(void){
 	//Eagle: What is that comment for?
 	cg_pmove.pmove_fixed = pmove_fixed.integer;// | cg_pmove_fixed.integer;
 	cg_pmove.pmove_msec = pmove_msec.integer;
+	// pmove_fixed changes the commands as they're run, so those can't be kept
+	optimize = cg_optimizePrediction.integer && !cg_pmove.pmove_fixed;
+	predictCmd = 0;
+	stateIndex = 0;
+	if(optimize){
+		if(cg.nextFrameTeleport || cg.thisFrameTeleport){
+			cg.lastPredictedCommand = 0;
+			cg.stateTail = cg.stateHead;
+			predictCmd = current - CMD_BACKUP + 1;
+		}
+		// no new snapshot, carry on from the last command predicted
+		else if(cg.physicsTime == cg.lastServerTime){predictCmd = cg.lastPredictedCommand + 1;}
+		else{predictCmd = CG_MatchSavedPrediction(current);}
+		cg.lastServerTime = cg.physicsTime;
+		stateIndex = cg.stateHead;
+	}
+	cg.predictFrames++;
 	//run cmds
 	moved = qfalse;
 	cmdNum = current - CMD_BACKUP + 1;
@@ -301,6 +380,8 @@ void CG_PredictPlayerState(void){
 				VectorSubtract(oldPlayerState.origin, adjusted, delta);
 				len = VectorLength(delta);
 				if(len > .1f){
+					cg.predictErrors++;
+					cg.predictErrorTotal += len;
 					if(cg_showmiss.integer){CG_Printf("Prediction miss: %f\n", len);}
 					if(cg_errorDecay.integer){
 						int		t = cg.time - cg.predictedErrorTime;
@@ -321,10 +402,32 @@ void CG_PredictPlayerState(void){
 		if(cg_pmove.pmove_fixed){
 			cg_pmove.cmd.serverTime = ((cg_pmove.cmd.serverTime + pmove_msec.integer - 1) / pmove_msec.integer) * pmove_msec.integer;
 		}
-		Pmove(&cg_pmove);
+		if(!optimize){
+			Pmove(&cg_pmove);
+			cg.predictCommandsRun++;
+			// add push trigger movement effects
+			CG_TouchTriggerPrediction();
+		}
+		// run it if it hasn't been yet, or if there's no room left to keep it
+		else if(cmdNum >= predictCmd || (stateIndex + 1) % NUM_SAVED_STATES == cg.stateHead){
+			Pmove(&cg_pmove);
+			cg.predictCommandsRun++;
+			CG_TouchTriggerPrediction();
+			cg.lastPredictedCommand = cmdNum;
+			if((stateIndex + 1) % NUM_SAVED_STATES != cg.stateHead){
+				cg.savedPmoveStates[stateIndex] = *cg_pmove.ps;
+				stateIndex = (stateIndex + 1) % NUM_SAVED_STATES;
+				cg.stateTail = stateIndex;
+			}
+		}
+		else{
+			*cg_pmove.ps = cg.savedPmoveStates[stateIndex];
+			stateIndex = (stateIndex + 1) % NUM_SAVED_STATES;
+			cg.predictCommandsReused++;
+			// items and teleporters still get touched
+			CG_TouchTriggerPrediction();
+		}
 		moved = qtrue;
-		// add push trigger movement effects
-		CG_TouchTriggerPrediction();
 		// check for predictable events that changed from previous predictions
 		//CG_CheckChangedPredictableEvents(&cg.predictedPlayerState);
 	}
@@ -169,8 +169,33 @@ typedef enum {
 	CG_FS_GETFILELIST,
 	CG_R_ADDFOGTOSCENE,
 	// -->
+	CG_R_ADDSCENECOMMANDS,
+	CG_R_TAGINDEX,
+	CG_R_LERPTAGS,
+	CG_R_DRAWSTRING,
 }cgameImport_t;
 //============================================
+//packed scene commands
+//============================================
+// refEntities and polys are queued by the cgame in a local buffer and handed
+// to the client in one CG_R_ADDSCENECOMMANDS call before each scene is rendered
+#define	MAX_SCENE_COMMAND_BYTES	0x40000
+typedef enum{
+	SCENECMD_REFENTITY,
+	SCENECMD_POLYS
+}sceneCommandType_t;
+typedef struct{
+	int				commandId;
+	refEntity_t		entity;
+}sceneEntityCommand_t;
+typedef struct{
+	int				commandId;
+	qhandle_t		hShader;
+	int				numVerts;
+	int				numPolys;
+	// followed by numVerts * numPolys polyVert_t
+}scenePolysCommand_t;
+//============================================
 //functions exported to the main executable
 //============================================
 typedef enum{
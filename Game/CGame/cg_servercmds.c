@@ -59,6 +59,8 @@ void CG_ParseServerinfo(void){
 	cgs.capturelimit = atoi( Info_ValueForKey( info, "capturelimit" ) );
 	cgs.timelimit = atoi( Info_ValueForKey( info, "timelimit" ) );
 	cgs.maxclients = atoi( Info_ValueForKey( info, "sv_maxclients" ) );
+	cgs.maxEntities = atoi( Info_ValueForKey( info, "sv_maxEntities" ) );
+	if(cgs.maxEntities <= 0 || cgs.maxEntities > MAX_GENTITIES){cgs.maxEntities = MAX_GENTITIES;}
 	mapname = Info_ValueForKey( info, "mapname" );
 	Com_sprintf( cgs.mapname, sizeof( cgs.mapname ), "maps/%s.bsp", mapname );
 	Q_strncpyz( cgs.redTeam, Info_ValueForKey( info, "g_redTeam" ), sizeof(cgs.redTeam) );
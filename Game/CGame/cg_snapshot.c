@@ -239,7 +239,7 @@ void CG_ProcessSnapshots(void){
 	if(cgs.editMode == EM_mlf){
 		if(cg.lfEditor.moversStopped){
 			int num = MAX_CLIENTS;
-			for(;num<ENTITYNUM_MAX_NORMAL;num++){
+			for(;num<cgs.maxEntities;num++){
 				centity_t* cent;
 				cent = &cg_entities[num];
 				if(cent->currentState.eType != ET_MOVER){continue;}
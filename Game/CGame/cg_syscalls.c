@@ -98,16 +98,65 @@ qhandle_t trap_R_RegisterSkin(const char *name){return syscall(CG_R_REGISTERSKIN
 qhandle_t trap_R_RegisterShader(const char *name){return syscall(CG_R_REGISTERSHADER,name);}
 qhandle_t trap_R_RegisterShaderNoMip(const char *name){return syscall(CG_R_REGISTERSHADERNOMIP,name);}
 void trap_R_RegisterFont(const char *fontName,int pointSize,fontInfo_t *font){syscall(CG_R_REGISTERFONT,fontName,pointSize,font);}
-void trap_R_ClearScene(void){syscall(CG_R_CLEARSCENE);}
-void trap_R_AddRefEntityToScene(const refEntity_t *re){syscall(CG_R_ADDREFENTITYTOSCENE,re);}
-void trap_R_AddPolyToScene(qhandle_t hShader,int numVerts,const polyVert_t *verts){syscall(CG_R_ADDPOLYTOSCENE,hShader,numVerts,verts);}
-void trap_R_AddPolysToScene(qhandle_t hShader,int numVerts,const polyVert_t *verts,int num){syscall(CG_R_ADDPOLYSTOSCENE,hShader,numVerts,verts,num);}
+/*
+====================
+Scene command buffer
+
+refEntities and polys are packed here and sent to the client in bulk
+instead of crossing the syscall boundary one at a time.
+====================
+*/
+static int sceneCommandData[MAX_SCENE_COMMAND_BYTES / sizeof(int)];
+static int sceneCommandUsed;
+static void CG_FlushSceneCommands(void){
+	if(!sceneCommandUsed){return;}
+	syscall(CG_R_ADDSCENECOMMANDS,sceneCommandData,sceneCommandUsed);
+	sceneCommandUsed = 0;
+}
+static void *CG_GetSceneCommandBuffer(int bytes){
+	void *cmd;
+	bytes = PAD(bytes,sizeof(int));
+	if(bytes > MAX_SCENE_COMMAND_BYTES){return NULL;}
+	if(sceneCommandUsed + bytes > MAX_SCENE_COMMAND_BYTES){CG_FlushSceneCommands();}
+	cmd = (byte*)sceneCommandData + sceneCommandUsed;
+	sceneCommandUsed += bytes;
+	return cmd;
+}
+void trap_R_ClearScene(void){
+	sceneCommandUsed = 0;
+	syscall(CG_R_CLEARSCENE);
+}
+void trap_R_AddRefEntityToScene(const refEntity_t *re){
+	sceneEntityCommand_t *cmd = CG_GetSceneCommandBuffer(sizeof(sceneEntityCommand_t));
+	cmd->commandId = SCENECMD_REFENTITY;
+	cmd->entity = *re;
+}
+void trap_R_AddPolysToScene(qhandle_t hShader,int numVerts,const polyVert_t *verts,int num){
+	scenePolysCommand_t *cmd;
+	int vertBytes;
+	if(numVerts <= 0 || num <= 0){return;}
+	vertBytes = numVerts * num * sizeof(polyVert_t);
+	cmd = CG_GetSceneCommandBuffer(sizeof(scenePolysCommand_t) + vertBytes);
+	if(!cmd){
+		syscall(CG_R_ADDPOLYSTOSCENE,hShader,numVerts,verts,num);
+		return;
+	}
+	cmd->commandId = SCENECMD_POLYS;
+	cmd->hShader = hShader;
+	cmd->numVerts = numVerts;
+	cmd->numPolys = num;
+	memcpy(cmd + 1,verts,vertBytes);
+}
+void trap_R_AddPolyToScene(qhandle_t hShader,int numVerts,const polyVert_t *verts){trap_R_AddPolysToScene(hShader,numVerts,verts,1);}
 int trap_R_LightForPoint(vec3_t point,vec3_t ambientLight,vec3_t directedLight,vec3_t lightDir){
 	return syscall(CG_R_LIGHTFORPOINT,point,ambientLight,directedLight,lightDir);
 }
 void trap_R_AddLightToScene(const vec3_t org,float intensity,float r,float g,float b){syscall(CG_R_ADDLIGHTTOSCENE,org,PASSFLOAT(intensity),PASSFLOAT(r),PASSFLOAT(g),PASSFLOAT(b));}
 void trap_R_AddAdditiveLightToScene(const vec3_t org,float intensity,float r,float g,float b){syscall(CG_R_ADDADDITIVELIGHTTOSCENE,org,PASSFLOAT(intensity),PASSFLOAT(r),PASSFLOAT(g),PASSFLOAT(b));}
-void trap_R_RenderScene(const refdef_t *fd){syscall(CG_R_RENDERSCENE,fd);}
+void trap_R_RenderScene(const refdef_t *fd){
+	CG_FlushSceneCommands();
+	syscall(CG_R_RENDERSCENE,fd);
+}
 void trap_R_SetColor(const float *rgba){syscall(CG_R_SETCOLOR,rgba);}
 void trap_R_DrawStretchPic(float x,float y,float w,float h,float s1,float t1,float s2,float t2,qhandle_t hShader){
 	syscall(CG_R_DRAWSTRETCHPIC,PASSFLOAT(x),PASSFLOAT(y),PASSFLOAT(w),PASSFLOAT(h),PASSFLOAT(s1),PASSFLOAT(t1),PASSFLOAT(s2),PASSFLOAT(t2),hShader);
@@ -116,6 +165,13 @@ void trap_R_ModelBounds(clipHandle_t model,vec3_t mins,vec3_t maxs,int frame){sy
 int trap_R_LerpTag(orientation_t *tag,clipHandle_t mod,int startFrame,int endFrame,float frac,const char *tagName){
 	return syscall(CG_R_LERPTAG,tag,mod,startFrame,endFrame,PASSFLOAT(frac),tagName);
 }
+int trap_R_TagIndex(clipHandle_t mod,const char *tagName){return syscall(CG_R_TAGINDEX,mod,tagName);}
+int trap_R_LerpTags(orientation_t *tags,clipHandle_t mod,int startFrame,int endFrame,float frac,const int *tagIndexes,int numTags){
+	return syscall(CG_R_LERPTAGS,tags,mod,startFrame,endFrame,PASSFLOAT(frac),tagIndexes,numTags);
+}
+void trap_R_DrawString(float x,float y,float w,float h,float advance,const char *string,int maxChars,int flags,qhandle_t hShader){
+	syscall(CG_R_DRAWSTRING,PASSFLOAT(x),PASSFLOAT(y),PASSFLOAT(w),PASSFLOAT(h),PASSFLOAT(advance),string,maxChars,flags,hShader);
+}
 void trap_R_RemapShader(const char *oldShader,const char *newShader,const char *timeOffset){syscall(CG_R_REMAP_SHADER,oldShader,newShader,timeOffset);}
 void trap_GetGlconfig(glconfig_t *glconfig){syscall(CG_GETGLCONFIG,glconfig);}
 void trap_GetGameState(gameState_t *gamestate){syscall(CG_GETGAMESTATE,gamestate);}
@@ -55,7 +55,7 @@ static void CG_LerpTrails(void){
 	vec3_t	dir;
 	int		i, j=0;
 	trail_t	*trail;
-	for(;j<MAX_GENTITIES;j++){
+	for(;j<cgs.maxEntities;j++){
 		trail = &cg_trails[j];
 		// Don't bother updating if the very end and very start are already
 		// the same. We'd either be on the start frame or the last frame of
@@ -138,7 +138,7 @@ void CG_AddTrailsToScene(void){
 	verts[2].st[1] = 0.f;
 	verts[3].st[1] = 1.f;
 	for(;i<4;i++){verts[i].modulate[3] = 255;}
-	for(;j<MAX_GENTITIES;j++){
+	for(;j<cgs.maxEntities;j++){
 		trail = &cg_trails[j];
 		if(!trail->shader){continue;}
 		// Don't bother drawing if the very end and very start are already
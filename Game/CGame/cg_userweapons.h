@@ -28,6 +28,7 @@ typedef struct{
 	vec3_t			chargeDlightColor;
 	// the names of the player model tags on which to place an instance of the charge
 	char			chargeTag[MAX_CHARGES][MAX_TAGNAME];
+	int				chargeTagHandle[MAX_CHARGES];	// CG_RegisterTag
 	chargeVoice_t	chargeVoice[MAX_CHARGE_VOICES];
 	sfxHandle_t		chargeLoopSound;
 	char			chargeParticleSystem[MAX_QPATH];
@@ -106,10 +106,10 @@ void CG_Camera(centity_t *cent){
 	cameraHeight = cg_thirdPersonHeight.value + ci->tierConfig[ci->tierCurrent].cameraOffset[1];
 	cameraRange = cg_thirdPersonRange.value + ci->tierConfig[ci->tierCurrent].cameraOffset[2];
 	if(cg_thirdPersonCamera.value <= 0){
-		if(CG_TryLerpPlayerTag(cent,"tag_eyes",&tagOrient)){
+		if(CG_LerpPlayerTag(cent,cgs.media.eyesTag,&tagOrient)){
 			VectorCopy(tagOrient.origin, cg.refdef.vieworg);
 		}
-		if(CG_TryLerpPlayerTag(cent,"tag_head",&tagOrient)){
+		if(CG_LerpPlayerTag(cent,cgs.media.headTag,&tagOrient)){
 			VectorCopy(tagOrient.origin, cg.refdef.vieworg);
 			cg.refdef.vieworg[2] -= NECK_LENGTH;
 			AngleVectors(cg.refdefViewAngles, forward, NULL, up);
@@ -119,13 +119,13 @@ void CG_Camera(centity_t *cent){
 		else{cg.refdef.vieworg[2] += cg.predictedPlayerState.viewheight;}
 	}
 	else if(cg_thirdPersonCamera.value >= 1){
-		if(CG_TryLerpPlayerTag(cent,"tag_cam",&tagOrient)){
+		if(CG_LerpPlayerTag(cent,cgs.media.camTag,&tagOrient)){
 			if(!cent->pe.modelLerpFrames[3].animation->continuous){
 				VectorCopy(cent->lerpOrigin,tagOrient.origin);
 				tagOrient.origin[2] += cg.predictedPlayerState.viewheight;
 			}
 			else if(!((cent->currentState.weaponstate == WEAPON_GUIDING) || (cent->currentState.weaponstate == WEAPON_ALTGUIDING) || (cent->currentState.playerBitFlags & usingSoar))){
-				if(CG_TryLerpPlayerTag(cent,"tag_camTar",&tagOrient2)){
+				if(CG_LerpPlayerTag(cent,cgs.media.camTarTag,&tagOrient2)){
 					VectorSubtract(tagOrient2.origin, tagOrient.origin, forward);
 					VectorNormalize(forward);
 					vectoangles(forward, tagForwardAngles);
@@ -30,6 +30,7 @@ void CG_weapGfx_StoreBuffer(int clientNum, int weaponNum){
 	VectorCopy(src->chargeDlightColor, dest->chargeDlightColor);
 	VectorCopy(src->chargeSpin, dest->chargeSpin);
 	Q_strncpyz(dest->chargeTag[0], src->chargeTag[0], sizeof(dest->chargeTag[0]));
+	dest->chargeTagHandle[0] = CG_RegisterTag(dest->chargeTag[0]);
 	dest->chargeGrowth = (src->chargeStartPct != src->chargeEndPct); // <-- May become redundant...
 	dest->chargeStartPct = src->chargeStartPct;
 	dest->chargeEndPct = src->chargeEndPct;
@@ -243,7 +243,7 @@ void CG_AddPlayerWeapon(refEntity_t *parent, playerState_t *ps, centity_t *cent,
 		// Only bother with anything else if the charge in question is larger than the minimum used for display
 		if(lerp > weaponGraphics->chargeStartPct){
 			// Locate a tag wherever on the model's parts. Don't process further if the tag is not found
-			if(CG_TryLerpPlayerTag(cent,weaponGraphics->chargeTag[0],&orient)){
+			if(CG_LerpPlayerTag(cent,weaponGraphics->chargeTagHandle[0],&orient)){
 				memset(&refEnt, 0, sizeof(refEnt));
 				if(VectorLength(weaponGraphics->chargeSpin) != 0.f){
 					vec3_t	tempAngles, lerpAxis[3], tempAxis[3];
@@ -279,7 +279,7 @@ void CG_AddPlayerWeapon(refEntity_t *parent, playerState_t *ps, centity_t *cent,
 		if(weaponState == WEAPON_GUIDING || weaponState == WEAPON_FIRING){weaponGraphics = CG_FindUserWeaponGraphics(ent->clientNum, ent->weapon);}
 		else{weaponGraphics = CG_FindUserWeaponGraphics(ent->clientNum, ent->weapon + ALTWEAPON_OFFSET);}
 		// Locate a tag wherever on the model's parts. Don't process further if the tag is not found
-		if(CG_TryLerpPlayerTag(cent,weaponGraphics->chargeTag[0],&orient)){
+		if(CG_LerpPlayerTag(cent,weaponGraphics->chargeTagHandle[0],&orient)){
 			memset(&refEnt, 0, sizeof(refEnt));
 			VectorCopy(orient.origin, refEnt.origin);
 			AxisCopy(orient.axis, refEnt.axis);
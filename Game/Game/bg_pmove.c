@@ -46,7 +46,6 @@ int		c_pmove = 0;
 /*===============
 DECLARATIONS
 ===============*/
-int trap_RealTime( qtime_t *qtime );
 int PM_CheckDirection(vec3_t direction,qboolean player);
 void PM_StopBoost(void);
 void PM_StopBlink(void);
@@ -1146,20 +1145,20 @@ void PM_StopJump(void){
 	}
 }
 void PM_CheckBlink(void){
-	qtime_t realRandom;
-	trap_RealTime(&realRandom);
+	int seed;
+	seed = pm->cmd.serverTime;
 	if(pm->ps->timers[tmBlink] < 0){
 		pm->ps->timers[tmBlink] += pml.msec;
 		pm->ps->bitFlags |= isBlinking;
 		if(pm->ps->timers[tmBlink] >= 0){
-			pm->ps->timers[tmBlink] = (Q_random(&realRandom.tm_sec) * 100) + 33;
+			pm->ps->timers[tmBlink] = (Q_random(&seed) * 100) + 33;
 		}
 	}
 	else if(pm->ps->timers[tmBlink] > 0){
 		pm->ps->bitFlags &= ~isBlinking;
 		pm->ps->timers[tmBlink] -= pml.msec;
 		if(pm->ps->timers[tmBlink] <= 0){
-			pm->ps->timers[tmBlink] = -(Q_random(&realRandom.tm_sec) * 1000) - 100;
+			pm->ps->timers[tmBlink] = -(Q_random(&seed) * 1000) - 100;
 		}
 	}
 }
@@ -1189,8 +1188,8 @@ void PM_CheckJump(void){
 	if(!(pm->cmd.buttons & BUTTON_JUMP) && pm->ps->timers[tmJump]){
 		float extra;
 		float truePower;
-		qtime_t realRandom;
-		trap_RealTime(&realRandom);
+		int seed;
+		seed = pm->cmd.serverTime;
 		pm->ps->bitFlags |= usingJump;
 		jumpPower = (pm->ps->baseStats[stSpeed] * 160);
 		jumpEmphasis = 1500.0;
@@ -1209,7 +1208,7 @@ void PM_CheckJump(void){
 			if(extra > 3){extra = 3;}
 			jumpEmphasis += (700) * extra;
 			if((pm->ps->stats[stJumpTimed] == 5) && !pm->ps->timers[tmBlink]){
-				pm->ps->timers[tmBlink] = -(Q_random(&realRandom.tm_sec) * 1000) - 100;
+				pm->ps->timers[tmBlink] = -(Q_random(&seed) * 1000) - 100;
 			}
 			truePower = jumpPower * (4 + extra);
 			pm->ps->powerLevel[plUseFatigue] += pm->ps->powerLevel[plMaximum] * 0.005;
@@ -2421,8 +2420,8 @@ void PM_MeleeIdle(void){
 void PM_Melee(void){
 	int meleeCharge,enemyState,state,option,damage,distance,animation,direction,entity;
 	qboolean charging,movingForward,idleTime,enemyChanged,enemyDefense;
-	qtime_t realRandom;
-	trap_RealTime(&realRandom);
+	int seed;
+	seed = pm->cmd.serverTime;
 	if(pm->ps->persistant[PERS_TEAM] == TEAM_SPECTATOR || pm->ps->bitFlags & isStruggling || pm->ps->timers[tmMeleeIdle] < 0){return;}
 	charging = (pm->ps->weaponstate == WEAPON_CHARGING || pm->ps->weaponstate == WEAPON_ALTCHARGING) ? qtrue : qfalse;
 	state = pm->ps->stats[stMeleeState];
@@ -2585,7 +2584,7 @@ void PM_Melee(void){
 				else if(!pm->ps->timers[tmMeleeBreakerWait]){
 					pm->ps->timers[tmMeleeBreaker] = 1;
 					pm->ps->timers[tmMeleeBreakerWait] = 500;
-					pm->ps->stats[stAnimState] = (Q_random(&realRandom.tm_sec) * 5)+1;
+					pm->ps->stats[stAnimState] = (Q_random(&seed) * 5)+1;
 					meleeCharge = 0;
 				}
 				else{meleeCharge = 0;}
@@ -2608,7 +2607,7 @@ void PM_Melee(void){
 				if(!pm->ps->timers[tmMeleeBreakerWait]){
 					pm->ps->timers[tmMeleeBreaker] = -1;
 					pm->ps->timers[tmMeleeBreakerWait] = 500;
-					pm->ps->stats[stAnimState] = (Q_random(&realRandom.tm_sec) * 5)+1;
+					pm->ps->stats[stAnimState] = (Q_random(&seed) * 5)+1;
 					meleeCharge = 0;
 				}
 				else{meleeCharge = 0;}
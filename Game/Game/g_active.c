@@ -531,7 +531,7 @@ void ClientThink_real( gentity_t *ent ) {
 	pm.pmove_fixed = pmove_fixed.integer | client->pers.pmoveFixed;
 	pm.pmove_msec = pmove_msec.integer;
 	VectorCopy(client->ps.origin,client->oldOrigin);
-	Pmove(&pm);
+	G_Pmove(ent,&pm);
 	checkTier(client);
 	if(pm.ps->powerLevel[plTierChanged] == 1)
 	{
@@ -141,7 +141,7 @@ static void CelebrateStop( gentity_t *player ) {
 #define	TIMER_GESTURE	(34*66+50)
 static void CelebrateStart( gentity_t *player ) {
 	player->s.torsoAnim = ( ( player->s.torsoAnim & ANIM_TOGGLEBIT ) ^ ANIM_TOGGLEBIT ) ;//| ANIM_GESTURE;
-	player->nextthink = level.time + TIMER_GESTURE;
+	G_SetNextThink( player, level.time + TIMER_GESTURE );
 	player->think = CelebrateStop;
 
 	/*
@@ -162,7 +162,7 @@ static void PodiumPlacementThink( gentity_t *podium ) {
 	vec3_t		origin;
 	vec3_t		f, r, u;
 
-	podium->nextthink = level.time + 100;
+	G_SetNextThink( podium, level.time + 100 );
 
 	AngleVectors( level.intermission_angle, vec, NULL, NULL );
 	VectorMA( level.intermission_origin, trap_Cvar_VariableIntegerValue( "g_podiumDist" ), vec, origin );
@@ -240,7 +240,7 @@ static gentity_t *SpawnPodium( void ) {
 	trap_LinkEntity (podium);
 
 	podium->think = PodiumPlacementThink;
-	podium->nextthink = level.time + 100;
+	G_SetNextThink( podium, level.time + 100 );
 	return podium;
 }
 
@@ -264,7 +264,7 @@ void Svcmd_AbortPodium_f( void ) {
 	}
 
 	if( podium1 ) {
-		podium1->nextthink = level.time;
+		G_SetNextThink( podium1, level.time );
 		podium1->think = CelebrateStop;
 	}
 }
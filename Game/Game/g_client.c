@@ -358,7 +358,7 @@ void BodySink( gentity_t *ent ) {
 		ent->physicsObject = qfalse;
 		return;	
 	}
-	ent->nextthink = level.time + 100;
+	G_SetNextThink( ent, level.time + 100 );
 	ent->s.pos.trBase[2] -= 1;
 }
 
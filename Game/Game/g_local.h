@@ -190,6 +190,12 @@ struct gentity_s {
 	// ADDING FOR ZEQ2
 	int			maxMissileTime;	// Anything more than this will always explode a guided missile.
 	int			missileSpawnTime; // Need to know when the missile was spawned for this.
+	int			lastThinkTime;		// when Think_NormalMissile last ran
+
+	// missile simulation LOD, see G_MissileLodMsec
+	int			lodNextUpdate;		// next full update, 0 when running every frame
+	int			lodTrTime;			// s.pos.trTime of the course it was left on
+	vec3_t		lodOrigin;			// where the next movement trace starts
 
 	int			sectionSpawnTime; // Servertime at which the last drop of a waypoint for a beam took place.
 	int			newSectionTime;  // Time to pass before a new waypoint drop;
@@ -351,7 +357,8 @@ typedef struct {
 
 	struct gentity_s	*gentities;
 	int			gentitySize;
-	int			num_entities;		// MAX_CLIENTS <= num_entities <= ENTITYNUM_MAX_NORMAL
+	int			num_entities;		// MAX_CLIENTS <= num_entities <= maxEntities
+	int			maxEntities;		// sv_maxEntities, at most ENTITYNUM_MAX_NORMAL
 
 	int			warmupTime;			// restart match at this time
 
@@ -600,12 +607,33 @@ void FindIntermissionPoint( void );
 void SetLeader(int team, int client);
 void CheckTeamLeader( int team );
 void G_RunThink (gentity_t *ent);
+void G_RunFrame( int levelTime );
 void AddTournamentQueue(gclient_t *client);
 void QDECL G_LogPrintf( const char *fmt, ... ) __attribute__ ((format (printf, 1, 2)));
 void SendScoreboardMessageToAllClients( void );
 void QDECL G_Printf( const char *fmt, ... ) __attribute__ ((format (printf, 1, 2)));
 void QDECL G_Error( const char *fmt, ... ) __attribute__ ((noreturn, format (printf, 1, 2)));
 
+//
+// g_think.c
+//
+void G_InitThinkWheel( void );
+void G_SetNextThink( gentity_t *ent, int time );
+void G_WakeEntity( gentity_t *ent );
+void G_ForgetEntity( gentity_t *ent );
+void G_ParkEntity( gentity_t *ent );
+int G_FirstActiveEntity( void );
+int G_NextActiveEntity( int i );
+void Svcmd_ThinkBench_f( void );
+
+//
+// g_pmovebench.c
+//
+void G_Pmove( gentity_t *ent, pmove_t *pm );
+void G_StopPmoveRecord( void );
+void Svcmd_PmoveRecord_f( void );
+void Svcmd_PmoveBench_f( void );
+
 //
 // g_client.c
 //
@@ -660,6 +688,10 @@ void Svcmd_AbortPodium_f( void );
 void Fire_UserWeapon( gentity_t *self, vec3_t start, vec3_t dir, qboolean altfire );
 void Release_UserWeapon( gentity_t *self, qboolean altfire );
 void G_RunUserExplosion( gentity_t *ent );
+void G_QueueRadiusDamage( vec3_t origin, gentity_t *attacker, gentity_t *ignore, float centerDamage, float radius, int extraKnockback );
+void G_RunRadiusDamage( void );
+void G_CollideUserMissiles( void );
+void G_SweepUserMissiles( void );
 void G_RunUserMissile( gentity_t *ent );
 void G_RunRiftWeaponClass( gentity_t *ent );
 void G_ExplodeUserWeapon (gentity_t *self);
@@ -731,6 +763,12 @@ extern	vmCvar_t	g_teamForceBalance;
 extern	vmCvar_t	g_banIPs;
 extern	vmCvar_t	g_filterBan;
 extern	vmCvar_t	g_smoothClients;
+extern	vmCvar_t	g_thinkWheel;
+extern	vmCvar_t	g_missileLod;
+extern	vmCvar_t	g_missileLodNear;
+extern	vmCvar_t	g_missileLodFar;
+extern	vmCvar_t	g_missileLodMsec;
+extern	vmCvar_t	g_maxEntities;
 extern	vmCvar_t	pmove_fixed;
 extern	vmCvar_t	pmove_msec;
 extern	vmCvar_t	g_rankings;
@@ -799,6 +837,7 @@ void	trap_SetUserinfo( int num, const char *buffer );
 void	trap_GetServerinfo( char *buffer, int bufferSize );
 void	trap_SetBrushModel( gentity_t *ent, const char *name );
 void	trap_Trace( trace_t *results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int passEntityNum, int contentmask );
+void	trap_TraceBatch( batchTrace_t *traces, int count );
 int		trap_PointContents( const vec3_t point, int passEntityNum );
 qboolean trap_InPVS( const vec3_t p1, const vec3_t p2 );
 qboolean trap_InPVSIgnorePortals( const vec3_t p1, const vec3_t p2 );
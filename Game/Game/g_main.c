@@ -82,6 +82,12 @@ vmCvar_t	pmove_fixed;
 vmCvar_t	pmove_msec;
 vmCvar_t	g_rankings;
 vmCvar_t	g_listEntity;
+vmCvar_t	g_thinkWheel;
+vmCvar_t	g_missileLod;
+vmCvar_t	g_missileLodNear;
+vmCvar_t	g_missileLodFar;
+vmCvar_t	g_missileLodMsec;
+vmCvar_t	g_maxEntities;
 // ADDING FOR ZEQ2
 vmCvar_t	g_verboseParse;
 vmCvar_t	g_powerlevel;
@@ -164,6 +170,12 @@ static cvarTable_t		gameCvarTable[] = {
 
 	{ &g_allowVote, "g_allowVote", "1", CVAR_ARCHIVE, 0, qfalse },
 	{ &g_listEntity, "g_listEntity", "0", 0, 0, qfalse },
+	{ &g_thinkWheel, "g_thinkWheel", "1", 0, 0, qfalse },
+	{ &g_missileLod, "g_missileLod", "1", 0, 0, qfalse },
+	{ &g_missileLodNear, "g_missileLodNear", "1500", 0, 0, qfalse },
+	{ &g_missileLodFar, "g_missileLodFar", "6000", 0, 0, qfalse },
+	{ &g_missileLodMsec, "g_missileLodMsec", "400", 0, 0, qfalse },
+	{ &g_maxEntities, "sv_maxEntities", "2048", CVAR_SERVERINFO | CVAR_LATCH, 0, qfalse },
 	{ &g_smoothClients, "g_smoothClients", "1", 0, 0, qfalse },
 	{ &pmove_fixed, "pmove_fixed", "0", CVAR_SYSTEMINFO, 0, qfalse },
 	{ &pmove_msec, "pmove_msec", "8", CVAR_SYSTEMINFO, 0, qfalse },
@@ -417,6 +429,12 @@ void G_InitGame( int levelTime, int randomSeed, int restart ) {
 	level.time = levelTime;
 	level.startTime = levelTime;
 
+	// the server has already bounded this
+	level.maxEntities = g_maxEntities.integer;
+	if ( level.maxEntities > ENTITYNUM_MAX_NORMAL ) {
+		level.maxEntities = ENTITYNUM_MAX_NORMAL;
+	}
+
 	if ( g_gametype.integer != GT_SINGLE_PLAYER && g_logfile.string[0] ) {
 		if ( g_logfileSync.integer ) {
 			trap_FS_FOpenFile( g_logfile.string, &level.logFile, FS_APPEND_SYNC );
@@ -442,6 +460,7 @@ void G_InitGame( int levelTime, int randomSeed, int restart ) {
 	// initialize all entities for this game
 	memset( g_entities, 0, MAX_GENTITIES * sizeof(g_entities[0]) );
 	level.gentities = g_entities;
+	G_InitThinkWheel();
 
 	// initialize all clients for this game
 	level.maxclients = g_maxclients.integer;
@@ -503,6 +522,8 @@ void G_ShutdownGame( int restart ) {
 		level.logFile = 0;
 	}
 
+	G_StopPmoveRecord();
+
 	// write all the client session data so we can get it back
 	G_WriteSessionData();
 }
@@ -1459,11 +1480,16 @@ void G_RunFrame( int levelTime ) {
 	// get any cvar changes
 	G_UpdateCvars();
 
+	// settle missiles running into each other, then trace all their moves at once
+	G_CollideUserMissiles();
+	G_SweepUserMissiles();
+
 	//
 	// go through all allocated objects
 	//
-	ent = &g_entities[0];
-	for (i=0 ; i<level.num_entities ; i++, ent++) {
+	// parked entities are skipped until they are due
+	for (i=G_FirstActiveEntity() ; i<level.num_entities ; i=G_NextActiveEntity(i)) {
+		ent = &g_entities[i];
 		if ( !ent->inuse ) {
 			continue;
 		}
@@ -1488,6 +1514,7 @@ void G_RunFrame( int levelTime ) {
 			}
 		}
 		if ( ent->freeAfterEvent ) {
+			G_ParkEntity( ent );
 			continue;
 		}
 		if ( !ent->r.linked && ent->neverFree ) {
@@ -1515,8 +1542,12 @@ void G_RunFrame( int levelTime ) {
 		}
 
 		G_RunThink( ent );
+		G_ParkEntity( ent );
 	}
 
+	// explosions from this frame do their damage together
+	G_RunRadiusDamage();
+
 	// perform final fixups on the players
 	ent = &g_entities[0];
 	for (i=0 ; i < level.maxclients ; i++, ent++ ) {
@@ -217,7 +217,7 @@ void SP_misc_portal_surface(gentity_t *ent) {
 		VectorCopy( ent->s.origin, ent->s.origin2 );
 	} else {
 		ent->think = locateCamera;
-		ent->nextthink = level.time + 100;
+		G_SetNextThink( ent, level.time + 100 );
 	}
 }
 
@@ -278,7 +278,7 @@ void DropPortalDestination( gentity_t *player ) {
 	VectorCopy( player->s.apos.trBase, ent->s.angles );
 
 	ent->think = G_FreeEntity;
-	ent->nextthink = level.time + 2 * 60 * 1000;
+	G_SetNextThink( ent, level.time + 2 * 60 * 1000 );
 
 	trap_LinkEntity( ent );
 
@@ -327,7 +327,7 @@ static void PortalTouch( gentity_t *self, gentity_t *other, trace_t *trace) {
 static void PortalEnable( gentity_t *self ) {
 	self->touch = PortalTouch;
 	self->think = G_FreeEntity;
-	self->nextthink = level.time + 2 * 60 * 1000;
+	G_SetNextThink( self, level.time + 2 * 60 * 1000 );
 }
 
 
@@ -361,7 +361,7 @@ void DropPortalSource( gentity_t *player ) {
 
 //	ent->spawnflags = player->client->ps.persistant[PERS_TEAM];
 
-	ent->nextthink = level.time + 1000;
+	G_SetNextThink( ent, level.time + 1000 );
 	ent->think = PortalEnable;
 
 	// find the destination
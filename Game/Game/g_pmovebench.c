@@ -0,0 +1,481 @@
+// g_pmovebench.c -- recording and replaying player moves
+
+#include "g_local.h"
+
+/*
+==============================================================================
+
+PMOVE RECORDING
+
+pmoveRecord saves every move one client makes -- the command, the
+player state going in, whatever it is locked on to and a checksum of what
+came out -- so that pmoveBench can run the same moves through Pmove again
+against the collision model of the loaded map.
+
+Player states are written without the two pointers in them and with
+attackPower cut to an int, so a recording made by a native build replays
+in the qvm and the other way around.
+
+==============================================================================
+*/
+
+#define	PMOVE_RECORD_ID			( ('C'<<24)+('R'<<16)+('M'<<8)+'P' )
+#define	PMOVE_RECORD_VERSION	1
+#define	MAX_PMOVE_RECORD		1024
+
+typedef struct {
+	usercmd_t		cmd;
+	playerState_t	ps;				// going in
+	qboolean		hasLockedPlayer;
+	playerState_t	lockedPlayer;
+	qboolean		hasLockedPosition;
+	vec3_t			lockedPosition;
+	unsigned		checksum;		// of what came out
+} pmoveRecord_t;
+
+typedef struct {
+	int				id;
+	int				version;
+	int				packedInts;
+	int				pmove_fixed;
+	int				pmove_msec;
+	int				noFootsteps;
+} pmoveRecordHeader_t;
+
+static fileHandle_t		recordFile;
+static int				recordClient = -1;
+static int				recordMoves;
+
+static pmoveRecord_t	benchMoves[MAX_PMOVE_RECORD];
+static int				benchTraces;
+
+#define	PSOFS(x)	( (int)(size_t)&( (playerState_t *)0 )->x )
+
+/*
+================
+G_PackPlayerState
+
+Returns the number of ints written to out, which is the same in every
+kind of build.  out may be NULL.
+================
+*/
+static int G_PackPlayerState( const playerState_t *ps, int *out ) {
+	const byte	*p;
+	int			ranges[2][2];
+	int			i, n, ofs;
+
+	ranges[0][0] = 0;
+	ranges[0][1] = PSOFS( lockedPlayer );
+	ranges[1][0] = PSOFS( soarLimit );
+	ranges[1][1] = PSOFS( attackPower );
+
+	p = (const byte *)ps;
+	n = 0;
+	for ( i = 0 ; i < 2 ; i++ ) {
+		for ( ofs = ranges[i][0] ; ofs < ranges[i][1] ; ofs += 4, n++ ) {
+			if ( out ) {
+				out[n] = *(int *)( p + ofs );
+			}
+		}
+	}
+	if ( out ) {
+		out[n] = (int)ps->attackPower;
+	}
+	n++;
+	for ( ofs = PSOFS( attackPowerTotal ) ; ofs < (int)sizeof( *ps ) ; ofs += 4, n++ ) {
+		if ( out ) {
+			out[n] = *(int *)( p + ofs );
+		}
+	}
+	return n;
+}
+
+/*
+================
+G_UnpackPlayerState
+================
+*/
+static void G_UnpackPlayerState( const int *in, playerState_t *ps ) {
+	byte	*p;
+	int		ofs;
+
+	memset( ps, 0, sizeof( *ps ) );
+	p = (byte *)ps;
+	for ( ofs = 0 ; ofs < PSOFS( lockedPlayer ) ; ofs += 4 ) {
+		*(int *)( p + ofs ) = *in++;
+	}
+	for ( ofs = PSOFS( soarLimit ) ; ofs < PSOFS( attackPower ) ; ofs += 4 ) {
+		*(int *)( p + ofs ) = *in++;
+	}
+	ps->attackPower = *in++;
+	for ( ofs = PSOFS( attackPowerTotal ) ; ofs < (int)sizeof( *ps ) ; ofs += 4 ) {
+		*(int *)( p + ofs ) = *in++;
+	}
+}
+
+/*
+================
+G_PmoveChecksum
+
+FNV-1a over the packed player state and, if there is one, the packed
+state of the player it is locked on to.
+================
+*/
+static unsigned G_PmoveChecksum( const playerState_t *ps ) {
+	int			packed[1024];
+	unsigned	hash;
+	int			i, n;
+
+	hash = 2166136261u;
+	n = G_PackPlayerState( ps, packed );
+	for ( i = 0 ; i < n ; i++ ) {
+		hash = ( hash ^ (unsigned)packed[i] ) * 16777619u;
+	}
+	if ( ps->lockedPlayer ) {
+		n = G_PackPlayerState( ps->lockedPlayer, packed );
+		for ( i = 0 ; i < n ; i++ ) {
+			hash = ( hash ^ (unsigned)packed[i] ) * 16777619u;
+		}
+	}
+	return hash;
+}
+
+/*
+================
+G_WriteRecordedPlayerState
+================
+*/
+static void G_WriteRecordedPlayerState( const playerState_t *ps ) {
+	int		packed[1024];
+	int		n;
+
+	n = G_PackPlayerState( ps, packed );
+	trap_FS_Write( packed, n * sizeof( int ), recordFile );
+}
+
+/*
+================
+G_StopPmoveRecord
+================
+*/
+void G_StopPmoveRecord( void ) {
+	if ( recordClient < 0 ) {
+		return;
+	}
+	trap_FS_FCloseFile( recordFile );
+	G_Printf( "pmoveRecord: %i moves recorded\n", recordMoves );
+	recordClient = -1;
+}
+
+/*
+================
+G_Pmove
+
+Runs the move, saving it first if the client is being recorded.
+================
+*/
+void G_Pmove( gentity_t *ent, pmove_t *pm ) {
+	playerState_t	*ps;
+	int				hasLocked[2];
+	unsigned		checksum;
+
+	if ( ent->s.number != recordClient ) {
+		Pmove( pm );
+		return;
+	}
+
+	ps = pm->ps;
+	hasLocked[0] = ( ps->lockedPlayer != NULL );
+	hasLocked[1] = ( ps->lockedPosition != NULL );
+	trap_FS_Write( &pm->cmd, sizeof( pm->cmd ), recordFile );
+	G_WriteRecordedPlayerState( ps );
+	trap_FS_Write( hasLocked, sizeof( hasLocked ), recordFile );
+	if ( hasLocked[0] ) {
+		G_WriteRecordedPlayerState( ps->lockedPlayer );
+	}
+	if ( hasLocked[1] ) {
+		trap_FS_Write( *ps->lockedPosition, sizeof( vec3_t ), recordFile );
+	}
+
+	Pmove( pm );
+
+	checksum = G_PmoveChecksum( ps );
+	trap_FS_Write( &checksum, sizeof( checksum ), recordFile );
+
+	if ( ++recordMoves >= MAX_PMOVE_RECORD ) {
+		G_StopPmoveRecord();
+	}
+}
+
+/*
+=================
+Svcmd_PmoveRecord_f
+
+pmoveRecord <clientNum> <file>
+pmoveRecord
+
+Records the moves of a client until MAX_PMOVE_RECORD of them have been
+made or pmoveRecord is given with no arguments.
+=================
+*/
+void Svcmd_PmoveRecord_f( void ) {
+	char				arg[MAX_TOKEN_CHARS];
+	char				name[MAX_QPATH];
+	pmoveRecordHeader_t	header;
+	int					clientNum;
+
+	if ( trap_Argc() < 3 ) {
+		if ( recordClient < 0 ) {
+			G_Printf( "usage: pmoveRecord <clientNum> <file>\n" );
+		}
+		G_StopPmoveRecord();
+		return;
+	}
+	G_StopPmoveRecord();
+
+	trap_Argv( 1, arg, sizeof( arg ) );
+	clientNum = atoi( arg );
+	if ( clientNum < 0 || clientNum >= level.maxclients ||
+		level.clients[clientNum].pers.connected != CON_CONNECTED ) {
+		G_Printf( "pmoveRecord: client %i is not connected\n", clientNum );
+		return;
+	}
+
+	trap_Argv( 2, arg, sizeof( arg ) );
+	Com_sprintf( name, sizeof( name ), "pmove/%s.pmr", arg );
+	trap_FS_FOpenFile( name, &recordFile, FS_WRITE );
+	if ( !recordFile ) {
+		G_Printf( "pmoveRecord: couldn't open %s\n", name );
+		return;
+	}
+
+	header.id = PMOVE_RECORD_ID;
+	header.version = PMOVE_RECORD_VERSION;
+	header.packedInts = G_PackPlayerState( &level.clients[clientNum].ps, NULL );
+	header.pmove_fixed = pmove_fixed.integer | level.clients[clientNum].pers.pmoveFixed;
+	header.pmove_msec = pmove_msec.integer;
+	header.noFootsteps = ( g_dmflags.integer & DF_NO_FOOTSTEPS ) > 0;
+	trap_FS_Write( &header, sizeof( header ), recordFile );
+
+	recordClient = clientNum;
+	recordMoves = 0;
+	G_Printf( "pmoveRecord: recording client %i to %s\n", clientNum, name );
+}
+
+
+/*
+==============================================================================
+
+BENCHMARK
+
+==============================================================================
+*/
+
+static void PmoveBench_Trace( trace_t *results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int passEntityNum, int contentMask ) {
+	benchTraces++;
+	trap_Trace( results, start, mins, maxs, end, passEntityNum, contentMask );
+}
+
+static int PmoveBench_PointContents( const vec3_t point, int passEntityNum ) {
+	benchTraces++;
+	return trap_PointContents( point, passEntityNum );
+}
+
+/*
+================
+G_ReadRecordedPlayerState
+================
+*/
+static void G_ReadRecordedPlayerState( fileHandle_t f, int packedInts, playerState_t *ps ) {
+	int		packed[1024];
+
+	trap_FS_Read( packed, packedInts * sizeof( int ), f );
+	G_UnpackPlayerState( packed, ps );
+}
+
+/*
+================
+G_LoadPmoveRecord
+
+Returns the number of moves read into benchMoves.
+================
+*/
+static int G_LoadPmoveRecord( const char *name, pmoveRecordHeader_t *header ) {
+	fileHandle_t	f;
+	pmoveRecord_t	*rec;
+	int				hasLocked[2];
+	int				len, moveSize, count;
+
+	len = trap_FS_FOpenFile( name, &f, FS_READ );
+	if ( !f ) {
+		G_Printf( "pmoveBench: couldn't open %s\n", name );
+		return 0;
+	}
+	if ( len < (int)sizeof( *header ) ) {
+		G_Printf( "pmoveBench: %s is too short\n", name );
+		trap_FS_FCloseFile( f );
+		return 0;
+	}
+	trap_FS_Read( header, sizeof( *header ), f );
+	if ( header->id != PMOVE_RECORD_ID || header->version != PMOVE_RECORD_VERSION ||
+		header->packedInts != G_PackPlayerState( &benchMoves[0].ps, NULL ) ) {
+		G_Printf( "pmoveBench: %s is not a recording this build can replay\n", name );
+		trap_FS_FCloseFile( f );
+		return 0;
+	}
+	len -= sizeof( *header );
+
+	// smallest a move can be
+	moveSize = sizeof( usercmd_t ) + header->packedInts * sizeof( int ) +
+		sizeof( hasLocked ) + sizeof( unsigned );
+
+	count = 0;
+	while ( len >= moveSize && count < MAX_PMOVE_RECORD ) {
+		rec = &benchMoves[count];
+		trap_FS_Read( &rec->cmd, sizeof( rec->cmd ), f );
+		G_ReadRecordedPlayerState( f, header->packedInts, &rec->ps );
+		trap_FS_Read( hasLocked, sizeof( hasLocked ), f );
+		len -= moveSize;
+		rec->hasLockedPlayer = hasLocked[0];
+		if ( rec->hasLockedPlayer ) {
+			G_ReadRecordedPlayerState( f, header->packedInts, &rec->lockedPlayer );
+			len -= header->packedInts * sizeof( int );
+		}
+		rec->hasLockedPosition = hasLocked[1];
+		if ( rec->hasLockedPosition ) {
+			trap_FS_Read( rec->lockedPosition, sizeof( vec3_t ), f );
+			len -= sizeof( vec3_t );
+		}
+		if ( len < 0 ) {
+			break;
+		}
+		trap_FS_Read( &rec->checksum, sizeof( rec->checksum ), f );
+		count++;
+	}
+	trap_FS_FCloseFile( f );
+	return count;
+}
+
+/*
+================
+G_ReplayPmove
+
+Runs one recorded move on copies of its states and returns the checksum
+of what came out.
+================
+*/
+static unsigned G_ReplayPmove( const pmoveRecordHeader_t *header, const pmoveRecord_t *rec ) {
+	pmove_t			pm;
+	playerState_t	ps, lockedPlayer;
+	vec3_t			lockedPosition;
+
+	ps = rec->ps;
+	ps.lockedPlayer = NULL;
+	ps.lockedPosition = NULL;
+	if ( rec->hasLockedPlayer ) {
+		lockedPlayer = rec->lockedPlayer;
+		ps.lockedPlayer = &lockedPlayer;
+	}
+	if ( rec->hasLockedPosition ) {
+		VectorCopy( rec->lockedPosition, lockedPosition );
+		ps.lockedPosition = &lockedPosition;
+	}
+
+	memset( &pm, 0, sizeof( pm ) );
+	pm.ps = &ps;
+	pm.cmd = rec->cmd;
+	pm.tracemask = MASK_PLAYERSOLID;
+	pm.trace = PmoveBench_Trace;
+	pm.pointcontents = PmoveBench_PointContents;
+	pm.noFootsteps = header->noFootsteps;
+	pm.pmove_fixed = header->pmove_fixed;
+	pm.pmove_msec = header->pmove_msec;
+	Pmove( &pm );
+
+	return G_PmoveChecksum( &ps );
+}
+
+/*
+=================
+Svcmd_PmoveBench_f
+
+pmoveBench <file> [passes]
+
+Replays a recording made with pmoveRecord, timing Pmove and counting the
+traces and point contents it asks for.  Every move starts from its
+recorded state, so a move that comes out differently doesn't throw off
+the ones after it.
+
+Moves that don't match the recording were either made while other
+players or movers were in the way -- replay on an empty server to rule
+that out -- or Pmove isn't computing the same thing as the build that
+made the recording.  Moves that don't match between passes mean Pmove
+isn't deterministic at all.  The final checksum can be compared between
+builds and compilers directly.
+=================
+*/
+void Svcmd_PmoveBench_f( void ) {
+	char				arg[MAX_TOKEN_CHARS];
+	char				name[MAX_QPATH];
+	pmoveRecordHeader_t	header;
+	unsigned			first[MAX_PMOVE_RECORD];
+	unsigned			checksum, total;
+	int					passes, moves;
+	int					pass, i, start, msec;
+	int					recordDiffs, passDiffs;
+
+	if ( trap_Argc() < 2 ) {
+		G_Printf( "usage: pmoveBench <file> [passes]\n" );
+		return;
+	}
+	if ( recordClient >= 0 ) {
+		G_Printf( "pmoveBench: stop recording first\n" );
+		return;
+	}
+	trap_Argv( 1, arg, sizeof( arg ) );
+	Com_sprintf( name, sizeof( name ), "pmove/%s.pmr", arg );
+	passes = 20;
+	if ( trap_Argc() > 2 ) {
+		trap_Argv( 2, arg, sizeof( arg ) );
+		passes = atoi( arg );
+		if ( passes < 1 ) {
+			passes = 1;
+		}
+	}
+
+	moves = G_LoadPmoveRecord( name, &header );
+	if ( !moves ) {
+		return;
+	}
+
+	// the first pass checks against the recording
+	recordDiffs = 0;
+	total = 2166136261u;
+	for ( i = 0 ; i < moves ; i++ ) {
+		first[i] = G_ReplayPmove( &header, &benchMoves[i] );
+		if ( first[i] != benchMoves[i].checksum ) {
+			recordDiffs++;
+		}
+		total = ( total ^ first[i] ) * 16777619u;
+	}
+
+	benchTraces = 0;
+	passDiffs = 0;
+	start = trap_Milliseconds();
+	for ( pass = 0 ; pass < passes ; pass++ ) {
+		for ( i = 0 ; i < moves ; i++ ) {
+			checksum = G_ReplayPmove( &header, &benchMoves[i] );
+			if ( checksum != first[i] ) {
+				passDiffs++;
+			}
+		}
+	}
+	msec = trap_Milliseconds() - start;
+
+	G_Printf( "%i moves, %i passes\n", moves, passes );
+	G_Printf( "%10.0f ns/move\n", (float)msec * 1000000.0f / ( (float)moves * passes ) );
+	G_Printf( "%10.2f traces/move\n", (float)benchTraces / ( (float)moves * passes ) );
+	G_Printf( "%10i moves differ from the recording\n", recordDiffs );
+	G_Printf( "%10i moves differ between passes\n", passDiffs );
+	G_Printf( "checksum %08x\n", total );
+}
@@ -46,6 +46,7 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #define SVF_CAPSULE				0x00000200	// use capsule for collision detection instead of bbox
 #define SVF_NOTSINGLECLIENT		0x00000400	// send entity to everyone but one client
 											// (entityShared_t->singleClient)
+#define SVF_FULLRATE			0x00000800	// never held back in snapshots for being far away
 
 
 
@@ -97,6 +98,18 @@ typedef struct {
 } sharedEntity_t;
 
 
+// one trace of a G_TRACE_BATCH call
+typedef struct {
+	vec3_t			start;
+	vec3_t			end;
+	vec3_t			mins;
+	vec3_t			maxs;
+	int				passEntityNum;
+	int				contentmask;
+	trace_t			trace;			// filled in by the server
+} batchTrace_t;
+
+
 
 //===============================================================
 
@@ -224,6 +237,10 @@ typedef enum {
 	// 1.32
 	G_FS_SEEK,
 
+	G_TRACE_BATCH,	// ( batchTrace_t *traces, int count );
+	// runs several traces in one call, sharing the work of finding
+	// the entities near them
+
 } gameImport_t;
 
 
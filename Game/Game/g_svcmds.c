@@ -477,6 +477,21 @@ qboolean	ConsoleCommand( void ) {
 		return qtrue;
 	}
 
+	if (Q_stricmp (cmd, "thinkBench") == 0) {
+		Svcmd_ThinkBench_f();
+		return qtrue;
+	}
+
+	if (Q_stricmp (cmd, "pmoveRecord") == 0) {
+		Svcmd_PmoveRecord_f();
+		return qtrue;
+	}
+
+	if (Q_stricmp (cmd, "pmoveBench") == 0) {
+		Svcmd_PmoveBench_f();
+		return qtrue;
+	}
+
 	if (Q_stricmp (cmd, "abort_podium") == 0) {
 		Svcmd_AbortPodium_f();
 		return qtrue;
@@ -44,6 +44,7 @@ equ trap_SnapVector						-41
 equ trap_TraceCapsule					-42
 equ trap_EntityContactCapsule			-43
 equ trap_FS_Seek						-44
+equ trap_TraceBatch					-45
 
 equ	memset					-101
 equ	memcpy					-102
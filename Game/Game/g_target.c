@@ -63,7 +63,7 @@ void Think_Target_Delay( gentity_t *ent ) {
 }
 
 void Use_Target_Delay( gentity_t *ent, gentity_t *other, gentity_t *activator ) {
-	ent->nextthink = level.time + ( ent->wait + ent->random * crandom() ) * 1000;
+	G_SetNextThink( ent, level.time + ( ent->wait + ent->random * crandom() ) * 1000 );
 	ent->think = Think_Target_Delay;
 	ent->activator = activator;
 }
@@ -219,7 +219,7 @@ void target_laser_on (gentity_t *self)
 void target_laser_off (gentity_t *self)
 {
 	trap_UnlinkEntity( self );
-	self->nextthink = 0;
+	G_SetNextThink( self, 0 );
 }
 
 void target_laser_use (gentity_t *self, gentity_t *other, gentity_t *activator)
@@ -264,7 +264,7 @@ void SP_target_laser (gentity_t *self)
 {
 	// let everything else get spawned before we start firing
 	self->think = target_laser_start;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( self, level.time + FRAMETIME );
 }
 
 
@@ -386,7 +386,7 @@ in site, closest in distance
 */
 void SP_target_location( gentity_t *self ){
 	self->think = target_location_linkup;
-	self->nextthink = level.time + 200;  // Let them all spawn first
+	G_SetNextThink( self, level.time + 200 );  // Let them all spawn first
 
 	G_SetOrigin( self, self->s.origin );
 }
@@ -614,7 +614,7 @@ Obelisks
 */
 
 static void ObeliskRegen( gentity_t *self ) {
-	self->nextthink = level.time + g_obeliskRegenPeriod.integer * 1000;
+	G_SetNextThink( self, level.time + g_obeliskRegenPeriod.integer * 1000 );
 	if( self->powerLevelTotal >= g_obeliskHealth.integer ) {
 		return;
 	}
@@ -635,7 +635,7 @@ static void ObeliskRespawn( gentity_t *self ) {
 	self->powerLevelTotal = g_obeliskHealth.integer;
 
 	self->think = ObeliskRegen;
-	self->nextthink = level.time + g_obeliskRegenPeriod.integer * 1000;
+	G_SetNextThink( self, level.time + g_obeliskRegenPeriod.integer * 1000 );
 
 	self->activator->s.frame = 0;
 }
@@ -672,7 +672,7 @@ gentity_t *SpawnObelisk( vec3_t origin, int team, int spawnflags) {
 		ent->die = ObeliskDie;
 		ent->pain = ObeliskPain;
 		ent->think = ObeliskRegen;
-		ent->nextthink = level.time + g_obeliskRegenPeriod.integer * 1000;
+		G_SetNextThink( ent, level.time + g_obeliskRegenPeriod.integer * 1000 );
 	}
 	if( g_gametype.integer == GT_HARVESTER ) {
 		ent->r.contents = CONTENTS_TRIGGER;
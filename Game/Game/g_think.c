@@ -0,0 +1,377 @@
+// g_think.c -- think scheduling
+
+#include "g_local.h"
+
+/*
+==============================================================================
+
+THINK WHEEL
+
+Entities that do nothing each frame but wait for their nextthink or for
+an event to run out are parked on a hashed timer wheel and left out of
+the G_RunFrame pass until they are due.  Everything else -- clients,
+missiles, explosions, beam heads, movers -- stays in the pass every frame.
+
+Anything that wakes a parked entity early has to go through
+G_SetNextThink or G_AddEvent, never set nextthink directly.
+
+==============================================================================
+*/
+
+#define	THINK_WHEEL_SHIFT	4		// 16 msec a slot
+#define	THINK_WHEEL_SLOTS	256		// power of two, about four seconds around
+#define	THINK_WHEEL_MASK	( THINK_WHEEL_SLOTS - 1 )
+
+static int		wheelHead[THINK_WHEEL_SLOTS];
+static int		wheelNext[MAX_GENTITIES];
+static int		wheelPrev[MAX_GENTITIES];
+static int		wheelSlot[MAX_GENTITIES];		// -1 if not on the wheel
+static int		wheelTime[MAX_GENTITIES];
+static int		wheelTick;
+static qboolean	wheelEnabled;
+
+// entities that get looked at this frame
+static unsigned	activeBits[MAX_GENTITIES / 32];
+
+#define	SetActive( n )		( activeBits[(n) >> 5] |= 1u << ( (n) & 31 ) )
+#define	ClearActive( n )	( activeBits[(n) >> 5] &= ~( 1u << ( (n) & 31 ) ) )
+
+static void G_UnlinkThink( int n ) {
+	if ( wheelSlot[n] < 0 ) {
+		return;
+	}
+	if ( wheelPrev[n] >= 0 ) {
+		wheelNext[wheelPrev[n]] = wheelNext[n];
+	} else {
+		wheelHead[wheelSlot[n]] = wheelNext[n];
+	}
+	if ( wheelNext[n] >= 0 ) {
+		wheelPrev[wheelNext[n]] = wheelPrev[n];
+	}
+	wheelSlot[n] = -1;
+}
+
+static void G_LinkThink( int n, int time ) {
+	int		slot;
+
+	slot = ( time >> THINK_WHEEL_SHIFT ) & THINK_WHEEL_MASK;
+	wheelSlot[n] = slot;
+	wheelTime[n] = time;
+	wheelPrev[n] = -1;
+	wheelNext[n] = wheelHead[slot];
+	if ( wheelHead[slot] >= 0 ) {
+		wheelPrev[wheelHead[slot]] = n;
+	}
+	wheelHead[slot] = n;
+}
+
+/*
+================
+G_ResetThinkWheel
+
+Empties the wheel and puts every entity back in the frame.
+================
+*/
+static void G_ResetThinkWheel( void ) {
+	int		i;
+
+	for ( i = 0 ; i < THINK_WHEEL_SLOTS ; i++ ) {
+		wheelHead[i] = -1;
+	}
+	for ( i = 0 ; i < MAX_GENTITIES ; i++ ) {
+		wheelSlot[i] = -1;
+	}
+	memset( activeBits, 0, sizeof( activeBits ) );
+	for ( i = 0 ; i < MAX_GENTITIES ; i++ ) {
+		if ( i < MAX_CLIENTS || g_entities[i].inuse ) {
+			SetActive( i );
+		}
+	}
+	wheelTick = level.time >> THINK_WHEEL_SHIFT;
+}
+
+/*
+================
+G_InitThinkWheel
+================
+*/
+void G_InitThinkWheel( void ) {
+	G_ResetThinkWheel();
+	wheelEnabled = ( g_thinkWheel.integer != 0 );
+}
+
+/*
+================
+G_WakeEntity
+
+Puts the entity back in the frame, if it was parked.
+================
+*/
+void G_WakeEntity( gentity_t *ent ) {
+	int		n;
+
+	n = ent - g_entities;
+	G_UnlinkThink( n );
+	SetActive( n );
+}
+
+/*
+================
+G_ForgetEntity
+
+Called when an entity is freed.
+================
+*/
+void G_ForgetEntity( gentity_t *ent ) {
+	int		n;
+
+	n = ent - g_entities;
+	G_UnlinkThink( n );
+	// client slots are always looked at
+	if ( n >= MAX_CLIENTS ) {
+		ClearActive( n );
+	}
+}
+
+/*
+================
+G_SetNextThink
+================
+*/
+void G_SetNextThink( gentity_t *ent, int time ) {
+	ent->nextthink = time;
+	G_WakeEntity( ent );
+}
+
+/*
+================
+G_ParkEntity
+
+Leaves the entity out of the frame until its nextthink comes or its event
+runs out.  Only called for entities that G_RunFrame did nothing with this
+frame but G_RunThink.
+================
+*/
+void G_ParkEntity( gentity_t *ent ) {
+	int		n;
+	int		wake;
+
+	if ( !wheelEnabled || !ent->inuse ) {
+		return;
+	}
+	n = ent - g_entities;
+	if ( n < MAX_CLIENTS ) {
+		return;
+	}
+	// beam heads fall through to G_RunThink after moving
+	switch ( ent->s.eType ) {
+	case ET_MISSILE:
+	case ET_BEAMHEAD:
+	case ET_EXPLOSION:
+	case ET_MOVER:
+		return;
+	default:
+		break;
+	}
+
+	wake = 0;
+	if ( ent->s.event || ent->freeAfterEvent || ent->unlinkAfterEvent ) {
+		wake = ent->eventTime + EVENT_VALID_MSEC + 1;
+	}
+	if ( ent->nextthink > 0 && ( !wake || ent->nextthink < wake ) ) {
+		wake = ent->nextthink;
+	}
+	if ( wake && wake <= level.time ) {
+		return;
+	}
+
+	G_UnlinkThink( n );
+	ClearActive( n );
+	if ( wake ) {
+		G_LinkThink( n, wake );
+	}
+}
+
+/*
+================
+G_WakeDueEntities
+
+Puts everything that has come due since the last frame back in it.
+The last slot is walked again, since it can still hold entities that
+were parked later within its 16 msec.
+================
+*/
+static void G_WakeDueEntities( void ) {
+	int		tick, t;
+	int		n, next;
+
+	tick = level.time >> THINK_WHEEL_SHIFT;
+	t = wheelTick;
+	if ( tick - t >= THINK_WHEEL_SLOTS ) {
+		t = tick - THINK_WHEEL_SLOTS + 1;
+	}
+	for ( ; t <= tick ; t++ ) {
+		for ( n = wheelHead[t & THINK_WHEEL_MASK] ; n >= 0 ; n = next ) {
+			next = wheelNext[n];
+			// anything that isn't due yet waits for the wheel to come around again
+			if ( wheelTime[n] <= level.time ) {
+				G_UnlinkThink( n );
+				SetActive( n );
+			}
+		}
+	}
+	wheelTick = tick;
+}
+
+/*
+================
+G_FirstActiveEntity
+
+Starts the G_RunFrame pass over the entities.
+================
+*/
+int G_FirstActiveEntity( void ) {
+	if ( wheelEnabled != ( g_thinkWheel.integer != 0 ) ) {
+		wheelEnabled = ( g_thinkWheel.integer != 0 );
+		G_ResetThinkWheel();
+	}
+	if ( !wheelEnabled ) {
+		return 0;
+	}
+	G_WakeDueEntities();
+	return G_NextActiveEntity( -1 );
+}
+
+/*
+================
+G_NextActiveEntity
+
+Entities spawned during the pass are picked up if they come after the
+current one, just as with a plain walk over level.num_entities.
+================
+*/
+int G_NextActiveEntity( int i ) {
+	unsigned	bits;
+	int			word;
+
+	i++;
+	if ( !wheelEnabled || i >= level.num_entities ) {
+		return i;
+	}
+	word = i >> 5;
+	bits = activeBits[word] & ( 0xffffffffu << ( i & 31 ) );
+	while ( !bits ) {
+		word++;
+		if ( ( word << 5 ) >= level.num_entities ) {
+			return level.num_entities;
+		}
+		bits = activeBits[word];
+	}
+	for ( i = word << 5 ; !( bits & 1 ) ; i++ ) {
+		bits >>= 1;
+	}
+	return i;
+}
+
+
+/*
+==============================================================================
+
+BENCHMARK
+
+==============================================================================
+*/
+
+static void ThinkBench_Think( gentity_t *self ) {
+	G_SetNextThink( self, level.time + 1000 + rand() % 4000 );
+}
+
+/*
+=================
+Svcmd_ThinkBench_f
+
+thinkBench [frames]
+
+Fills the level with idle thinking entities in steps and times G_RunFrame
+with and without the think wheel at each step.  The level clock is held
+still, so nothing comes due while it runs, but the extra frames still run
+every entity in the level, so it only runs in a devmap with no one
+connected.
+=================
+*/
+void Svcmd_ThinkBench_f( void ) {
+	char		arg[MAX_TOKEN_CHARS];
+	gentity_t	*ent;
+	int			frames;
+	int			spawned, room, step;
+	int			mode, i, start;
+	int			msec[2];
+	int			wheel;
+
+	if ( !g_cheats.integer ) {
+		G_Printf( "thinkBench: only runs in a devmap\n" );
+		return;
+	}
+	if ( level.numConnectedClients ) {
+		G_Printf( "thinkBench: only runs with no clients connected\n" );
+		return;
+	}
+
+	frames = 500;
+	if ( trap_Argc() > 1 ) {
+		trap_Argv( 1, arg, sizeof( arg ) );
+		frames = atoi( arg );
+		if ( frames < 1 ) {
+			frames = 1;
+		}
+	}
+
+	// leave some room for whatever the level spawns meanwhile
+	room = level.maxEntities - level.num_entities - 64;
+	if ( room <= 0 ) {
+		G_Printf( "thinkBench: no free entities\n" );
+		return;
+	}
+	step = room / 4;
+	if ( step < 1 ) {
+		step = room;
+	}
+
+	wheel = g_thinkWheel.integer;
+	G_Printf( "%i frames at each step\n", frames );
+	G_Printf( "entities    scan msec/frame   wheel msec/frame\n" );
+	for ( spawned = 0 ; ; ) {
+		for ( mode = 0 ; mode < 2 ; mode++ ) {
+			trap_Cvar_Set( "g_thinkWheel", mode ? "1" : "0" );
+			trap_Cvar_Update( &g_thinkWheel );
+			// one frame to let the wheel settle
+			G_RunFrame( level.time );
+			start = trap_Milliseconds();
+			for ( i = 0 ; i < frames ; i++ ) {
+				G_RunFrame( level.time );
+			}
+			msec[mode] = trap_Milliseconds() - start;
+		}
+		G_Printf( "%8i    %16.4f   %16.4f\n", level.num_entities,
+			(float)msec[0] / frames, (float)msec[1] / frames );
+
+		if ( spawned >= room ) {
+			break;
+		}
+		for ( i = 0 ; i < step && spawned < room ; i++, spawned++ ) {
+			ent = G_Spawn();
+			ent->classname = "thinkbench";
+			ent->think = ThinkBench_Think;
+			G_SetNextThink( ent, level.time + 1000 + rand() % 4000 );
+		}
+	}
+
+	for ( i = MAX_CLIENTS ; i < level.num_entities ; i++ ) {
+		ent = &g_entities[i];
+		if ( ent->inuse && ent->think == ThinkBench_Think ) {
+			G_FreeEntity( ent );
+		}
+	}
+	trap_Cvar_Set( "g_thinkWheel", va( "%i", wheel ) );
+	trap_Cvar_Update( &g_thinkWheel );
+}
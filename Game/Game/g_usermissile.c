@@ -82,7 +82,7 @@ void Think_ProxDet( gentity_t *self ) {
 	if ( ( self->missileSpawnTime + self->maxMissileTime ) <= level.time) {
 	  self->think = G_ExplodeUserWeapon;
 	}
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( self, level.time + FRAMETIME );
 }
 
 
@@ -138,7 +138,7 @@ void Think_Guided (gentity_t *self) {
 		}
 	} // END OF BEAM SECTIONS
 	// If the weapon has existed too long, make the next think detonate it.
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( self, level.time + FRAMETIME );
 }
 
 
@@ -237,7 +237,7 @@ void Think_Homing (gentity_t *self) {
 	if ( ( self->missileSpawnTime + self->maxMissileTime ) <= level.time ) {
 	  self->think = G_ExplodeUserWeapon;
 	}
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( self, level.time + FRAMETIME );
 }
 
 
@@ -343,7 +343,7 @@ void Think_CylinderHoming (gentity_t *self) {
 	if ( ( self->missileSpawnTime + self->maxMissileTime ) <= level.time ) {
 	  self->think = G_ExplodeUserWeapon;
 	}
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( self, level.time + FRAMETIME );
 }
 
 /*
@@ -353,6 +353,22 @@ Think_NormalMissile
 */
 void Think_NormalMissile (gentity_t *self) {
 	gentity_t	*missileOwner = GetMissileOwnerEntity(self);
+	int			steps;
+
+	// a missile left at a lower rate by G_MissileLodMsec makes up for the thinks it missed,
+	// carrying the remainder over so a rate that isn't a multiple of FRAMETIME loses nothing
+	if (!self->lastThinkTime) {
+		steps = 1;
+		self->lastThinkTime = level.time;
+	} else {
+		steps = (level.time - self->lastThinkTime) / FRAMETIME;
+		if (steps < 1) {
+			steps = 1;
+			self->lastThinkTime = level.time;
+		} else {
+			self->lastThinkTime += steps * FRAMETIME;
+		}
+	}
 
 	if(level.time > self->startTimer && self->radius){
 		int radius = self->radius;
@@ -367,12 +383,12 @@ void Think_NormalMissile (gentity_t *self) {
 
 	if ((self->missileSpawnTime + self->maxMissileTime) <= level.time){
 		self->think = G_ExplodeUserWeapon;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink( self, level.time + FRAMETIME );
 		return;
 	}
 
 	if(self->isDrainable && self->s.eType != ET_BEAMHEAD){
-		self->powerLevelCurrent -= (float)self->powerLevelTotal * 0.01;
+		self->powerLevelCurrent -= (float)self->powerLevelTotal * 0.01 * steps;
 	}
 	if (self->powerLevelCurrent <= 0) {
 		G_RemoveUserWeapon(self);
@@ -382,7 +398,7 @@ void Think_NormalMissile (gentity_t *self) {
 		self->powerLevelCurrent += 10 + ((float)self->powerLevelTotal * 0.005);
 		self->speed += 10 + ((float)missileOwner->client->ps.powerLevel[plMaximum] * 0.0003);
 	}
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( self, level.time + FRAMETIME );
 }
 
 /*
@@ -439,7 +455,7 @@ void Think_NormalMissileStruggle (gentity_t *self) {
 	VectorCopy(dir,self->r.currentAngles);
 	self->s.pos.trType = TR_LINEAR;
 	self->s.pos.trTime = level.time;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( self, level.time + FRAMETIME );
 }
 
 /*
@@ -493,80 +509,338 @@ void G_UserWeaponDamage(gentity_t *target,gentity_t *inflictor,gentity_t *attack
 }
 
 /*
-=====================
-G_UserRadiusDamage
-=====================
+   -----------------------------------------
+     R A D I U S   D A M A G E
+   -----------------------------------------
+   Explosions queue their damage while the entities run and G_RunFrame
+   applies all of it afterwards. The entities near any explosion are
+   gathered once, targets outside the PVS are dropped without a trace,
+   and the traces that are left go to the server in two batches. Whether
+   a target can be hit from an origin cell is remembered for the rest of
+   the frame, so repeated explosions from the same spot skip the traces.
 */
-qboolean G_UserRadiusDamage ( vec3_t origin, gentity_t *attacker, gentity_t *ignore, float centerDamage, float radius,int extraKnockback ) {
-	int			entityList[MAX_GENTITIES];
-	int			numListedEntities;
-	
-	float		realDamage, distance;
-	gentity_t	*ent;
-	gentity_t	*owner = GetMissileOwnerEntity(ignore);
-	
-	vec3_t		mins, maxs;
-	vec3_t		deltaRadius;
-	vec3_t		dir;
-	int			i, e;
-	qboolean	hitClient = qfalse;
+#define MAX_RADIUS_DAMAGE		128
+#define MAX_RADIUS_PAIRS		MAX_GENTITIES
+#define	OCCLUSION_CELL_SIZE		16
+#define	OCCLUSION_CACHE_SIZE	2048	// power of two
 
-	if ( radius < 1 ) {
-		radius = 1;
+typedef struct {
+	vec3_t		origin;
+	gentity_t	*attacker;
+	gentity_t	*ignore;
+	gentity_t	*owner;
+	float		damage;
+	float		radius;
+	int			extraKnockback;
+	qboolean	inSolid;
+} radiusDamage_t;
+
+typedef enum {
+	OCCLUSION_UNKNOWN,
+	OCCLUSION_VISIBLE,
+	OCCLUSION_BLOCKED
+} occlusion_t;
+
+typedef struct {
+	int			frame;
+	int			cell[3];
+	int			target;
+	vec3_t		midpoint;		// where the target was when it was tested
+	occlusion_t	result;
+	int			pair;			// the pair testing it, or -1
+} occlusionCache_t;
+
+typedef struct {
+	int			explosion;
+	int			target;
+	vec3_t		midpoint;
+	occlusionCache_t	*cache;	// NULL if the cache was full
+	occlusion_t	result;
+	int			firstTrace;
+} radiusPair_t;
+
+static radiusDamage_t	radiusDamage[MAX_RADIUS_DAMAGE];
+static int				numRadiusDamage;
+static occlusionCache_t	occlusionCache[OCCLUSION_CACHE_SIZE];
+static radiusPair_t		radiusPairs[MAX_RADIUS_PAIRS];
+static batchTrace_t		radiusTraces[MAX_RADIUS_PAIRS];
+
+static const float damageCorners[4][2] = { {15, 15}, {15, -15}, {-15, 15}, {-15, -15} };
+
+static occlusionCache_t *G_OcclusionCache( vec3_t origin, gentity_t *target, vec3_t midpoint ) {
+	occlusionCache_t *entry;
+	int cell[3];
+	unsigned hash;
+	int i;
+
+	for (i = 0; i < 3; i++) {cell[i] = floor(origin[i] / OCCLUSION_CELL_SIZE);}
+	hash = (cell[0] * 73856093u) ^ (cell[1] * 19349663u) ^ (cell[2] * 83492791u) ^ (target->s.number * 2654435761u);
+	for (i = 0; i < 8; i++) {
+		entry = &occlusionCache[(hash + i) & (OCCLUSION_CACHE_SIZE - 1)];
+		if (entry->frame != level.framenum) {
+			entry->frame = level.framenum;
+			entry->cell[0] = cell[0];
+			entry->cell[1] = cell[1];
+			entry->cell[2] = cell[2];
+			entry->target = target->s.number;
+			VectorCopy(midpoint, entry->midpoint);
+			entry->result = OCCLUSION_UNKNOWN;
+			entry->pair = -1;
+			return entry;
+		}
+		if (entry->target == target->s.number &&
+			entry->cell[0] == cell[0] && entry->cell[1] == cell[1] && entry->cell[2] == cell[2]) {
+			// it moved since, so test it again
+			if (!VectorCompare(entry->midpoint, midpoint)) {
+				VectorCopy(midpoint, entry->midpoint);
+				entry->result = OCCLUSION_UNKNOWN;
+			}
+			return entry;
+		}
 	}
+	return NULL;
+}
 
-	for ( i = 0 ; i < 3 ; i++ ) {
-		mins[i] = origin[i] - radius;
-		maxs[i] = origin[i] + radius;
+static qboolean G_DamagePointsInPVS( vec3_t origin, vec3_t midpoint ) {
+	vec3_t dest;
+	int i;
+
+	if (trap_InPVSIgnorePortals(origin, midpoint)) {return qtrue;}
+	for (i = 0; i < 4; i++) {
+		VectorCopy(midpoint, dest);
+		dest[0] += damageCorners[i][0];
+		dest[1] += damageCorners[i][1];
+		if (trap_InPVSIgnorePortals(origin, dest)) {return qtrue;}
 	}
+	return qfalse;
+}
 
-	numListedEntities = trap_EntitiesInBox( mins, maxs, entityList, MAX_GENTITIES );
+static void G_AddDamageTrace( int *numTraces, vec3_t origin, vec3_t dest ) {
+	batchTrace_t *trace = &radiusTraces[(*numTraces)++];
 
-	for ( e = 0 ; e < numListedEntities ; e++ ) {
-		ent = &g_entities[entityList[ e ]];
+	VectorCopy(origin, trace->start);
+	VectorCopy(dest, trace->end);
+	VectorClear(trace->mins);
+	VectorClear(trace->maxs);
+	trace->passEntityNum = ENTITYNUM_NONE;
+	trace->contentmask = MASK_SOLID;
+}
 
-		if (ent == ignore)
-			continue;
-		if (!ent->takedamage)
-			continue;
-		if (ent == owner && ignore->isBlindable)
-			continue;
-		
-		// Find the distance between the perimeter of the entities' bounding box
-		// and the explosion's origin.
-		for ( i = 0 ; i < 3 ; i++ ) {
-			if ( origin[i] < ent->r.absmin[i] ) {
-				deltaRadius[i] = ent->r.absmin[i] - origin[i];
-			} else if ( origin[i] > ent->r.absmax[i] ) {
-				deltaRadius[i] = origin[i] - ent->r.absmax[i];
-			} else {
-				deltaRadius[i] = 0;
+/*
+=====================
+G_CollectRadiusPairs
+
+Finds every target in reach of the explosions from first on, settling
+what the cache and the PVS can. Stops early if the next explosion might
+not fit, and returns the explosion to carry on from.
+=====================
+*/
+static int G_CollectRadiusPairs( int first, int *entityList, int numListedEntities, int *numPairs ) {
+	radiusDamage_t	*rd;
+	radiusPair_t	*pair;
+	gentity_t		*ent;
+	vec3_t			deltaRadius;
+	float			distance;
+	int				i, e, n;
+
+	*numPairs = 0;
+	for (n = first, rd = &radiusDamage[first]; n < numRadiusDamage; n++, rd++) {
+		if (*numPairs + numListedEntities > MAX_RADIUS_PAIRS) {break;}
+		for (e = 0; e < numListedEntities; e++) {
+			ent = &g_entities[entityList[e]];
+			if (ent == rd->ignore) {continue;}
+			if (!ent->takedamage) {continue;}
+			if (ent == rd->owner && rd->ignore->isBlindable) {continue;}
+			// Find the distance between the perimeter of the entities' bounding box
+			// and the explosion's origin.
+			for (i = 0; i < 3; i++) {
+				if (rd->origin[i] < ent->r.absmin[i]) {deltaRadius[i] = ent->r.absmin[i] - rd->origin[i];}
+				else if (rd->origin[i] > ent->r.absmax[i]) {deltaRadius[i] = rd->origin[i] - ent->r.absmax[i];}
+				else {deltaRadius[i] = 0;}
+			}
+			distance = VectorLength(deltaRadius);
+			if (distance >= rd->radius) {continue;}
+			pair = &radiusPairs[(*numPairs)++];
+			pair->explosion = n;
+			pair->target = entityList[e];
+			pair->firstTrace = -1;
+			VectorAdd(ent->r.absmin, ent->r.absmax, pair->midpoint);
+			VectorScale(pair->midpoint, 0.5, pair->midpoint);
+			pair->cache = G_OcclusionCache(rd->origin, ent, pair->midpoint);
+			pair->result = pair->cache ? pair->cache->result : OCCLUSION_UNKNOWN;
+			if (pair->result == OCCLUSION_UNKNOWN && !rd->inSolid && !G_DamagePointsInPVS(rd->origin, pair->midpoint)) {
+				pair->result = OCCLUSION_BLOCKED;
+				if (pair->cache) {pair->cache->result = OCCLUSION_BLOCKED;}
 			}
 		}
+	}
+	return n;
+}
 
-		distance = VectorLength( deltaRadius );
-		if ( distance >= radius ) {
+/*
+=====================
+G_TestRadiusPairs
+
+The same tests CanDamage makes, as two batches of traces.
+=====================
+*/
+static void G_TestRadiusPairs( int numPairs ) {
+	radiusPair_t	*pair;
+	trace_t			*tr;
+	vec3_t			dest;
+	int				numTraces;
+	int				i, j;
+
+	// straight at the middle first
+	numTraces = 0;
+	for (j = 0, pair = radiusPairs; j < numPairs; j++, pair++) {
+		if (pair->result != OCCLUSION_UNKNOWN) {continue;}
+		if (pair->cache) {
+			// an earlier explosion from the same cell is already testing it
+			if (pair->cache->pair >= 0) {continue;}
+			pair->cache->pair = j;
+		}
+		pair->firstTrace = numTraces;
+		G_AddDamageTrace(&numTraces, radiusDamage[pair->explosion].origin, pair->midpoint);
+	}
+	trap_TraceBatch(radiusTraces, numTraces);
+
+	// then at the corners of whatever that didn't reach
+	numTraces = 0;
+	for (j = 0, pair = radiusPairs; j < numPairs; j++, pair++) {
+		if (pair->firstTrace < 0) {continue;}
+		tr = &radiusTraces[pair->firstTrace].trace;
+		if (tr->fraction == 1.0 || tr->entityNum == pair->target) {
+			pair->result = OCCLUSION_VISIBLE;
+			pair->firstTrace = -1;
+			continue;
+		}
+		if (numTraces + 4 > MAX_RADIUS_PAIRS) {
+			pair->firstTrace = -1;
+			pair->result = CanDamage(&g_entities[pair->target], radiusDamage[pair->explosion].origin) ? OCCLUSION_VISIBLE : OCCLUSION_BLOCKED;
 			continue;
 		}
+		pair->firstTrace = numTraces;
+		for (i = 0; i < 4; i++) {
+			VectorCopy(pair->midpoint, dest);
+			dest[0] += damageCorners[i][0];
+			dest[1] += damageCorners[i][1];
+			G_AddDamageTrace(&numTraces, radiusDamage[pair->explosion].origin, dest);
+		}
+	}
+	trap_TraceBatch(radiusTraces, numTraces);
+
+	// pairs come in order, so whoever tested a cache entry is done before anyone waiting on it
+	for (j = 0, pair = radiusPairs; j < numPairs; j++, pair++) {
+		if (pair->firstTrace >= 0) {
+			pair->result = OCCLUSION_BLOCKED;
+			for (i = 0; i < 4; i++) {
+				if (radiusTraces[pair->firstTrace + i].trace.fraction == 1.0) {
+					pair->result = OCCLUSION_VISIBLE;
+					break;
+				}
+			}
+		}
+		if (!pair->cache) {continue;}
+		if (pair->cache->pair == j) {
+			pair->cache->result = pair->result;
+			pair->cache->pair = -1;
+		}
+		pair->result = pair->cache->result;
+	}
+}
 
-		realDamage = centerDamage /** ( 1.0 - distance / radius )*/;
+/*
+=====================
+G_RunRadiusDamage
 
-		if(CanDamage(ent, origin)){
-			VectorSubtract (ent->r.currentOrigin, origin, dir);
+Applies the queued explosion damage.
+=====================
+*/
+void G_RunRadiusDamage( void ) {
+	int				entityList[MAX_GENTITIES];
+	int				numListedEntities;
+	int				numPairs;
+	radiusDamage_t	*rd;
+	radiusPair_t	*pair;
+	gentity_t		*ent;
+	vec3_t			mins, maxs;
+	vec3_t			dir;
+	int				i, j, n, first;
+
+	if (!numRadiusDamage) {return;}
+
+	// one box around every explosion
+	ClearBounds(mins, maxs);
+	for (n = 0, rd = radiusDamage; n < numRadiusDamage; n++, rd++) {
+		for (i = 0; i < 3; i++) {
+			if (rd->origin[i] - rd->radius < mins[i]) {mins[i] = rd->origin[i] - rd->radius;}
+			if (rd->origin[i] + rd->radius > maxs[i]) {maxs[i] = rd->origin[i] + rd->radius;}
+		}
+	}
+	numListedEntities = trap_EntitiesInBox(mins, maxs, entityList, MAX_GENTITIES);
+
+	for (first = 0; first < numRadiusDamage; first = n) {
+		n = G_CollectRadiusPairs(first, entityList, numListedEntities, &numPairs);
+		G_TestRadiusPairs(numPairs);
+
+		// apply the damage in the order the explosions came in
+		for (j = 0, pair = radiusPairs; j < numPairs; j++, pair++) {
+			if (pair->result != OCCLUSION_VISIBLE) {continue;}
+			rd = &radiusDamage[pair->explosion];
+			ent = &g_entities[pair->target];
+			// an earlier explosion may have finished it off
+			if (!ent->inuse || !ent->takedamage) {continue;}
+			VectorSubtract (ent->r.currentOrigin, rd->origin, dir);
 			// push the center of mass higher than the origin so players
 			// get knocked into the air more
 			dir[2] += 24;
-			G_LocationImpact(origin,ent,attacker);
+			G_LocationImpact(rd->origin,ent,rd->attacker);
 			if(ent->client){
-				ent->client->ps.powerLevel[plDamageGeneric] += realDamage;
-				if(ent->pain){ent->pain(ent,attacker,realDamage);}
+				ent->client->ps.powerLevel[plDamageGeneric] += rd->damage;
+				if(ent->pain){ent->pain(ent,rd->attacker,rd->damage);}
 				/*if(ent->client->lasthurt_location == LOCATION_FRONT){
 					ent->client->ps.timers[tmBlind] = 10000;
 				}*/
 			}
 		}
 	}
-	return hitClient;
+	numRadiusDamage = 0;
+}
+
+/*
+=====================
+G_QueueRadiusDamage
+=====================
+*/
+void G_QueueRadiusDamage ( vec3_t origin, gentity_t *attacker, gentity_t *ignore, float centerDamage, float radius,int extraKnockback ) {
+	radiusDamage_t *rd;
+
+	if (numRadiusDamage == MAX_RADIUS_DAMAGE) {G_RunRadiusDamage();}
+	if ( radius < 1 ) {
+		radius = 1;
+	}
+	rd = &radiusDamage[numRadiusDamage++];
+	VectorCopy(origin, rd->origin);
+	rd->attacker = attacker;
+	rd->ignore = ignore;
+	rd->owner = GetMissileOwnerEntity(ignore);
+	rd->damage = centerDamage /** ( 1.0 - distance / radius )*/;
+	rd->radius = radius;
+	rd->extraKnockback = extraKnockback;
+	// the PVS means nothing from inside a wall
+	rd->inSolid = (trap_PointContents(origin, ENTITYNUM_NONE) & CONTENTS_SOLID) != 0;
+}
+
+/*
+=====================
+G_UserRadiusDamage
+=====================
+*/
+qboolean G_UserRadiusDamage ( vec3_t origin, gentity_t *attacker, gentity_t *ignore, float centerDamage, float radius,int extraKnockback ) {
+	G_QueueRadiusDamage(origin, attacker, ignore, centerDamage, radius, extraKnockback);
+	G_RunRadiusDamage();
+	return qfalse;
 }
 void UserHitscan_Fire (gentity_t *self, g_userWeapon_t *weaponInfo, int weaponNum, vec3_t muzzle, vec3_t forward ) {
 	trace_t		tr;
@@ -855,12 +1129,12 @@ void Fire_UserWeapon( gentity_t *self, vec3_t start, vec3_t dir, qboolean altfir
 		switch (weaponInfo->homing_type) {
 			case HOM_PROX:
 				bolt->think = Think_ProxDet;
-				bolt->nextthink = level.time + FRAMETIME;
+				G_SetNextThink( bolt, level.time + FRAMETIME );
 				bolt->homRange = weaponInfo->homing_range;
 				break;
 			case HOM_GUIDED:
 				bolt->think = Think_Guided;
-				bolt->nextthink = level.time + FRAMETIME;
+				G_SetNextThink( bolt, level.time + FRAMETIME );
 				// Kill off previously set accel, bounce and gravity. Guided missiles
 				// do not accelerate, bounce or experience gravity.
 				bolt->accel = 0;
@@ -874,19 +1148,19 @@ void Fire_UserWeapon( gentity_t *self, vec3_t start, vec3_t dir, qboolean altfir
 				break;
 			case HOM_REGULAR:
 				bolt->think = Think_Homing;
-				bolt->nextthink = level.time + FRAMETIME;
+				G_SetNextThink( bolt, level.time + FRAMETIME );
 				bolt->homRange = weaponInfo->homing_range;
 				//bolt->homAccel = weaponInfo->homing_accel;
 				break;
 			case HOM_CYLINDER:
 				bolt->think = Think_CylinderHoming;
-				bolt->nextthink = level.time + FRAMETIME;
+				G_SetNextThink( bolt, level.time + FRAMETIME );
 				bolt->homRange = weaponInfo->homing_range;
 				//bolt->homAccel = weaponInfo->homing_accel;
 				break;
 			case HOM_ARCH:
 				bolt->think = Think_NormalMissile;
-				bolt->nextthink = level.time + FRAMETIME;
+				G_SetNextThink( bolt, level.time + FRAMETIME );
 				bolt->bounceFrac = 0;
 				bolt->bouncesLeft = 0;
 				bolt->accel = 0;
@@ -914,13 +1188,13 @@ void Fire_UserWeapon( gentity_t *self, vec3_t start, vec3_t dir, qboolean altfir
 				break;
 			case HOM_DRUNKEN:
 				bolt->think = Think_NormalMissile;
-				bolt->nextthink = level.time + FRAMETIME;
+				G_SetNextThink( bolt, level.time + FRAMETIME );
 				bolt->s.pos.trType = TR_DRUNKEN;
 				bolt->s.pos.trDuration = weaponInfo->homing_range;
 				break;
 			case HOM_NONE:
 				bolt->think = Think_NormalMissile;
-				bolt->nextthink = level.time + FRAMETIME;
+				G_SetNextThink( bolt, level.time + FRAMETIME );
 				break;
 			default:
 				// This should never happen!
@@ -935,7 +1209,7 @@ void Fire_UserWeapon( gentity_t *self, vec3_t start, vec3_t dir, qboolean altfir
 		bolt = G_Spawn();
 		bolt->classname = "user_beam";
 		bolt->s.eType = ET_BEAMHEAD;
-		bolt->r.svFlags = SVF_USE_CURRENT_ORIGIN;
+		bolt->r.svFlags = SVF_USE_CURRENT_ORIGIN | SVF_FULLRATE;
 		bolt->startTimer = level.time + 800;
 		// Set the weapon number correct, depending on altfire status.
 		if ( !altfire ) {
@@ -1003,7 +1277,7 @@ void Fire_UserWeapon( gentity_t *self, vec3_t start, vec3_t dir, qboolean altfir
 		switch (homingType) {
 		case HOM_GUIDED:
 			bolt->think = Think_Guided;
-			bolt->nextthink = level.time + FRAMETIME;
+			G_SetNextThink( bolt, level.time + FRAMETIME );
 			bolt->s.eFlags |= EF_GUIDED;
 			self->client->guidetarget = bolt;
 			bolt->guided = qtrue;
@@ -1015,7 +1289,7 @@ void Fire_UserWeapon( gentity_t *self, vec3_t start, vec3_t dir, qboolean altfir
 		case HOM_CYLINDER:
 		case HOM_NONE:
 			bolt->think = Think_NormalMissile;
-			bolt->nextthink = level.time + FRAMETIME;
+			G_SetNextThink( bolt, level.time + FRAMETIME );
 			self->client->guidetarget = bolt;
 			bolt->guided = qtrue;			
 			break;
@@ -1123,7 +1397,7 @@ void G_DieUserWeapon(gentity_t *self, gentity_t *inflictor,gentity_t *attacker,
 		return;
 	self->takedamage = qfalse;
 	self->think = G_ExplodeUserWeapon;
-	self->nextthink = level.time;
+	G_SetNextThink( self, level.time );
 }
 void G_ExplodeUserWeapon( gentity_t *self ) {
 	// Handles actual detonation of the weapon in question.
@@ -1259,7 +1533,7 @@ static void Think_NormalMissileStrugglePlayer( gentity_t *self ) {
 		self->bounceFrac = 0.75;
 		G_PushUserMissile(self,self->enemy);
 	}
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( self, level.time + FRAMETIME );
 }
 static void Think_NormalMissileBurnPlayer( gentity_t *self ) {
 	vec3_t fwd;
@@ -1276,7 +1550,7 @@ static void Think_NormalMissileBurnPlayer( gentity_t *self ) {
 		self->freeAfterEvent = qtrue;
 		self->enemy->client->ps.states &= ~isBurning;
 	}
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( self, level.time + FRAMETIME );
 }
 static void Think_NormalMissileRidePlayer( gentity_t *self ){
 	vec3_t fwd;
@@ -1293,7 +1567,7 @@ static void Think_NormalMissileRidePlayer( gentity_t *self ){
 		self->enemy->client->ps.states &= ~isRiding;
 		//self->enemy->client->ps.states |= canRideEscape;
 	}
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( self, level.time + FRAMETIME );
 }
 /* 
 ============
@@ -1349,7 +1623,7 @@ void G_ImpactUserWeapon(gentity_t *self,trace_t *trace){
 				self->enemy = other;
 				self->enemy->client->ps.timers[tmStruggleBlock] = 0;
 				self->think = Think_NormalMissileStrugglePlayer;
-				self->nextthink = level.time;
+				G_SetNextThink( self, level.time );
 				if(!other->client->ps.lockedTarget){
 					other->client->ps.lockedTarget = self->s.number;
 					other->client->ps.lockedPosition = &self->r.currentOrigin;
@@ -1369,7 +1643,7 @@ void G_ImpactUserWeapon(gentity_t *self,trace_t *trace){
 				/*self->enemy = other;
 				self->enemy->client->ps.timers[tmBurning] = 0;
 				self->think = Think_NormalMissileBurnPlayer;
-				self->nextthink = level.time;
+				G_SetNextThink( self, level.time );
 				return;*/
 			}
 		}
@@ -1377,7 +1651,7 @@ void G_ImpactUserWeapon(gentity_t *self,trace_t *trace){
 			/*self->enemy = other;
 			self->enemy->client->ps.timers[tmRiding] = 0;
 			self->think = Think_NormalMissileRidePlayer;
-			self->nextthink = level.time;
+			G_SetNextThink( self, level.time );
 			return;*/
 		}
 	}
@@ -1414,16 +1688,16 @@ void G_ImpactUserWeapon(gentity_t *self,trace_t *trace){
 	}
 	else if(self->s.eType == ET_BEAMHEAD){
 		if(other->s.eType == ET_BEAMHEAD){
-			if(!(self->client->ps.bitFlags & isStruggling)){
+			if(!(GetMissileOwnerEntity(self)->client->ps.bitFlags & isStruggling)){
 				G_AddEvent(self,EV_POWER_STRUGGLE_START, DirToByte( trace->plane.normal));
 				other->enemy = self;
 				self->s.dashDir[2] = 1.0f;
 				self->think = Think_NormalMissileStruggle;
-				self->nextthink = level.time;
+				G_SetNextThink( self, level.time );
 				self->enemy = other;
 				self->enemy->s.dashDir[2] = 1.0f;
 				self->enemy->think = Think_NormalMissileStruggle;
-				self->enemy->nextthink = level.time;
+				G_SetNextThink( self->enemy, level.time );
 				if(self->s.eFlags & EF_GUIDED){self->s.eFlags &= ~EF_GUIDED;}
 				if(other->s.eFlags & EF_GUIDED){other->s.eFlags &= ~EF_GUIDED;}
 			}
@@ -1520,12 +1794,393 @@ void G_RunUserExplosion(gentity_t *ent) {
 		radius = step * ent->splashRadius;
 		power = (ent->powerLevelCurrent * (100.0/(float)ent->splashDuration));
 		//G_Printf("Explosion power : %i\n",power);
-		G_UserRadiusDamage(ent->r.currentOrigin,GetMissileOwnerEntity(ent),ent,power,radius,ent->extraKnockback);
+		G_QueueRadiusDamage(ent->r.currentOrigin,GetMissileOwnerEntity(ent),ent,power,radius,ent->extraKnockback);
 	}
 	if(level.time >= ent->splashEnd || ent->powerLevelCurrent <= 0){
 		ent->freeAfterEvent = qtrue;
 	}
 }
+/*
+   -----------------------------------------
+     S I M U L A T I O N   L O D
+   -----------------------------------------
+   A missile flying a straight course with no player near it doesn't need
+   its movement traced or its think run every frame. In between full
+   updates its origin is only moved along its trajectory and relinked.
+   The next full update traces everything it covered since the last one,
+   so it can't pass through anything, and Think_NormalMissile makes up for
+   the time it missed. It runs every frame again as soon as a player is
+   within g_missileLodNear of it, or its course changes.
+*/
+static float G_NearestPlayerDistance( vec3_t origin ) {
+	gentity_t	*ent;
+	float		dist, nearest;
+	int			i;
+
+	nearest = -1;
+	for (i=0, ent=g_entities ; i<level.maxclients ; i++, ent++) {
+		if (!ent->inuse || ent->client->pers.connected != CON_CONNECTED) {continue;}
+		if (ent->client->sess.sessionTeam == TEAM_SPECTATOR) {continue;}
+		dist = Distance(origin, ent->r.currentOrigin);
+		if (nearest < 0 || dist < nearest) {nearest = dist;}
+	}
+	return nearest;
+}
+
+/*
+================
+G_MissileLodMsec
+
+How long the missile can go between full updates, 0 for every frame.
+It grows from nothing at g_missileLodNear from the nearest player to
+g_missileLodMsec at g_missileLodFar, but never lets the missile get
+within g_missileLodNear of where that player is now before the next one.
+================
+*/
+static int G_MissileLodMsec( gentity_t *ent, vec3_t origin ) {
+	float	nearDist, farDist;
+	float	dist, speed;
+	int		msec;
+
+	if (!g_missileLod.integer || g_missileLodMsec.integer <= 0) {return 0;}
+	if (ent->s.eType != ET_MISSILE || ent->s.pos.trType != TR_LINEAR) {return 0;}
+	if (ent->think != Think_NormalMissile || !ent->count) {return 0;}
+
+	nearDist = g_missileLodNear.value;
+	farDist = g_missileLodFar.value;
+	dist = G_NearestPlayerDistance(origin);
+	if (dist < 0) {
+		dist = farDist;
+	}
+	if (dist <= nearDist) {return 0;}
+	if (farDist <= nearDist || dist >= farDist) {
+		msec = g_missileLodMsec.integer;
+	} else {
+		msec = g_missileLodMsec.integer * (dist - nearDist) / (farDist - nearDist);
+	}
+	speed = VectorLength(ent->s.pos.trDelta);
+	if (speed > 0 && msec > (dist - nearDist) * 1000 / speed) {
+		msec = (dist - nearDist) * 1000 / speed;
+	}
+	return msec;
+}
+
+/*
+================
+G_MissileSweepStart
+
+Where the movement trace starts: where the last full update left the
+missile, if it is still on the course it had then.
+================
+*/
+static float *G_MissileSweepStart( gentity_t *ent ) {
+	if (ent->lodNextUpdate && ent->lodTrTime == ent->s.pos.trTime && ent->s.pos.trType == TR_LINEAR) {
+		return ent->lodOrigin;
+	}
+	return ent->r.currentOrigin;
+}
+
+static qboolean G_SkipMissileUpdate( gentity_t *ent, vec3_t origin ) {
+	if (G_MissileSweepStart(ent) != ent->lodOrigin) {return qfalse;}
+	if (level.time >= ent->lodNextUpdate) {return qfalse;}
+	return G_MissileLodMsec(ent, origin) != 0;
+}
+
+static void G_ScheduleMissileUpdate( gentity_t *ent ) {
+	int msec;
+
+	msec = G_MissileLodMsec(ent, ent->r.currentOrigin);
+	if (!msec) {
+		ent->lodNextUpdate = 0;
+		return;
+	}
+	ent->lodNextUpdate = level.time + msec;
+	ent->lodTrTime = ent->s.pos.trTime;
+	VectorCopy(ent->r.currentOrigin, ent->lodOrigin);
+}
+
+/*
+   -----------------------------------------
+     M I S S I L E   C O N T A C T S
+   -----------------------------------------
+   Two missiles closing on each other fast enough can pass straight
+   through one another, since each traces its move against where the
+   other stood at that moment. Before anything moves, every missile and
+   beam head's move for the frame is swept against every other one it
+   could hit: sweep and prune along x over the boxes covering each move,
+   then a moving box test for the pairs those boxes overlap on. The
+   contacts found are settled through G_ImpactUserWeapon in the order
+   they happen, just as if a trace had hit.
+*/
+#define	MAX_MISSILE_CONTACTS	256
+
+typedef struct {
+	gentity_t	*ent;
+	vec3_t		start;
+	vec3_t		move;			// over the whole frame
+	vec3_t		absmin, absmax;	// of the whole move
+	int			trTime;			// to tell if something changed its course
+	trType_t	trType;
+} missileProxy_t;
+
+typedef struct {
+	missileProxy_t	*self;
+	missileProxy_t	*other;
+	float			fraction;
+} missileContact_t;
+
+static missileProxy_t	missileProxies[MAX_GENTITIES];
+static missileProxy_t	*sortedProxies[MAX_GENTITIES];
+static missileContact_t	missileContacts[MAX_MISSILE_CONTACTS];
+
+static int QDECL G_CompareProxies( const void *a, const void *b ) {
+	float diff;
+
+	diff = (*(missileProxy_t **)a)->absmin[0] - (*(missileProxy_t **)b)->absmin[0];
+	return diff < 0 ? -1 : diff > 0;
+}
+
+static int QDECL G_CompareContacts( const void *a, const void *b ) {
+	float diff;
+
+	diff = ((missileContact_t *)a)->fraction - ((missileContact_t *)b)->fraction;
+	return diff < 0 ? -1 : diff > 0;
+}
+
+static qboolean G_MissileCanCollide( gentity_t *ent ) {
+	if (!ent->inuse || ent->freeAfterEvent || !ent->r.linked) {return qfalse;}
+	return ent->s.eType == ET_MISSILE || ent->s.eType == ET_BEAMHEAD;
+}
+
+/*
+================
+G_MissileContactFraction
+
+When in the frame the two moving boxes first touch, or -1 if they don't.
+================
+*/
+static float G_MissileContactFraction( missileProxy_t *a, missileProxy_t *b ) {
+	float	enter, leave;
+	float	offset, move, lo, hi, t0, t1;
+	int		i;
+
+	enter = 0;
+	leave = 1;
+	for (i=0 ; i<3 ; i++) {
+		// where a is relative to b, and the range that keeps them touching
+		offset = a->start[i] - b->start[i];
+		move = a->move[i] - b->move[i];
+		lo = b->ent->r.mins[i] - a->ent->r.maxs[i];
+		hi = b->ent->r.maxs[i] - a->ent->r.mins[i];
+		if (move == 0) {
+			if (offset < lo || offset > hi) {return -1;}
+			continue;
+		}
+		t0 = (lo - offset) / move;
+		t1 = (hi - offset) / move;
+		if (t0 > t1) {
+			float t = t0;
+			t0 = t1;
+			t1 = t;
+		}
+		if (t0 > enter) {enter = t0;}
+		if (t1 < leave) {leave = t1;}
+		if (enter > leave) {return -1;}
+	}
+	return enter;
+}
+
+static void G_AddMissileContact( int *numContacts, missileProxy_t *a, missileProxy_t *b ) {
+	missileContact_t	*contact;
+	missileProxy_t		*swap;
+	float				fraction;
+
+	// the same pairs a trace would have let through
+	if (a->ent->r.ownerNum == b->ent->r.ownerNum) {return;}
+	if (!(a->ent->clipmask & b->ent->r.contents)) {
+		if (!(b->ent->clipmask & a->ent->r.contents)) {return;}
+		swap = a;
+		a = b;
+		b = swap;
+	}
+	else if ((b->ent->clipmask & a->ent->r.contents) && b->ent->s.number < a->ent->s.number) {
+		// both could hit, the one that moves first does
+		swap = a;
+		a = b;
+		b = swap;
+	}
+	if (*numContacts == MAX_MISSILE_CONTACTS) {return;}
+	fraction = G_MissileContactFraction(a, b);
+	if (fraction < 0) {return;}
+	contact = &missileContacts[(*numContacts)++];
+	contact->self = a;
+	contact->other = b;
+	contact->fraction = fraction;
+}
+
+static qboolean G_ProxyUnchanged( missileProxy_t *proxy ) {
+	return G_MissileCanCollide(proxy->ent) && proxy->ent->s.pos.trTime == proxy->trTime &&
+		proxy->ent->s.pos.trType == proxy->trType;
+}
+
+/*
+================
+G_CollideUserMissiles
+================
+*/
+void G_CollideUserMissiles( void ) {
+	missileProxy_t		*proxy, *other;
+	missileContact_t	*contact;
+	gentity_t			*ent;
+	trace_t				trace;
+	vec3_t				end;
+	int					numProxies, numContacts;
+	int					i, j, k;
+
+	numProxies = 0;
+	ent = &g_entities[0];
+	for (i=0 ; i<level.num_entities ; i++, ent++) {
+		if (!G_MissileCanCollide(ent)) {continue;}
+		proxy = &missileProxies[numProxies];
+		proxy->ent = ent;
+		proxy->trTime = ent->s.pos.trTime;
+		proxy->trType = ent->s.pos.trType;
+		VectorCopy(ent->r.currentOrigin, proxy->start);
+		BG_EvaluateTrajectory(&ent->s, &ent->s.pos, level.time, end);
+		VectorSubtract(end, proxy->start, proxy->move);
+		for (k=0 ; k<3 ; k++) {
+			proxy->absmin[k] = (end[k] < proxy->start[k] ? end[k] : proxy->start[k]) + ent->r.mins[k];
+			proxy->absmax[k] = (end[k] > proxy->start[k] ? end[k] : proxy->start[k]) + ent->r.maxs[k];
+		}
+		sortedProxies[numProxies++] = proxy;
+	}
+	if (numProxies < 2) {return;}
+
+	qsort(sortedProxies, numProxies, sizeof(sortedProxies[0]), G_CompareProxies);
+	numContacts = 0;
+	for (i=0 ; i<numProxies ; i++) {
+		proxy = sortedProxies[i];
+		for (j=i+1 ; j<numProxies ; j++) {
+			other = sortedProxies[j];
+			if (other->absmin[0] > proxy->absmax[0]) {break;}
+			if (other->absmin[1] > proxy->absmax[1] || other->absmax[1] < proxy->absmin[1]) {continue;}
+			if (other->absmin[2] > proxy->absmax[2] || other->absmax[2] < proxy->absmin[2]) {continue;}
+			G_AddMissileContact(&numContacts, proxy, other);
+		}
+	}
+	if (!numContacts) {return;}
+
+	qsort(missileContacts, numContacts, sizeof(missileContacts[0]), G_CompareContacts);
+	for (i=0, contact=missileContacts ; i<numContacts ; i++, contact++) {
+		// an earlier contact already dealt with one of them
+		if (!G_ProxyUnchanged(contact->self) || !G_ProxyUnchanged(contact->other)) {continue;}
+
+		memset(&trace, 0, sizeof(trace));
+		trace.fraction = contact->fraction;
+		trace.entityNum = contact->other->ent->s.number;
+		VectorMA(contact->self->start, contact->fraction, contact->self->move, trace.endpos);
+		VectorMA(contact->other->start, contact->fraction, contact->other->move, end);
+		VectorSubtract(trace.endpos, end, trace.plane.normal);
+		if (VectorNormalize(trace.plane.normal) == 0) {
+			VectorNormalize2(contact->self->move, trace.plane.normal);
+			VectorInverse(trace.plane.normal);
+		}
+
+		G_ImpactUserWeapon(contact->self->ent, &trace);
+
+		// absorbed attacks must not be run into again by the traces this frame
+		if (contact->self->ent->freeAfterEvent) {trap_UnlinkEntity(contact->self->ent);}
+		if (contact->other->ent->freeAfterEvent) {trap_UnlinkEntity(contact->other->ent);}
+	}
+}
+
+/*
+   -----------------------------------------
+     B A T C H E D   M I S S I L E   T R A C E S
+   -----------------------------------------
+   Every missile's movement trace, and every unguided beam's owner to head
+   trace, goes to the server in one trap_TraceBatch before the entities
+   run. A missile uses its result only if nothing earlier in the frame
+   moved it, changed its course or removed what it hit; otherwise it
+   traces again as usual. Missiles therefore see each other where they
+   stood at the start of the frame.
+*/
+typedef enum {
+	SWEEP_MOVE,
+	SWEEP_BEAM,
+	NUM_SWEEPS
+} missileSweep_t;
+
+static batchTrace_t	missileSweeps[MAX_GENTITIES];
+static int			numMissileSweeps;
+static int			missileSweepFrame[MAX_GENTITIES];
+static int			missileSweepIndex[MAX_GENTITIES][NUM_SWEEPS];
+
+static void G_AddMissileSweep( gentity_t *ent, missileSweep_t type, vec3_t start, vec3_t end, int passEntityNum, int contentmask ) {
+	batchTrace_t *sweep;
+
+	if (numMissileSweeps == MAX_GENTITIES) {return;}
+	sweep = &missileSweeps[numMissileSweeps];
+	VectorCopy(start, sweep->start);
+	VectorCopy(end, sweep->end);
+	VectorCopy(ent->r.mins, sweep->mins);
+	VectorCopy(ent->r.maxs, sweep->maxs);
+	sweep->passEntityNum = passEntityNum;
+	sweep->contentmask = contentmask;
+	missileSweepIndex[ent->s.number][type] = numMissileSweeps++;
+}
+
+static qboolean G_TakeMissileSweep( gentity_t *ent, missileSweep_t type, vec3_t start, vec3_t end, int passEntityNum, int contentmask, trace_t *trace ) {
+	batchTrace_t *sweep;
+	int index;
+	int hit;
+
+	if (missileSweepFrame[ent->s.number] != level.framenum) {return qfalse;}
+	index = missileSweepIndex[ent->s.number][type];
+	if (index < 0) {return qfalse;}
+	missileSweepIndex[ent->s.number][type] = -1;
+	sweep = &missileSweeps[index];
+	if (!VectorCompare(sweep->start, start) || !VectorCompare(sweep->end, end) ||
+		!VectorCompare(sweep->mins, ent->r.mins) || !VectorCompare(sweep->maxs, ent->r.maxs) ||
+		sweep->passEntityNum != passEntityNum || sweep->contentmask != contentmask) {
+		return qfalse;
+	}
+	hit = sweep->trace.entityNum;
+	if (hit != ENTITYNUM_NONE && hit != ENTITYNUM_WORLD && !g_entities[hit].inuse) {return qfalse;}
+	*trace = sweep->trace;
+	return qtrue;
+}
+
+void G_SweepUserMissiles( void ) {
+	gentity_t	*ent;
+	gentity_t	*missileOwner;
+	vec3_t		origin, start;
+	int			i;
+
+	numMissileSweeps = 0;
+	ent = &g_entities[0];
+	for (i=0 ; i<level.num_entities ; i++, ent++) {
+		if (!ent->inuse || ent->freeAfterEvent) {continue;}
+		if (!ent->r.linked && ent->neverFree) {continue;}
+		if ((ent->s.eType != ET_MISSILE) && (ent->s.eType != ET_BEAMHEAD)) {continue;}
+		missileSweepFrame[i] = level.framenum;
+		missileSweepIndex[i][SWEEP_MOVE] = -1;
+		missileSweepIndex[i][SWEEP_BEAM] = -1;
+		BG_EvaluateTrajectory( &ent->s, &ent->s.pos, level.time, origin );
+		if (G_SkipMissileUpdate( ent, origin )) {continue;}
+		G_AddMissileSweep( ent, SWEEP_MOVE, G_MissileSweepStart( ent ), origin, ent->count ? ent->s.number : ent->r.ownerNum, ent->clipmask );
+		if (ent->s.eType == ET_BEAMHEAD && !(ent->s.eFlags & EF_GUIDED)) {
+			missileOwner = GetMissileOwnerEntity(ent);
+			if (!missileOwner->client) {continue;}
+			BG_EvaluateTrajectory( &missileOwner->s, &missileOwner->s.pos, level.time, start );
+			G_AddMissileSweep( ent, SWEEP_BEAM, start, origin, ent->s.number, MASK_SHOT );
+		}
+	}
+	if (numMissileSweeps) {
+		trap_TraceBatch( missileSweeps, numMissileSweeps );
+	}
+}
+
 void G_RunUserMissile( gentity_t *ent ) {
 	vec3_t		origin;
 	trace_t		trace;
@@ -1537,7 +2192,13 @@ void G_RunUserMissile( gentity_t *ent ) {
 	trace_t		trace2;
 	gentity_t	*traceEnt2;
 	gentity_t	*missileOwner = GetMissileOwnerEntity(ent);
+	float		*sweepStart;
 	BG_EvaluateTrajectory( &ent->s, &ent->s.pos, level.time, origin );
+	if (G_SkipMissileUpdate( ent, origin )) {
+		VectorCopy( origin, ent->r.currentOrigin );
+		trap_LinkEntity( ent );
+		return;
+	}
 	if (ent->count) {
 		pass_ent = ent->s.number;
 	}
@@ -1545,12 +2206,17 @@ void G_RunUserMissile( gentity_t *ent ) {
 		pass_ent = ent->r.ownerNum;
 	}
 	// trace a line from the previous position to the current position
-	trap_Trace( &trace, ent->r.currentOrigin, ent->r.mins, ent->r.maxs, origin, pass_ent, ent->clipmask );
+	sweepStart = G_MissileSweepStart( ent );
+	if (!G_TakeMissileSweep( ent, SWEEP_MOVE, sweepStart, origin, pass_ent, ent->clipmask, &trace )) {
+		trap_Trace( &trace, sweepStart, ent->r.mins, ent->r.maxs, origin, pass_ent, ent->clipmask );
+	}
+	ent->lodNextUpdate = 0;
 
 	if ( trace.startsolid || trace.allsolid ) {
 		// make sure the trace.entityNum is set to the entity we're stuck in
-		trap_Trace(&trace, ent->r.currentOrigin, ent->r.mins, ent->r.maxs, ent->r.currentOrigin, pass_ent, ent->clipmask );
+		trap_Trace(&trace, sweepStart, ent->r.mins, ent->r.maxs, sweepStart, pass_ent, ent->clipmask );
 		trace.fraction = 0;
+		VectorCopy( sweepStart, ent->r.currentOrigin );
 	}
 	else {
 		VectorCopy( trace.endpos, ent->r.currentOrigin );
@@ -1588,7 +2254,9 @@ void G_RunUserMissile( gentity_t *ent ) {
 		BG_EvaluateTrajectory( &missileOwner->s, &missileOwner->s.pos, level.time, start );
 		BG_EvaluateTrajectory( &ent->s, &ent->s.pos, level.time, end );
 		// Trace between the two positions
-		trap_Trace (&trace2, start, ent->r.mins, ent->r.maxs, end, ent->s.number, MASK_SHOT);
+		if (!G_TakeMissileSweep( ent, SWEEP_BEAM, start, end, ent->s.number, MASK_SHOT, &trace2 )) {
+			trap_Trace (&trace2, start, ent->r.mins, ent->r.maxs, end, ent->s.number, MASK_SHOT);
+		}
 		traceEnt2 = &g_entities[ trace2.entityNum ];
 		// Snap the endpos to integers, but nudged towards the line
 		SnapVectorTowards( trace2.endpos, muzzle );
@@ -1606,4 +2274,8 @@ void G_RunUserMissile( gentity_t *ent ) {
 
 	// check think function after bouncing
 	G_RunThink( ent );
+
+	if (ent->inuse && ent->s.eType == ET_MISSILE) {
+		G_ScheduleMissileUpdate( ent );
+	}
 }
@@ -35,6 +35,8 @@ if "%1"=="TA" goto TA
 @if errorlevel 1 goto quit
 %cc%  ../g_mover.c
 @if errorlevel 1 goto quit
+%cc%  ../g_pmovebench.c
+@if errorlevel 1 goto quit
 %cc%  ../g_session.c
 @if errorlevel 1 goto quit
 %cc%  ../g_spawn.c
@@ -45,6 +47,8 @@ if "%1"=="TA" goto TA
 @if errorlevel 1 goto quit
 %cc%  ../g_team.c
 @if errorlevel 1 goto quit
+%cc%  ../g_think.c
+@if errorlevel 1 goto quit
 %cc%  ../g_trigger.c
 @if errorlevel 1 goto quit
 %cc%  ../g_utils.c
@@ -215,6 +215,7 @@ static	int			fs_loadStack;			// total files in memory
 static	int			fs_packFiles = 0;		// total number of files in packs
 
 static int fs_checksumFeed;
+static int fs_restartCount;
 
 typedef union qfile_gus {
 	FILE*		o;
@@ -282,6 +283,19 @@ qboolean FS_Initialized( void ) {
 	return (fs_searchPaths != NULL);
 }
 
+/*
+==============
+FS_RestartCount
+
+Changes every time FS_Shutdown closes the open file handles, so a handle
+kept across frames can tell it was closed under it
+==============
+*/
+
+int FS_RestartCount( void ) {
+	return fs_restartCount;
+}
+
 /*
 =================
 FS_PakIsPure
@@ -1723,6 +1737,71 @@ int	FS_FileIsInPAK(const char *filename, int *pChecksum ) {
 	return -1;
 }
 
+/*
+============
+FS_FileStamp
+
+Identifies the copy of a file FS_ReadFile would load without reading it:
+the checksum of the pak holding it, or the modification time of a loose
+file, along with its size.  Returns qfalse if the file isn't found.
+============
+*/
+qboolean FS_FileStamp( const char *filename, int *stamp, int *size ) {
+	searchPath_t	*search;
+	fileInPack_t	*pakFile;
+	char			*netpath;
+	FILE			*filep;
+	long			hash;
+
+	if ( !fs_searchPaths ) {
+		Com_Error( ERR_FATAL, "Filesystem call made without initialization" );
+	}
+
+	// qpaths are not supposed to have a leading slash
+	if ( filename[0] == '/' || filename[0] == '\\' ) {
+		filename++;
+	}
+
+	if ( strstr( filename, ".." ) || strstr( filename, "::" ) ) {
+		return qfalse;
+	}
+
+	for ( search = fs_searchPaths ; search ; search = search->next ) {
+		if ( search->pack ) {
+			// disregard if it doesn't match one of the allowed pure pak files
+			if ( !FS_PakIsPure( search->pack ) ) {
+				continue;
+			}
+
+			hash = FS_HashFileName( filename, search->pack->hashSize );
+			for ( pakFile = search->pack->hashTable[hash]; pakFile; pakFile = pakFile->next ) {
+				// case and separator insensitive comparisons
+				if ( !FS_FilenameCompare( pakFile->name, filename ) ) {
+					*stamp = search->pack->checksum;
+					*size = pakFile->len;
+					return qtrue;
+				}
+			}
+		} else if ( search->dir ) {
+			// pure servers only take scripts from paks
+			if ( fs_numServerPaks ) {
+				continue;
+			}
+
+			netpath = FS_BuildOSPath( search->dir->path, search->dir->dir, filename );
+			filep = Sys_FOpen( netpath, "rb" );
+			if ( filep ) {
+				*size = FS_fplength( filep );
+				fclose( filep );
+				*stamp = Sys_FileTime( netpath );
+				return qtrue;
+			}
+		}
+	}
+
+	return qfalse;
+}
+
 /*
 ============
 FS_ReadFileDir
@@ -3101,6 +3180,7 @@ void FS_Shutdown( qboolean closemfp ) {
 			FS_FCloseFile(i);
 		}
 	}
+	fs_restartCount++;
 
 	// free everything
 	for(p = fs_searchPaths; p; p = next)
@@ -340,6 +340,128 @@ void Huff_offsetTransmit (huff_t *huff, int ch, byte *fout, int *offset, int max
 	*offset = bloc;
 }
 
+/* Build the encode and decode tables for a tree that won't be updated anymore */
+void Huff_BuildTable(huffTable_t *table, const huff_t *huff) {
+	const node_t *node;
+	int i, j, len;
+	uint64_t code;
+
+	Com_Memset(table, 0, sizeof(*table));
+
+	for (i = 0; i <= HMAX; i++) {
+		node = huff->loc[i];
+		if (!node) {
+			continue;
+		}
+		code = 0;
+		len = 0;
+		/* walk up to the root, the bit nearest the root is sent first */
+		for ( ; node->parent; node = node->parent) {
+			code = (code << 1) | (node->parent->right == node);
+			len++;
+		}
+		if (len > HUFF_MAX_CODE_BITS) {
+			Com_Error(ERR_FATAL, "Huff_BuildTable: code for %i is %i bits", i, len);
+		}
+		table->code[i] = code;
+		table->codeLength[i] = len;
+	}
+
+	for (i = 0; i < (1<<HUFF_LOOKUP_BITS); i++) {
+		node = huff->tree;
+		for (j = 0; j < HUFF_LOOKUP_BITS && node && node->symbol == INTERNAL_NODE; j++) {
+			node = ((i >> j) & 1) ? node->right : node->left;
+		}
+		if (!node) {
+			table->lookup[i].symbol = -1;
+		} else if (node->symbol == INTERNAL_NODE) {
+			table->lookup[i].node = (node_t *)node;
+			table->lookup[i].bits = HUFF_LOOKUP_BITS;
+		} else {
+			table->lookup[i].symbol = node->symbol;
+			table->lookup[i].bits = j;
+		}
+	}
+}
+
+/* Get a symbol, resolving up to HUFF_LOOKUP_BITS at once */
+void Huff_tableReceive(const huffTable_t *table, int *ch, const byte *fin, int *offset, int maxoffset) {
+	const huffLookup_t *entry;
+	const node_t *node;
+	uint32_t window;
+	int i, first, last;
+
+	bloc = *offset;
+	first = bloc >> 3;
+	last = (maxoffset + 7) >> 3;
+	window = 0;
+	for (i = 0; i < 3 && first + i < last; i++) {
+		window |= (uint32_t)fin[first + i] << (i << 3);
+	}
+	entry = &table->lookup[(window >> (bloc & 7)) & ((1<<HUFF_LOOKUP_BITS) - 1)];
+
+	if (bloc + entry->bits > maxoffset) {
+		*ch = 0;
+		*offset = maxoffset + 1;
+		return;
+	}
+	bloc += entry->bits;
+
+	if (!entry->node) {
+		*ch = entry->symbol < 0 ? 0 : entry->symbol;
+		*offset = bloc;
+		return;
+	}
+
+	/* longer than the lookup, finish the walk a bit at a time */
+	node = entry->node;
+	while (node && node->symbol == INTERNAL_NODE) {
+		if (bloc >= maxoffset) {
+			*ch = 0;
+			*offset = maxoffset + 1;
+			return;
+		}
+		if (get_bit((byte *)fin)) {
+			node = node->right;
+		} else {
+			node = node->left;
+		}
+	}
+	if (!node) {
+		*ch = 0;
+		return;
+	}
+	*ch = node->symbol;
+	*offset = bloc;
+}
+
+/* Send a symbol with its precomputed code word */
+void Huff_tableTransmit(const huffTable_t *table, int ch, byte *fout, int *offset, int maxoffset) {
+	uint64_t acc;
+	int i, len, shift, bytes;
+
+	bloc = *offset;
+	len = table->codeLength[ch];
+	if (bloc + len > maxoffset) {
+		bloc = *offset = maxoffset + 1;
+		return;
+	}
+
+	/* merge with the bits already in the current byte, then store whole bytes */
+	shift = bloc & 7;
+	acc = table->code[ch] << shift;
+	if (shift) {
+		acc |= fout[bloc >> 3] & ((1 << shift) - 1);
+	}
+	bytes = (shift + len + 7) >> 3;
+	for (i = 0; i < bytes; i++) {
+		fout[(bloc >> 3) + i] = (byte)(acc >> (i << 3));
+	}
+
+	bloc += len;
+	*offset = bloc;
+}
+
 void Huff_Decompress(msg_t *mbuf, int offset) {
 	int			ch, cch, i, j, size;
 	byte		seq[65536];
@@ -21,8 +21,10 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 */
 #include "q_shared.h"
 #include "qcommon.h"
+#include "../Game/Game/bg_public.h"
 
 static huffman_t		msgHuff;
+static huffTable_t		msgHuffTable;
 
 static qboolean			msgInit = qfalse;
 
@@ -159,7 +161,7 @@ void MSG_WriteBits( msg_t *msg, int value, int bits ) {
 		}
 		if ( bits ) {
 			for( i = 0; i < bits; i += 8 ) {
-				Huff_offsetTransmit( &msgHuff.compressor, (value & 0xff), msg->data, &msg->bit, msg->maxsize << 3 );
+				Huff_tableTransmit( &msgHuffTable, (value & 0xff), msg->data, &msg->bit, msg->maxsize << 3 );
 				value = (value >> 8);
 
 				if ( msg->bit > msg->maxsize << 3 ) {
@@ -237,7 +239,7 @@ int MSG_ReadBits( msg_t *msg, int bits ) {
 		if (bits) {
 //			fp = fopen("c:\\netchan.bin", "a");
 			for(i=0;i<bits;i+=8) {
-				Huff_offsetReceive (msgHuff.decompressor.tree, &get, msg->data, &msg->bit, msg->cursize<<3);
+				Huff_tableReceive (&msgHuffTable, &get, msg->data, &msg->bit, msg->cursize<<3);
 //				fwrite(&get, 1, 1, fp);
 				value |= (get<<(i+nbits));
 
@@ -847,9 +849,15 @@ void MSG_ReportChangeVectors_f( void ) {
 typedef struct {
 	char	*name;
 	int		offset;
-	int		bits;		// 0 = float
+	int		bits;		// 0 = float, < 0 = fixed point float
 } netField_t;
 
+// a float sent as a signed fixed point value of width bits, frac of them
+// after the point
+#define	FIXED(width,frac)	( -( ( (width) << 8 ) | (frac) ) )
+#define	FIXED_WIDTH(bits)	( -(bits) >> 8 )
+#define	FIXED_FRAC(bits)	( -(bits) & 255 )
+
 // using the stringizing operator to save typing...
 #define	NETF(x) #x,(size_t)&((entityState_t*)0)->x
 
@@ -928,12 +936,139 @@ netField_t	entityStateFields[] =
 { NETF(frame), 16 }
 };
 
+// missiles and beam heads move, turn and change power level every frame;
+// their positions, velocities and angles are sent as fixed point
+netField_t	missileStateFields[] = 
+{
+{ NETF(pos.trTime), 32 },
+{ NETF(pos.trBase[0]), FIXED( 24, 3 ) },
+{ NETF(pos.trBase[1]), FIXED( 24, 3 ) },
+{ NETF(pos.trBase[2]), FIXED( 24, 3 ) },
+{ NETF(pos.trDelta[0]), FIXED( 20, 0 ) },
+{ NETF(pos.trDelta[1]), FIXED( 20, 0 ) },
+{ NETF(pos.trDelta[2]), FIXED( 20, 0 ) },
+{ NETF(dashDir[1]), FIXED( 24, 0 ) },
+{ NETF(angles[0]), FIXED( 16, 4 ) },
+{ NETF(angles[1]), FIXED( 16, 4 ) },
+{ NETF(angles[2]), FIXED( 16, 4 ) },
+{ NETF(dashDir[0]), FIXED( 24, 0 ) },
+{ NETF(dashDir[2]), FIXED( 8, 0 ) },
+{ NETF(apos.trBase[1]), 0 },
+{ NETF(apos.trBase[0]), 0 },
+{ NETF(charge1.chTime), 32 },
+{ NETF(charge1.chBase), 32 },
+{ NETF(charge1.chDelta), 16 },
+{ NETF(charge2.chTime), 32 },
+{ NETF(charge2.chBase), 32 },
+{ NETF(charge2.chDelta), 16 },
+{ NETF(event), 10 },
+{ NETF(angles2[1]), 0 },
+{ NETF(eType), 8 },
+{ NETF(torsoAnim), 8 },
+{ NETF(eventParm), 8 },
+{ NETF(legsAnim), 8 },
+{ NETF(groundEntityNum), GENTITYNUM_BITS },
+{ NETF(pos.trType), 8 },
+{ NETF(eFlags), 19 },
+{ NETF(otherEntityNum), GENTITYNUM_BITS },
+{ NETF(weapon), 8 },
+{ NETF(weaponstate), 4 },
+{ NETF(tier), 4 },
+{ NETF(attackPowerTotal), 16 },
+{ NETF(attackPowerCurrent), 16 },
+{ NETF(clientNum), 8 },
+{ NETF(pos.trDuration), 32 },
+{ NETF(apos.trType), 8 },
+{ NETF(origin[0]), 0 },
+{ NETF(origin[1]), 0 },
+{ NETF(origin[2]), 0 },
+{ NETF(solid), 24 },
+{ NETF(powerups), MAX_POWERUPS },
+{ NETF(playerBitFlags), 32 },
+{ NETF(modelindex), 8 },
+{ NETF(otherEntityNum2), GENTITYNUM_BITS },
+{ NETF(loopSound), 8 },
+{ NETF(generic1), 8 },
+{ NETF(origin2[2]), 0 },
+{ NETF(origin2[0]), 0 },
+{ NETF(origin2[1]), 0 },
+{ NETF(modelindex2), 8 },
+{ NETF(time), 32 },
+{ NETF(apos.trTime), 32 },
+{ NETF(apos.trDuration), 32 },
+{ NETF(apos.trBase[2]), 0 },
+{ NETF(apos.trDelta[0]), 0 },
+{ NETF(apos.trDelta[1]), 0 },
+{ NETF(apos.trDelta[2]), 0 },
+{ NETF(time2), 32 },
+{ NETF(angles2[0]), 0 },
+{ NETF(angles2[2]), 0 },
+{ NETF(constantLight), 32 },
+{ NETF(frame), 16 }
+};
+
 
 // if (int)f == f and (int)f + ( 1<<(FLOAT_INT_BITS-1) ) < ( 1 << FLOAT_INT_BITS )
 // the float will be sent with FLOAT_INT_BITS, otherwise all 32 bits will be sent
 #define	FLOAT_INT_BITS	13
 #define	FLOAT_INT_BIAS	(1<<(FLOAT_INT_BITS-1))
 
+/*
+==================
+MSG_EntityStateFields
+
+The field list is picked by the state being deltaed from, which
+both ends already have.
+==================
+*/
+static netField_t *MSG_EntityStateFields( entityState_t *from, int *numFields ) {
+	if ( from->eType == ET_MISSILE || from->eType == ET_BEAMHEAD ) {
+		*numFields = ARRAY_LEN( missileStateFields );
+		return missileStateFields;
+	}
+	*numFields = ARRAY_LEN( entityStateFields );
+	return entityStateFields;
+}
+
+/*
+==================
+MSG_WriteFixedFloat
+
+Sends a non zero float as a signed fixed point value, rounded to the
+nearest step the field's FIXED() allows, or as all 32 bits
+if it doesn't fit.  Rounding a value that was already read back gives
+the same value, so demos can send it on again unchanged.
+==================
+*/
+static void MSG_WriteFixedFloat( msg_t *msg, netField_t *field, int *toF ) {
+	double	scaled;
+	int		width, limit;
+
+	width = FIXED_WIDTH( field->bits );
+	scaled = (double)*(float *)toF * ( 1 << FIXED_FRAC( field->bits ) );
+	limit = 1 << ( width - 1 );
+	if ( scaled > -limit && scaled < limit - 1 ) {
+		MSG_WriteBits( msg, 0, 1 );
+		MSG_WriteBits( msg, (int)floor( scaled + 0.5 ), -width );
+	} else {
+		MSG_WriteBits( msg, 1, 1 );
+		MSG_WriteBits( msg, *toF, 32 );
+	}
+}
+
+/*
+==================
+MSG_ReadFixedFloat
+==================
+*/
+static void MSG_ReadFixedFloat( msg_t *msg, netField_t *field, int *toF ) {
+	if ( MSG_ReadBits( msg, 1 ) == 0 ) {
+		*(float *)toF = (float)MSG_ReadBits( msg, -FIXED_WIDTH( field->bits ) ) / ( 1 << FIXED_FRAC( field->bits ) );
+	} else {
+		*toF = MSG_ReadBits( msg, 32 );
+	}
+}
+
 /*
 ==================
 MSG_WriteDeltaEntity
@@ -949,19 +1084,11 @@ void MSG_WriteDeltaEntity( msg_t *msg, struct entityState_s *from, struct entity
 						   qboolean force ) {
 	int			i, lc;
 	int			numFields;
-	netField_t	*field;
+	netField_t	*fields, *field;
 	int			trunc;
 	float		fullFloat;
 	int			*fromF, *toF;
 
-	numFields = ARRAY_LEN( entityStateFields );
-
-	// all fields should be 32 bits to avoid any compiler packing issues
-	// the "number" field is not part of the field list
-	// if this assert fails, someone added a field to the entityState_t
-	// struct without updating the message fields
-	assert( numFields + 1 == sizeof( *from )/4 );
-
 	// a NULL to is a delta remove message
 	if ( to == NULL ) {
 		if ( from == NULL ) {
@@ -972,13 +1099,22 @@ void MSG_WriteDeltaEntity( msg_t *msg, struct entityState_s *from, struct entity
 		return;
 	}
 
+	fields = MSG_EntityStateFields( from, &numFields );
+
+	// all fields should be 32 bits to avoid any compiler packing issues
+	// the "number" field is not part of the field list
+	// if this assert fails, someone added a field to the entityState_t
+	// struct without updating the message fields
+	assert( numFields + 1 == sizeof( *from )/4 );
+	assert( ARRAY_LEN( missileStateFields ) == ARRAY_LEN( entityStateFields ) );
+
 	if ( to->number < 0 || to->number >= MAX_GENTITIES ) {
 		Com_Error (ERR_FATAL, "MSG_WriteDeltaEntity: Bad entity number: %i", to->number );
 	}
 
 	lc = 0;
 	// build the change vector as bytes so it is endien independent
-	for ( i = 0, field = entityStateFields ; i < numFields ; i++, field++ ) {
+	for ( i = 0, field = fields ; i < numFields ; i++, field++ ) {
 		fromF = (int *)( (byte *)from + field->offset );
 		toF = (int *)( (byte *)to + field->offset );
 		if ( *fromF != *toF ) {
@@ -1006,7 +1142,7 @@ void MSG_WriteDeltaEntity( msg_t *msg, struct entityState_s *from, struct entity
 
 	oldsize += numFields;
 
-	for ( i = 0, field = entityStateFields ; i < lc ; i++, field++ ) {
+	for ( i = 0, field = fields ; i < lc ; i++, field++ ) {
 		fromF = (int *)( (byte *)from + field->offset );
 		toF = (int *)( (byte *)to + field->offset );
 
@@ -1017,7 +1153,7 @@ void MSG_WriteDeltaEntity( msg_t *msg, struct entityState_s *from, struct entity
 
 		MSG_WriteBits( msg, 1, 1 );	// changed
 
-		if ( field->bits == 0 ) {
+		if ( field->bits <= 0 ) {
 			// float
 			fullFloat = *(float *)toF;
 			trunc = (int)fullFloat;
@@ -1025,6 +1161,9 @@ void MSG_WriteDeltaEntity( msg_t *msg, struct entityState_s *from, struct entity
 			if (fullFloat == 0.0f) {
 					MSG_WriteBits( msg, 0, 1 );
 					oldsize += FLOAT_INT_BITS;
+			} else if ( field->bits < 0 ) {
+				MSG_WriteBits( msg, 1, 1 );
+				MSG_WriteFixedFloat( msg, field, toF );
 			} else {
 				MSG_WriteBits( msg, 1, 1 );
 				if ( trunc == fullFloat && trunc + FLOAT_INT_BIAS >= 0 && 
@@ -1066,7 +1205,7 @@ void MSG_ReadDeltaEntity( msg_t *msg, entityState_t *from, entityState_t *to,
 						 int number) {
 	int			i, lc;
 	int			numFields;
-	netField_t	*field;
+	netField_t	*fields, *field;
 	int			*fromF, *toF;
 	int			print;
 	int			trunc;
@@ -1099,7 +1238,7 @@ void MSG_ReadDeltaEntity( msg_t *msg, entityState_t *from, entityState_t *to,
 		return;
 	}
 
-	numFields = ARRAY_LEN( entityStateFields );
+	fields = MSG_EntityStateFields( from, &numFields );
 	lc = MSG_ReadByte(msg);
 
 	if ( lc > numFields || lc < 0 ) {
@@ -1117,7 +1256,7 @@ void MSG_ReadDeltaEntity( msg_t *msg, entityState_t *from, entityState_t *to,
 
 	to->number = number;
 
-	for ( i = 0, field = entityStateFields ; i < lc ; i++, field++ ) {
+	for ( i = 0, field = fields ; i < lc ; i++, field++ ) {
 		fromF = (int *)( (byte *)from + field->offset );
 		toF = (int *)( (byte *)to + field->offset );
 
@@ -1125,10 +1264,15 @@ void MSG_ReadDeltaEntity( msg_t *msg, entityState_t *from, entityState_t *to,
 			// no change
 			*toF = *fromF;
 		} else {
-			if ( field->bits == 0 ) {
+			if ( field->bits <= 0 ) {
 				// float
 				if ( MSG_ReadBits( msg, 1 ) == 0 ) {
 						*(float *)toF = 0.0f; 
+				} else if ( field->bits < 0 ) {
+					MSG_ReadFixedFloat( msg, field, toF );
+					if ( print ) {
+						Com_Printf( "%s:%f ", field->name, *(float *)toF );
+					}
 				} else {
 					if ( MSG_ReadBits( msg, 1 ) == 0 ) {
 						// integral float
@@ -1161,7 +1305,7 @@ void MSG_ReadDeltaEntity( msg_t *msg, entityState_t *from, entityState_t *to,
 //			pcount[i]++;
 		}
 	}
-	for ( i = lc, field = &entityStateFields[lc] ; i < numFields ; i++, field++ ) {
+	for ( i = lc, field = &fields[lc] ; i < numFields ; i++, field++ ) {
 		fromF = (int *)( (byte *)from + field->offset );
 		toF = (int *)( (byte *)to + field->offset );
 		// no change
@@ -1236,7 +1380,7 @@ netField_t	playerStateFields[] =
 { PSF(clientNum), 8 },
 { PSF(weapon), 5 },
 { PSF(viewangles[2]), 0 },
-{ PSF(jumppad_ent), 10 },
+{ PSF(jumppad_ent), GENTITYNUM_BITS },
 { PSF(loopSound), 16 },
 { PSF(dashDir[0]), 0 },
 { PSF(dashDir[1]), 0 },
@@ -2051,6 +2195,115 @@ void MSG_initHuffman( void ) {
 			Huff_addRef(&msgHuff.decompressor,	(byte)i);			// Do update
 		}
 	}
+	// the tree is static from here on, so every code can be precomputed
+	Huff_BuildTable(&msgHuffTable, &msgHuff.compressor);
+}
+
+/*
+=================
+MSG_HuffBenchmark_f
+
+Decodes and re-encodes every message of a recorded demo with both the
+tree walking and the table driven codecs, checks that they agree
+bit for bit and reports the time spent in each
+=================
+*/
+void MSG_HuffBenchmark_f( void ) {
+	static byte	decoded[MAX_MSGLEN], treeEncoded[MAX_MSGLEN * 2], tableEncoded[MAX_MSGLEN * 2];
+	union {
+		byte	*b;
+		void	*v;
+	} demo;
+	int		demoLen, pos, len, passes, pass;
+	int		i, bit, ch, check, count, start;
+	int		treeDecode, tableDecode, treeEncode, tableEncode;
+	int		numMessages, numBytes, mismatches;
+	byte	*data;
+
+	if ( Cmd_Argc() < 2 ) {
+		Com_Printf( "usage: huffBench <demofile> [passes]\n" );
+		return;
+	}
+	passes = Cmd_Argc() > 2 ? atoi( Cmd_Argv( 2 ) ) : 10;
+	if ( passes < 1 ) {
+		passes = 1;
+	}
+	demoLen = FS_ReadFile( Cmd_Argv( 1 ), &demo.v );
+	if ( demoLen <= 0 ) {
+		Com_Printf( "Couldn't read %s\n", Cmd_Argv( 1 ) );
+		return;
+	}
+	if ( !msgInit ) {
+		MSG_initHuffman();
+	}
+
+	treeDecode = tableDecode = treeEncode = tableEncode = 0;
+	numMessages = numBytes = mismatches = 0;
+	for ( pass = 0 ; pass < passes ; pass++ ) {
+		// each demo message is a sequence number and a length followed by the huffman stream
+		for ( pos = 0 ; pos + 8 <= demoLen ; pos += 8 + len ) {
+			len = LittleLong( *(int *)( demo.b + pos + 4 ) );
+			if ( len <= 0 || len > MAX_MSGLEN || pos + 8 + len > demoLen ) {
+				break;
+			}
+			data = demo.b + pos + 8;
+
+			start = Sys_Milliseconds();
+			count = 0;
+			for ( bit = 0 ; bit < len << 3 && count < MAX_MSGLEN ; ) {
+				Huff_offsetReceive( msgHuff.decompressor.tree, &ch, data, &bit, len << 3 );
+				if ( bit > len << 3 ) {
+					break;
+				}
+				decoded[count++] = ch;
+			}
+			treeDecode += Sys_Milliseconds() - start;
+
+			start = Sys_Milliseconds();
+			check = 0;
+			for ( bit = 0 ; bit < len << 3 && check < MAX_MSGLEN ; ) {
+				Huff_tableReceive( &msgHuffTable, &ch, data, &bit, len << 3 );
+				if ( bit > len << 3 ) {
+					break;
+				}
+				if ( decoded[check++] != ch ) {
+					mismatches++;
+				}
+			}
+			tableDecode += Sys_Milliseconds() - start;
+			if ( check != count ) {
+				mismatches++;
+			}
+
+			start = Sys_Milliseconds();
+			for ( i = 0, bit = 0 ; i < count ; i++ ) {
+				Huff_offsetTransmit( &msgHuff.compressor, decoded[i], treeEncoded, &bit, sizeof( treeEncoded ) << 3 );
+			}
+			treeEncode += Sys_Milliseconds() - start;
+
+			start = Sys_Milliseconds();
+			for ( i = 0, check = 0 ; i < count ; i++ ) {
+				Huff_tableTransmit( &msgHuffTable, decoded[i], tableEncoded, &check, sizeof( tableEncoded ) << 3 );
+			}
+			tableEncode += Sys_Milliseconds() - start;
+			if ( check != bit || memcmp( treeEncoded, tableEncoded, ( bit + 7 ) >> 3 ) ) {
+				mismatches++;
+			}
+
+			if ( !pass ) {
+				numMessages++;
+				numBytes += count;
+			}
+		}
+	}
+	FS_FreeFile( demo.v );
+
+	Com_Printf( "%i messages, %i bytes, %i passes\n", numMessages, numBytes, passes );
+	Com_Printf( "decode: tree %i msec, table %i msec\n", treeDecode, tableDecode );
+	Com_Printf( "encode: tree %i msec, table %i msec\n", treeEncode, tableEncode );
+	if ( mismatches ) {
+		Com_Printf( S_COLOR_RED "%i mismatches between the tree and table codecs\n", mismatches );
+	}
 }
 
 /*
@@ -987,6 +987,59 @@ int Q_CountChar(const char *string, char tocount)
 	return count;
 }
 
+/*
+============
+Q_DecodeUTF8
+
+A byte that does not start a well formed sequence is returned on its own,
+so strings that use the high half of the charset directly still come out
+the way they always have.
+============
+*/
+int Q_DecodeUTF8( const char **string ) {
+	const byte	*s;
+	int			c, min, len, i;
+
+	s = (const byte *)*string;
+	c = s[0];
+	if ( c < 0x80 ) {
+		len = 1;
+		min = 0;
+	} else if ( ( c & 0xe0 ) == 0xc0 ) {
+		len = 2;
+		min = 0x80;
+		c &= 0x1f;
+	} else if ( ( c & 0xf0 ) == 0xe0 ) {
+		len = 3;
+		min = 0x800;
+		c &= 0x0f;
+	} else if ( ( c & 0xf8 ) == 0xf0 ) {
+		len = 4;
+		min = 0x10000;
+		c &= 0x07;
+	} else {
+		*string += 1;
+		return c;
+	}
+
+	for ( i = 1 ; i < len ; i++ ) {
+		if ( ( s[i] & 0xc0 ) != 0x80 ) {
+			break;
+		}
+		c = ( c << 6 ) | ( s[i] & 0x3f );
+	}
+
+	// overlong forms, surrogates and anything past the last plane are not
+	// text, so fall back to the lead byte
+	if ( i < len || c < min || c > 0x10ffff || ( c >= 0xd800 && c <= 0xdfff ) ) {
+		*string += 1;
+		return s[0];
+	}
+
+	*string += len;
+	return c;
+}
+
 int QDECL Com_sprintf(char *dest, int size, const char *fmt, ...)
 {
 	int		len;
@@ -111,6 +111,7 @@ void MSG_ReadDeltaPlayerstate( msg_t *msg, struct playerState_s *from, struct pl
 
 
 void MSG_ReportChangeVectors_f( void );
+void MSG_HuffBenchmark_f( void );
 
 //============================================================================
 
@@ -253,7 +254,7 @@ PROTOCOL
 ==============================================================
 */
 
-#define	PROTOCOL_VERSION	71
+#define	PROTOCOL_VERSION	73
 #define PROTOCOL_LEGACY_VERSION	68
 // 1.31 - 67
 
@@ -594,6 +595,7 @@ issues.
 #endif
 
 qboolean FS_Initialized( void );
+int		FS_RestartCount( void );
 
 void	FS_InitFilesystem ( void );
 void	FS_Shutdown( qboolean closemfp );
@@ -645,6 +647,10 @@ long		FS_FOpenFileRead( const char *qpath, fileHandle_t *file, qboolean uniqueFI
 int		FS_FileIsInPAK(const char *filename, int *pChecksum );
 // returns 1 if a file is in the PAK file, otherwise -1
 
+qboolean	FS_FileStamp( const char *filename, int *stamp, int *size );
+// the checksum of the pak holding the file, or the modification time of a
+// loose file, and its size; qfalse if the file isn't found
+
 int		FS_Write( const void *buffer, int len, fileHandle_t f );
 
 int		FS_Read( void *buffer, int len, fileHandle_t f );
@@ -1110,6 +1116,26 @@ char *Sys_ConsoleInput(void);
 char **Sys_ListFiles( const char *directory, const char *extension, char *filter, int *numFiles, qboolean wantsubs );
 void	Sys_FreeFileList( char **list );
 void	Sys_Sleep(int msec);
+int		Sys_FileTime( char *path );
+
+// client-only threading, see sys_main.c
+typedef struct sysThread_s sysThread_t;
+typedef struct sysMutex_s sysMutex_t;
+typedef struct sysSemaphore_s sysSemaphore_t;
+
+sysThread_t	*Sys_CreateThread( const char *name, int (*function)( void *data ), void *data );
+int		Sys_WaitThread( sysThread_t *thread );
+sysMutex_t	*Sys_CreateMutex( void );
+void	Sys_DestroyMutex( sysMutex_t *mutex );
+void	Sys_LockMutex( sysMutex_t *mutex );
+void	Sys_UnlockMutex( sysMutex_t *mutex );
+sysSemaphore_t	*Sys_CreateSemaphore( int value );
+void	Sys_DestroySemaphore( sysSemaphore_t *sem );
+void	Sys_PostSemaphore( sysSemaphore_t *sem );
+qboolean	Sys_WaitSemaphore( sysSemaphore_t *sem, int msec );
+int		Sys_AtomicGet( const volatile int *value );
+void	Sys_AtomicSet( volatile int *value, int newValue );
+int		Sys_ProcessorCount( void );
 
 qboolean Sys_LowPhysicalMemory( void );
 
@@ -1173,6 +1199,23 @@ typedef struct {
 	huff_t		decompressor;
 } huffman_t;
 
+/* Lookup tables for a static tree: every code word is precomputed for the
+ * encoder, and the decoder resolves HUFF_LOOKUP_BITS of input per probe */
+#define HUFF_LOOKUP_BITS	11
+#define HUFF_MAX_CODE_BITS	56
+
+typedef struct {
+	node_t*		node;		/* subtree to keep walking when the code is longer than the lookup */
+	short		symbol;
+	byte		bits;
+} huffLookup_t;
+
+typedef struct {
+	uint64_t		code[HMAX+1];	/* first bit sent is the least significant */
+	byte			codeLength[HMAX+1];
+	huffLookup_t	lookup[1<<HUFF_LOOKUP_BITS];
+} huffTable_t;
+
 void	Huff_Compress(msg_t *buf, int offset);
 void	Huff_Decompress(msg_t *buf, int offset);
 void	Huff_Init(huffman_t *huff);
@@ -1181,6 +1224,9 @@ int		Huff_Receive (node_t *node, int *ch, byte *fin);
 void	Huff_transmit (huff_t *huff, int ch, byte *fout, int maxoffset);
 void	Huff_offsetReceive (node_t *node, int *ch, byte *fin, int *offset, int maxoffset);
 void	Huff_offsetTransmit (huff_t *huff, int ch, byte *fout, int *offset, int maxoffset);
+void	Huff_BuildTable(huffTable_t *table, const huff_t *huff);
+void	Huff_tableReceive(const huffTable_t *table, int *ch, const byte *fin, int *offset, int maxoffset);
+void	Huff_tableTransmit(const huffTable_t *table, int ch, byte *fout, int *offset, int maxoffset);
 void	Huff_putBit( int bit, byte *fout, int *offset);
 int		Huff_getBit( byte *fout, int *offset);
 